@@ -18,24 +18,44 @@
 
 #include <Box2D/Common/b2StackAllocator.h>
 #include <Box2D/Common/b2Math.h>
+#include <string.h>
 
 b2StackAllocator::b2StackAllocator()
 {
 	m_index = 0;
 	m_allocation = 0;
 	m_maxAllocation = 0;
+	m_entries = m_entryStorage;
 	m_entryCount = 0;
+	m_entryCapacity = b2_maxStackEntries;
 }
 
 b2StackAllocator::~b2StackAllocator()
 {
 	b2Assert(m_index == 0);
 	b2Assert(m_entryCount == 0);
+
+	if (m_entries != m_entryStorage)
+	{
+		b2Free(m_entries);
+	}
 }
 
 void* b2StackAllocator::Allocate(int32 size)
 {
-	b2Assert(m_entryCount < b2_maxStackEntries);
+	if (m_entryCount == m_entryCapacity)
+	{
+		int32 capacity = m_entryCapacity * 2;
+		b2StackEntry* entries = (b2StackEntry*)b2Alloc(capacity * sizeof(b2StackEntry));
+		memcpy(entries, m_entries, m_entryCount * sizeof(b2StackEntry));
+
+		if (m_entries != m_entryStorage)
+		{
+			b2Free(m_entries);
+		}
+		m_entries = entries;
+		m_entryCapacity = capacity;
+	}
 
 	b2StackEntry* entry = m_entries + m_entryCount;
 	entry->size = size;
@@ -53,8 +53,13 @@ private:
 	int32 m_allocation;
 	int32 m_maxAllocation;
 
-	b2StackEntry m_entries[b2_maxStackEntries];
+	// MOAI: the entry table grows past b2_maxStackEntries instead of
+	// asserting. The parallel island solver keeps every island's buffers
+	// alive until all of them are solved.
+	b2StackEntry m_entryStorage[b2_maxStackEntries];
+	b2StackEntry* m_entries;
 	int32 m_entryCount;
+	int32 m_entryCapacity;
 };
 
 #endif
@@ -184,6 +184,36 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 {
 	b2Timer timer;
 
+	IntegrateVelocities(step, gravity);
+
+	timer.Reset();
+
+	// Initialize velocity constraints.
+	b2ContactSolverDef contactSolverDef;
+	contactSolverDef.step = step;
+	contactSolverDef.contacts = m_contacts;
+	contactSolverDef.count = m_contactCount;
+	contactSolverDef.positions = m_positions;
+	contactSolverDef.velocities = m_velocities;
+	contactSolverDef.allocator = m_allocator;
+
+	b2ContactSolver contactSolver(&contactSolverDef);
+	InitConstraints(contactSolver, step);
+
+	profile->solveInit = timer.GetMilliseconds();
+
+	bool positionSolved = SolveConstraints(profile, contactSolver, step);
+
+	Report(contactSolver.m_velocityConstraints);
+
+	if (allowSleep)
+	{
+		UpdateSleep(step.dt, positionSolved);
+	}
+}
+
+void b2Island::IntegrateVelocities(const b2TimeStep& step, const b2Vec2& gravity)
+{
 	float32 h = step.dt;
 
 	// Integrate velocities and apply damping. Initialize the body state.
@@ -222,25 +252,16 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 		m_velocities[i].v = v;
 		m_velocities[i].w = w;
 	}
+}
 
-	timer.Reset();
-
+void b2Island::InitConstraints(b2ContactSolver& contactSolver, const b2TimeStep& step)
+{
 	// Solver data
 	b2SolverData solverData;
 	solverData.step = step;
 	solverData.positions = m_positions;
 	solverData.velocities = m_velocities;
 
-	// Initialize velocity constraints.
-	b2ContactSolverDef contactSolverDef;
-	contactSolverDef.step = step;
-	contactSolverDef.contacts = m_contacts;
-	contactSolverDef.count = m_contactCount;
-	contactSolverDef.positions = m_positions;
-	contactSolverDef.velocities = m_velocities;
-	contactSolverDef.allocator = m_allocator;
-
-	b2ContactSolver contactSolver(&contactSolverDef);
 	contactSolver.InitializeVelocityConstraints();
 
 	if (step.warmStarting)
@@ -252,8 +273,19 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	{
 		m_joints[i]->InitVelocityConstraints(solverData);
 	}
+}
 
-	profile->solveInit = timer.GetMilliseconds();
+bool b2Island::SolveConstraints(b2Profile* profile, b2ContactSolver& contactSolver, const b2TimeStep& step)
+{
+	b2Timer timer;
+
+	float32 h = step.dt;
+
+	// Solver data
+	b2SolverData solverData;
+	solverData.step = step;
+	solverData.positions = m_positions;
+	solverData.velocities = m_velocities;
 
 	// Solve velocity constraints
 	timer.Reset();
@@ -330,6 +362,14 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 	for (int32 i = 0; i < m_bodyCount; ++i)
 	{
 		b2Body* body = m_bodies[i];
+
+		// MOAI: static bodies are shared between islands and the solver
+		// never moves them, so leave them alone.
+		if (body->m_type == b2_staticBody)
+		{
+			continue;
+		}
+
 		body->m_sweep.c = m_positions[i].c;
 		body->m_sweep.a = m_positions[i].a;
 		body->m_linearVelocity = m_velocities[i].v;
@@ -339,44 +379,44 @@ void b2Island::Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& g
 
 	profile->solvePosition = timer.GetMilliseconds();
 
-	Report(contactSolver.m_velocityConstraints);
+	return positionSolved;
+}
 
-	if (allowSleep)
-	{
-		float32 minSleepTime = b2_maxFloat;
+void b2Island::UpdateSleep(float32 h, bool positionSolved)
+{
+	float32 minSleepTime = b2_maxFloat;
 
-		const float32 linTolSqr = b2_linearSleepTolerance * b2_linearSleepTolerance;
-		const float32 angTolSqr = b2_angularSleepTolerance * b2_angularSleepTolerance;
+	const float32 linTolSqr = b2_linearSleepTolerance * b2_linearSleepTolerance;
+	const float32 angTolSqr = b2_angularSleepTolerance * b2_angularSleepTolerance;
 
-		for (int32 i = 0; i < m_bodyCount; ++i)
+	for (int32 i = 0; i < m_bodyCount; ++i)
+	{
+		b2Body* b = m_bodies[i];
+		if (b->GetType() == b2_staticBody)
 		{
-			b2Body* b = m_bodies[i];
-			if (b->GetType() == b2_staticBody)
-			{
-				continue;
-			}
-
-			if ((b->m_flags & b2Body::e_autoSleepFlag) == 0 ||
-				b->m_angularVelocity * b->m_angularVelocity > angTolSqr ||
-				b2Dot(b->m_linearVelocity, b->m_linearVelocity) > linTolSqr)
-			{
-				b->m_sleepTime = 0.0f;
-				minSleepTime = 0.0f;
-			}
-			else
-			{
-				b->m_sleepTime += h;
-				minSleepTime = b2Min(minSleepTime, b->m_sleepTime);
-			}
+			continue;
 		}
 
-		if (minSleepTime >= b2_timeToSleep && positionSolved)
+		if ((b->m_flags & b2Body::e_autoSleepFlag) == 0 ||
+			b->m_angularVelocity * b->m_angularVelocity > angTolSqr ||
+			b2Dot(b->m_linearVelocity, b->m_linearVelocity) > linTolSqr)
 		{
-			for (int32 i = 0; i < m_bodyCount; ++i)
-			{
-				b2Body* b = m_bodies[i];
-				b->SetAwake(false);
-			}
+			b->m_sleepTime = 0.0f;
+			minSleepTime = 0.0f;
+		}
+		else
+		{
+			b->m_sleepTime += h;
+			minSleepTime = b2Min(minSleepTime, b->m_sleepTime);
+		}
+	}
+
+	if (minSleepTime >= b2_timeToSleep && positionSolved)
+	{
+		for (int32 i = 0; i < m_bodyCount; ++i)
+		{
+			b2Body* b = m_bodies[i];
+			b->SetAwake(false);
 		}
 	}
 }
@@ -27,6 +27,7 @@ class b2Contact;
 class b2Joint;
 class b2StackAllocator;
 class b2ContactListener;
+class b2ContactSolver;
 struct b2ContactVelocityConstraint;
 struct b2Profile;
 
@@ -47,6 +48,16 @@ public:
 
 	void Solve(b2Profile* profile, const b2TimeStep& step, const b2Vec2& gravity, bool allowSleep);
 
+	// MOAI: the stages of Solve, split out so islands can be solved concurrently.
+	// IntegrateVelocities and InitConstraints (along with the contact solver's
+	// constructor) read the island index of shared static bodies and must run
+	// right after the island is built. SolveConstraints only touches this
+	// island's own bodies, contacts and joints. UpdateSleep follows Report.
+	void IntegrateVelocities(const b2TimeStep& step, const b2Vec2& gravity);
+	void InitConstraints(b2ContactSolver& contactSolver, const b2TimeStep& step);
+	bool SolveConstraints(b2Profile* profile, b2ContactSolver& contactSolver, const b2TimeStep& step);
+	void UpdateSleep(float32 h, bool positionSolved);
+
 	void SolveTOI(const b2TimeStep& subStep, int32 toiIndexA, int32 toiIndexB);
 
 	void Add(b2Body* body)
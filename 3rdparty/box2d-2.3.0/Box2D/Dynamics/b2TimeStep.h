@@ -32,6 +32,11 @@ struct b2Profile
 	float32 solvePosition;
 	float32 broadphase;
 	float32 solveTOI;
+
+	// MOAI: parallel island solve (see b2World::SetTaskExecutor)
+	float32 solveParallel;	// wall time of the concurrent constraint solve
+	float32 solveReport;	// post solve callbacks and sleep, replayed afterward
+	int32 islandCount;
 };
 
 /// This is an internal structure.
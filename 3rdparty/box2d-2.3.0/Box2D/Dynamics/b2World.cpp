@@ -34,10 +34,22 @@
 #include <Box2D/Common/b2Timer.h>
 #include <new>
 
+// MOAI: an island built during b2World::Solve and held until every island
+// has been solved by the task executor.
+struct b2IslandJob
+{
+	b2Island* island;
+	b2ContactSolver* contactSolver;
+	b2Profile profile;
+	b2TimeStep step;
+	bool positionSolved;
+};
+
 b2World::b2World(const b2Vec2& gravity)
 {
 	m_destructionListener = NULL;
 	m_debugDraw = NULL;
+	m_taskExecutor = NULL;
 
 	m_bodyList = NULL;
 	m_jointList = NULL;
@@ -104,6 +116,11 @@ void b2World::SetDebugDraw(b2Draw* debugDraw)
 	m_debugDraw = debugDraw;
 }
 
+void b2World::SetTaskExecutor(b2TaskExecutor* executor)
+{
+	m_taskExecutor = executor;
+}
+
 b2Body* b2World::CreateBody(const b2BodyDef* def)
 {
 	b2Assert(IsLocked() == false);
@@ -388,6 +405,9 @@ void b2World::Solve(const b2TimeStep& step)
 	m_profile.solveInit = 0.0f;
 	m_profile.solveVelocity = 0.0f;
 	m_profile.solvePosition = 0.0f;
+	m_profile.solveParallel = 0.0f;
+	m_profile.solveReport = 0.0f;
+	m_profile.islandCount = 0;
 
 	// Size the island for the worst case.
 	b2Island island(m_bodyCount,
@@ -413,6 +433,15 @@ void b2World::Solve(const b2TimeStep& step)
 	// Build and simulate all awake islands.
 	int32 stackSize = m_bodyCount;
 	b2Body** stack = (b2Body**)m_stackAllocator.Allocate(stackSize * sizeof(b2Body*));
+
+	// MOAI: with a task executor, each island is copied out, prepared and
+	// kept until all of them can be solved at once.
+	b2IslandJob* jobs = NULL;
+	int32 jobCount = 0;
+	if (m_taskExecutor)
+	{
+		jobs = (b2IslandJob*)m_stackAllocator.Allocate(b2Max(m_bodyCount, 1) * sizeof(b2IslandJob));
+	}
 	for (b2Body* seed = m_bodyList; seed; seed = seed->m_next)
 	{
 		if (seed->m_flags & b2Body::e_islandFlag)
@@ -527,11 +556,62 @@ void b2World::Solve(const b2TimeStep& step)
 			}
 		}
 
-		b2Profile profile;
-		island.Solve(&profile, step, m_gravity, m_allowSleep);
-		m_profile.solveInit += profile.solveInit;
-		m_profile.solveVelocity += profile.solveVelocity;
-		m_profile.solvePosition += profile.solvePosition;
+		++m_profile.islandCount;
+
+		if (jobs)
+		{
+			b2Timer timer;
+
+			// The copy gets exact sized buffers. Adding the bodies in the same
+			// order also sets their island indices for the constraints.
+			b2IslandJob* job = &jobs[jobCount++];
+			job->step = step;
+
+			void* islandMem = m_stackAllocator.Allocate(sizeof(b2Island));
+			job->island = new (islandMem) b2Island(island.m_bodyCount,
+													island.m_contactCount,
+													island.m_jointCount,
+													&m_stackAllocator,
+													m_contactManager.m_contactListener);
+
+			b2Island* jobIsland = job->island;
+			for (int32 i = 0; i < island.m_bodyCount; ++i)
+			{
+				jobIsland->Add(island.m_bodies[i]);
+			}
+			for (int32 i = 0; i < island.m_contactCount; ++i)
+			{
+				jobIsland->Add(island.m_contacts[i]);
+			}
+			for (int32 i = 0; i < island.m_jointCount; ++i)
+			{
+				jobIsland->Add(island.m_joints[i]);
+			}
+
+			jobIsland->IntegrateVelocities(step, m_gravity);
+
+			b2ContactSolverDef contactSolverDef;
+			contactSolverDef.step = step;
+			contactSolverDef.contacts = jobIsland->m_contacts;
+			contactSolverDef.count = jobIsland->m_contactCount;
+			contactSolverDef.positions = jobIsland->m_positions;
+			contactSolverDef.velocities = jobIsland->m_velocities;
+			contactSolverDef.allocator = &m_stackAllocator;
+
+			void* contactSolverMem = m_stackAllocator.Allocate(sizeof(b2ContactSolver));
+			job->contactSolver = new (contactSolverMem) b2ContactSolver(&contactSolverDef);
+			jobIsland->InitConstraints(*job->contactSolver, step);
+
+			m_profile.solveInit += timer.GetMilliseconds();
+		}
+		else
+		{
+			b2Profile profile;
+			island.Solve(&profile, step, m_gravity, m_allowSleep);
+			m_profile.solveInit += profile.solveInit;
+			m_profile.solveVelocity += profile.solveVelocity;
+			m_profile.solvePosition += profile.solvePosition;
+		}
 
 		// Post solve cleanup.
 		for (int32 i = 0; i < island.m_bodyCount; ++i)
@@ -545,6 +625,45 @@ void b2World::Solve(const b2TimeStep& step)
 		}
 	}
 
+	if (jobs)
+	{
+		b2Timer timer;
+		m_taskExecutor->Run(SolveIslandTask, jobs, jobCount);
+		m_profile.solveParallel = timer.GetMilliseconds();
+
+		// Deliver post solve callbacks and put islands to sleep in the order
+		// the serial solver would have.
+		timer.Reset();
+		for (int32 i = 0; i < jobCount; ++i)
+		{
+			b2IslandJob* job = &jobs[i];
+			m_profile.solveVelocity += job->profile.solveVelocity;
+			m_profile.solvePosition += job->profile.solvePosition;
+
+			job->island->Report(job->contactSolver->m_velocityConstraints);
+
+			if (m_allowSleep)
+			{
+				job->island->UpdateSleep(step.dt, job->positionSolved);
+			}
+		}
+		m_profile.solveReport = timer.GetMilliseconds();
+
+		// Release in reverse to keep the stack allocator happy.
+		for (int32 i = jobCount - 1; i >= 0; --i)
+		{
+			b2IslandJob* job = &jobs[i];
+
+			job->contactSolver->~b2ContactSolver();
+			m_stackAllocator.Free(job->contactSolver);
+
+			job->island->~b2Island();
+			m_stackAllocator.Free(job->island);
+		}
+
+		m_stackAllocator.Free(jobs);
+	}
+
 	m_stackAllocator.Free(stack);
 
 	{
@@ -573,6 +692,13 @@ void b2World::Solve(const b2TimeStep& step)
 	}
 }
 
+// MOAI: solve one prepared island; called by the task executor.
+void b2World::SolveIslandTask(void* context, int32 index)
+{
+	b2IslandJob* job = &((b2IslandJob*)context)[index];
+	job->positionSolved = job->island->SolveConstraints(&job->profile, *job->contactSolver, job->step);
+}
+
 // Find TOI contacts and solve them.
 void b2World::SolveTOI(const b2TimeStep& step)
 {
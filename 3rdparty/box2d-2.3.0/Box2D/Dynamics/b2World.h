@@ -66,6 +66,13 @@ public:
 	/// by you and must remain in scope.
 	void SetDebugDraw(b2Draw* debugDraw);
 
+	/// MOAI: register a task executor to solve independent islands concurrently.
+	/// Contacts and joints are still prepared on the calling thread, and post
+	/// solve callbacks are delivered there in island order once every island
+	/// is solved, so results match the serial solver. Pass NULL to solve
+	/// serially. The executor is owned by you and must remain in scope.
+	void SetTaskExecutor(b2TaskExecutor* executor);
+
 	/// Create a rigid body given a definition. No reference to the definition
 	/// is retained.
 	/// @warning This function is locked during callbacks.
@@ -239,6 +246,9 @@ private:
 	void Solve(const b2TimeStep& step);
 	void SolveTOI(const b2TimeStep& step);
 
+	// MOAI: parallel island solve
+	static void SolveIslandTask(void* context, int32 index);
+
 	void DrawJoint(b2Joint* joint);
 	void DrawShape(b2Fixture* shape, const b2Transform& xf, const b2Color& color);
 
@@ -260,6 +270,7 @@ private:
 
 	b2DestructionListener* m_destructionListener;
 	b2Draw* m_debugDraw;
+	b2TaskExecutor* m_taskExecutor;
 
 	// This is used to compute the time step ratio to
 	// support a variable time step.
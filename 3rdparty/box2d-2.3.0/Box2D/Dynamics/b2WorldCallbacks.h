@@ -118,6 +118,21 @@ public:
 	}
 };
 
+/// MOAI: implement this class to let the world solve its islands concurrently.
+/// Run must call task(context, i) once for every i in [0, count), from any
+/// thread, and return only when all of them are finished. Tasks never call
+/// back into the contact listener.
+/// See b2World::SetTaskExecutor
+class b2TaskExecutor
+{
+public:
+	typedef void (*b2Task)(void* context, int32 index);
+
+	virtual ~b2TaskExecutor() {}
+
+	virtual void Run(b2Task task, void* context, int32 count) = 0;
+};
+
 /// Callback class for AABB queries.
 /// See b2World::Query
 class b2QueryCallback
@@ -0,0 +1,47 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- samples 10k curves of 64 keys each, first as forward playback (key cursor hits)
+-- and then as random seeks (binary search every time)
+
+TOTAL_CURVES	= 10000
+TOTAL_KEYS		= 64
+TOTAL_FRAMES	= 600
+STEP			= 1 / 60
+
+local length = TOTAL_FRAMES * STEP
+
+local target = MOAITransform.new ()
+
+local anim = MOAIAnim.new ()
+anim:reserveLinks ( TOTAL_CURVES )
+
+for i = 1, TOTAL_CURVES do
+
+	local curve = MOAIAnimCurve.new ()
+	curve:reserveKeys ( TOTAL_KEYS )
+
+	for k = 1, TOTAL_KEYS do
+		curve:setKey ( k, length * ( k - 1 ) / ( TOTAL_KEYS - 1 ), math.random ( -100, 100 ), MOAIEaseType.LINEAR )
+	end
+
+	anim:setLink ( i, curve, target, MOAITransform.ATTR_X_LOC )
+end
+
+local function run ( name, getTime )
+
+	local start = MOAISim.getDeviceTime ()
+
+	for frame = 1, TOTAL_FRAMES do
+		anim:apply ( getTime ( frame ))
+	end
+
+	local elapsed = MOAISim.getDeviceTime () - start
+	print ( string.format ( '%-10s %8.2f ms total, %8.4f ms/frame', name, elapsed * 1000, elapsed * 1000 / TOTAL_FRAMES ))
+end
+
+run ( 'forward', function ( frame ) return frame * STEP end )
+run ( 'seek', function ( frame ) return math.random () * length end )
@@ -0,0 +1,73 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- times a box2d step plus the body to transform sync for a pile of dynamic
+-- bodies, each with a prop attached, with and without the bulk sync.
+
+BODIES		= 3000
+FRAMES		= 120
+STEP		= 1 / 60
+
+MOAISim.openWindow ( "box2d-bulk-sync", 640, 480 )
+
+viewport = MOAIViewport.new ()
+viewport:setSize ( 640, 480 )
+viewport:setScale ( 640, 480 )
+
+layer = MOAIPartitionViewLayer.new ()
+layer:setViewport ( viewport )
+layer:pushRenderPass ()
+
+deck = MOAISpriteDeck2D.new ()
+deck:setTexture ( "moai.png" )
+deck:setRect ( -2, -2, 2, 2 )
+
+----------------------------------------------------------------
+function run ( bulkSync )
+
+	local world = MOAIBox2DWorld.new ()
+	world:setGravity ( 0, -10 )
+	world:setUnitsToMeters ( 0.05 )
+	world:setBulkSync ( bulkSync )
+
+	local ground = world:addBody ( MOAIBox2DBody.STATIC )
+	ground:addRect ( -320, -240, 320, -220 )
+
+	math.randomseed ( 1 )
+
+	local props = {}
+
+	for i = 1, BODIES do
+
+		local body = world:addBody ( MOAIBox2DBody.DYNAMIC )
+		body:setTransform ( math.random ( -300, 300 ), math.random ( -200, 2000 ))
+
+		local fixture = body:addCircle ( 0, 0, 2 )
+		fixture:setDensity ( 1 )
+
+		local prop = MOAIGraphicsProp.new ()
+		prop:setDeck ( deck )
+		prop:setParent ( body )
+		prop:setPartition ( layer )
+		props [ i ] = prop
+	end
+
+	local start = MOAISim.getDeviceTime ()
+	for i = 1, FRAMES do
+		world:update ( STEP )
+		MOAINodeMgr.update ()
+	end
+	local elapsed = MOAISim.getDeviceTime () - start
+
+	print ( string.format ( "bulk sync %-5s %8.3f ms/frame", tostring ( bulkSync ), ( elapsed * 1000 ) / FRAMES ))
+
+	for i, prop in ipairs ( props ) do
+		prop:setPartition ()
+	end
+end
+
+run ( false )
+run ( true )
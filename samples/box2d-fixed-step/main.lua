@@ -0,0 +1,58 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- runs a world on a fixed step clock while the frame rate jitters. each
+-- frame prints how many substeps ran and the interpolation alpha; the sprite
+-- should move smoothly even when a frame runs zero or several steps.
+
+FIXED_STEP		= 1 / 60
+MAX_SUBSTEPS	= 4
+FRAMES			= 120
+
+MOAISim.openWindow ( "box2d-fixed-step", 640, 480 )
+
+viewport = MOAIViewport.new ()
+viewport:setSize ( 640, 480 )
+viewport:setScale ( 640, 480 )
+
+layer = MOAIPartitionViewLayer.new ()
+layer:setViewport ( viewport )
+layer:pushRenderPass ()
+
+deck = MOAISpriteDeck2D.new ()
+deck:setTexture ( "moai.png" )
+deck:setRect ( -16, -16, 16, 16 )
+
+world = MOAIBox2DWorld.new ()
+world:setGravity ( 0, -10 )
+world:setUnitsToMeters ( 0.05 )
+world:setFixedStep ( FIXED_STEP, MAX_SUBSTEPS, MOAIBox2DWorld.INTERPOLATION_LINEAR )
+
+ground = world:addBody ( MOAIBox2DBody.STATIC )
+ground:addRect ( -320, -240, 320, -220 )
+
+body = world:addBody ( MOAIBox2DBody.DYNAMIC )
+body:setTransform ( 0, 200 )
+body:addRect ( -16, -16, 16, 16 ):setDensity ( 1 )
+body:setAngularVelocity ( 90 )
+
+prop = MOAIGraphicsProp.new ()
+prop:setDeck ( deck )
+prop:setParent ( body )
+prop:setPartition ( layer )
+
+math.randomseed ( 1 )
+
+for i = 1, FRAMES do
+	-- frame times between a third and twice the physics step
+	local dt = FIXED_STEP * ( 0.33 + math.random () * 1.67 )
+	world:update ( dt )
+	MOAINodeMgr.update ()
+
+	local alpha, substeps = world:getInterpolation ()
+	local x, y = prop:getWorldLoc ()
+	print ( string.format ( "dt %6.2f ms  substeps %d  alpha %.3f  y %8.3f", dt * 1000, substeps, alpha, y ))
+end
@@ -0,0 +1,62 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- times a world of independent stacks (one island each) solved serially and
+-- then on worker threads, and prints the getPerformance breakdown. the final
+-- positions and the post solve callback tally should match between runs.
+
+STACKS		= 48
+HEIGHT		= 12
+FRAMES		= 120
+STEP		= 1 / 60
+WORKERS		= 3
+
+----------------------------------------------------------------
+function run ( workers )
+
+	local world = MOAIBox2DWorld.new ()
+	world:setGravity ( 0, -10 )
+	world:setWorkerCount ( workers )
+
+	local ground = world:addBody ( MOAIBox2DBody.STATIC )
+	ground:addRect ( -500, -1, 500, 0 )
+
+	local impulse = 0
+
+	for i = 1, STACKS do
+		for j = 1, HEIGHT do
+			local body = world:addBody ( MOAIBox2DBody.DYNAMIC )
+			body:setTransform (( i - STACKS / 2 ) * 10, j * 1.05 )
+			local fixture = body:addRect ( -0.5, -0.5, 0.5, 0.5 )
+			fixture:setDensity ( 1 )
+			fixture:setCollisionHandler ( function ( phase, a, b, arbiter )
+				impulse = impulse + arbiter:getNormalImpulse ()
+			end, MOAIBox2DArbiter.POST_SOLVE )
+		end
+	end
+
+	local totals = {}
+	for i = 1, FRAMES do
+		world:update ( STEP )
+		local perf = { world:getPerformance ()}
+		for k, v in ipairs ( perf ) do
+			totals [ k ] = ( totals [ k ] or 0 ) + v
+		end
+	end
+
+	print ( string.format ( "workers %d: step %.3f solve %.3f parallel %.3f report %.3f islands %d ms/frame, impulse %.6f",
+		workers,
+		totals [ 1 ] / FRAMES,
+		totals [ 3 ] / FRAMES,
+		totals [ 9 ] / FRAMES,
+		totals [ 10 ] / FRAMES,
+		totals [ 11 ] / FRAMES,
+		impulse
+	))
+end
+
+run ( 0 )
+run ( WORKERS )
@@ -0,0 +1,70 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- scatters bodies around the world and runs the native queries against
+-- them: a box, a circle, a ray that reports every hit and a batch of rays
+-- written to and read from streams.
+
+BODIES		= 500
+RAYS		= 1000
+
+MOAISim.openWindow ( "box2d-queries", 640, 480 )
+
+viewport = MOAIViewport.new ()
+viewport:setSize ( 640, 480 )
+viewport:setScale ( 640, 480 )
+
+world = MOAIBox2DWorld.new ()
+world:setUnitsToMeters ( 0.05 )
+
+debugLayer = MOAITableViewLayer.new ()
+debugLayer:setViewport ( viewport )
+debugLayer:setRenderTable ( world )
+debugLayer:pushRenderPass ()
+
+math.randomseed ( 1 )
+
+for i = 1, BODIES do
+
+	local body = world:addBody ( MOAIBox2DBody.STATIC )
+	body:setTransform ( math.random ( -300, 300 ), math.random ( -220, 220 ))
+
+	local fixture = body:addCircle ( 0, 0, 4 )
+	fixture:setFilter (( i % 2 == 0 ) and 0x01 or 0x02 )
+end
+
+----------------------------------------------------------------
+print ( "queryAABB", select ( "#", world:queryAABB ( -100, -100, 100, 100 )))
+print ( "queryAABB, category 1", select ( "#", world:queryAABB ( -100, -100, 100, 100, 0x01 )))
+print ( "queryShape, circle", select ( "#", world:queryShape ( 0, 0, 100 )))
+print ( "queryShape, polygon", select ( "#", world:queryShape ({ 0, 100, -100, -100, 100, -100 })))
+print ( "rayCastAll", select ( "#", world:rayCastAll ( -320, 0, 320, 0 )) / 5 )
+
+----------------------------------------------------------------
+rays = MOAIMemStream.new ()
+rays:open ()
+
+for i = 1, RAYS do
+	local angle = math.rad ( i * 360 / RAYS )
+	rays:writeFloat ( 0, 0, math.cos ( angle ) * 400, math.sin ( angle ) * 400 )
+end
+
+results = MOAIMemStream.new ()
+results:open ()
+
+fixtures = {}
+
+local start = MOAISim.getDeviceTime ()
+rays:seek ( 0 )
+results:seek ( 0 )
+local hits = world:rayCastBatch ( rays, results, fixtures )
+local elapsed = MOAISim.getDeviceTime () - start
+
+print ( string.format ( "rayCastBatch %d rays %d hits %8.3f ms", RAYS, hits, elapsed * 1000 ))
+
+results:seek ( 0 )
+local fraction, x, y, nx, ny = results:readFloat ( 5 )
+print ( "first ray", fraction, x, y, nx, ny, fixtures [ 1 ])
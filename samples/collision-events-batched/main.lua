@@ -0,0 +1,95 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- times overlap event delivery for a crowd of moving colliders, once with a
+-- callback per event and once with a single batched callback per pass. half
+-- of the props only ask for events about the other half.
+
+PROPS		= 5000
+FRAMES		= 60
+SIZE		= 4
+EXTENT		= 400
+
+RED			= 0x01
+BLUE		= 0x02
+
+MOAISim.openWindow ( "collision-events-batched", 640, 480 )
+
+events = 0
+
+onOverlap = function ( event, prop1, prop2 )
+	events = events + 1
+end
+
+onOverlapBatch = function ( nextEvent, total )
+	for event, prop1, prop2 in nextEvent do
+		events = events + 1
+	end
+end
+
+collDeck = MOAICollisionDeck.new ()
+collDeck:reserveShapes ( 1 )
+collDeck:setRect ( 1, -SIZE, -SIZE, SIZE, SIZE )
+
+----------------------------------------------------------------
+function run ( batch, name )
+
+	local world = MOAICollisionWorld.new ()
+	world:setBroadphase ( MOAICollisionWorld.BROADPHASE_SWEEP )
+	world:setCallback ( batch and onOverlapBatch or onOverlap, batch )
+
+	math.randomseed ( 1 )
+
+	local props = {}
+	local velocities = {}
+
+	for i = 1, PROPS do
+
+		local prop = MOAICollisionProp.new ()
+		prop:setDeck ( collDeck )
+		prop:setOverlapFlags ( MOAICollisionProp.OVERLAP_EVENTS_LIFECYCLE + MOAICollisionProp.OVERLAP_EVENTS_ON_UPDATE )
+		prop:setLoc ( math.random ( -EXTENT, EXTENT ), math.random ( -EXTENT, EXTENT ))
+
+		if i % 2 == 0 then
+			prop:setCategory ( RED )
+			prop:setEventMask ( BLUE )
+		else
+			prop:setCategory ( BLUE )
+			prop:setEventMask ( 0 )
+		end
+
+		prop:setPartition ( world )
+		prop:forceUpdate ()
+
+		props [ i ] = prop
+		velocities [ i ] = { math.random () * 2 - 1, math.random () * 2 - 1 }
+	end
+
+	events = 0
+	local elapsed = 0
+
+	for frame = 1, FRAMES do
+
+		for i, prop in ipairs ( props ) do
+			local v = velocities [ i ]
+			prop:addLoc ( v [ 1 ], v [ 2 ])
+			prop:forceUpdate ()
+		end
+
+		local start = MOAISim.getDeviceTime ()
+		world:processOverlaps ()
+		elapsed = elapsed + ( MOAISim.getDeviceTime () - start )
+	end
+
+	print ( string.format ( "%-10s %8.3f ms/pass %d events", name, ( elapsed * 1000 ) / FRAMES, events ))
+
+	for i, prop in ipairs ( props ) do
+		prop:setPartition ()
+	end
+end
+
+run ( false, "per-event" )
+run ( true, "batched" )
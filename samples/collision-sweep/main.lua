@@ -0,0 +1,77 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- times overlap processing for a crowd of moving colliders with each
+-- broadphase. both runs start from the same layout and should report the
+-- same number of overlap events.
+
+PROPS		= 5000
+FRAMES		= 60
+SIZE		= 4
+EXTENT		= 600
+
+MOAISim.openWindow ( "collision-sweep", 640, 480 )
+
+events = 0
+
+onOverlap = function ( event, prop1, prop2 )
+	events = events + 1
+end
+
+collDeck = MOAICollisionDeck.new ()
+collDeck:reserveShapes ( 1 )
+collDeck:setRect ( 1, -SIZE, -SIZE, SIZE, SIZE )
+
+----------------------------------------------------------------
+function run ( broadphase, name )
+
+	local world = MOAICollisionWorld.new ()
+	world:setBroadphase ( broadphase )
+	world:setCallback ( onOverlap )
+
+	math.randomseed ( 1 )
+
+	local props = {}
+	local velocities = {}
+
+	for i = 1, PROPS do
+
+		local prop = MOAICollisionProp.new ()
+		prop:setDeck ( collDeck )
+		prop:setOverlapFlags ( MOAICollisionProp.OVERLAP_EVENTS_LIFECYCLE )
+		prop:setLoc ( math.random ( -EXTENT, EXTENT ), math.random ( -EXTENT, EXTENT ))
+		prop:setPartition ( world )
+		prop:forceUpdate ()
+
+		props [ i ] = prop
+		velocities [ i ] = { math.random () * 2 - 1, math.random () * 2 - 1 }
+	end
+
+	events = 0
+	local elapsed = 0
+
+	for frame = 1, FRAMES do
+
+		for i, prop in ipairs ( props ) do
+			local v = velocities [ i ]
+			prop:addLoc ( v [ 1 ], v [ 2 ])
+			prop:forceUpdate ()
+		end
+
+		local start = MOAISim.getDeviceTime ()
+		world:processOverlaps ()
+		elapsed = elapsed + ( MOAISim.getDeviceTime () - start )
+	end
+
+	print ( string.format ( "%-10s %8.3f ms/pass %d events", name, ( elapsed * 1000 ) / FRAMES, events ))
+
+	for i, prop in ipairs ( props ) do
+		prop:setPartition ()
+	end
+end
+
+run ( MOAICollisionWorld.BROADPHASE_PARTITION, "partition" )
+run ( MOAICollisionWorld.BROADPHASE_SWEEP, "sweep" )
@@ -0,0 +1,74 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- times closest hit ray casts against a mesh of scattered triangles, first
+-- with the linear scan and then through a BVH. the BVH is round tripped
+-- through a stream to check that a saved one gives the same answers.
+
+TRIANGLES	= 50000
+RAYS		= 200
+SIZE		= 100
+
+MOAISim.openWindow ( "mesh-bvh", 320, 480 )
+
+math.randomseed ( 1 )
+
+vertexFormat = MOAIVertexFormat.new ()
+vertexFormat:declareCoord ( 1, MOAIVertexFormat.GL_FLOAT, 3 )
+
+vbo = MOAIVertexBuffer.new ()
+vbo:reserve ( TRIANGLES * 3 * vertexFormat:getVertexSize ())
+
+for i = 1, TRIANGLES do
+	local x, y, z = math.random () * SIZE, math.random () * SIZE, math.random () * SIZE
+	for j = 1, 3 do
+		vbo:writeFloat ( x + math.random (), y + math.random (), z + math.random ())
+	end
+end
+
+mesh = MOAIMesh.new ()
+mesh:setVertexBuffer ( vbo, vertexFormat )
+mesh:setTotalElements ( TRIANGLES * 3 )
+mesh:setBounds ( vbo:computeBounds ( vertexFormat ))
+mesh:setPrimType ( MOAIMesh.GL_TRIANGLES )
+
+rays = {}
+for i = 1, RAYS do
+	rays [ i ] = { math.random () * SIZE, math.random () * SIZE, -10, math.random () - 0.5, math.random () - 0.5, 1 }
+end
+
+----------------------------------------------------------------
+function castAll ( label )
+
+	local results = {}
+	local start = MOAISim.getDeviceTime ()
+	for i, ray in ipairs ( rays ) do
+		results [ i ] = mesh:getClosestHit ( unpack ( ray )) or 0
+	end
+	local elapsed = MOAISim.getDeviceTime () - start
+	print ( string.format ( "%-8s %8.4f ms/ray", label, ( elapsed * 1000 ) / RAYS ))
+	return results
+end
+
+local linear = castAll ( "linear" )
+
+local start = MOAISim.getDeviceTime ()
+mesh:buildBVH ()
+print ( string.format ( "build    %8.3f ms", ( MOAISim.getDeviceTime () - start ) * 1000 ))
+
+local stream = MOAIMemStream.new ()
+stream:open ()
+mesh:writeBVH ( stream )
+stream:seek ( 0 )
+print ( "read back", mesh:readBVH ( stream ))
+
+local bvh = castAll ( "bvh" )
+
+local mismatches = 0
+for i = 1, RAYS do
+	if linear [ i ] ~= bvh [ i ] then mismatches = mismatches + 1 end
+end
+print ( "mismatches", mismatches )
@@ -0,0 +1,94 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- draws a large field of particle sprites and flips between drawing them
+-- through the deck one at a time and writing them straight into the vertex
+-- cache. the frame rate for each mode is printed as it runs.
+
+PARTICLES	= 20000
+PERIOD		= 3
+
+MOAISim.openWindow ( "particles-direct-draw", 640, 480 )
+
+viewport = MOAIViewport.new ()
+viewport:setSize ( 640, 480 )
+viewport:setScale ( 640, 480 )
+
+layer = MOAIPartitionViewLayer.new ()
+layer:setViewport ( viewport )
+layer:pushRenderPass ()
+
+CONST = MOAIParticleScript.packConst
+ROT = MOAIParticleScript.packReg ( 1 )
+
+----------------------------------------------------------------
+local init = MOAIParticleScript.new ()
+
+init:rand				( MOAIParticleScript.PARTICLE_X, CONST ( -320 ), CONST ( 320 ))
+init:rand				( MOAIParticleScript.PARTICLE_Y, CONST ( -240 ), CONST ( 240 ))
+init:rand				( ROT, CONST ( 0 ), CONST ( 360 ))
+
+local render = MOAIParticleScript.new ()
+
+render:sprite			()
+render:set				( MOAIParticleScript.SPRITE_X_LOC, MOAIParticleScript.PARTICLE_X )
+render:set				( MOAIParticleScript.SPRITE_Y_LOC, MOAIParticleScript.PARTICLE_Y )
+render:ease				( MOAIParticleScript.SPRITE_ROT, ROT, CONST ( 720 ), MOAIEaseType.LINEAR )
+render:ease				( MOAIParticleScript.SPRITE_OPACITY, CONST ( 1 ), CONST ( 0 ), MOAIEaseType.EASE_OUT )
+
+----------------------------------------------------------------
+texture = MOAISpriteDeck2D.new ()
+texture:setTexture ( "../resources/moai.png" )
+texture:setRect ( -4, -4, 4, 4 )
+
+state = MOAIParticleState.new ()
+state:setTerm ( 4, 8 )
+state:setInitScript ( init )
+state:setRenderScript ( render )
+
+system = MOAIParticleSystem.new ()
+system:reserveParticles ( PARTICLES, 1 )
+system:reserveSprites ( PARTICLES )
+system:reserveStates ( 1 )
+system:setDeck ( texture )
+system:setState ( 1, state )
+system:setPartition ( layer )
+system:start ()
+
+emitter = MOAIParticleTimedEmitter.new ()
+emitter:setSystem ( system )
+emitter:setFrequency ( 1 / 60 )
+emitter:setEmission ( PARTICLES / 360 )
+emitter:start ()
+
+for i = 1, PARTICLES do
+	system:pushParticle ( 0, 0 )
+end
+
+----------------------------------------------------------------
+thread = MOAICoroutine.new ()
+thread:run ( function ()
+
+	local direct = true
+
+	while true do
+
+		system:setDirectDraw ( direct )
+
+		local start = MOAISim.getDeviceTime ()
+		local frames = 0
+
+		while MOAISim.getDeviceTime () - start < PERIOD do
+			coroutine.yield ()
+			frames = frames + 1
+		end
+
+		local elapsed = MOAISim.getDeviceTime () - start
+		print ( string.format ( "direct %-5s %8.3f ms/frame", tostring ( direct ), ( elapsed * 1000 ) / frames ))
+
+		direct = not direct
+	end
+end )
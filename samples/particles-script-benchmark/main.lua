@@ -0,0 +1,90 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- times the particle update with render scripts batched and unbatched.
+-- the render script follows the pex plugin's gravity mode: integrate the
+-- position, then ease color, scale and rotation over the particle's life.
+
+PARTICLES	= 100000
+FRAMES		= 60
+STEP		= 1 / 60
+
+MOAISim.openWindow ( "particles-script-benchmark", 640, 480 )
+
+viewport = MOAIViewport.new ()
+viewport:setSize ( 640, 480 )
+viewport:setScale ( 640, 480 )
+
+layer = MOAIPartitionViewLayer.new ()
+layer:setViewport ( viewport )
+layer:pushRenderPass ()
+
+CONST = MOAIParticleScript.packConst
+
+local rSpin = MOAIParticleScript.packReg ( 5 )
+
+----------------------------------------------------------------
+local init = MOAIParticleScript.new ()
+
+init:randVec			( MOAIParticleScript.PARTICLE_DX, MOAIParticleScript.PARTICLE_DY, CONST ( 0.5 ), CONST ( 2 ))
+init:rand				( rSpin, CONST ( -360 ), CONST ( 360 ))
+
+local render = MOAIParticleScript.new ()
+
+render:add				( MOAIParticleScript.PARTICLE_X, MOAIParticleScript.PARTICLE_X, MOAIParticleScript.PARTICLE_DX )
+render:add				( MOAIParticleScript.PARTICLE_Y, MOAIParticleScript.PARTICLE_Y, MOAIParticleScript.PARTICLE_DY )
+
+render:sprite			()
+render:ease				( MOAIParticleScript.SPRITE_ROT, CONST ( 0 ), rSpin, MOAIEaseType.LINEAR )
+render:ease				( MOAIParticleScript.SPRITE_X_SCL, CONST ( 1 ), CONST ( 0.25 ), MOAIEaseType.LINEAR )
+render:set				( MOAIParticleScript.SPRITE_Y_SCL, MOAIParticleScript.SPRITE_X_SCL )
+render:ease				( MOAIParticleScript.SPRITE_RED, CONST ( 1 ), CONST ( 0.2 ), MOAIEaseType.LINEAR )
+render:ease				( MOAIParticleScript.SPRITE_GREEN, CONST ( 0.8 ), CONST ( 0.1 ), MOAIEaseType.LINEAR )
+render:ease				( MOAIParticleScript.SPRITE_BLUE, CONST ( 0.2 ), CONST ( 0 ), MOAIEaseType.LINEAR )
+render:ease				( MOAIParticleScript.SPRITE_OPACITY, CONST ( 1 ), CONST ( 0 ), MOAIEaseType.EASE_OUT )
+
+----------------------------------------------------------------
+texture = MOAISpriteDeck2D.new ()
+texture:setTexture ( "../resources/moai.png" )
+texture:setRect ( -4, -4, 4, 4 )
+
+state = MOAIParticleState.new ()
+state:setTerm ( 1000, 1000 )
+state:setInitScript ( init )
+state:setRenderScript ( render )
+
+system = MOAIParticleSystem.new ()
+system:reserveParticles ( PARTICLES, 6 )
+system:reserveSprites ( PARTICLES )
+system:reserveStates ( 1 )
+system:setDeck ( texture )
+system:setState ( 1, state )
+system:setPartition ( layer )
+
+for i = 1, PARTICLES do
+	system:pushParticle ( 0, 0 )
+end
+
+----------------------------------------------------------------
+function run ( batching )
+
+	system:setScriptBatching ( batching )
+
+	local start = MOAISim.getDeviceTime ()
+	for i = 1, FRAMES do
+		system:update ( STEP )
+	end
+	local elapsed = MOAISim.getDeviceTime () - start
+
+	print ( string.format ( "batching %-5s %8.3f ms/frame", tostring ( batching ), ( elapsed * 1000 ) / FRAMES ))
+end
+
+run ( false )
+run ( true )
+run ( false )
+run ( true )
+
+system:start ()
@@ -0,0 +1,107 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- times threaded particle systems with and without worker threads. each
+-- system is seeded, so both runs simulate the same particles.
+
+SYSTEMS		= 40
+PARTICLES	= 5000
+FRAMES		= 60
+STEP		= 1 / 60
+
+MOAISim.openWindow ( "particles-threaded", 640, 480 )
+
+viewport = MOAIViewport.new ()
+viewport:setSize ( 640, 480 )
+viewport:setScale ( 640, 480 )
+
+layer = MOAIPartitionViewLayer.new ()
+layer:setViewport ( viewport )
+layer:pushRenderPass ()
+
+CONST = MOAIParticleScript.packConst
+
+----------------------------------------------------------------
+local init = MOAIParticleScript.new ()
+
+init:randVec			( MOAIParticleScript.PARTICLE_DX, MOAIParticleScript.PARTICLE_DY, CONST ( 0.5 ), CONST ( 2 ))
+
+local render = MOAIParticleScript.new ()
+
+render:add				( MOAIParticleScript.PARTICLE_X, MOAIParticleScript.PARTICLE_X, MOAIParticleScript.PARTICLE_DX )
+render:add				( MOAIParticleScript.PARTICLE_Y, MOAIParticleScript.PARTICLE_Y, MOAIParticleScript.PARTICLE_DY )
+
+render:sprite			()
+render:ease				( MOAIParticleScript.SPRITE_X_SCL, CONST ( 1 ), CONST ( 0.25 ), MOAIEaseType.LINEAR )
+render:set				( MOAIParticleScript.SPRITE_Y_SCL, MOAIParticleScript.SPRITE_X_SCL )
+render:ease				( MOAIParticleScript.SPRITE_OPACITY, CONST ( 1 ), CONST ( 0 ), MOAIEaseType.EASE_OUT )
+
+----------------------------------------------------------------
+texture = MOAISpriteDeck2D.new ()
+texture:setTexture ( "../resources/moai.png" )
+texture:setRect ( -4, -4, 4, 4 )
+
+state = MOAIParticleState.new ()
+state:setTerm ( 2, 4 )
+state:setInitScript ( init )
+state:setRenderScript ( render )
+
+systems = {}
+emitters = {}
+
+for i = 1, SYSTEMS do
+
+	local system = MOAIParticleSystem.new ()
+	system:reserveParticles ( PARTICLES, 0 )
+	system:reserveSprites ( PARTICLES )
+	system:reserveStates ( 1 )
+	system:setDeck ( texture )
+	system:setState ( 1, state )
+	system:setThreaded ( true )
+	system:setPartition ( layer )
+	systems [ i ] = system
+
+	local emitter = MOAIParticleTimedEmitter.new ()
+	emitter:setLoc ((( i - 1 ) % 8 ) * 80 - 280, math.floor (( i - 1 ) / 8 ) * 80 - 160 )
+	emitter:setSystem ( system )
+	emitter:setFrequency ( STEP )
+	emitter:setEmission ( 40 )
+	emitters [ i ] = emitter
+end
+
+----------------------------------------------------------------
+function run ( workers )
+
+	MOAIParticleMgr.setWorkerCount ( workers )
+
+	for i, system in ipairs ( systems ) do
+		system:setSeed ( i )
+		for j = 1, PARTICLES do
+			system:pushParticle ( 0, 0 )
+		end
+	end
+
+	local start = MOAISim.getDeviceTime ()
+	for i = 1, FRAMES do
+		for j, system in ipairs ( systems ) do
+			system:update ( STEP )
+		end
+		MOAIParticleMgr.update ()
+	end
+	local elapsed = MOAISim.getDeviceTime () - start
+
+	print ( string.format ( "workers %d %8.3f ms/frame", workers, ( elapsed * 1000 ) / FRAMES ))
+end
+
+run ( 0 )
+run ( 4 )
+run ( 0 )
+run ( 4 )
+
+for i = 1, SYSTEMS do
+	systems [ i ]:start ()
+	emitters [ i ]:start ()
+end
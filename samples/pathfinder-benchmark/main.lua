@@ -0,0 +1,100 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- runs random start/target queries over open, scattered and maze-like grids
+-- with each search mode and reports time per query and average path length
+
+QUERIES		= 200
+
+local function makeGrid ( size, wallChance, maze )
+
+	local grid = MOAIGrid.new ()
+	grid:setSize ( size, size, 1, 1 )
+
+	for y = 1, size do
+		for x = 1, size do
+			local wall = math.random () < wallChance
+			if maze and ( x % 8 == 0 ) and ( y % size ~= x % size ) then
+				wall = true
+			end
+			grid:setTile ( x, y, wall and 0 or 1 )
+		end
+	end
+	return grid
+end
+
+local function randomOpenCell ( grid, size )
+
+	while true do
+		local x, y = math.random ( size ), math.random ( size )
+		if grid:getTile ( x, y ) ~= 0 then
+			return grid:getCellAddr ( x, y )
+		end
+	end
+end
+
+local MODES = {
+	{ 'default',	0 },
+	{ 'jps',		MOAIGridPathGraph.JUMP_POINTS },
+	{ 'hpa',		MOAIGridPathGraph.HIERARCHICAL },
+}
+
+local function query ( name, grid, size, flags, edits )
+
+	local graph = MOAIGridPathGraph.new ()
+	graph:setGrid ( grid )
+
+	local pathFinder = MOAIPathFinder.new ()
+	pathFinder:setGraph ( graph )
+	pathFinder:setHeuristic ( MOAIGridPathGraph.DIAGONAL_DISTANCE )
+	pathFinder:setFlags ( flags )
+
+	-- first query pays for building the hierarchy
+	pathFinder:init ( randomOpenCell ( grid, size ), randomOpenCell ( grid, size ))
+	pathFinder:findPath ()
+
+	local found = 0
+	local totalLength = 0
+
+	local start = MOAISim.getDeviceTime ()
+
+	for i = 1, QUERIES do
+
+		-- toggle a few tiles between queries to exercise incremental repair
+		for j = 1, edits do
+			local x, y = math.random ( size ), math.random ( size )
+			grid:setTile ( x, y, grid:getTile ( x, y ) == 0 and 1 or 0 )
+		end
+
+		pathFinder:init ( randomOpenCell ( grid, size ), randomOpenCell ( grid, size ))
+		pathFinder:findPath ()
+		local length = pathFinder:getPathSize ()
+		if length > 0 then
+			found = found + 1
+			totalLength = totalLength + length
+		end
+	end
+
+	local elapsed = MOAISim.getDeviceTime () - start
+	print ( string.format ( '%-20s %4dx%-4d %8.3f ms/query, %4d/%d found, avg length %.1f',
+		name, size, size, elapsed * 1000 / QUERIES, found, QUERIES, found > 0 and totalLength / found or 0 ))
+end
+
+local function run ( name, size, wallChance, maze, edits )
+
+	for i, mode in ipairs ( MODES ) do
+		math.randomseed ( 1 )
+		local grid = makeGrid ( size, wallChance, maze )
+		query ( name .. ' ' .. mode [ 1 ], grid, size, mode [ 2 ], edits or 0 )
+	end
+end
+
+run ( 'open', 64, 0.0 )
+run ( 'open', 256, 0.0 )
+run ( 'scattered', 256, 0.25 )
+run ( 'maze', 256, 0.1, true )
+run ( 'maze+edits', 256, 0.1, true, 4 )
+run ( 'scattered', 1024, 0.2 )
@@ -0,0 +1,86 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- sends a batch of units to a handful of rally points on background queues,
+-- editing the grid while the batch is in flight
+
+SIZE		= 256
+UNITS		= 500
+TARGETS		= 8
+QUEUES		= 4
+
+MOAISim.openWindow ( 'test', 320, 480 )
+
+math.randomseed ( 1 )
+
+grid = MOAIGrid.new ()
+grid:setSize ( SIZE, SIZE, 1, 1 )
+
+for y = 1, SIZE do
+	for x = 1, SIZE do
+		grid:setTile ( x, y, math.random () < 0.2 and 0 or 1 )
+	end
+end
+
+local function randomOpenCell ()
+
+	while true do
+		local x, y = math.random ( SIZE ), math.random ( SIZE )
+		if grid:getTile ( x, y ) ~= 0 then
+			return grid:getCellAddr ( x, y )
+		end
+	end
+end
+
+graph = MOAIGridPathGraph.new ()
+graph:setGrid ( grid )
+
+pathFinder = MOAIPathFinder.new ()
+pathFinder:setGraph ( graph )
+
+queues = {}
+for i = 1, QUEUES do
+	queues [ i ] = MOAITaskQueue.new ()
+end
+
+service = MOAIPathService.new ()
+service:setPathFinder ( pathFinder )
+
+local targets = {}
+for i = 1, TARGETS do
+	targets [ i ] = randomOpenCell ()
+end
+
+for i = 1, UNITS do
+	service:addRequest ( randomOpenCell (), targets [ math.random ( TARGETS )])
+end
+
+local start = MOAISim.getDeviceTime ()
+
+local function onFinish ( paths, batchID, version )
+
+	local elapsed = MOAISim.getDeviceTime () - start
+
+	local found = 0
+	local totalLength = 0
+	for i, path in ipairs ( paths ) do
+		if #path > 0 then
+			found = found + 1
+			totalLength = totalLength + #path
+		end
+	end
+
+	print ( string.format ( 'batch %d: %d/%d found, avg length %.1f, %.3f ms',
+		batchID, found, #paths, found > 0 and totalLength / found or 0, elapsed * 1000 ))
+	print ( string.format ( 'found on snapshot %d', version ))
+end
+
+service:findPaths ( onFinish, unpack ( queues ))
+
+-- safe: the batch reads from its own snapshot; the next batch will get a new one
+for i = 1, 100 do
+	grid:setTile ( math.random ( SIZE ), math.random ( SIZE ), 0 )
+end
@@ -0,0 +1,85 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- times point and distance queries against a region with thousands of
+-- polygons, with and without the region's index, then times a boolean
+-- against a small region. editing a vertex drops the index, so the
+-- unindexed copy is made by rewriting one vertex in place.
+
+POLYGONS	= 4000
+QUERIES		= 20000
+SIZE		= 2000
+
+----------------------------------------------------------------
+function makeRegion ( count, size, minRad, maxRad )
+
+	local region = MOAIRegion.new ()
+	region:reservePolygons ( count )
+
+	for i = 1, count do
+
+		local x = math.random () * size
+		local y = math.random () * size
+		local r = minRad + ( math.random () * ( maxRad - minRad ))
+
+		region:reserveVertices ( i, 4 )
+		region:setVertex ( i, 1, x - r, y - r )
+		region:setVertex ( i, 2, x + r, y - r )
+		region:setVertex ( i, 3, x + r, y + r )
+		region:setVertex ( i, 4, x - r, y + r )
+	end
+
+	region:bless ()
+	return region
+end
+
+----------------------------------------------------------------
+function query ( region, points )
+
+	local inside = 0
+	local total = 0
+
+	local start = MOAISim.getDeviceTime ()
+	for i = 1, #points, 2 do
+		local x, y = points [ i ], points [ i + 1 ]
+		if region:pointInside ( x, y ) then inside = inside + 1 end
+		local d = region:getDistance ( x, y )
+		total = total + ( d or 0 )
+	end
+	return MOAISim.getDeviceTime () - start, inside, total
+end
+
+math.randomseed ( 1 )
+
+indexed = makeRegion ( POLYGONS, SIZE, 2, 10 )
+
+linear = MOAIRegion.new ()
+linear:copy ( indexed )
+local vertex = linear:getPolygon ( 1 )[ 1 ]
+linear:setVertex ( 1, 1, vertex.x, vertex.y )
+
+points = {}
+for i = 1, QUERIES * 2 do
+	points [ i ] = math.random () * SIZE
+end
+
+local indexedTime, indexedInside, indexedTotal = query ( indexed, points )
+local linearTime, linearInside, linearTotal = query ( linear, points )
+
+print ( string.format ( "indexed: %.3fs (%d inside, distance sum %f)", indexedTime, indexedInside, indexedTotal ))
+print ( string.format ( "linear:  %.3fs (%d inside, distance sum %f)", linearTime, linearInside, linearTotal ))
+print ( "polygons near the middle:", indexed:findPolygons ( SIZE / 2 - 20, SIZE / 2 - 20, SIZE / 2 + 20, SIZE / 2 + 20 ))
+
+view = makeRegion ( 8, SIZE, 50, 100 )
+
+local start = MOAISim.getDeviceTime ()
+result = MOAIRegion.new ()
+result:boolean ( indexed, view, MOAIRegion.BOOLEAN_AND )
+print ( string.format ( "and: %.3fs (%d polygons)", MOAISim.getDeviceTime () - start, result:countPolygons ()))
+
+start = MOAISim.getDeviceTime ()
+result:boolean ( indexed, view, MOAIRegion.BOOLEAN_OR )
+print ( string.format ( "or:  %.3fs (%d polygons)", MOAISim.getDeviceTime () - start, result:countPolygons ()))
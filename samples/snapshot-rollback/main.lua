@@ -0,0 +1,71 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- captures and restores a 5k node scene, then rolls back and re-simulates
+
+TOTAL_NODES		= 5000
+ITERATIONS		= 100
+ROLLBACK		= 8
+
+local snapshot = MOAISnapshot.new ()
+snapshot:reserve ( 1024 * 1024 )
+snapshot:reserveObjects ( TOTAL_NODES * 2 )
+
+for i = 1, TOTAL_NODES do
+
+	local transform = MOAITransform.new ()
+	transform:setLoc ( math.random ( -100, 100 ), math.random ( -100, 100 ))
+
+	local action = transform:moveRot ( 0, 0, 360, 10 )
+
+	snapshot:setObject ( i, transform )
+	snapshot:setObject ( TOTAL_NODES + i, action )
+end
+
+local function bench ( name, func )
+
+	local start = MOAISim.getDeviceTime ()
+	for i = 1, ITERATIONS do
+		func ()
+	end
+	local elapsed = MOAISim.getDeviceTime () - start
+	print ( string.format ( '%-10s %8.4f ms', name, elapsed * 1000 / ITERATIONS ))
+end
+
+print ( 'snapshot size:', snapshot:capture ())
+
+bench ( 'capture', function () snapshot:capture () end )
+bench ( 'restore', function () snapshot:restore () end )
+
+snapshot:capture ()
+local stepCount = MOAISim.getStepCount ()
+
+MOAISim.resimulate ( ROLLBACK )
+snapshot:restore ()
+assert ( MOAISim.getStepCount () == stepCount )
+
+print ( string.format ( 'resimulate %8.4f ms for %d steps', MOAISim.resimulate ( ROLLBACK ) * 1000, ROLLBACK ))
+
+-- from inside a step (here, a coroutine) the rollback is deferred until the
+-- step finishes; asking again from inside the resimulated steps is an error
+thread = MOAICoroutine.new ()
+thread:run ( function ()
+
+	coroutine.yield ()
+
+	local before = MOAISim.getStepCount ()
+	assert ( MOAISim.resimulate ( ROLLBACK ) == nil )
+	assert ( MOAISim.getStepCount () == before )
+
+	-- resumed by the first resimulated step
+	coroutine.yield ()
+	assert ( not pcall ( MOAISim.resimulate, 1 ))
+
+	while MOAISim.getStepCount () < ( before + ROLLBACK + 1 ) do
+		coroutine.yield ()
+	end
+	print ( string.format ( 'deferred resimulate ran %d steps', MOAISim.getStepCount () - before - 1 ))
+end )
@@ -0,0 +1,74 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- times the node update for 50k moving sprites. every prop is rotated and
+-- translated by its own action each step, so the whole set is dirty every
+-- frame. the second pass sets a pivot on every prop to cover the pivot path.
+
+TOTAL_PROPS		= 50000
+WARMUP			= 30
+FRAMES			= 300
+
+MOAISim.openWindow ( "transform-update-benchmark", 640, 480 )
+
+viewport = MOAIViewport.new ()
+viewport:setSize ( 640, 480 )
+viewport:setScale ( 640, 480 )
+
+layer = MOAIPartitionViewLayer.new ()
+layer:setViewport ( viewport )
+layer:pushRenderPass ()
+
+deck = MOAISpriteDeck2D.new ()
+deck:setTexture ( "../resources/moai.png" )
+deck:setRect ( -4, -4, 4, 4 )
+
+props = {}
+
+for i = 1, TOTAL_PROPS do
+
+	local prop = MOAIGraphicsProp.new ()
+	prop:setDeck ( deck )
+	prop:setPartition ( layer )
+	prop:setLoc ( math.random ( -320, 320 ), math.random ( -240, 240 ))
+	prop:moveRot ( 0, 0, 360 * 100, 1000 )
+	prop:moveLoc ( math.random ( -64, 64 ), math.random ( -64, 64 ), 0, 1000 )
+
+	props [ i ] = prop
+end
+
+----------------------------------------------------------------
+function bench ( name )
+
+	for i = 1, WARMUP do
+		coroutine.yield ()
+	end
+
+	local actionTime = 0
+	local nodeTime = 0
+
+	for i = 1, FRAMES do
+		coroutine.yield ()
+		local fps, lastActionTree, lastNodeMgr = MOAISim.getPerformance ()
+		actionTime = actionTime + lastActionTree
+		nodeTime = nodeTime + lastNodeMgr
+	end
+
+	print ( string.format ( '%-10s action tree %8.3f ms/frame   node update %8.3f ms/frame', name, actionTime * 1000 / FRAMES, nodeTime * 1000 / FRAMES ))
+end
+
+----------------------------------------------------------------
+thread = MOAICoroutine.new ()
+thread:run ( function ()
+
+	bench ( 'no pivot' )
+
+	for i = 1, TOTAL_PROPS do
+		props [ i ]:setPiv ( 2, 2 )
+	end
+
+	bench ( 'pivot' )
+end )
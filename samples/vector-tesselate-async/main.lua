@@ -0,0 +1,76 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- times tesselating a drawing of many stroked polygons on the main thread,
+-- then again as an async job split across worker threads, and checks that
+-- both wrote the same vertex and index bytes. the job hands the shapes back
+-- to the tesselator when it publishes, so both runs see the same drawing.
+
+SHAPES		= 4000
+SIDES		= 12
+WORKERS		= 3
+SIZE		= 2000
+
+----------------------------------------------------------------
+function build ( tess )
+
+	tess:setFillStyle ( MOAIVectorTesselator.FILL_SOLID )
+	tess:setStrokeStyle ( MOAIVectorTesselator.STROKE_CENTER )
+	tess:setStrokeWidth ( 2 )
+
+	for i = 1, SHAPES do
+
+		local x = math.random () * SIZE
+		local y = math.random () * SIZE
+		local r = 5 + ( math.random () * 20 )
+
+		local vertices = {}
+		for j = 0, SIDES - 1 do
+			local a = ( j / SIDES ) * math.pi * 2
+			local d = r * ( 0.5 + ( math.random () * 0.5 ))
+			vertices [ #vertices + 1 ] = x + ( math.cos ( a ) * d )
+			vertices [ #vertices + 1 ] = y + ( math.sin ( a ) * d )
+		end
+
+		tess:setFillColor ( i / SHAPES, 0.5, 1.0, 1.0 )
+		tess:pushPoly ( unpack ( vertices ))
+	end
+end
+
+----------------------------------------------------------------
+function readAll ( buffer )
+
+	buffer:seek ( 0 )
+	return buffer:read ( buffer:getLength ())
+end
+
+math.randomseed ( 1 )
+
+tess = MOAIVectorTesselator.new ()
+tess:setWorkerCount ( WORKERS )
+build ( tess )
+
+vtxFormat = MOAIVertexFormatMgr.getFormat ( MOAIVertexFormatMgr.XYZC )
+
+serialVtx = MOAIVertexBuffer.new ()
+serialIdx = MOAIIndexBuffer.new ()
+
+local start = MOAISim.getDeviceTime ()
+local serialElements = tess:tesselate ( serialVtx, serialIdx, 4, vtxFormat )
+print ( string.format ( "serial: %.3fs (%d elements)", MOAISim.getDeviceTime () - start, serialElements ))
+
+queue = MOAITaskQueue.new ()
+asyncVtx = MOAIVertexBuffer.new ()
+asyncIdx = MOAIIndexBuffer.new ()
+
+start = MOAISim.getDeviceTime ()
+tess:tesselateAsync ( queue, function ( totalElements )
+
+	print ( string.format ( "async:  %.3fs (%d elements, %d workers)", MOAISim.getDeviceTime () - start, totalElements, WORKERS ))
+	
+	local same = ( readAll ( serialVtx ) == readAll ( asyncVtx )) and ( readAll ( serialIdx ) == readAll ( asyncIdx ))
+	print ( "identical output:", same )
+end, asyncVtx, asyncIdx, 4, vtxFormat )
@@ -0,0 +1,68 @@
+----------------------------------------------------------------
+-- Copyright (c) 2010-2017 Zipline Games, Inc. 
+-- All Rights Reserved. 
+-- http://getmoai.com
+----------------------------------------------------------------
+
+-- times rebuilding a vector drawing of many small shapes with and without
+-- the tesselator's shape cache. the drawing is rebuilt from scratch each
+-- frame, as an editor or animated ui would, but only one shape moves, so
+-- with the cache enabled everything else is copied from the last call.
+
+SHAPES		= 400
+FRAMES		= 60
+SIZE		= 1000
+
+----------------------------------------------------------------
+function build ( tess, positions, frame )
+
+	tess:clearShapes ()
+
+	tess:setFillStyle ( MOAIVectorTesselator.FILL_SOLID )
+	tess:setStrokeStyle ( MOAIVectorTesselator.STROKE_CENTER )
+	tess:setStrokeWidth ( 2 )
+	tess:setCircleResolution ( 32 )
+
+	for i = 1, SHAPES do
+
+		local x, y = positions [ i ].x, positions [ i ].y
+		if i == 1 then x = x + frame end
+
+		tess:setFillColor ( i / SHAPES, 0.5, 1.0, 1.0 )
+		tess:pushEllipse ( x, y, 10 )
+	end
+end
+
+----------------------------------------------------------------
+function run ( tess, positions )
+
+	local vtxFormat = MOAIVertexFormatMgr.getFormat ( MOAIVertexFormatMgr.XYZC )
+	local vtxBuffer = MOAIVertexBuffer.new ()
+	local idxBuffer = MOAIIndexBuffer.new ()
+	local totalElements = 0
+
+	local start = MOAISim.getDeviceTime ()
+	for frame = 1, FRAMES do
+		build ( tess, positions, frame )
+		totalElements = tess:tesselate ( vtxBuffer, idxBuffer, 4, vtxFormat )
+	end
+	return MOAISim.getDeviceTime () - start, totalElements
+end
+
+math.randomseed ( 1 )
+
+positions = {}
+for i = 1, SHAPES do
+	positions [ i ] = { x = math.random () * SIZE, y = math.random () * SIZE }
+end
+
+plain = MOAIVectorTesselator.new ()
+cached = MOAIVectorTesselator.new ()
+cached:setCacheEnabled ( true )
+
+local plainTime, plainElements = run ( plain, positions )
+local cachedTime, cachedElements = run ( cached, positions )
+
+print ( string.format ( "uncached: %.3fs (%d elements)", plainTime, plainElements ))
+print ( string.format ( "cached:   %.3fs (%d elements)", cachedTime, cachedElements ))
+print ( "hits, misses, entries:", cached:getCacheStats ())
@@ -0,0 +1,69 @@
+//----------------------------------------------------------------//
+// Copyright (c) 2010-2017 Zipline Games, Inc.
+// All Rights Reserved.
+// http://getmoai.com
+//----------------------------------------------------------------//
+
+#include <moai-sim/headers.h>
+#include "moai_gtest.h"
+
+#if AKU_WITH_BOX2D
+
+//----------------------------------------------------------------//
+static double GetGlobalNumber ( MOAILuaState& state, cc8* name ) {
+
+	lua_getglobal ( state, name );
+	double value = lua_tonumber ( state, -1 );
+	state.Pop ( 1 );
+	return value;
+}
+
+//----------------------------------------------------------------//
+// the bulk sync skips the regular node update; bodies with update listeners must still get one
+TEST_F ( GTESTMoaiContext, MOAIBox2DWorldBulkSyncListeners ) {
+	ASSERT_TRUE ( this->mContext != 0 );
+
+	AKUModulesContextInitialize ();
+
+	MOAIScopedLuaState state = MOAILuaRuntime::Get ().State ();
+
+	lua_pushnumber ( state, MOAINode::EVENT_NODE_PRE_UPDATE );
+	lua_setglobal ( state, "PRE_UPDATE" );
+
+	lua_pushnumber ( state, MOAINode::EVENT_NODE_POST_UPDATE );
+	lua_setglobal ( state, "POST_UPDATE" );
+
+	cc8* script =
+		"preCount, postCount = 0, 0\n"
+		"world = MOAIBox2DWorld.new ()\n"
+		"world:setGravity ( 0, -10 )\n"
+		"listened = world:addBody ( MOAIBox2DBody.DYNAMIC )\n"
+		"listened:addRect ( -1, -1, 1, 1 )\n"
+		"listened:setListener ( PRE_UPDATE, function () preCount = preCount + 1 end )\n"
+		"listened:setListener ( POST_UPDATE, function () postCount = postCount + 1 end )\n"
+		"plain = world:addBody ( MOAIBox2DBody.DYNAMIC )\n"
+		"plain:addRect ( -1, -1, 1, 1 )\n"
+		"plain:setTransform ( 10, 0 )\n";
+
+	ASSERT_EQ ( luaL_loadstring ( state, script ), 0 );
+	ASSERT_EQ ( state.DebugCall ( 0, 0 ), 0 );
+
+	for ( u32 i = 0; i < 4; ++i ) {
+
+		luaL_loadstring ( state, "world:update ( 1 / 60 )" );
+		state.DebugCall ( 0, 0 );
+		MOAINodeMgr::Get ().Update ();
+	}
+
+	ASSERT_EQ ( GetGlobalNumber ( state, "preCount" ), 4.0 );
+	ASSERT_EQ ( GetGlobalNumber ( state, "postCount" ), 4.0 );
+
+	// both bodies fell, whichever path synced them
+	luaL_loadstring ( state, "x1, y1 = listened:getWorldLoc () x2, y2 = plain:getWorldLoc ()" );
+	state.DebugCall ( 0, 0 );
+
+	ASSERT_LT ( GetGlobalNumber ( state, "y1" ), 0.0 );
+	ASSERT_LT ( GetGlobalNumber ( state, "y2" ), 0.0 );
+}
+
+#endif
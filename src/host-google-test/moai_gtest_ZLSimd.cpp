@@ -0,0 +1,265 @@
+//----------------------------------------------------------------//
+// Copyright (c) 2010-2017 Zipline Games, Inc.
+// All Rights Reserved.
+// http://getmoai.com
+//----------------------------------------------------------------//
+
+#include <moai-sim/headers.h>
+#include "moai_gtest.h"
+
+// The float matrices take the ZLSimd kernels when MOAI_SIMD is defined; the
+// double matrices always run the scalar code, so they serve as the reference.
+
+#define SIMD_TEST_ITERATIONS	256
+#define SIMD_TEST_POINTS		37		// odd, to cover the tail of the 2D kernel
+#define SIMD_TEST_TOLERANCE		0.0001f
+#define SIMD_BENCH_POINTS		4096
+#define SIMD_BENCH_PASSES		2000
+
+//----------------------------------------------------------------//
+static bool IsClose ( float value, double expected ) {
+
+	return ZLFloat::IsClose ( value, ( float )expected, SIMD_TEST_TOLERANCE * ( 1.0f + ( float )fabs ( expected )));
+}
+
+//----------------------------------------------------------------//
+static float RandomFloat () {
+
+	return ((( float )rand () / ( float )RAND_MAX ) * 2.0f ) - 1.0f;
+}
+
+//----------------------------------------------------------------//
+static void RandomMatrix ( ZLAffine3D& mtx, ZLAffine3D64& ref ) {
+
+	for ( u32 i = 0; i < 12; ++i ) {
+		mtx.m [ i ] = RandomFloat ();
+		ref.m [ i ] = mtx.m [ i ];
+	}
+}
+
+//----------------------------------------------------------------//
+static void RandomMatrix ( ZLMatrix4x4& mtx, ZLDoubleMatrix4x4& ref ) {
+
+	for ( u32 i = 0; i < 16; ++i ) {
+		mtx.m [ i ] = RandomFloat ();
+
+		// keep the diagonal dominant so the inverse is well conditioned
+		if ( i % 5 == 0 ) {
+			mtx.m [ i ] += 4.0f;
+		}
+		ref.m [ i ] = mtx.m [ i ];
+	}
+}
+
+//----------------------------------------------------------------//
+template < typename MATRIX, typename REF_MATRIX >
+static bool TestTransformPoints ( const MATRIX& mtx, const REF_MATRIX& ref ) {
+
+	ZLVec2D points2D [ SIMD_TEST_POINTS ];
+	ZLVec3D points3D [ SIMD_TEST_POINTS ];
+	ZLVec4D points4D [ SIMD_TEST_POINTS ];
+
+	ZLVec2D64 refs2D [ SIMD_TEST_POINTS ];
+	ZLVec3D64 refs3D [ SIMD_TEST_POINTS ];
+	ZLVec4D64 refs4D [ SIMD_TEST_POINTS ];
+
+	for ( u32 i = 0; i < SIMD_TEST_POINTS; ++i ) {
+
+		points2D [ i ].Init ( RandomFloat (), RandomFloat ());
+		points3D [ i ].Init ( RandomFloat (), RandomFloat (), RandomFloat ());
+		points4D [ i ].Init ( RandomFloat (), RandomFloat (), RandomFloat (), RandomFloat ());
+
+		refs2D [ i ].Init ( points2D [ i ].mX, points2D [ i ].mY );
+		refs3D [ i ].Init ( points3D [ i ].mX, points3D [ i ].mY, points3D [ i ].mZ );
+		refs4D [ i ].Init ( points4D [ i ].mX, points4D [ i ].mY, points4D [ i ].mZ, points4D [ i ].mW );
+
+		ref.Transform ( refs2D [ i ]);
+		ref.Transform ( refs3D [ i ]);
+		ref.Transform ( refs4D [ i ]);
+	}
+
+	mtx.TransformPoints ( points2D, SIMD_TEST_POINTS );
+	mtx.TransformPoints ( points3D, SIMD_TEST_POINTS );
+	mtx.TransformPoints ( points4D, SIMD_TEST_POINTS );
+
+	for ( u32 i = 0; i < SIMD_TEST_POINTS; ++i ) {
+
+		if ( !( IsClose ( points2D [ i ].mX, refs2D [ i ].mX ) && IsClose ( points2D [ i ].mY, refs2D [ i ].mY ))) return false;
+		if ( !( IsClose ( points3D [ i ].mX, refs3D [ i ].mX ) && IsClose ( points3D [ i ].mY, refs3D [ i ].mY ) && IsClose ( points3D [ i ].mZ, refs3D [ i ].mZ ))) return false;
+		if ( !( IsClose ( points4D [ i ].mX, refs4D [ i ].mX ) && IsClose ( points4D [ i ].mY, refs4D [ i ].mY ) && IsClose ( points4D [ i ].mZ, refs4D [ i ].mZ ) && IsClose ( points4D [ i ].mW, refs4D [ i ].mW ))) return false;
+	}
+	return true;
+}
+
+//----------------------------------------------------------------//
+TEST ( ZLSimd, Affine3D ) {
+
+	srand ( 1 );
+
+	for ( u32 i = 0; i < SIMD_TEST_ITERATIONS; ++i ) {
+
+		ZLAffine3D mtx1, mtx2, result;
+		ZLAffine3D64 ref1, ref2, refResult;
+
+		RandomMatrix ( mtx1, ref1 );
+		RandomMatrix ( mtx2, ref2 );
+
+		result.Multiply ( mtx2, mtx1 );
+		refResult.Multiply ( ref2, ref1 );
+
+		for ( u32 j = 0; j < 12; ++j ) {
+			ASSERT_TRUE ( IsClose ( result.m [ j ], refResult.m [ j ]));
+		}
+
+		ASSERT_TRUE ( TestTransformPoints ( result, refResult ));
+	}
+}
+
+//----------------------------------------------------------------//
+TEST ( ZLSimd, Matrix4x4 ) {
+
+	srand ( 1 );
+
+	for ( u32 i = 0; i < SIMD_TEST_ITERATIONS; ++i ) {
+
+		ZLMatrix4x4 mtx1, mtx2, result, inverse;
+		ZLDoubleMatrix4x4 ref1, ref2, refResult, refInverse;
+
+		RandomMatrix ( mtx1, ref1 );
+		RandomMatrix ( mtx2, ref2 );
+
+		result.Multiply ( mtx2, mtx1 );
+		refResult.Multiply ( ref2, ref1 );
+
+		for ( u32 j = 0; j < 16; ++j ) {
+			ASSERT_TRUE ( IsClose ( result.m [ j ], refResult.m [ j ]));
+		}
+
+		ASSERT_TRUE ( inverse.Inverse ( mtx1 ));
+		ASSERT_TRUE ( refInverse.Inverse ( ref1 ));
+
+		for ( u32 j = 0; j < 16; ++j ) {
+			ASSERT_TRUE ( IsClose ( inverse.m [ j ], refInverse.m [ j ]));
+		}
+
+		ASSERT_TRUE ( TestTransformPoints ( result, refResult ));
+	}
+
+	// singular matrices report failure and copy the source, as before
+	ZLMatrix4x4 singular, inverse;
+	singular.Scale ( 1.0f, 0.0f, 1.0f );
+
+	ASSERT_FALSE ( inverse.Inverse ( singular ));
+	ASSERT_TRUE ( inverse.IsSame ( singular ));
+}
+
+//----------------------------------------------------------------//
+TEST ( ZLSimd, TransformQuads ) {
+
+	srand ( 1 );
+
+	ZLMatrix4x4 mtx;
+	ZLDoubleMatrix4x4 ref;
+	RandomMatrix ( mtx, ref );
+
+	ZLAffine3D affine;
+	ZLAffine3D64 affineRef;
+	RandomMatrix ( affine, affineRef );
+
+	ZLQuad quads [ 3 ];
+	ZLQuad affineQuads [ 3 ];
+	ZLVec2D64 refs [ 12 ];
+	ZLVec2D64 affineRefs [ 12 ];
+
+	for ( u32 i = 0; i < 12; ++i ) {
+
+		ZLVec2D& point = quads [ i >> 2 ].mV [ i & 3 ];
+		point.Init ( RandomFloat (), RandomFloat ());
+		affineQuads [ i >> 2 ].mV [ i & 3 ] = point;
+
+		refs [ i ].Init ( point.mX, point.mY );
+		affineRefs [ i ] = refs [ i ];
+
+		ref.Transform ( refs [ i ]);
+		affineRef.Transform ( affineRefs [ i ]);
+	}
+
+	mtx.TransformQuads ( quads [ 0 ].mV, 3 );
+
+	for ( u32 i = 0; i < 3; ++i ) {
+		affineQuads [ i ].Transform ( affine );
+	}
+
+	for ( u32 i = 0; i < 12; ++i ) {
+
+		const ZLVec2D& point = quads [ i >> 2 ].mV [ i & 3 ];
+		const ZLVec2D& affinePoint = affineQuads [ i >> 2 ].mV [ i & 3 ];
+
+		ASSERT_TRUE ( IsClose ( point.mX, refs [ i ].mX ) && IsClose ( point.mY, refs [ i ].mY ));
+		ASSERT_TRUE ( IsClose ( affinePoint.mX, affineRefs [ i ].mX ) && IsClose ( affinePoint.mY, affineRefs [ i ].mY ));
+	}
+}
+
+//----------------------------------------------------------------//
+// not a pass/fail test; reports the batch transform against the per point loop
+TEST ( ZLSimd, Benchmark ) {
+
+	srand ( 1 );
+
+	ZLMatrix4x4 mtx;
+	ZLDoubleMatrix4x4 ref;
+	RandomMatrix ( mtx, ref );
+
+	ZLLeanArray < ZLVec4D > points;
+	points.Init ( SIMD_BENCH_POINTS );
+
+	for ( u32 i = 0; i < SIMD_BENCH_POINTS; ++i ) {
+		points [ i ].Init ( RandomFloat (), RandomFloat (), RandomFloat (), 1.0f );
+	}
+
+	// renormalize every pass so the values stay bounded
+	ZLMatrix4x4 inverse;
+	inverse.Inverse ( mtx );
+
+	double start = ZLDeviceTime::GetTimeInSeconds ();
+
+	for ( u32 pass = 0; pass < SIMD_BENCH_PASSES; ++pass ) {
+		ZLVec4D* data = points.Data ();
+		for ( u32 i = 0; i < SIMD_BENCH_POINTS; ++i ) {
+			mtx.Transform ( data [ i ]);
+			inverse.Transform ( data [ i ]);
+		}
+	}
+
+	double scalar = ZLDeviceTime::GetTimeInSeconds () - start;
+	start = ZLDeviceTime::GetTimeInSeconds ();
+
+	for ( u32 pass = 0; pass < SIMD_BENCH_PASSES; ++pass ) {
+		mtx.TransformPoints ( points.Data (), SIMD_BENCH_POINTS );
+		inverse.TransformPoints ( points.Data (), SIMD_BENCH_POINTS );
+	}
+
+	double batch = ZLDeviceTime::GetTimeInSeconds () - start;
+
+	start = ZLDeviceTime::GetTimeInSeconds ();
+
+	ZLMatrix4x4 product;
+	ZLMatrix4x4 round;
+	for ( u32 pass = 0; pass < SIMD_BENCH_PASSES * 64; ++pass ) {
+		product.Multiply ( mtx, inverse );
+		round.Inverse ( product );
+	}
+
+	double multiply = ZLDeviceTime::GetTimeInSeconds () - start;
+
+	#ifdef MOAI_SIMD
+		printf ( "simd: on\n" );
+	#else
+		printf ( "simd: off\n" );
+	#endif
+	printf ( "per point transform: %f ms\n", scalar * 1000.0 );
+	printf ( "batch transform: %f ms\n", batch * 1000.0 );
+	printf ( "multiply + inverse x %d: %f ms\n", SIMD_BENCH_PASSES * 64, multiply * 1000.0 );
+
+	ASSERT_TRUE ( IsClose ( round.m [ 0 ], 1.0 ));
+}
@@ -995,6 +995,7 @@ int MOAIBox2DBody::_setTransform ( lua_State* L ) {
 	float angle		= state.GetValue < float >( 4, 0.0f ) * ( float )D2R;
 	
 	self->mBody->SetTransform ( position, angle );
+	self->ResetInterpolation ();
 	self->ScheduleUpdate ();
 	
 	return 0;
@@ -1044,7 +1045,9 @@ void MOAIBox2DBody::Destroy () {
 
 //----------------------------------------------------------------//
 MOAIBox2DBody::MOAIBox2DBody () :
-	mBody ( 0 ) {
+	mBody ( 0 ),
+	mPrevPosition ( 0.0f, 0.0f ),
+	mPrevAngle ( 0.0f ) {
 	
 	RTTI_BEGIN
 		RTTI_EXTEND ( MOAITransformBase )
@@ -1114,11 +1117,40 @@ void MOAIBox2DBody::RegisterLuaFuncs ( MOAILuaState& state ) {
 	luaL_register ( state, 0, regTable );
 }
 
+//----------------------------------------------------------------//
+// call when the body is placed directly so it doesn't appear to slide there
+void MOAIBox2DBody::ResetInterpolation () {
+
+	if ( this->mBody ) {
+		this->mPrevPosition = this->mBody->GetPosition ();
+		this->mPrevAngle = this->mBody->GetAngle ();
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIBox2DBody::SetBody ( b2Body* body ) {
 
 	this->mBody = body;
 	body->SetUserData ( this );
+	this->ResetInterpolation ();
+}
+
+//----------------------------------------------------------------//
+// x and y are in world units
+void MOAIBox2DBody::SyncTransform ( float x, float y, float c, float s ) {
+
+	float* m = this->mLocalToWorldMtx.m;
+	
+	m [ ZLAffine3D::C0_R0 ] = c;
+	m [ ZLAffine3D::C0_R1 ] = s;
+
+	m [ ZLAffine3D::C1_R0 ] = -s;
+	m [ ZLAffine3D::C1_R1 ] = c;
+
+	m [ ZLAffine3D::C3_R0 ] = x;
+	m [ ZLAffine3D::C3_R1 ] = y;
+	
+	this->InvalidateWorldToLocalMtx ();
 }
 
 //================================================================//
@@ -1138,18 +1170,21 @@ bool MOAIBox2DBody::MOAINode_ApplyAttrOp ( u32 attrID, MOAIAttribute& attr, u32
 			case MOAITransform::ATTR_X_LOC: {
 				float x = attr.Apply ( xform.p.x, op, MOAIAttribute::ATTR_READ_WRITE ) * this->GetUnitsToMeters ();
 				mBody->SetTransform ( b2Vec2( x, xform.p.y), xform.q.GetAngle() );
+				this->ResetInterpolation ();
 				return true;
 			}
 				
 			case MOAITransform::ATTR_Y_LOC: {
 				float y = attr.Apply ( xform.p.y, op, MOAIAttribute::ATTR_READ_WRITE ) * this->GetUnitsToMeters ();
 				mBody->SetTransform ( b2Vec2( xform.p.x, y ), xform.q.GetAngle() );
+				this->ResetInterpolation ();
 				return true;
 			}
 				
 			case MOAITransform::ATTR_Z_ROT: {
 				float angle = attr.Apply ( xform.q.GetAngle(), op, MOAIAttribute::ATTR_READ_WRITE );
 				mBody->SetTransform ( xform.p,  ( float )((angle * D2R) + M_PI_4 ));
+				this->ResetInterpolation ();
 				return true;
 			}
 		}
@@ -1162,21 +1197,11 @@ void MOAIBox2DBody::MOAINode_Update () {
 
 	if ( this->mBody ) {
 		
-		b2Transform transform = this->mBody->GetTransform ();
-		float scale = 1.0f / this->GetUnitsToMeters ();
-		
-		float* m = this->mLocalToWorldMtx.m;
+		float x, y, c, s;
+		this->mWorld->GetRenderTransform ( *this, x, y, c, s );
 		
-		m [ ZLAffine3D::C0_R0 ] = ( float )transform.q.GetXAxis().x;
-		m [ ZLAffine3D::C0_R1 ] = ( float )transform.q.GetXAxis().y;
-
-		m [ ZLAffine3D::C1_R0 ] = ( float )transform.q.GetYAxis().x;
-		m [ ZLAffine3D::C1_R1 ] = ( float )transform.q.GetYAxis().y;
-
-		m [ ZLAffine3D::C3_R0 ] = ( float )transform.p.x * scale;
-		m [ ZLAffine3D::C3_R1 ] = ( float )transform.p.y * scale;
-		
-		this->mWorldToLocalMtx.Inverse ( this->mLocalToWorldMtx );
+		float scale = 1.0f / this->GetUnitsToMeters ();
+		this->SyncTransform ( x * scale, y * scale, c, s );
 	}
 }
 
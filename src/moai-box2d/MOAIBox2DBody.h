@@ -25,6 +25,10 @@ class MOAIBox2DBody :
 private:
 
 	b2Body*			mBody;
+	
+	// physics transform before the last fixed step; used to interpolate
+	b2Vec2			mPrevPosition;
+	float			mPrevAngle;
 
 	//----------------------------------------------------------------//
 	static int		_addChain				( lua_State* L );
@@ -67,7 +71,9 @@ private:
 	
 	//----------------------------------------------------------------//
 	void			Clear					();
+	void			ResetInterpolation		();
 	void			SetBody					( b2Body* body );
+	void			SyncTransform			( float x, float y, float c, float s );
 	
 	//----------------------------------------------------------------//
 	bool			MOAINode_ApplyAttrOp						( u32 attrID, MOAIAttribute& attr, u32 op );
@@ -34,25 +34,146 @@ private:
 	b2Fixture*		m_fixture;
 	b2Vec2			m_point;
 	b2Vec2			m_normal;
+	float32			m_fraction;
+	u32				m_mask;
 
 public:
 
 	//----------------------------------------------------------------//
-	MOAIBox2DRayCastCallback () {
+	MOAIBox2DRayCastCallback ( u32 mask = 0xffff ) {
 		m_fixture = NULL;
 		m_point.SetZero();
 		m_normal.SetZero();
+		m_fraction = 1.0f;
+		m_mask = mask;
 	}
 
 	//----------------------------------------------------------------//
 	float32 ReportFixture ( b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float32 fraction ) {
+		if ( !( fixture->GetFilterData ().categoryBits & m_mask )) return -1.0f;
 		m_fixture = fixture;
 		m_point = point;
 		m_normal = normal;
+		m_fraction = fraction;
 		return fraction;
 	}
 };
 
+//================================================================//
+// MOAIBox2DRayHit
+//================================================================//
+class MOAIBox2DRayHit {
+public:
+
+	b2Fixture*		mFixture;
+	b2Vec2			mPoint;
+	b2Vec2			mNormal;
+	float32			mFraction;
+};
+
+//================================================================//
+// MOAIBox2DRayCastAllCallback
+//================================================================//
+// collects every fixture along the ray, nearest first
+class MOAIBox2DRayCastAllCallback :
+	public b2RayCastCallback {
+private:
+
+	friend class MOAIBox2DWorld;
+
+	u32									mMask;
+	ZLLeanStack < MOAIBox2DRayHit, 16 >	mHits;
+
+public:
+
+	//----------------------------------------------------------------//
+	MOAIBox2DRayCastAllCallback ( u32 mask ) :
+		mMask ( mask ) {
+	}
+
+	//----------------------------------------------------------------//
+	float32 ReportFixture ( b2Fixture* fixture, const b2Vec2& point, const b2Vec2& normal, float32 fraction ) {
+	
+		if ( !( fixture->GetFilterData ().categoryBits & this->mMask )) return -1.0f;
+		if ( !fixture->GetUserData ()) return -1.0f;
+		
+		// fixtures are reported in no particular order; insert sorted
+		this->mHits.Push ();
+		MOAIBox2DRayHit* hits = this->mHits;
+		
+		u32 i = ( u32 )this->mHits.GetTop () - 1;
+		for ( ; ( i > 0 ) && ( hits [ i - 1 ].mFraction > fraction ); --i ) {
+			hits [ i ] = hits [ i - 1 ];
+		}
+		
+		MOAIBox2DRayHit& hit = hits [ i ];
+		hit.mFixture	= fixture;
+		hit.mPoint		= point;
+		hit.mNormal		= normal;
+		hit.mFraction	= fraction;
+		
+		return 1.0f;
+	}
+};
+
+//================================================================//
+// MOAIBox2DQueryCallback
+//================================================================//
+// collects the fixtures whose bounds overlap the query box; if a shape
+// is given, only fixtures that actually touch the shape are kept
+class MOAIBox2DQueryCallback :
+	public b2QueryCallback {
+private:
+
+	friend class MOAIBox2DWorld;
+
+	u32								mMask;
+	const b2Shape*					mShape;
+	b2Transform						mTransform;
+	ZLLeanStack < b2Fixture*, 32 >	mFixtures;
+
+public:
+
+	//----------------------------------------------------------------//
+	MOAIBox2DQueryCallback ( u32 mask, const b2Shape* shape = 0 ) :
+		mMask ( mask ),
+		mShape ( shape ) {
+		
+		this->mTransform.SetIdentity ();
+	}
+
+	//----------------------------------------------------------------//
+	bool ReportFixture ( b2Fixture* fixture ) {
+	
+		if ( !( fixture->GetFilterData ().categoryBits & this->mMask )) return true;
+		if ( !fixture->GetUserData ()) return true;
+		
+		const b2Shape* shape = fixture->GetShape ();
+		int32 childCount = shape->GetChildCount ();
+		
+		if ( this->mShape ) {
+		
+			const b2Transform& transform = fixture->GetBody ()->GetTransform ();
+		
+			bool overlap = false;
+			for ( int32 i = 0; ( i < childCount ) && !overlap; ++i ) {
+				overlap = b2TestOverlap ( this->mShape, 0, shape, i, this->mTransform, transform );
+			}
+			if ( !overlap ) return true;
+		}
+		
+		// chains have a proxy per edge, so they may be reported more than once
+		if ( childCount > 1 ) {
+			for ( u32 i = 0; i < this->mFixtures.GetTop (); ++i ) {
+				if ( this->mFixtures [ i ] == fixture ) return true;
+			}
+		}
+		
+		this->mFixtures.Push ( fixture );
+		return true;
+	}
+};
+
 //================================================================//
 // MOAIBox2DPrim
 //================================================================//
@@ -781,6 +902,24 @@ int MOAIBox2DWorld::_getGravity ( lua_State* L ) {
 	return 2;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	getInterpolation
+	@text	Returns the state of the fixed step clock after the last
+			update: how far the rendered transforms are between the last
+			two physics steps ( 0 to 1 ) and how many fixed steps ran.
+	
+	@in		MOAIBox2DWorld self
+	@out	number alpha
+	@out	number substeps
+*/
+int MOAIBox2DWorld::_getInterpolation ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIBox2DWorld, "U" )
+	
+	state.Push ( self->mStepAlpha );
+	state.Push ( self->mSubsteps );
+	return 2;
+}
+
 //----------------------------------------------------------------//
 /**	@lua	getLinearSleepTolerance
 	@text	See Box2D documentation.
@@ -808,6 +947,9 @@ int MOAIBox2DWorld::_getLinearSleepTolerance ( lua_State* L ) {
 	@out	number	solvePosition
 	@out	number	broadphase
 	@out	number	solveTOI
+	@out	number	solveParallel	Wall time of the island solve when it runs on worker threads.
+	@out	number	solveReport		Time spent replaying post solve callbacks after a parallel solve.
+	@out	number	islands			Islands solved in the last step.
 */
 int MOAIBox2DWorld::_getPerformance ( lua_State* L ) {
 	MOAI_LUA_SETUP ( MOAIBox2DWorld, "U" )
@@ -822,8 +964,11 @@ int MOAIBox2DWorld::_getPerformance ( lua_State* L ) {
 	state.Push ( p.solvePosition );
 	state.Push ( p.broadphase );
 	state.Push ( p.solveTOI );
+	state.Push ( p.solveParallel );
+	state.Push ( p.solveReport );
+	state.Push ( p.islandCount );
 
-	return 8;
+	return 11;
 }
 
 //----------------------------------------------------------------//
@@ -891,6 +1036,253 @@ int MOAIBox2DWorld::_getTimeToSleep ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	getWorkerCount
+	@text	Returns the number of worker threads solving islands.
+	
+	@in		MOAIBox2DWorld self
+	@out	number count
+*/
+int MOAIBox2DWorld::_getWorkerCount ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIBox2DWorld, "U" )
+	
+	state.Push ( self->mWorkers.GetWorkerCount ());
+	return 1;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	queryAABB
+	@text	Returns every fixture whose bounds overlap the given rect,
+			found through the world's broadphase.
+	
+	@in		MOAIBox2DWorld self
+	@in		number xMin				in units, world coordinates, converted to meters
+	@in		number yMin				in units, world coordinates, converted to meters
+	@in		number xMax				in units, world coordinates, converted to meters
+	@in		number yMax				in units, world coordinates, converted to meters
+	@opt	number mask				Only fixtures with a filter category in the mask are returned. Default value is 0xffff.
+	@out	... fixtures
+*/
+int MOAIBox2DWorld::_queryAABB ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIBox2DWorld, "UNNNN" )
+	
+	float unitsToMeters = self->mUnitsToMeters;
+	
+	b2AABB aabb;
+	aabb.lowerBound.x = state.GetValue < float >( 2, 0.0f ) * unitsToMeters;
+	aabb.lowerBound.y = state.GetValue < float >( 3, 0.0f ) * unitsToMeters;
+	aabb.upperBound.x = state.GetValue < float >( 4, 0.0f ) * unitsToMeters;
+	aabb.upperBound.y = state.GetValue < float >( 5, 0.0f ) * unitsToMeters;
+	
+	MOAIBox2DQueryCallback callback ( state.GetValue < u32 >( 6, 0xffff ));
+	self->mWorld->QueryAABB ( &callback, aabb );
+	
+	return MOAIBox2DWorld::PushFixtures ( state, callback.mFixtures, callback.mFixtures.GetTop ());
+}
+
+//----------------------------------------------------------------//
+/**	@lua	queryShape
+	@text	Returns every fixture that overlaps the given circle or
+			polygon. Candidates come from the world's broadphase and are
+			then tested against the shape.
+	
+	@overload	Query with a circle.
+	
+		@in		MOAIBox2DWorld self
+		@in		number x				in units, world coordinates, converted to meters
+		@in		number y				in units, world coordinates, converted to meters
+		@in		number radius			in units, converted to meters
+		@opt	number mask				Only fixtures with a filter category in the mask are returned. Default value is 0xffff.
+		@out	... fixtures
+	
+	@overload	Query with a convex polygon.
+	
+		@in		MOAIBox2DWorld self
+		@in		table verts				Array containing vertex coordinate components ( t[1] = x0, t[2] = y0, t[3] = x1, t[4] = y1... ) in units, world coordinates, converted to meters.
+		@opt	number mask				Only fixtures with a filter category in the mask are returned. Default value is 0xffff.
+		@out	... fixtures
+*/
+int MOAIBox2DWorld::_queryShape ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIBox2DWorld, "U" )
+	
+	float unitsToMeters = self->mUnitsToMeters;
+	
+	b2CircleShape circleShape;
+	b2PolygonShape polyShape;
+	b2Shape* shape = 0;
+	u32 mask = 0xffff;
+	
+	if ( state.IsType ( 2, LUA_TTABLE )) {
+	
+		b2Vec2 verts [ b2_maxPolygonVertices ];
+		int numVerts = MOAIBox2DFixture::LoadVerts ( state, 2, verts, b2_maxPolygonVertices, unitsToMeters );
+		
+		if (( numVerts < 3 ) || ( numVerts > b2_maxPolygonVertices )) {
+			MOAILogF ( state, ZLLog::LOG_ERROR, MOAISTRING_MOAIBox2DBody_InvalidVertexCount_D, numVerts );
+			return 0;
+		}
+		
+		polyShape.Set ( verts, numVerts );
+		shape = &polyShape;
+		mask = state.GetValue < u32 >( 3, mask );
+	}
+	else if ( state.CheckParams ( 2, "NNN" )) {
+	
+		circleShape.m_p.x = state.GetValue < float >( 2, 0.0f ) * unitsToMeters;
+		circleShape.m_p.y = state.GetValue < float >( 3, 0.0f ) * unitsToMeters;
+		circleShape.m_radius = state.GetValue < float >( 4, 0.0f ) * unitsToMeters;
+		shape = &circleShape;
+		mask = state.GetValue < u32 >( 5, mask );
+	}
+	
+	if ( !shape ) return 0;
+	
+	b2Transform identity;
+	identity.SetIdentity ();
+	
+	b2AABB aabb;
+	shape->ComputeAABB ( &aabb, identity, 0 );
+	
+	MOAIBox2DQueryCallback callback ( mask, shape );
+	self->mWorld->QueryAABB ( &callback, aabb );
+	
+	return MOAIBox2DWorld::PushFixtures ( state, callback.mFixtures, callback.mFixtures.GetTop ());
+}
+
+//----------------------------------------------------------------//
+/**	@lua	rayCastAll
+	@text	Casts a ray and returns every fixture it passes through,
+			nearest first, with the point and normal of each hit.
+	
+	@in		MOAIBox2DWorld self
+	@in		number p1x				in units, world coordinates, converted to meters
+	@in		number p1y				in units, world coordinates, converted to meters
+	@in		number p2x				in units, world coordinates, converted to meters
+	@in		number p2y				in units, world coordinates, converted to meters
+	@opt	number mask				Only fixtures with a filter category in the mask are hit. Default value is 0xffff.
+	@out	... hits				Five values per hit: fixture, x, y, normalX, normalY.
+*/
+int MOAIBox2DWorld::_rayCastAll ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIBox2DWorld, "UNNNN" )
+	
+	float unitsToMeters = self->mUnitsToMeters;
+	
+	b2Vec2 p1 ( state.GetValue < float >( 2, 0.0f ) * unitsToMeters, state.GetValue < float >( 3, 0.0f ) * unitsToMeters );
+	b2Vec2 p2 ( state.GetValue < float >( 4, 0.0f ) * unitsToMeters, state.GetValue < float >( 5, 0.0f ) * unitsToMeters );
+	
+	if (( p2 - p1 ).LengthSquared () <= 0.0f ) return 0;
+	
+	MOAIBox2DRayCastAllCallback callback ( state.GetValue < u32 >( 6, 0xffff ));
+	self->mWorld->RayCast ( &callback, p1, p2 );
+	
+	u32 totalHits = ( u32 )callback.mHits.GetTop ();
+	if ( !lua_checkstack ( state, ( int )totalHits * 5 )) return 0;
+	
+	float metersToUnits = 1.0f / unitsToMeters;
+	
+	for ( u32 i = 0; i < totalHits; ++i ) {
+	
+		const MOAIBox2DRayHit& hit = callback.mHits [ i ];
+		
+		(( MOAIBox2DFixture* )hit.mFixture->GetUserData ())->PushLuaUserdata ( state );
+		state.Push ( hit.mPoint.x * metersToUnits );
+		state.Push ( hit.mPoint.y * metersToUnits );
+		state.Push ( hit.mNormal.x );
+		state.Push ( hit.mNormal.y );
+	}
+	return ( int )totalHits * 5;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	rayCastBatch
+	@text	Casts a batch of rays, reporting the closest hit of each.
+			Rays are read from the stream as four floats each ( p1x, p1y,
+			p2x, p2y ) in units, starting at the stream's cursor. For each
+			ray, five floats are written to the result stream: the hit
+			fraction along the ray ( -1 for a miss ), the hit point x and y
+			in units and the hit normal x and y. If a table is given, the
+			fixture hit by ray i (or false) is stored at index i; reusing
+			the same table avoids allocating per call.
+	
+	@in		MOAIBox2DWorld self
+	@in		MOAIStream rays
+	@in		MOAIStream results
+	@opt	table fixtures
+	@opt	number mask				Only fixtures with a filter category in the mask are hit. Default value is 0xffff.
+	@opt	number nRays			Default value is as many as the stream holds.
+	@out	number nHits
+*/
+int MOAIBox2DWorld::_rayCastBatch ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIBox2DWorld, "UUU" )
+	
+	MOAIStream* rays = state.GetLuaObject < MOAIStream >( 2, true );
+	MOAIStream* results = state.GetLuaObject < MOAIStream >( 3, true );
+	if ( !( rays && results )) return 0;
+	
+	bool hasFixtures = state.IsType ( 4, LUA_TTABLE );
+	u32 mask = state.GetValue < u32 >( 5, 0xffff );
+	u32 maxRays = state.GetValue < u32 >( 6, 0xffffffff );
+	
+	float unitsToMeters = self->mUnitsToMeters;
+	float metersToUnits = 1.0f / unitsToMeters;
+	
+	u32 totalHits = 0;
+	
+	for ( u32 i = 0; i < maxRays; ++i ) {
+	
+		float ray [ 4 ];
+		if ( rays->ReadBytes ( ray, sizeof ( ray )).mValue != sizeof ( ray )) break;
+		
+		b2Vec2 p1 ( ray [ 0 ] * unitsToMeters, ray [ 1 ] * unitsToMeters );
+		b2Vec2 p2 ( ray [ 2 ] * unitsToMeters, ray [ 3 ] * unitsToMeters );
+		
+		MOAIBox2DRayCastCallback callback ( mask );
+		
+		if (( p2 - p1 ).LengthSquared () > 0.0f ) {
+			self->mWorld->RayCast ( &callback, p1, p2 );
+		}
+		
+		float result [ 5 ];
+		
+		if ( callback.m_fixture ) {
+		
+			result [ 0 ] = callback.m_fraction;
+			result [ 1 ] = callback.m_point.x * metersToUnits;
+			result [ 2 ] = callback.m_point.y * metersToUnits;
+			result [ 3 ] = callback.m_normal.x;
+			result [ 4 ] = callback.m_normal.y;
+			
+			totalHits++;
+		}
+		else {
+		
+			result [ 0 ] = -1.0f;
+			result [ 1 ] = 0.0f;
+			result [ 2 ] = 0.0f;
+			result [ 3 ] = 0.0f;
+			result [ 4 ] = 0.0f;
+		}
+		
+		results->WriteBytes ( result, sizeof ( result ));
+		
+		if ( hasFixtures ) {
+		
+			MOAIBox2DFixture* moaiFixture = callback.m_fixture ? ( MOAIBox2DFixture* )callback.m_fixture->GetUserData () : 0;
+		
+			if ( moaiFixture ) {
+				moaiFixture->PushLuaUserdata ( state );
+			}
+			else {
+				lua_pushboolean ( state, false );
+			}
+			lua_rawseti ( state, 4, ( int )i + 1 );
+		}
+	}
+	
+	state.Push ( totalHits );
+	return 1;
+}
+
 //----------------------------------------------------------------//
 /**	@lua	setAngularSleepTolerance
 	@text	See Box2D documentation.
@@ -926,6 +1318,26 @@ int MOAIBox2DWorld::_setAutoClearForces ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	setBulkSync
+	@text	When enabled (the default), the transforms of all bodies that
+			moved during a step are written in a single pass after the
+			step, and only nodes that depend on those bodies are scheduled
+			for update. Bodies with attribute links of their own are still
+			updated through the node graph. When disabled, every moved
+			body is scheduled for a regular node update.
+	
+	@in		MOAIBox2DWorld self
+	@opt	boolean bulkSync			Default value is true.
+	@out	nil
+*/
+int MOAIBox2DWorld::_setBulkSync ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIBox2DWorld, "U" )
+	
+	self->mBulkSync = state.GetValue < bool >( 2, true );
+	return 0;
+}
+
 //----------------------------------------------------------------//
 /**	@lua	setDebugDrawEnabled
 	@text	enable/disable debug drawing.
@@ -976,6 +1388,35 @@ int MOAIBox2DWorld::_setDebugDrawFlags ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	setFixedStep
+	@text	Runs the simulation on its own fixed step clock. Time handed
+			to the world by the action tree is accumulated and consumed
+			in whole steps, at most maxSubsteps per update; time beyond
+			that is dropped. Bodies are then drawn between (or past) the
+			last two physics states by the leftover time. Contact
+			callbacks fire once per fixed step. A step of 0 restores
+			variable stepping.
+	
+	@in		MOAIBox2DWorld self
+	@opt	number step				in seconds. Default value is 0.
+	@opt	number maxSubsteps		Default value is 8.
+	@opt	number interpolation	One of MOAIBox2DWorld.INTERPOLATION_NONE, MOAIBox2DWorld.INTERPOLATION_LINEAR, MOAIBox2DWorld.INTERPOLATION_EXTRAPOLATE. Default value is INTERPOLATION_LINEAR.
+	@out	nil
+*/
+int MOAIBox2DWorld::_setFixedStep ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIBox2DWorld, "U" )
+	
+	self->mFixedStep		= state.GetValue < float >( 2, 0.0f );
+	self->mMaxSubsteps		= state.GetValue < u32 >( 3, DEFAULT_MAX_SUBSTEPS );
+	self->mInterpolation	= state.GetValue < u32 >( 4, INTERPOLATION_LINEAR );
+	
+	self->mStepAccumulator	= 0.0;
+	self->mStepAlpha		= 0.0f;
+	
+	return 0;
+}
+
 //----------------------------------------------------------------//
 /**	@lua	setGravity
 	@text	See Box2D documentation.
@@ -1062,6 +1503,38 @@ int MOAIBox2DWorld::_setUnitsToMeters ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	setWorkerCount
+	@text	Solves independent islands in parallel on the given number of
+			worker threads (plus the thread updating the world). Contacts
+			and joints are still prepared on the updating thread, and
+			post solve arbiter callbacks are held until every island is
+			solved, then delivered there in the same order as the serial
+			solver. Results match the serial solver. Zero workers (the
+			default) solves serially.
+	
+	@in		MOAIBox2DWorld self
+	@opt	number count			Default value is 0.
+	@out	nil
+*/
+int MOAIBox2DWorld::_setWorkerCount ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIBox2DWorld, "U" )
+	
+	u32 count = state.GetValue < u32 >( 2, 0 );
+	
+	self->mWorkers.SetWorkerCount ( count );
+	self->mWorld->SetTaskExecutor ( count ? self : 0 );
+	
+	return 0;
+}
+
+//----------------------------------------------------------------//
+void MOAIBox2DWorld::_runTask ( void* param, u32 idx ) {
+
+	MOAIBox2DWorld* self = ( MOAIBox2DWorld* )param;
+	self->mTask ( self->mTaskContext, ( int32 )idx );
+}
+
 //================================================================//
 // MOAIBox2DWorld
 //================================================================//
@@ -1115,9 +1588,18 @@ MOAIBox2DWorld::MOAIBox2DWorld () :
 	mVelocityIterations ( 10 ),
 	mPositionIterations ( 10 ),
 	mUnitsToMeters ( 1.0f ),
+	mFixedStep ( 0.0f ),
+	mMaxSubsteps ( DEFAULT_MAX_SUBSTEPS ),
+	mInterpolation ( INTERPOLATION_LINEAR ),
+	mStepAccumulator ( 0.0 ),
+	mStepAlpha ( 0.0f ),
+	mSubsteps ( 0 ),
 	mDestroyBodies ( 0 ),
 	mDestroyFixtures ( 0 ),
-	mDestroyJoints ( 0 ) {
+	mDestroyJoints ( 0 ),
+	mBulkSync ( true ),
+	mTask ( 0 ),
+	mTaskContext ( 0 ) {
 	
 	RTTI_BEGIN
 		RTTI_EXTEND ( MOAIAction )
@@ -1141,6 +1623,8 @@ MOAIBox2DWorld::MOAIBox2DWorld () :
 MOAIBox2DWorld::~MOAIBox2DWorld () {
 
 	this->mWorld->SetContactListener ( 0 );
+	this->mWorld->SetTaskExecutor ( 0 );
+	this->mWorkers.Stop ();
 
 	while ( b2Body* body = this->mWorld->GetBodyList ()) {
 		MOAIBox2DBody* moaiBody = ( MOAIBox2DBody* )body->GetUserData ();
@@ -1154,6 +1638,61 @@ MOAIBox2DWorld::~MOAIBox2DWorld () {
 	delete ( this->mWorld );
 }
 
+//----------------------------------------------------------------//
+// render transform of a body in meters
+void MOAIBox2DWorld::GetRenderTransform ( MOAIBox2DBody& body, float& x, float& y, float& c, float& s ) {
+
+	const b2Body& b2body = *body.mBody;
+	const b2Transform& transform = b2body.GetTransform ();
+	
+	u32 interpolation = this->mFixedStep > 0.0f ? this->mInterpolation : ( u32 )INTERPOLATION_NONE;
+	
+	switch ( interpolation ) {
+	
+		case INTERPOLATION_LINEAR: {
+		
+			float t = this->mStepAlpha;
+			float angle = body.mPrevAngle + (( b2body.GetAngle () - body.mPrevAngle ) * t );
+			
+			x = body.mPrevPosition.x + (( transform.p.x - body.mPrevPosition.x ) * t );
+			y = body.mPrevPosition.y + (( transform.p.y - body.mPrevPosition.y ) * t );
+			c = Cos ( angle );
+			s = Sin ( angle );
+			break;
+		}
+		case INTERPOLATION_EXTRAPOLATE: {
+		
+			float t = this->mStepAlpha * this->mFixedStep;
+			float angle = b2body.GetAngle () + ( b2body.GetAngularVelocity () * t );
+			const b2Vec2& velocity = b2body.GetLinearVelocity ();
+			
+			x = transform.p.x + ( velocity.x * t );
+			y = transform.p.y + ( velocity.y * t );
+			c = Cos ( angle );
+			s = Sin ( angle );
+			break;
+		}
+		default:
+		
+			x = transform.p.x;
+			y = transform.p.y;
+			c = transform.q.c;
+			s = transform.q.s;
+			break;
+	}
+}
+
+//----------------------------------------------------------------//
+int MOAIBox2DWorld::PushFixtures ( MOAILuaState& state, b2Fixture** fixtures, size_t total ) {
+
+	if ( !lua_checkstack ( state, ( int )total )) return 0;
+
+	for ( size_t i = 0; i < total; ++i ) {
+		(( MOAIBox2DFixture* )fixtures [ i ]->GetUserData ())->PushLuaUserdata ( state );
+	}
+	return ( int )total;
+}
+
 //----------------------------------------------------------------//
 void MOAIBox2DWorld::RegisterLuaClass ( MOAILuaState& state ) {
 
@@ -1166,6 +1705,10 @@ void MOAIBox2DWorld::RegisterLuaClass ( MOAILuaState& state ) {
 	state.SetField ( -1, "DEBUG_DRAW_CENTERS", ( u32 )DEBUG_DRAW_CENTERS );
 	
 	state.SetField ( -1, "DEBUG_DRAW_DEFAULT", ( u32 )DEBUG_DRAW_DEFAULT );
+	
+	state.SetField ( -1, "INTERPOLATION_NONE",			( u32 )INTERPOLATION_NONE );
+	state.SetField ( -1, "INTERPOLATION_LINEAR",		( u32 )INTERPOLATION_LINEAR );
+	state.SetField ( -1, "INTERPOLATION_EXTRAPOLATE",	( u32 )INTERPOLATION_EXTRAPOLATE );
 }
 
 //----------------------------------------------------------------//
@@ -1190,24 +1733,41 @@ void MOAIBox2DWorld::RegisterLuaFuncs ( MOAILuaState& state ) {
 		{ "getAngularSleepTolerance",	_getAngularSleepTolerance },
 		{ "getAutoClearForces",			_getAutoClearForces },
 		{ "getGravity",					_getGravity },
+		{ "getInterpolation",			_getInterpolation },
 		{ "getLinearSleepTolerance",	_getLinearSleepTolerance },
 		{ "getRayCast",					_getRayCast },
 		{ "getTimeToSleep",				_getTimeToSleep },
+		{ "getWorkerCount",				_getWorkerCount },
+		{ "queryAABB",					_queryAABB },
+		{ "queryShape",					_queryShape },
+		{ "rayCastAll",					_rayCastAll },
+		{ "rayCastBatch",				_rayCastBatch },
 		{ "setAngularSleepTolerance",	_setAngularSleepTolerance },
 		{ "setAutoClearForces",			_setAutoClearForces },
+		{ "setBulkSync",				_setBulkSync },
 		{ "setDebugDrawEnabled",		_setDebugDrawEnabled },
 		{ "setDebugDrawFlags",			_setDebugDrawFlags },
+		{ "setFixedStep",				_setFixedStep },
 		{ "setGravity",					_setGravity },
 		{ "setIterations",				_setIterations },
 		{ "setLinearSleepTolerance",	_setLinearSleepTolerance },
 		{ "setTimeToSleep",				_setTimeToSleep },
 		{ "setUnitsToMeters",			_setUnitsToMeters },
+		{ "setWorkerCount",				_setWorkerCount },
 		{ NULL, NULL }
 	};
 	
 	luaL_register ( state, 0, regTable );
 }
 
+//----------------------------------------------------------------//
+void MOAIBox2DWorld::Run ( b2Task task, void* context, int32 count ) {
+
+	this->mTask = task;
+	this->mTaskContext = context;
+	this->mWorkers.Run ( _runTask, this, ( u32 )count );
+}
+
 //----------------------------------------------------------------//
 void MOAIBox2DWorld::SayGoodbye ( b2Fixture* fixture ) {
 
@@ -1261,32 +1821,147 @@ void MOAIBox2DWorld::ScheduleDestruction ( MOAIBox2DJoint& joint ) {
 	this->Destroy ();
 }
 
-//================================================================//
-// ::implementation::
-//================================================================//
+//----------------------------------------------------------------//
+void MOAIBox2DWorld::Step ( float step ) {
+
+	this->mLock = true;
+	this->mWorld->Step (( float32 )step, this->mVelocityIterations, this->mPositionIterations );
+	this->mLock = false;
+	
+	this->Destroy ();
+}
 
 //----------------------------------------------------------------//
-bool MOAIBox2DWorld::MOAIAction_IsDone () {
+void MOAIBox2DWorld::StepFixed ( double step ) {
 
-	return false;
+	double fixedStep = this->mFixedStep;
+	
+	this->mStepAccumulator += step;
+	u32 substeps = ( u32 )( this->mStepAccumulator / fixedStep );
+	
+	// if we've fallen too far behind, drop the time we can't make up
+	if ( substeps > this->mMaxSubsteps ) {
+		substeps = this->mMaxSubsteps;
+		this->mStepAccumulator = substeps * fixedStep;
+	}
+	this->mStepAccumulator -= substeps * fixedStep;
+	
+	if ( substeps ) {
+	
+		// forces applied between updates should act on every substep, so hold
+		// off on clearing them until the last one
+		bool autoClearForces = this->mWorld->GetAutoClearForces ();
+		this->mWorld->SetAutoClearForces ( false );
+		
+		for ( u32 i = 0; i < substeps; ++i ) {
+		
+			// only the last two states are needed to interpolate
+			if (( i == ( substeps - 1 )) && ( this->mInterpolation == INTERPOLATION_LINEAR )) {
+				b2Body* body = this->mWorld->GetBodyList ();
+				for ( ; body; body = body->GetNext ()) {
+					(( MOAIBox2DBody* )body->GetUserData ())->ResetInterpolation ();
+				}
+			}
+			this->Step (( float )fixedStep );
+		}
+		
+		if ( autoClearForces ) {
+			this->mWorld->ClearForces ();
+			this->mWorld->SetAutoClearForces ( true );
+		}
+	}
+	
+	this->mSubsteps = substeps;
+	this->mStepAlpha = ( float )( this->mStepAccumulator / fixedStep );
 }
 
 //----------------------------------------------------------------//
-void MOAIBox2DWorld::MOAIAction_Update ( double step ) {
+void MOAIBox2DWorld::SyncBodies () {
+
+	u32 bodyCount = ( u32 )this->mWorld->GetBodyCount ();
+	if ( !bodyCount ) return;
+
+	if ( !this->mBulkSync ) {
 	
-	this->mLock = true;
-	this->mWorld->Step (( float32 )step, this->mVelocityIterations, this->mPositionIterations );
-	this->mLock = false;
+		b2Body* body = this->mWorld->GetBodyList ();
+		for ( ; body; body = body->GetNext ()) {
+			if ( body->IsActive () && body->IsAwake ()) {
+				MOAIBox2DBody* moaiBody = ( MOAIBox2DBody* )body->GetUserData ();
+				moaiBody->ScheduleUpdate ();
+			}
+		}
+		return;
+	}
 	
-	this->Destroy ();
+	this->mSyncBodies.GrowChunked ( bodyCount, 256 );
+	this->mSyncX.GrowChunked ( bodyCount, 256 );
+	this->mSyncY.GrowChunked ( bodyCount, 256 );
+	this->mSyncC.GrowChunked ( bodyCount, 256 );
+	this->mSyncS.GrowChunked ( bodyCount, 256 );
 	
+	MOAIBox2DBody** bodies = this->mSyncBodies;
+	float* x = this->mSyncX;
+	float* y = this->mSyncY;
+	float* c = this->mSyncC;
+	float* s = this->mSyncS;
+	
+	// gather
+	u32 total = 0;
 	b2Body* body = this->mWorld->GetBodyList ();
 	for ( ; body; body = body->GetNext ()) {
-		if ( body->IsActive () && body->IsAwake ()) {
-			MOAIBox2DBody* moaiBody = ( MOAIBox2DBody* )body->GetUserData ();
+	
+		if ( !( body->IsActive () && body->IsAwake ())) continue;
+		
+		MOAIBox2DBody* moaiBody = ( MOAIBox2DBody* )body->GetUserData ();
+		
+		// linked attributes have to be pulled, and update listeners fired, by a regular update
+		if ( moaiBody->HasPullLinks () || moaiBody->HasUpdateListeners ()) {
 			moaiBody->ScheduleUpdate ();
+			continue;
 		}
+		
+		bodies [ total ] = moaiBody;
+		this->GetRenderTransform ( *moaiBody, x [ total ], y [ total ], c [ total ], s [ total ]);
+		++total;
+	}
+	
+	// meters to world units
+	float scale = 1.0f / this->mUnitsToMeters;
+	for ( u32 i = 0; i < total; ++i ) {
+		x [ i ] *= scale;
+		y [ i ] *= scale;
+	}
+	
+	// scatter
+	for ( u32 i = 0; i < total; ++i ) {
+		MOAIBox2DBody& moaiBody = *bodies [ i ];
+		moaiBody.SyncTransform ( x [ i ], y [ i ], c [ i ], s [ i ]);
+		moaiBody.ScheduleDependents ();
+	}
+}
+
+//================================================================//
+// ::implementation::
+//================================================================//
+
+//----------------------------------------------------------------//
+bool MOAIBox2DWorld::MOAIAction_IsDone () {
+
+	return false;
+}
+
+//----------------------------------------------------------------//
+void MOAIBox2DWorld::MOAIAction_Update ( double step ) {
+	
+	if ( this->mFixedStep > 0.0f ) {
+		this->StepFixed ( step );
+	}
+	else {
+		this->Step (( float )step );
+		this->mSubsteps = 1;
+		this->mStepAlpha = 1.0f;
 	}
+	this->SyncBodies ();
 }
 
 //----------------------------------------------------------------//
@@ -58,11 +58,15 @@ public:
 	@const DEBUG_DRAW_PAIRS
 	@const DEBUG_DRAW_CENTERS
 	@const DEBUG_DRAW_DEFAULT
+	@const INTERPOLATION_NONE
+	@const INTERPOLATION_LINEAR
+	@const INTERPOLATION_EXTRAPOLATE
 */
 class MOAIBox2DWorld :
 	public MOAIAction,
 	public MOAIDrawable,
-	public b2DestructionListener {
+	public b2DestructionListener,
+	public b2TaskExecutor {
 private:
 
 	bool						mLock;
@@ -76,10 +80,32 @@ private:
 	u32		mPositionIterations;
 	
 	float	mUnitsToMeters; // maps world space units to meters
+	
+	// fixed step clock; disabled while mFixedStep is zero
+	float	mFixedStep;
+	u32		mMaxSubsteps;
+	u32		mInterpolation;
+	double	mStepAccumulator;
+	float	mStepAlpha;
+	u32		mSubsteps;
 
 	MOAIBox2DPrim*		mDestroyBodies;
 	MOAIBox2DPrim*		mDestroyFixtures;
 	MOAIBox2DPrim*		mDestroyJoints;
+	
+	// scratch for the bulk body sync; positions and rotations of moved bodies,
+	// gathered so unit conversion runs over contiguous arrays
+	bool							mBulkSync;
+	ZLLeanArray < MOAIBox2DBody* >	mSyncBodies;
+	ZLLeanArray < float >			mSyncX;
+	ZLLeanArray < float >			mSyncY;
+	ZLLeanArray < float >			mSyncC;
+	ZLLeanArray < float >			mSyncS;
+	
+	// islands are solved on the pool when it has workers
+	MOAIWorkerPool					mWorkers;
+	b2TaskExecutor::b2Task			mTask;
+	void*							mTaskContext;
 
 	//----------------------------------------------------------------//
 	static int		_addBody					( lua_State* L );
@@ -98,27 +124,45 @@ private:
 	static int		_getAngularSleepTolerance	( lua_State* L );
 	static int		_getAutoClearForces			( lua_State* L );
 	static int		_getGravity					( lua_State* L );
+	static int		_getInterpolation			( lua_State* L );
 	static int		_getLinearSleepTolerance	( lua_State* L );
 	static int		_getPerformance				( lua_State* L );
 	static int		_getRayCast					( lua_State* L );
 	static int		_getTimeToSleep				( lua_State* L );
+	static int		_getWorkerCount				( lua_State* L );
+	static int		_queryAABB					( lua_State* L );
+	static int		_queryShape					( lua_State* L );
+	static int		_rayCastAll					( lua_State* L );
+	static int		_rayCastBatch				( lua_State* L );
 	static int		_setAngularSleepTolerance	( lua_State* L );
 	static int		_setAutoClearForces			( lua_State* L );
+	static int		_setBulkSync				( lua_State* L );
 	static int		_setDebugDrawEnabled		( lua_State* L );
 	static int		_setDebugDrawFlags			( lua_State* L );
+	static int		_setFixedStep				( lua_State* L );
 	static int		_setGravity					( lua_State* L );
 	static int		_setIterations				( lua_State* L );
 	static int		_setLinearSleepTolerance	( lua_State* L );
 	static int		_setTimeToSleep				( lua_State* L );
 	static int		_setUnitsToMeters			( lua_State* L );
+	static int		_setWorkerCount				( lua_State* L );
+	
+	//----------------------------------------------------------------//
+	static void		_runTask				( void* param, u32 idx );
 	
 	//----------------------------------------------------------------//
 	void			Destroy					();
+	void			GetRenderTransform		( MOAIBox2DBody& body, float& x, float& y, float& c, float& s );
+	static int		PushFixtures			( MOAILuaState& state, b2Fixture** fixtures, size_t total );
+	void			Run						( b2Task task, void* context, int32 count );
 	void			SayGoodbye				( b2Fixture* fixture ); 
 	void			SayGoodbye				( b2Joint* joint );
 	void			ScheduleDestruction		( MOAIBox2DBody& body );
 	void			ScheduleDestruction		( MOAIBox2DFixture& fixture );
 	void			ScheduleDestruction		( MOAIBox2DJoint& joint );
+	void			Step					( float step );
+	void			StepFixed				( double step );
+	void			SyncBodies				();
 
 	//----------------------------------------------------------------//
 	bool			MOAIAction_IsDone		();
@@ -145,6 +189,14 @@ public:
 	
 	static const u32 DEBUG_DRAW_DEFAULT = DEBUG_DRAW_SHAPES | DEBUG_DRAW_JOINTS | DEBUG_DRAW_CENTERS;
 	
+	enum {
+		INTERPOLATION_NONE,
+		INTERPOLATION_LINEAR,
+		INTERPOLATION_EXTRAPOLATE,
+	};
+	
+	static const u32 DEFAULT_MAX_SUBSTEPS	= 8;
+	
 	//----------------------------------------------------------------//
 	bool			IsLocked				();
 					MOAIBox2DWorld			();
@@ -106,6 +106,16 @@ void MOAIInstanceEventSource::AffirmListenerTable ( MOAILuaState& state ) {
 	}
 }
 
+//----------------------------------------------------------------//
+bool MOAIInstanceEventSource::HasListener ( u32 eventID ) {
+
+	// most objects never get a listener table; skip Lua entirely for those
+	if ( !( this->mListenerTable && MOAILuaRuntime::IsValid ())) return false;
+	
+	MOAIScopedLuaState state = MOAILuaRuntime::Get ().State ();
+	return this->PushListener ( eventID, state );
+}
+
 //----------------------------------------------------------------//
 void MOAIInstanceEventSource::InvokeListener ( u32 eventID ) {
 
@@ -57,6 +57,7 @@ protected:
 public:
 
 	//----------------------------------------------------------------//
+	bool			HasListener					( u32 eventID );
 	void			InvokeListener				( u32 eventID );
 	void			InvokeListenerWithSelf		( u32 eventID );
 					MOAIInstanceEventSource		();
@@ -574,6 +574,16 @@ void MOAILuaObject::SerializeOut ( MOAILuaState& state, MOAISerializer& serializ
 	UNUSED ( serializer );
 }
 
+//----------------------------------------------------------------//
+void MOAILuaObject::SnapshotIn ( ZLStream& stream ) {
+	UNUSED ( stream );
+}
+
+//----------------------------------------------------------------//
+void MOAILuaObject::SnapshotOut ( ZLStream& stream ) {
+	UNUSED ( stream );
+}
+
 //----------------------------------------------------------------//
 void MOAILuaObject::SetInterfaceTable ( MOAILuaState& state, int idx ) {
 
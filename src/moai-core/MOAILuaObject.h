@@ -85,6 +85,8 @@ public:
 	virtual void			RegisterLuaFuncs			( MOAILuaState& state );
 	virtual	void			SerializeIn					( MOAILuaState& state, MOAIDeserializer& serializer );
 	virtual	void			SerializeOut				( MOAILuaState& state, MOAISerializer& serializer );
+	virtual void			SnapshotIn					( ZLStream& stream );
+	virtual void			SnapshotOut					( ZLStream& stream );
 	
 	//----------------------------------------------------------------//
 	template < typename TYPE, lua_CFunction FUNC >
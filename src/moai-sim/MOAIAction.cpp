@@ -630,6 +630,23 @@ void MOAIAction::Update ( MOAIActionTree& tree, double step ) {
 	MOAIActionStackMgr::Get ().Pop ();
 }
 
+//----------------------------------------------------------------//
+void MOAIAction::SnapshotIn ( ZLStream& stream ) {
+
+	// tree membership is structural and isn't part of the snapshot
+	u32 flags = stream.Read < u32 >( this->mActionFlags ) & ~FLAGS_IS_UPDATING;
+
+	this->mThrottle		= stream.Read < float >( this->mThrottle );
+	this->mActionFlags	= ( this->mActionFlags & FLAGS_IS_UPDATING ) | flags;
+}
+
+//----------------------------------------------------------------//
+void MOAIAction::SnapshotOut ( ZLStream& stream ) {
+
+	stream.Write < u32 >( this->mActionFlags );
+	stream.Write < float >( this->mThrottle );
+}
+
 //----------------------------------------------------------------//
 void MOAIAction::Start ( MOAIAction* parent, bool defer ) {
 
@@ -135,6 +135,8 @@ public:
 							~MOAIAction				();
 	void					RegisterLuaClass		( MOAILuaState& state );
 	void					RegisterLuaFuncs		( MOAILuaState& state );
+	void					SnapshotIn				( ZLStream& stream );
+	void					SnapshotOut				( ZLStream& stream );
 	void					Start					( MOAIAction* parent, bool defer );
 	void					Stop					();
 };
@@ -37,6 +37,49 @@ int MOAIAnim::_apply ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	bake
+	@text	Resample every absolute (non-relative) link into a fixed rate,
+			interleaved frame buffer. Once baked, playback indexes the two
+			frames around the current time and blends all channels in a
+			single pass instead of searching and evaluating each curve.
+			Relative links are still played from their curves. Only times
+			between 0 and the animation's length are baked; outside that
+			range the curves are evaluated live so their wrap modes still
+			apply. Changes to links or curves are not seen until the
+			animation is baked again.
+	
+	@in		MOAIAnim self
+	@in		number frameRate		Frames per unit of animation time.
+	@opt	boolean quantize		Store frames as 16-bit values scaled to each channel's range. Default value is false.
+	@out	number maxError			Largest difference between a baked and a live channel, measured halfway between frames.
+*/
+int MOAIAnim::_bake ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIAnim, "UN" );
+
+	float frameRate		= state.GetValue < float >( 2, 0.0f );
+	bool quantize		= state.GetValue < bool >( 3, false );
+
+	lua_pushnumber ( state, self->Bake ( frameRate, quantize ));
+
+	return 1;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	clearBake
+	@text	Discard the baked frames and go back to evaluating curves.
+	
+	@in		MOAIAnim self
+	@out	nil
+*/
+int MOAIAnim::_clearBake ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIAnim, "U" );
+
+	self->ClearBake ();
+
+	return 0;
+}
+
 //----------------------------------------------------------------//
 /**	@lua	getLength
 	@text	Return the length of the animation.
@@ -105,6 +148,7 @@ int	MOAIAnim::_setLink ( lua_State* L ) {
 void MOAIAnim::Apply ( float t ) {
 	
 	MOAIAttribute attr;
+	bool baked = this->SampleBake ( t );
 	
 	u32 total = ( u32 )this->mLinks.Size ();
 	for ( u32 i = 0; i < total; ++i ) {
@@ -116,7 +160,7 @@ void MOAIAnim::Apply ( float t ) {
 		if ( curve && target ) {
 			
 			if ( !link.mRelative ) {
-				curve->GetValue ( attr, t );
+				this->GetLinkValue ( i, attr, t, baked );
 				target->ApplyAttrOp ( link.mAttrID, attr, MOAIAttribute::SET );
 			}
 			target->ScheduleUpdate ();
@@ -133,6 +177,7 @@ void MOAIAnim::Apply ( float t0, float t1 ) {
 	}
 	
 	MOAIAttribute attr;
+	bool baked = this->SampleBake ( t1 );
 	
 	u32 total = ( u32 )this->mLinks.Size ();
 	for ( u32 i = 0; i < total; ++i ) {
@@ -148,7 +193,7 @@ void MOAIAnim::Apply ( float t0, float t1 ) {
 				target->ApplyAttrOp ( link.mAttrID, attr, MOAIAttribute::ADD );
 			}
 			else {
-				curve->GetValue ( attr, t1 );
+				this->GetLinkValue ( i, attr, t1, baked );
 				target->ApplyAttrOp ( link.mAttrID, attr, MOAIAttribute::SET );
 			}
 			target->ScheduleUpdate ();
@@ -156,6 +201,119 @@ void MOAIAnim::Apply ( float t0, float t1 ) {
 	}
 }
 
+//----------------------------------------------------------------//
+float MOAIAnim::Bake ( float frameRate, bool quantize ) {
+
+	this->ClearBake ();
+	
+	if ( frameRate <= 0.0f ) return 0.0f;
+	
+	u32 totalLinks = ( u32 )this->mLinks.Size ();
+	this->mBakeOffsets.Init ( totalLinks );
+	
+	u32 stride = 0;
+	for ( u32 i = 0; i < totalLinks; ++i ) {
+	
+		MOAIAnimLink& link = this->mLinks [ i ];
+		MOAIAnimCurveBase* curve = link.mCurve;
+		
+		this->mBakeOffsets [ i ] = NOT_BAKED;
+		
+		if ( curve && link.mTarget && ( !link.mRelative ) && curve->Size ()) {
+			this->mBakeOffsets [ i ] = stride;
+			stride += curve->GetBakeWidth ();
+		}
+	}
+	
+	if ( !stride ) {
+		this->ClearBake ();
+		return 0.0f;
+	}
+	
+	u32 totalFrames = ( u32 )ZLFloat::Ceil ( this->mLength * frameRate ) + 1;
+	
+	this->mBakeFrames.Init ( totalFrames * stride );
+	
+	for ( u32 frame = 0; frame < totalFrames; ++frame ) {
+	
+		float time = MIN (( float )frame / frameRate, this->mLength );
+		
+		float* sample = &this->mBakeFrames [ frame * stride ];
+		float* prev = frame > 0 ? sample - stride : 0;
+		
+		for ( u32 i = 0; i < totalLinks; ++i ) {
+		
+			u32 offset = this->mBakeOffsets [ i ];
+			if ( offset == NOT_BAKED ) continue;
+			
+			this->mLinks [ i ].mCurve->BakeSample ( &sample [ offset ], prev ? &prev [ offset ] : 0, time );
+		}
+	}
+	
+	if ( quantize ) {
+	
+		this->mBakeMin.Init ( stride );
+		this->mBakeStep.Init ( stride );
+		this->mBakeQuantized.Init ( totalFrames * stride );
+		
+		for ( u32 c = 0; c < stride; ++c ) {
+		
+			float min = this->mBakeFrames [ c ];
+			float max = min;
+			
+			for ( u32 frame = 1; frame < totalFrames; ++frame ) {
+				float value = this->mBakeFrames [( frame * stride ) + c ];
+				min = MIN ( min, value );
+				max = MAX ( max, value );
+			}
+			
+			float step = ( max - min ) / 65535.0f;
+			
+			this->mBakeMin [ c ] = min;
+			this->mBakeStep [ c ] = step;
+			
+			for ( u32 frame = 0; frame < totalFrames; ++frame ) {
+				u32 idx = ( frame * stride ) + c;
+				this->mBakeQuantized [ idx ] = step > 0.0f ? ( u16 )ZLFloat::Clamp ( ZLFloat::Round (( this->mBakeFrames [ idx ] - min ) / step ), 0.0f, 65535.0f ) : 0;
+			}
+		}
+		this->mBakeFrames.Clear ();
+	}
+	
+	this->mBakeRate = frameRate;
+	this->mBakeTotalFrames = totalFrames;
+	this->mBakeStride = stride;
+	this->mBakeSample.Init ( stride );
+	
+	// measure the worst case error against the live curves between each pair of frames
+	ZLLeanArray < float > reference;
+	reference.Init ( stride );
+	
+	float maxError = 0.0f;
+	
+	for ( u32 frame = 0; ( frame + 1 ) < totalFrames; ++frame ) {
+	
+		float t0 = ( float )frame / frameRate;
+		float t1 = MIN (( float )( frame + 1 ) / frameRate, this->mLength );
+		float time = ( t0 + t1 ) * 0.5f;
+		
+		this->SampleBake ( time );
+		
+		for ( u32 i = 0; i < totalLinks; ++i ) {
+		
+			u32 offset = this->mBakeOffsets [ i ];
+			if ( offset == NOT_BAKED ) continue;
+			
+			this->mLinks [ i ].mCurve->BakeSample ( &reference [ offset ], &this->mBakeSample [ offset ], time );
+		}
+		
+		for ( u32 c = 0; c < stride; ++c ) {
+			maxError = MAX ( maxError, ABS ( reference [ c ] - this->mBakeSample [ c ]));
+		}
+	}
+	return maxError;
+}
+
 //----------------------------------------------------------------//
 void MOAIAnim::Clear () {
 
@@ -163,9 +321,26 @@ void MOAIAnim::Clear () {
 	this->mLength = 0.0f;
 }
 
+//----------------------------------------------------------------//
+void MOAIAnim::ClearBake () {
+
+	this->mBakeRate = 0.0f;
+	this->mBakeTotalFrames = 0;
+	this->mBakeStride = 0;
+	
+	this->mBakeOffsets.Clear ();
+	this->mBakeFrames.Clear ();
+	this->mBakeQuantized.Clear ();
+	this->mBakeMin.Clear ();
+	this->mBakeStep.Clear ();
+	this->mBakeSample.Clear ();
+}
+
 //----------------------------------------------------------------//
 void MOAIAnim::ClearLinks () {
 
+	this->ClearBake ();
+
 	for ( u32 i = 0; i < this->mLinks.Size (); ++i ) {
 		MOAIAnimLink& link = this->mLinks [ i ];
 		link.mCurve.Set ( *this, 0 );
@@ -174,9 +349,27 @@ void MOAIAnim::ClearLinks () {
 	this->mLinks.Clear ();
 }
 
+//----------------------------------------------------------------//
+void MOAIAnim::GetLinkValue ( u32 linkID, MOAIAttribute& attr, float t, bool baked ) {
+
+	MOAIAnimCurveBase* curve = this->mLinks [ linkID ].mCurve;
+
+	u32 offset = baked ? this->mBakeOffsets [ linkID ] : NOT_BAKED;
+	
+	if ( offset != NOT_BAKED ) {
+		curve->GetBakedValue ( attr, &this->mBakeSample [ offset ]);
+	}
+	else {
+		curve->GetValue ( attr, t );
+	}
+}
+
 //----------------------------------------------------------------//
 MOAIAnim::MOAIAnim () :
-	mLength ( 0.0f ) {
+	mLength ( 0.0f ),
+	mBakeRate ( 0.0f ),
+	mBakeTotalFrames ( 0 ),
+	mBakeStride ( 0 ) {
 	
 	RTTI_SINGLE ( MOAITimer )
 }
@@ -200,6 +393,8 @@ void MOAIAnim::RegisterLuaFuncs ( MOAILuaState& state ) {
 
 	luaL_Reg regTable [] = {
 		{ "apply",				_apply },
+		{ "bake",				_bake },
+		{ "clearBake",			_clearBake },
 		{ "getLength",			_getLength },
 		{ "reserveLinks",		_reserveLinks },
 		{ "setLink",			_setLink },
@@ -216,12 +411,61 @@ void MOAIAnim::ReserveLinks ( u32 totalLinks ) {
 	this->mLinks.Init ( totalLinks );
 }
 
+//----------------------------------------------------------------//
+bool MOAIAnim::SampleBake ( float t ) {
+
+	if ( !this->mBakeTotalFrames ) return false;
+	
+	// the table only covers the baked range; past either end the curves' own wrap modes
+	// (wrap, mirror, append) decide the value, so hand those times back to the curves
+	if (( t < 0.0f ) || ( t > this->mLength )) return false;
+	
+	u32 stride = this->mBakeStride;
+	u32 lastFrame = this->mBakeTotalFrames - 1;
+	
+	u32 f0 = MIN (( u32 )( t * this->mBakeRate ), lastFrame );
+	u32 f1 = MIN ( f0 + 1, lastFrame );
+	
+	float t0 = ( float )f0 / this->mBakeRate;
+	float t1 = MIN (( float )f1 / this->mBakeRate, this->mLength );
+	float alpha = t1 > t0 ? ZLFloat::Clamp (( t - t0 ) / ( t1 - t0 ), 0.0f, 1.0f ) : 0.0f;
+	
+	float* sample = this->mBakeSample.Data ();
+	
+	// straight lerp across every channel of the frame; quaternions are renormalized by the curves
+	if ( this->mBakeQuantized.Size ()) {
+	
+		const u16* q0 = &this->mBakeQuantized [ f0 * stride ];
+		const u16* q1 = &this->mBakeQuantized [ f1 * stride ];
+		const float* min = this->mBakeMin.Data ();
+		const float* step = this->mBakeStep.Data ();
+		
+		for ( u32 c = 0; c < stride; ++c ) {
+			float v0 = ( float )q0 [ c ];
+			float v1 = ( float )q1 [ c ];
+			sample [ c ] = min [ c ] + ( step [ c ] * ( v0 + (( v1 - v0 ) * alpha )));
+		}
+	}
+	else {
+	
+		const float* v0 = &this->mBakeFrames [ f0 * stride ];
+		const float* v1 = &this->mBakeFrames [ f1 * stride ];
+		
+		for ( u32 c = 0; c < stride; ++c ) {
+			sample [ c ] = v0 [ c ] + (( v1 [ c ] - v0 [ c ]) * alpha );
+		}
+	}
+	return true;
+}
+
 //----------------------------------------------------------------//
 void MOAIAnim::SetLink ( u32 linkID, MOAIAnimCurveBase* curve, MOAINode* target, u32 attrID, bool relative ) {
 
 	if ( linkID >= this->mLinks.Size ()) return;
 	if ( !target ) return;
 	if ( !target->CheckAttrExists ( attrID )) return;
+	
+	this->ClearBake ();
 
 	MOAIAnimLink& link = this->mLinks [ linkID ];
 	link.mCurve.Set ( *this, curve );
@@ -30,16 +30,35 @@ class MOAIAnim :
 	public virtual MOAITimer {
 private:
 
+	static const u32 NOT_BAKED = ( u32 )-1;
+
 	float mLength;
 
 	ZLLeanArray < MOAIAnimLink > mLinks;
 
+	// baked playback: all absolute links resampled into interleaved frames of mBakeStride floats
+	float						mBakeRate;
+	u32							mBakeTotalFrames;
+	u32							mBakeStride;
+	ZLLeanArray < u32 >			mBakeOffsets;		// offset of each link's channels in a frame (or NOT_BAKED)
+	ZLLeanArray < float >		mBakeFrames;		// unquantized frames
+	ZLLeanArray < u16 >			mBakeQuantized;		// quantized frames
+	ZLLeanArray < float >		mBakeMin;			// per channel dequantization base
+	ZLLeanArray < float >		mBakeStep;			// per channel dequantization step
+	ZLLeanArray < float >		mBakeSample;		// blended frame for the current time
+
 	//----------------------------------------------------------------//
 	static int		_apply				( lua_State* L );
+	static int		_bake				( lua_State* L );
+	static int		_clearBake			( lua_State* L );
 	static int		_getLength			( lua_State* L );
 	static int		_reserveLinks		( lua_State* L );
 	static int		_setLink			( lua_State* L );
 	
+	//----------------------------------------------------------------//
+	void			GetLinkValue		( u32 linkID, MOAIAttribute& attr, float t, bool baked );
+	bool			SampleBake			( float t );
+	
 	//----------------------------------------------------------------//
 	void			MOAIAction_Update	( double step );
 	
@@ -49,10 +68,17 @@ public:
 	
 	GET ( float, Length, mLength )
 	
+	//----------------------------------------------------------------//
+	inline bool IsBaked () const {
+		return this->mBakeTotalFrames > 0;
+	}
+	
 	//----------------------------------------------------------------//
 	void			Apply				( float t );
 	void			Apply				( float t0, float t1 );
+	float			Bake				( float frameRate, bool quantize );
 	void			Clear				();
+	void			ClearBake			();
 	void			ClearLinks			();
 					MOAIAnim			();
 					~MOAIAnim			();
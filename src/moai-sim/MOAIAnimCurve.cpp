@@ -102,6 +102,13 @@ void MOAIAnimCurve::ApplyValueAttrOp ( MOAIAttribute& attr, u32 op ) {
 	this->mValue = attr.Apply ( this->mValue, op, MOAIAttribute::ATTR_READ_WRITE );
 }
 
+//----------------------------------------------------------------//
+void MOAIAnimCurve::BakeSample ( float* sample, const float* prev, float time ) const {
+	UNUSED ( prev );
+
+	sample [ 0 ] = this->GetValue ( time );
+}
+
 //----------------------------------------------------------------//
 void MOAIAnimCurve::Draw ( u32 resolution ) const {
 
@@ -134,6 +141,18 @@ void MOAIAnimCurve::Draw ( u32 resolution ) const {
 	gfxState.EndPrim ();
 }
 
+//----------------------------------------------------------------//
+void MOAIAnimCurve::GetBakedValue ( MOAIAttribute& attr, const float* sample ) const {
+
+	attr.SetValue ( sample [ 0 ]);
+}
+
+//----------------------------------------------------------------//
+u32 MOAIAnimCurve::GetBakeWidth () const {
+
+	return 1;
+}
+
 //----------------------------------------------------------------//
 float MOAIAnimCurve::GetCurveDelta () const {
 
@@ -38,7 +38,10 @@ public:
 	
 	//----------------------------------------------------------------//
 	void			ApplyValueAttrOp	( MOAIAttribute& attr, u32 op );
+	void			BakeSample			( float* sample, const float* prev, float time ) const;
 	void			Draw				( u32 resolution ) const;
+	void			GetBakedValue		( MOAIAttribute& attr, const float* sample ) const;
+	u32				GetBakeWidth		() const;
 	void			GetDelta			( MOAIAttribute& attr, const MOAIAnimKeySpan& span0, const MOAIAnimKeySpan& span1 ) const;
 	float			GetSample			( u32 id );
 	float			GetValue			( float time ) const;
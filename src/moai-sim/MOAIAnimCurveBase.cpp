@@ -83,6 +83,7 @@ int	MOAIAnimCurveBase::_setWrapMode	( lua_State* L ) {
 void MOAIAnimCurveBase::Clear () {
 
 	this->mKeys.Clear ();
+	this->mKeyCursor = 0;
 }
 
 //----------------------------------------------------------------//
@@ -93,11 +94,27 @@ void MOAIAnimCurveBase::Draw ( u32 resolution ) const {
 //----------------------------------------------------------------//
 u32 MOAIAnimCurveBase::FindKeyID ( float time ) const {
 	
+	u32 total = ( u32 )this->mKeys.Size ();
+	
+	// check the cached key and the one after it before falling back on a search
+	for ( u32 i = this->mKeyCursor, end = MIN ( this->mKeyCursor + 2, total ); i < end; ++i ) {
+	
+		if ( time < this->mKeys [ i ].mTime ) break;
+	
+		if ((( i + 1 ) < total ) ? ( time < this->mKeys [ i + 1 ].mTime ) : ( time == this->mKeys [ i ].mTime )) {
+			this->mKeyCursor = i;
+			return i;
+		}
+	}
+	
 	MOAIAnimKey key;
 	key.mTime = time;
 	
-	u32 index = USBinarySearchNearest < MOAIAnimKey >( this->mKeys.Data (), key, ( u32 )this->mKeys.Size ());
+	u32 index = USBinarySearchNearest < MOAIAnimKey >( this->mKeys.Data (), key, total );
 	
+	if ( index < total ) {
+		this->mKeyCursor = index;
+	}
 	return index;
 }
 
@@ -178,7 +195,8 @@ void MOAIAnimCurveBase::GetValue ( MOAIAttribute& attr, float time ) {
 //----------------------------------------------------------------//
 MOAIAnimCurveBase::MOAIAnimCurveBase () :
 	mTime ( 0.0f ),
-	mWrapMode ( CLAMP ) {
+	mWrapMode ( CLAMP ),
+	mKeyCursor ( 0 ) {
 	
 	RTTI_SINGLE ( MOAINode )
 }
@@ -223,6 +241,7 @@ void MOAIAnimCurveBase::RegisterLuaFuncs ( MOAILuaState& state ) {
 void MOAIAnimCurveBase::ReserveKeys ( u32 total ) {
 
 	this->mKeys.Init ( total );
+	this->mKeyCursor = 0;
 	this->ReserveSamples ( total );
 }
 
@@ -61,6 +61,8 @@ protected:
 
 	float	mTime;
 	u32		mWrapMode;
+	
+	mutable u32		mKeyCursor;		// last key found; playback usually lands on it or the next one
 
 	//----------------------------------------------------------------//
 	static int			_getLength			( lua_State* L );
@@ -97,9 +99,12 @@ public:
 	};
 	
 	//----------------------------------------------------------------//
+	virtual void		BakeSample				( float* sample, const float* prev, float time ) const = 0;
 	void				Clear					();
 	virtual void		Draw					( u32 resolution ) const;
 	u32					FindKeyID				( float time ) const;
+	virtual void		GetBakedValue			( MOAIAttribute& attr, const float* sample ) const = 0;
+	virtual u32			GetBakeWidth			() const = 0;
 	void				GetDelta				( MOAIAttribute& attr, float t0, float t1 );
 	const MOAIAnimKey&	GetKey					( u32 id ) const;
 	float				GetLength				() const;
@@ -57,6 +57,36 @@ void MOAIAnimCurveBone::ApplyValueAttrOp ( MOAIAttribute& attr, u32 op ) {
 	this->mValue = attr.ApplyNoAdd ( this->mValue, op, MOAIAttribute::ATTR_READ_WRITE );
 }
 
+//----------------------------------------------------------------//
+void MOAIAnimCurveBone::BakeSample ( float* sample, const float* prev, float time ) const {
+
+	ZLVec3D pos;
+	ZLQuaternion rot;
+	ZLVec3D scl;
+	
+	this->GetValue ( time, pos, rot, scl );
+	
+	// position, rotation, scale; rotation is blended as a normalized lerp
+	sample [ 0 ] = pos.mX;
+	sample [ 1 ] = pos.mY;
+	sample [ 2 ] = pos.mZ;
+	
+	sample [ 3 ] = rot.mS;
+	sample [ 4 ] = rot.mV.mX;
+	sample [ 5 ] = rot.mV.mY;
+	sample [ 6 ] = rot.mV.mZ;
+	
+	sample [ 7 ] = scl.mX;
+	sample [ 8 ] = scl.mY;
+	sample [ 9 ] = scl.mZ;
+	
+	if ( prev && ((( sample [ 3 ] * prev [ 3 ]) + ( sample [ 4 ] * prev [ 4 ]) + ( sample [ 5 ] * prev [ 5 ]) + ( sample [ 6 ] * prev [ 6 ])) < 0.0f )) {
+		for ( u32 i = 3; i < 7; ++i ) {
+			sample [ i ] = -sample [ i ];
+		}
+	}
+}
+
 //----------------------------------------------------------------//
 ZLAffine3D MOAIAnimCurveBone::Compose ( const ZLVec3D& pos, const ZLQuaternion& rot, const ZLVec3D& scl ) {
 
@@ -73,6 +103,24 @@ ZLAffine3D MOAIAnimCurveBone::Compose ( const ZLVec3D& pos, const ZLQuaternion&
 	return value;
 }
 
+//----------------------------------------------------------------//
+void MOAIAnimCurveBone::GetBakedValue ( MOAIAttribute& attr, const float* sample ) const {
+
+	ZLVec3D pos ( sample [ 0 ], sample [ 1 ], sample [ 2 ]);
+	ZLQuaternion rot ( sample [ 3 ], sample [ 4 ], sample [ 5 ], sample [ 6 ]);
+	ZLVec3D scl ( sample [ 7 ], sample [ 8 ], sample [ 9 ]);
+	
+	rot.Normalize ();
+	
+	attr.SetValue ( MOAIAnimCurveBone::Compose ( pos, rot, scl ));
+}
+
+//----------------------------------------------------------------//
+u32 MOAIAnimCurveBone::GetBakeWidth () const {
+
+	return 10;
+}
+
 //----------------------------------------------------------------//
 void MOAIAnimCurveBone::GetCurveDelta ( ZLVec3D& pos, ZLQuaternion& rot, ZLVec3D& scl ) const {
 
@@ -124,6 +172,12 @@ ZLAffine3D MOAIAnimCurveBone::GetValue ( float time ) const {
 	return this->GetValue ( span );
 }
 
+//----------------------------------------------------------------//
+void MOAIAnimCurveBone::GetValue ( float time, ZLVec3D& pos, ZLQuaternion& rot, ZLVec3D& scl ) const {
+
+	this->GetValue ( this->GetSpan ( time ), pos, rot, scl );
+}
+
 //----------------------------------------------------------------//
 ZLAffine3D MOAIAnimCurveBone::GetValue ( const MOAIAnimKeySpan& span ) const {
 	
@@ -26,7 +26,6 @@ private:
 	static int		_setKey				( lua_State* L );
 
 	//----------------------------------------------------------------//
-	static ZLAffine3D		Compose				( const ZLVec3D& pos, const ZLQuaternion& rot, const ZLVec3D& scl );
 	void					GetCurveDelta		( ZLVec3D& pos, ZLQuaternion& rot, ZLVec3D& scl ) const;
 	ZLAffine3D				GetValue			( const MOAIAnimKeySpan& span ) const;
 	void					GetValue			( const MOAIAnimKeySpan& span, ZLVec3D& pos, ZLQuaternion& rot, ZLVec3D& scl ) const;
@@ -41,8 +40,13 @@ public:
 	
 	//----------------------------------------------------------------//
 	void			ApplyValueAttrOp		( MOAIAttribute& attr, u32 op );
+	void			BakeSample				( float* sample, const float* prev, float time ) const;
+	static ZLAffine3D	Compose				( const ZLVec3D& pos, const ZLQuaternion& rot, const ZLVec3D& scl );
+	void			GetBakedValue			( MOAIAttribute& attr, const float* sample ) const;
+	u32				GetBakeWidth			() const;
 	void			GetDelta				( MOAIAttribute& attr, const MOAIAnimKeySpan& span0, const MOAIAnimKeySpan& span1 ) const;
 	ZLAffine3D		GetValue				( float time ) const;
+	void			GetValue				( float time, ZLVec3D& pos, ZLQuaternion& rot, ZLVec3D& scl ) const;
 	void			GetValue				( MOAIAttribute& attr, const MOAIAnimKeySpan& span ) const;
 	void			GetZero					( MOAIAttribute& attr ) const;
 					MOAIAnimCurveBone		();
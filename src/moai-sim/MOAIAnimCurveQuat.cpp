@@ -84,6 +84,38 @@ void MOAIAnimCurveQuat::ApplyValueAttrOp ( MOAIAttribute& attr, u32 op ) {
 	this->mValue = attr.Apply ( this->mValue, op, MOAIAttribute::ATTR_READ_WRITE );
 }
 
+//----------------------------------------------------------------//
+void MOAIAnimCurveQuat::BakeSample ( float* sample, const float* prev, float time ) const {
+
+	ZLQuaternion value = this->GetValue ( time );
+	
+	sample [ 0 ] = value.mS;
+	sample [ 1 ] = value.mV.mX;
+	sample [ 2 ] = value.mV.mY;
+	sample [ 3 ] = value.mV.mZ;
+	
+	// keep neighboring samples in the same hemisphere so that a normalized lerp between them takes the short arc
+	if ( prev && ((( sample [ 0 ] * prev [ 0 ]) + ( sample [ 1 ] * prev [ 1 ]) + ( sample [ 2 ] * prev [ 2 ]) + ( sample [ 3 ] * prev [ 3 ])) < 0.0f )) {
+		for ( u32 i = 0; i < 4; ++i ) {
+			sample [ i ] = -sample [ i ];
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIAnimCurveQuat::GetBakedValue ( MOAIAttribute& attr, const float* sample ) const {
+
+	ZLQuaternion value ( sample [ 0 ], sample [ 1 ], sample [ 2 ], sample [ 3 ]);
+	value.Normalize ();
+	attr.SetValue ( value );
+}
+
+//----------------------------------------------------------------//
+u32 MOAIAnimCurveQuat::GetBakeWidth () const {
+
+	return 4;
+}
+
 //----------------------------------------------------------------//
 ZLQuaternion MOAIAnimCurveQuat::GetCurveDelta () const {
 
@@ -37,6 +37,9 @@ public:
 	
 	//----------------------------------------------------------------//
 	void			ApplyValueAttrOp		( MOAIAttribute& attr, u32 op );
+	void			BakeSample				( float* sample, const float* prev, float time ) const;
+	void			GetBakedValue			( MOAIAttribute& attr, const float* sample ) const;
+	u32				GetBakeWidth			() const;
 	void			GetDelta				( MOAIAttribute& attr, const MOAIAnimKeySpan& span0, const MOAIAnimKeySpan& span1 ) const;
 	ZLQuaternion	GetValue				( float time ) const;
 	void			GetValue				( MOAIAttribute& attr, const MOAIAnimKeySpan& span ) const;
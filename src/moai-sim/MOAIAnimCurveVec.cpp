@@ -81,6 +81,29 @@ void MOAIAnimCurveVec::ApplyValueAttrOp ( MOAIAttribute& attr, u32 op ) {
 	this->mValue = attr.Apply ( this->mValue, op, MOAIAttribute::ATTR_READ_WRITE );
 }
 
+//----------------------------------------------------------------//
+void MOAIAnimCurveVec::BakeSample ( float* sample, const float* prev, float time ) const {
+	UNUSED ( prev );
+
+	ZLVec3D value = this->GetValue ( time );
+	
+	sample [ 0 ] = value.mX;
+	sample [ 1 ] = value.mY;
+	sample [ 2 ] = value.mZ;
+}
+
+//----------------------------------------------------------------//
+void MOAIAnimCurveVec::GetBakedValue ( MOAIAttribute& attr, const float* sample ) const {
+
+	attr.SetValue ( ZLVec3D ( sample [ 0 ], sample [ 1 ], sample [ 2 ]));
+}
+
+//----------------------------------------------------------------//
+u32 MOAIAnimCurveVec::GetBakeWidth () const {
+
+	return 3;
+}
+
 //----------------------------------------------------------------//
 ZLVec3D MOAIAnimCurveVec::GetCurveDelta () const {
 
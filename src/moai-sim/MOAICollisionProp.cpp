@@ -75,6 +75,43 @@ int MOAICollisionProp::_hasOverlaps ( lua_State* L ) {
 	return self->mOverlapLinks != 0;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	setCategory
+	@text	Sets the category flags of the prop and the mask of categories
+			it collides with. Two props are only tested for overlap if
+			either one's mask matches the other's category.
+	
+	@in		MOAICollisionProp self
+	@opt	number category		Default value is CATEGORY_MASK_ALL.
+	@opt	number mask			Default value is CATEGORY_MASK_ALL.
+	@out	nil
+*/
+int MOAICollisionProp::_setCategory ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAICollisionProp, "U" )
+	
+	self->mCategory		= state.GetValue < u32 >( 2, CATEGORY_MASK_ALL );
+	self->mMask			= state.GetValue < u32 >( 3, CATEGORY_MASK_ALL );
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	setEventMask
+	@text	Sets the mask of categories the prop wants overlap events
+			about. An event is sent to the collision world's callback
+			only if either prop's event mask matches the other's
+			category. Filtered events never reach Lua.
+	
+	@in		MOAICollisionProp self
+	@opt	number mask			Default value is CATEGORY_MASK_ALL.
+	@out	nil
+*/
+int MOAICollisionProp::_setEventMask ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAICollisionProp, "U" )
+	
+	self->mEventMask = state.GetValue < u32 >( 2, CATEGORY_MASK_ALL );
+	return 0;
+}
+
 //----------------------------------------------------------------//
 // TODO: doxygen
 //int MOAICollisionProp::_setGroupMask ( lua_State* L ) {
@@ -211,9 +248,13 @@ bool MOAICollisionProp::IsActive () {
 MOAICollisionProp::MOAICollisionProp () :
 	mCategory ( CATEGORY_MASK_ALL ),
 	mMask ( CATEGORY_MASK_ALL ),
+	mEventMask ( CATEGORY_MASK_ALL ),
 	mOverlapFlags ( DEFAULT_OVERLAP_FLAGS ),
 	mOverlapPass ( MOAICollisionWorld::OVERLAP_PASS_INIT ),
 	mOverlapLinks ( 0 ),
+	mSweepIdx ( 0 ),
+	mSweepBase ( 0 ),
+	mSweepTotal ( 0 ),
 	mStayActive ( false ),
 	mTouched ( MOAICollisionWorld::OVERLAP_PASS_INIT ),
 	mCollisionWorld ( 0 ) {
@@ -453,6 +494,8 @@ void MOAICollisionProp::RegisterLuaFuncs ( MOAILuaState& state ) {
 		{ "collisionMove",		_collisionMove },
 		{ "getOverlaps",		_getOverlaps },
 		{ "hasOverlaps",		_hasOverlaps },
+		{ "setCategory",		_setCategory },
+		{ "setEventMask",		_setEventMask },
 		//{ "setGroupMask",		_setGroupMask },
 		{ "setOverlapFlags",	_setOverlapFlags },
 		{ NULL, NULL }
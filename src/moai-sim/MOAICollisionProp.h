@@ -52,6 +52,9 @@ private:
 	bool					mIsValid;
 	
 	ZLLeanLink < MOAIPropOverlap* >	mOverlapListLink;
+	
+	u32						mHash;				// key in the collision world's pair cache
+	MOAIPropOverlap*		mHashNext;			// next overlap in the same pair cache bucket
 };
 
 //================================================================//
@@ -64,6 +67,7 @@ class MOAICollisionProp :
 	public virtual MOAIIndexedPropBase {
 private:
 	
+	friend class MOAICollisionSweep;
 	friend class MOAICollisionWorld;
 	friend class MOAIOverlapHandler;
 	
@@ -71,6 +75,7 @@ private:
 	
 	u32									mCategory;			// type flags for collision object
 	u32									mMask;				// mask of type flags this object collides with
+	u32									mEventMask;			// mask of type flags this object wants overlap events about
 	
 	u32									mOverlapFlags;
 	u32									mOverlapPass;		// used to identify if prop has been processed in current cycle
@@ -78,6 +83,10 @@ private:
 	
 	ZLLeanLink < MOAICollisionProp* >	mActiveListLink;	// link in collision world's list of props with overlaps or in need of update
 	
+	u32									mSweepIdx;			// position in the sweep broadphase's sorted list
+	u32									mSweepBase;			// start of this prop's run of sweep neighbors
+	u32									mSweepTotal;		// number of sweep neighbors
+	
 	bool								mStayActive;
 	u32									mTouched;			// only for debug drawing
 	
@@ -87,6 +96,8 @@ private:
 	static int				_collisionMove			( lua_State* L );
 	static int				_getOverlaps			( lua_State* L );
 	static int				_hasOverlaps			( lua_State* L );
+	static int				_setCategory			( lua_State* L );
+	static int				_setEventMask			( lua_State* L );
 	//static int				_setGroupMask			( lua_State* L );
 	static int				_setOverlapFlags		( lua_State* L );
 	
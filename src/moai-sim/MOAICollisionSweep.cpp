@@ -0,0 +1,174 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#include <float.h>
+#include <moai-sim/MOAICollisionProp.h>
+#include <moai-sim/MOAICollisionSweep.h>
+
+//================================================================//
+// MOAICollisionSweep
+//================================================================//
+
+//----------------------------------------------------------------//
+MOAICollisionProp** MOAICollisionSweep::GetNeighbors ( MOAICollisionProp& prop, u32& total ) {
+
+	total = prop.mSweepTotal;
+	return total ? &this->mNeighbors [ prop.mSweepBase ] : 0;
+}
+
+//----------------------------------------------------------------//
+void MOAICollisionSweep::Insert ( MOAICollisionProp& prop ) {
+
+	// new props go on the end and are sorted into place on the next update
+	prop.mSweepIdx		= ( u32 )this->mEntries.GetTop ();
+	prop.mSweepBase		= 0;
+	prop.mSweepTotal	= 0;
+
+	MOAICollisionSweepEntry& entry = this->mEntries.Push ();
+	entry.mProp			= &prop;
+	entry.mIsEmpty		= true;
+	entry.mBox.Init ( FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX );
+}
+
+//----------------------------------------------------------------//
+MOAICollisionSweep::MOAICollisionSweep () {
+}
+
+//----------------------------------------------------------------//
+MOAICollisionSweep::~MOAICollisionSweep () {
+}
+
+//----------------------------------------------------------------//
+void MOAICollisionSweep::Remove ( MOAICollisionProp& prop ) {
+
+	u32 idx = prop.mSweepIdx;
+	u32 top = ( u32 )this->mEntries.GetTop ();
+	if ( !(( idx < top ) && ( this->mEntries [ idx ].mProp == &prop ))) return;
+	
+	// the prop may be removed while its pairs are being processed, so blank it
+	// out of each neighbor's run rather than rebuilding the lists
+	for ( u32 i = 0; i < prop.mSweepTotal; ++i ) {
+	
+		MOAICollisionProp* neighbor = this->mNeighbors [ prop.mSweepBase + i ];
+		if ( !neighbor ) continue;
+		
+		MOAICollisionProp** others = &this->mNeighbors [ neighbor->mSweepBase ];
+		for ( u32 j = 0; j < neighbor->mSweepTotal; ++j ) {
+			if ( others [ j ] == &prop ) {
+				others [ j ] = 0;
+			}
+		}
+	}
+	prop.mSweepTotal = 0;
+	
+	// fill the hole with the last entry; order is restored on the next update
+	MOAICollisionSweepEntry last = this->mEntries [ top - 1 ];
+	this->mEntries [ idx ] = last;
+	last.mProp->mSweepIdx = idx;
+	this->mEntries.Pop ();
+}
+
+//----------------------------------------------------------------//
+void MOAICollisionSweep::Update () {
+
+	u32 total = ( u32 )this->mEntries.GetTop ();
+	MOAICollisionSweepEntry* entries = this->mEntries;
+
+	// refresh the cached bounds. props without bounds sort to the end; global
+	// bounds span everything.
+	for ( u32 i = 0; i < total; ++i ) {
+	
+		MOAICollisionSweepEntry& entry = entries [ i ];
+		ZLBounds bounds = entry.mProp->GetWorldBounds ();
+		
+		entry.mIsEmpty = false;
+		
+		switch ( bounds.mStatus ) {
+		
+			case ZLBounds::ZL_BOUNDS_OK:
+				entry.mBox = bounds;
+				break;
+			
+			case ZLBounds::ZL_BOUNDS_GLOBAL:
+				entry.mBox.Init ( -FLT_MAX, FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX, FLT_MAX );
+				break;
+			
+			default:
+				entry.mIsEmpty = true;
+				entry.mBox.Init ( FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX );
+				break;
+		}
+	}
+	
+	// insertion sort on the low x edge; nearly sorted from the last step
+	for ( u32 i = 1; i < total; ++i ) {
+	
+		MOAICollisionSweepEntry entry = entries [ i ];
+		float minX = entry.mBox.mMin.mX;
+		
+		u32 j = i;
+		for ( ; ( j > 0 ) && ( entries [ j - 1 ].mBox.mMin.mX > minX ); --j ) {
+			entries [ j ] = entries [ j - 1 ];
+		}
+		entries [ j ] = entry;
+	}
+	
+	for ( u32 i = 0; i < total; ++i ) {
+		MOAICollisionProp& prop = *entries [ i ].mProp;
+		prop.mSweepIdx = i;
+		prop.mSweepTotal = 0;
+	}
+	
+	// sweep: each entry only needs to be tested against those that start
+	// before it ends. pairs that could never raise an event are dropped here.
+	this->mPairs.Reset ();
+	
+	for ( u32 i = 0; i < total; ++i ) {
+	
+		const MOAICollisionSweepEntry& entry0 = entries [ i ];
+		if ( entry0.mIsEmpty ) break;
+		
+		MOAICollisionProp& prop0 = *entry0.mProp;
+		float maxX = entry0.mBox.mMax.mX;
+		
+		for ( u32 j = i + 1; j < total; ++j ) {
+		
+			const MOAICollisionSweepEntry& entry1 = entries [ j ];
+			if ( entry1.mIsEmpty || ( entry1.mBox.mMin.mX > maxX )) break;
+			
+			MOAICollisionProp& prop1 = *entry1.mProp;
+			
+			if ( !( prop0.mOverlapFlags | prop1.mOverlapFlags )) continue;
+			if ( !(( prop0.mCategory & prop1.mMask ) || ( prop0.mMask & prop1.mCategory ))) continue;
+			if ( !entry0.mBox.Overlap ( entry1.mBox )) continue;
+			
+			this->mPairs.Push ( i );
+			this->mPairs.Push ( j );
+			
+			prop0.mSweepTotal++;
+			prop1.mSweepTotal++;
+		}
+	}
+	
+	// lay out each prop's run of neighbors, then fill them in
+	u32 base = 0;
+	for ( u32 i = 0; i < total; ++i ) {
+		MOAICollisionProp& prop = *entries [ i ].mProp;
+		prop.mSweepBase = base;
+		base += prop.mSweepTotal;
+		prop.mSweepTotal = 0;
+	}
+	
+	this->mNeighbors.GrowChunked ( base, 256 );
+	
+	u32 totalPairs = ( u32 )this->mPairs.GetTop ();
+	for ( u32 i = 0; i < totalPairs; i += 2 ) {
+	
+		MOAICollisionProp& prop0 = *entries [ this->mPairs [ i ]].mProp;
+		MOAICollisionProp& prop1 = *entries [ this->mPairs [ i + 1 ]].mProp;
+		
+		this->mNeighbors [ prop0.mSweepBase + prop0.mSweepTotal++ ] = &prop1;
+		this->mNeighbors [ prop1.mSweepBase + prop1.mSweepTotal++ ] = &prop0;
+	}
+}
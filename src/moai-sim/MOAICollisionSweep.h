@@ -0,0 +1,51 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAICOLLISIONSWEEP_H
+#define	MOAICOLLISIONSWEEP_H
+
+class MOAICollisionProp;
+
+//================================================================//
+// MOAICollisionSweepEntry
+//================================================================//
+class MOAICollisionSweepEntry {
+private:
+
+	friend class MOAICollisionSweep;
+
+	MOAICollisionProp*		mProp;
+	ZLBox					mBox;
+	bool					mIsEmpty;
+};
+
+//================================================================//
+// MOAICollisionSweep
+//================================================================//
+// sort and sweep broadphase for the collision world. props are kept sorted
+// by the low edge of their world bounds on the x axis; since props move a
+// little each step, an insertion sort restores the order in close to
+// linear time. one sweep over the sorted list then finds every pair of
+// props whose bounds overlap and stores them in a compressed neighbor list,
+// giving each prop a contiguous run of candidates.
+class MOAICollisionSweep {
+private:
+
+	ZLLeanStack < MOAICollisionSweepEntry >		mEntries;
+	ZLLeanArray < MOAICollisionProp* >			mNeighbors;
+	ZLLeanStack < u32 >							mPairs;
+
+public:
+
+	GET ( u32, TotalPairs, ( u32 )( mPairs.GetTop () >> 1 ))
+
+	//----------------------------------------------------------------//
+	MOAICollisionProp**		GetNeighbors				( MOAICollisionProp& prop, u32& total );
+	void					Insert						( MOAICollisionProp& prop );
+							MOAICollisionSweep			();
+							~MOAICollisionSweep			();
+	void					Remove						( MOAICollisionProp& prop );
+	void					Update						();
+};
+
+#endif
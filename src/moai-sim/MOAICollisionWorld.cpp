@@ -44,6 +44,18 @@ private:
 // local
 //================================================================//
 
+//----------------------------------------------------------------//
+// iterator handed to batched callbacks; upvalue 1 is the world
+int MOAICollisionWorld::_nextEvent ( lua_State* L ) {
+	MOAILuaState state ( L );
+
+	MOAICollisionWorld* self = state.GetLuaObject < MOAICollisionWorld >( lua_upvalueindex ( 1 ), false );
+	if ( !( self && ( self->mEventCursor < self->mEventEnd ))) return 0;
+	
+	MOAICollisionEvent& event = self->mEvents [ self->mEventCursor++ ];
+	return ( int )MOAICollisionWorld::PushEvent ( state, event.mEventID, *event.mProp0, *event.mProp1, event.mBounds );
+}
+
 //----------------------------------------------------------------//
 // TODO: doxygen
 int MOAICollisionWorld::_processOverlaps ( lua_State* L ) {
@@ -54,11 +66,45 @@ int MOAICollisionWorld::_processOverlaps ( lua_State* L ) {
 }
 
 //----------------------------------------------------------------//
-// TODO: doxygen
+/**	@lua	setBroadphase
+	@text	Selects how candidate pairs are found for active props.
+			BROADPHASE_PARTITION queries the partition once per active
+			prop. BROADPHASE_SWEEP keeps the world's props sorted along
+			the x axis and finds all overlapping pairs in a single sweep
+			per pass; it is faster when many props move every step.
+	
+	@in		MOAICollisionWorld self
+	@opt	number broadphase		One of MOAICollisionWorld.BROADPHASE_PARTITION, MOAICollisionWorld.BROADPHASE_SWEEP. Default value is BROADPHASE_PARTITION.
+	@out	nil
+*/
+int MOAICollisionWorld::_setBroadphase ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAICollisionWorld, "U" )
+	
+	self->mBroadphase = state.GetValue < u32 >( 2, BROADPHASE_PARTITION );
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	setCallback
+	@text	Sets the overlap event handler. By default it is called once
+			per event with ( event, prop0, prop1, [ xMin, yMin, zMin,
+			xMax, yMax, zMax ]). In batched mode the events of a pass
+			are queued natively and the handler is called once, at the
+			end of the pass, with ( iterator, count ); the iterator
+			returns the same values per event and may be used in a
+			generic for. Events whose props do not pass each other's
+			event masks are never queued or delivered.
+	
+	@in		MOAICollisionWorld self
+	@opt	function callback
+	@opt	boolean batch			Default value is false.
+	@out	nil
+*/
 int MOAICollisionWorld::_setCallback ( lua_State* L ) {
 	MOAI_LUA_SETUP ( MOAICollisionWorld, "U" )
 	
 	self->mCallback.SetRef ( state, 2 );
+	self->mBatchEvents = state.GetValue < bool >( 3, false );
 	return 0;
 }
 
@@ -69,20 +115,22 @@ int MOAICollisionWorld::_setCallback ( lua_State* L ) {
 //----------------------------------------------------------------//
 void MOAICollisionWorld::AffirmOverlap ( MOAICollisionProp& prop0, u32 type0, MOAICollisionProp& prop1, u32 type1, const ZLBounds& bounds ) {
 	
-	MOAIPropOverlapLink* overlapLink = prop0.mOverlapLinks;
-	for ( ; overlapLink; overlapLink = overlapLink->mNext ) {
+	// the hash is symmetric, so the pair is found whichever prop comes first
+	u32 hash = MOAICollisionWorld::HashOverlapLink ( prop0, type0 ) + MOAICollisionWorld::HashOverlapLink ( prop1, type1 );
 	
-		if (( overlapLink->mType == type0 ) && ( overlapLink->mOtherLink->mProp == &prop1 ) && ( overlapLink->mOtherLink->mType == type1 )) {
-			MOAIPropOverlap& overlap = *overlapLink->mOverlap;
-			overlap.mIsValid = true;
-			overlap.mBounds = bounds;
-			return;
-		}
+	MOAIPropOverlap* overlap = this->FindOverlap ( hash, prop0, type0, prop1, type1 );
+	
+	if ( overlap ) {
+		overlap->mIsValid = true;
+		overlap->mBounds = bounds;
+		return;
 	}
 	
-	MOAIPropOverlap* overlap = this->mOverlapPool.Alloc ();
+	overlap = this->mOverlapPool.Alloc ();
 	assert ( overlap );
 	
+	overlap->mHash				= hash;
+	
 	overlap->mIsValid			= true; // latch is set
 	overlap->mBounds			= bounds;
 	
@@ -102,6 +150,7 @@ void MOAICollisionWorld::AffirmOverlap ( MOAICollisionProp& prop0, u32 type0, MO
 	
 	overlap->mOverlapListLink.Data ( overlap );
 	this->mOverlapList.PushBack ( overlap->mOverlapListLink );
+	this->InsertOverlap ( *overlap );
 	
 	this->DoCallback ( OVERLAP_BEGIN, prop0, prop1, bounds );
 }
@@ -161,54 +210,122 @@ void MOAICollisionWorld::ClearOverlaps ( MOAICollisionProp& prop ) {
 		// clear out the linkbacks
 		other.ClearOverlapLink ( *overlapLink->mOverlap );
 		
-		// remove from the list
-		this->mOverlapList.Remove ( overlapLink->mOverlap->mOverlapListLink );
-		
 		// done with the overlap and links
-		this->mOverlapPool.Free ( overlapLink->mOverlap );
+		this->FreeOverlap ( *overlapLink->mOverlap );
 	}
 }
 
 //----------------------------------------------------------------//
 void MOAICollisionWorld::DoCallback ( u32 eventID, MOAICollisionProp& prop0, MOAICollisionProp& prop1 ) {
 	
-	if ( this->mCallback ) {
+	this->DoCallback ( eventID, prop0, prop1, ZLBounds::EMPTY );
+}
+
+//----------------------------------------------------------------//
+void MOAICollisionWorld::DoCallback ( u32 eventID, MOAICollisionProp& prop0, MOAICollisionProp& prop1, const ZLBounds& bounds ) {
+	
+	if ( !this->mCallback ) return;
+	
+	// either prop may ask for events about the other's category
+	if ( !(( prop0.mCategory & prop1.mEventMask ) || ( prop0.mEventMask & prop1.mCategory ))) return;
+	
+	if ( this->mBatchEvents ) {
+	
+		// props are held until the batch is delivered in case one is removed
+		// from the world and collected in the meantime
+		MOAICollisionEvent& event = this->mEvents.Push ();
+		event.mEventID	= eventID;
+		event.mProp0	= &prop0;
+		event.mProp1	= &prop1;
+		event.mBounds	= bounds;
 		
-		MOAIScopedLuaState state = this->mCallback.GetSelf ();
+		this->LuaRetain ( &prop0 );
+		this->LuaRetain ( &prop1 );
+		return;
+	}
+	
+	MOAIScopedLuaState state = this->mCallback.GetSelf ();
+	u32 nArgs = MOAICollisionWorld::PushEvent ( state, eventID, prop0, prop1, bounds );
+	state.DebugCall ( nArgs, 0 );
+}
+
+//----------------------------------------------------------------//
+MOAIPropOverlap* MOAICollisionWorld::FindOverlap ( u32 hash, MOAICollisionProp& prop0, u32 type0, MOAICollisionProp& prop1, u32 type1 ) {
+
+	size_t tableSize = this->mOverlapTable.Size ();
+	if ( !tableSize ) return 0;
+
+	MOAIPropOverlap* overlap = this->mOverlapTable [ hash & ( tableSize - 1 )];
+	for ( ; overlap; overlap = overlap->mHashNext ) {
+	
+		if ( overlap->mHash != hash ) continue;
+		
+		const MOAIPropOverlapLink& left = overlap->mLeft;
+		const MOAIPropOverlapLink& right = overlap->mRight;
 		
-		state.Push ( eventID );
-		state.Push ( &prop0 );
-		state.Push ( &prop1 );
-		state.DebugCall ( 3, 0 );
+		if (( left.mProp == &prop0 ) && ( left.mType == type0 ) && ( right.mProp == &prop1 ) && ( right.mType == type1 )) return overlap;
+		if (( left.mProp == &prop1 ) && ( left.mType == type1 ) && ( right.mProp == &prop0 ) && ( right.mType == type0 )) return overlap;
 	}
+	return 0;
 }
 
 //----------------------------------------------------------------//
-void MOAICollisionWorld::DoCallback ( u32 eventID, MOAICollisionProp& prop0, MOAICollisionProp& prop1, const ZLBounds& bounds ) {
+void MOAICollisionWorld::FlushEvents () {
+
+	// events raised from inside the callback are queued behind the current
+	// batch and delivered in a follow-up call
+	if ( this->mIsFlushingEvents ) return;
+	this->mIsFlushingEvents = true;
 	
-	if ( this->mCallback ) {
+	u32 base = 0;
+	u32 top = ( u32 )this->mEvents.GetTop ();
+	
+	while (( base < top ) && this->mCallback ) {
+	
+		this->mEventCursor = base;
+		this->mEventEnd = top;
 	
 		MOAIScopedLuaState state = this->mCallback.GetSelf ();
 		
-		state.Push ( eventID );
-		state.Push ( &prop0 );
-		state.Push ( &prop1 );
-		
-		if ( bounds.mStatus == ZLBounds::ZL_BOUNDS_OK ) {
+		this->PushLuaUserdata ( state );
+		lua_pushcclosure ( state, _nextEvent, 1 );
+		state.Push ( top - base );
+		state.DebugCall ( 2, 0 );
 		
-			state.Push ( bounds.mMin.mX );
-			state.Push ( bounds.mMin.mY );
-			state.Push ( bounds.mMin.mZ );
-			state.Push ( bounds.mMax.mX );
-			state.Push ( bounds.mMax.mY );
-			state.Push ( bounds.mMax.mZ );
-			
-			state.DebugCall ( 9, 0 );
-		}
-		else {
-			state.DebugCall ( 3, 0 );
+		base = top;
+		top = ( u32 )this->mEvents.GetTop ();
+	}
+	
+	this->mEventCursor = 0;
+	this->mEventEnd = 0;
+	
+	for ( u32 i = 0; i < top; ++i ) {
+		MOAICollisionEvent& event = this->mEvents [ i ];
+		this->LuaRelease ( event.mProp0 );
+		this->LuaRelease ( event.mProp1 );
+	}
+	this->mEvents.Reset ();
+	
+	this->mIsFlushingEvents = false;
+}
+
+//----------------------------------------------------------------//
+void MOAICollisionWorld::FreeOverlap ( MOAIPropOverlap& overlap ) {
+
+	size_t tableSize = this->mOverlapTable.Size ();
+	if ( tableSize ) {
+	
+		MOAIPropOverlap** cursor = &this->mOverlapTable [ overlap.mHash & ( tableSize - 1 )];
+		for ( ; *cursor; cursor = &( *cursor )->mHashNext ) {
+			if ( *cursor == &overlap ) {
+				*cursor = overlap.mHashNext;
+				break;
+			}
 		}
 	}
+	
+	this->mOverlapList.Remove ( overlap.mOverlapListLink );
+	this->mOverlapPool.Free ( &overlap );
 }
 
 //----------------------------------------------------------------//
@@ -241,6 +358,45 @@ void MOAICollisionWorld::HandleOverlap ( MOAICollisionProp& prop0, u32 type0, MO
 
 }
 
+//----------------------------------------------------------------//
+u32 MOAICollisionWorld::HashOverlapLink ( const MOAICollisionProp& prop, u32 type ) {
+
+	u64 key = ( u64 )( size_t )&prop;
+	u32 hash = ( u32 )( key ^ ( key >> 32 ));
+	
+	hash = ( hash ^ ( hash >> 4 )) * 0x9e3779b1;
+	hash ^= ( type + 1 ) * 0x85ebca6b;
+	return hash ^ ( hash >> 16 );
+}
+
+//----------------------------------------------------------------//
+void MOAICollisionWorld::InsertOverlap ( MOAIPropOverlap& overlap ) {
+
+	size_t tableSize = this->mOverlapTable.Size ();
+
+	// keep the load factor at or under one; overlaps are already linked into
+	// the overlap list, so rehash from there
+	if ( this->mOverlapList.Count () > tableSize ) {
+	
+		tableSize = tableSize ? ( tableSize << 1 ) : 64;
+		this->mOverlapTable.Init ( tableSize );
+		this->mOverlapTable.Fill ( 0 );
+		
+		OverlapListIt overlapIt = this->mOverlapList.Head ();
+		for ( ; overlapIt; overlapIt = overlapIt->Next ()) {
+			MOAIPropOverlap* cursor = overlapIt->Data ();
+			MOAIPropOverlap*& bucket = this->mOverlapTable [ cursor->mHash & ( tableSize - 1 )];
+			cursor->mHashNext = bucket;
+			bucket = cursor;
+		}
+		return;
+	}
+	
+	MOAIPropOverlap*& bucket = this->mOverlapTable [ overlap.mHash & ( tableSize - 1 )];
+	overlap.mHashNext = bucket;
+	bucket = &overlap;
+}
+
 //----------------------------------------------------------------//
 void MOAICollisionWorld::InvalidateOverlaps ( MOAICollisionProp& prop, u32 nextPass ) {
 
@@ -267,7 +423,12 @@ void MOAICollisionWorld::MakeInactive ( MOAICollisionProp& prop ) {
 //----------------------------------------------------------------//
 MOAICollisionWorld::MOAICollisionWorld () :
 	mUpdated ( false ),
-	mOverlapPass ( OVERLAP_PASS_INIT ) {
+	mOverlapPass ( OVERLAP_PASS_INIT ),
+	mBroadphase ( BROADPHASE_PARTITION ),
+	mBatchEvents ( false ),
+	mIsFlushingEvents ( false ),
+	mEventCursor ( 0 ),
+	mEventEnd ( 0 ) {
 	
 	RTTI_BEGIN
 		RTTI_EXTEND ( MOAIAction )
@@ -279,6 +440,12 @@ MOAICollisionWorld::MOAICollisionWorld () :
 //----------------------------------------------------------------//
 MOAICollisionWorld::~MOAICollisionWorld () {
 
+	for ( u32 i = 0; i < this->mEvents.GetTop (); ++i ) {
+		MOAICollisionEvent& event = this->mEvents [ i ];
+		this->LuaRelease ( event.mProp0 );
+		this->LuaRelease ( event.mProp1 );
+	}
+
 	while ( this->mOverlapList.Count ()) {
 		MOAIPropOverlap* overlap = this->mOverlapList.Front ();
 		this->mOverlapList.Remove ( overlap->mOverlapListLink );
@@ -286,11 +453,30 @@ MOAICollisionWorld::~MOAICollisionWorld () {
 	}
 }
 
+//----------------------------------------------------------------//
+void MOAICollisionWorld::ProcessOverlap ( MOAICollisionProp& prop, MOAICollisionProp& other, u32 nextPass ) {
+
+	if ( !(( prop.mCategory & other.mMask ) || ( prop.mMask & other.mCategory ))) return;
+	if ( other.mOverlapPass == nextPass ) return; // has been processed
+	
+	// this calculates the detailed overlap, updates the links and sends overlap events
+	MOAIOverlapHandler overlapHandler;
+	overlapHandler.SetCalculateBounds ((( prop.mOverlapFlags | other.mOverlapFlags ) & MOAICollisionProp::OVERLAP_CALCULATE_BOUNDS ) != 0 );
+	overlapHandler.Process ( prop, other );
+}
+
 //----------------------------------------------------------------//
 void MOAICollisionWorld::ProcessOverlaps () {
 
 	u32 thisPass = this->mOverlapPass;
 	u32 nextPass = thisPass + 1;
+	
+	bool sweep = ( this->mBroadphase == BROADPHASE_SWEEP );
+	
+	// find every candidate pair up front; each active prop then visits its own run
+	if ( sweep ) {
+		this->mSweep.Update ();
+	}
 
 	// any prop becomes active when it is updated but only if
 	// flags are set
@@ -307,28 +493,38 @@ void MOAICollisionWorld::ProcessOverlaps () {
 		MOAICollisionProp& prop = *activeIt->Data ();
 		this->InvalidateOverlaps ( prop, nextPass );
 		
-		u32 interfaceMask = this->GetInterfaceMask < MOAICollisionProp >();
+		if ( sweep ) {
 		
-		// this gives us the coarse filter based on world space bounds
-		// TODO: find a way to utilize overlap flags?
-		MOAIScopedPartitionResultBufferHandle scopedBufferHandle = MOAIPartitionResultMgr::Get ().GetBufferHandle ();
-		MOAIPartitionResultBuffer& buffer = scopedBufferHandle;
-
-		u32 totalResults = this->GatherHulls ( buffer, &prop, prop.GetWorldBounds (), interfaceMask );
-		
-		for ( u32 i = 0; i < totalResults; ++i ) {
+			// neighbors removed during this pass are blanked out
+			u32 totalNeighbors;
+			MOAICollisionProp** neighbors = this->mSweep.GetNeighbors ( prop, totalNeighbors );
+			
+			for ( u32 i = 0; i < totalNeighbors; ++i ) {
+				if ( neighbors [ i ]) {
+					this->ProcessOverlap ( prop, *neighbors [ i ], nextPass );
+				}
+			}
+		}
+		else {
 		
-			MOAIPartitionResult* result = buffer.GetResultUnsafe ( i );
-			MOAICollisionProp* otherProp = result->AsType < MOAICollisionProp >();
+			u32 interfaceMask = this->GetInterfaceMask < MOAICollisionProp >();
 			
-			if ( !otherProp ) continue;
-			if ( !(( prop.mCategory & otherProp->mMask ) || ( prop.mMask & otherProp->mCategory ))) continue;
-			if ( otherProp->mOverlapPass == nextPass ) continue; // has been processed
+			// this gives us the coarse filter based on world space bounds
+			// TODO: find a way to utilize overlap flags?
+			MOAIScopedPartitionResultBufferHandle scopedBufferHandle = MOAIPartitionResultMgr::Get ().GetBufferHandle ();
+			MOAIPartitionResultBuffer& buffer = scopedBufferHandle;
+
+			u32 totalResults = this->GatherHulls ( buffer, &prop, prop.GetWorldBounds (), interfaceMask );
 			
-			// this calculates the detailed overlap, updates the links and sends overlap events
-			MOAIOverlapHandler overlapHandler;
-			overlapHandler.SetCalculateBounds ((( prop.mOverlapFlags | otherProp->mOverlapFlags ) & MOAICollisionProp::OVERLAP_CALCULATE_BOUNDS ) != 0 );
-			overlapHandler.Process ( prop, *otherProp );
+			for ( u32 i = 0; i < totalResults; ++i ) {
+			
+				MOAIPartitionResult* result = buffer.GetResultUnsafe ( i );
+				MOAICollisionProp* otherProp = result->AsType < MOAICollisionProp >();
+				
+				if ( otherProp ) {
+					this->ProcessOverlap ( prop, *otherProp, nextPass );
+				}
+			}
 		}
 		
 		this->PruneOverlaps ( prop );
@@ -343,6 +539,9 @@ void MOAICollisionWorld::ProcessOverlaps () {
 	}
 	
 	this->mOverlapPass = nextPass;
+	
+	// includes end events queued by props leaving the world since the last pass
+	this->FlushEvents ();
 }
 
 //----------------------------------------------------------------//
@@ -366,8 +565,7 @@ void MOAICollisionWorld::PruneOverlaps ( MOAICollisionProp& prop ) {
 			}
 		
 			other.ClearOverlapLink ( overlap );
-			this->mOverlapList.Remove ( overlapLink->mOverlap->mOverlapListLink );
-			this->mOverlapPool.Free ( overlapLink->mOverlap );
+			this->FreeOverlap ( overlap );
 		}
 		else {
 		
@@ -377,12 +575,36 @@ void MOAICollisionWorld::PruneOverlaps ( MOAICollisionProp& prop ) {
 	}
 }
 
+//----------------------------------------------------------------//
+u32 MOAICollisionWorld::PushEvent ( MOAILuaState& state, u32 eventID, MOAICollisionProp& prop0, MOAICollisionProp& prop1, const ZLBounds& bounds ) {
+
+	state.Push ( eventID );
+	state.Push ( &prop0 );
+	state.Push ( &prop1 );
+	
+	if ( bounds.mStatus == ZLBounds::ZL_BOUNDS_OK ) {
+	
+		state.Push ( bounds.mMin.mX );
+		state.Push ( bounds.mMin.mY );
+		state.Push ( bounds.mMin.mZ );
+		state.Push ( bounds.mMax.mX );
+		state.Push ( bounds.mMax.mY );
+		state.Push ( bounds.mMax.mZ );
+		
+		return 9;
+	}
+	return 3;
+}
+
 //----------------------------------------------------------------//
 void MOAICollisionWorld::RegisterLuaClass ( MOAILuaState& state ) {
 
 	MOAIAction::RegisterLuaClass ( state );
 	MOAIPartition::RegisterLuaClass ( state );
 	
+	state.SetField ( -1, "BROADPHASE_PARTITION",		( u32 )BROADPHASE_PARTITION );
+	state.SetField ( -1, "BROADPHASE_SWEEP",			( u32 )BROADPHASE_SWEEP );
+	
 	state.SetField ( -1, "OVERLAP_BEGIN",				( u32 )OVERLAP_BEGIN );
 	state.SetField ( -1, "OVERLAP_END",					( u32 )OVERLAP_END );
 	state.SetField ( -1, "OVERLAP_UPDATE",				( u32 )OVERLAP_UPDATE );
@@ -396,6 +618,7 @@ void MOAICollisionWorld::RegisterLuaFuncs ( MOAILuaState& state ) {
 	
 	luaL_Reg regTable [] = {
 		{ "processOverlaps",	_processOverlaps },
+		{ "setBroadphase",		_setBroadphase },
 		{ "setCallback",		_setCallback },
 		{ NULL, NULL }
 	};
@@ -450,6 +673,7 @@ void MOAICollisionWorld::MOAIPartition_OnInsertHull ( MOAIPartitionHull& hull )
 	
 		// must be set before calling set partition
 		prop->mCollisionWorld = this;
+		this->mSweep.Insert ( *prop );
 	
 		// now activate the prop
 		if ( prop->mOverlapFlags ) {
@@ -468,6 +692,7 @@ void MOAICollisionWorld::MOAIPartition_OnRemoveHull ( MOAIPartitionHull& hull )
 		
 		this->ClearOverlaps ( *prop );
 		this->MakeInactive ( *prop );
+		this->mSweep.Remove ( *prop );
 		prop->mCollisionWorld = 0;
 	}
 }
@@ -6,6 +6,7 @@
 
 #include <moai-sim/MOAIAction.h>
 #include <moai-sim/MOAICollisionProp.h>
+#include <moai-sim/MOAICollisionSweep.h>
 #include <moai-sim/MOAIDrawable.h>
 #include <moai-sim/MOAIDrawShapeRetained.h>
 #include <moai-sim/MOAIOverlap.h>
@@ -14,6 +15,20 @@
 class MOAIPartitionHull;
 class MOAICollisionWorld;
 
+//================================================================//
+// MOAICollisionEvent
+//================================================================//
+class MOAICollisionEvent {
+private:
+
+	friend class MOAICollisionWorld;
+
+	u32						mEventID;
+	MOAICollisionProp*		mProp0;
+	MOAICollisionProp*		mProp1;
+	ZLBounds				mBounds;
+};
+
 //================================================================//
 // MOAICollisionWorld
 //================================================================//
@@ -36,12 +51,29 @@ private:
 	ZLLeanList < MOAIPropOverlap* > mOverlapList;
 	
 	ZLLeanPool < MOAIPropOverlap > mOverlapPool;
+	
+	// pair cache: overlaps hashed on both props and their types, chained
+	// through MOAIPropOverlap::mHashNext. size is always a power of two.
+	ZLLeanArray < MOAIPropOverlap* > mOverlapTable;
+	
+	u32						mBroadphase;
+	MOAICollisionSweep		mSweep;
 
 	MOAILuaStrongRef mCallback;
+	
+	// batched delivery: events are queued for the pass and handed to the
+	// callback in one call, with an iterator over [ mEventCursor, mEventEnd )
+	bool									mBatchEvents;
+	bool									mIsFlushingEvents;
+	ZLLeanStack < MOAICollisionEvent, 64 >	mEvents;
+	u32										mEventCursor;
+	u32										mEventEnd;
 
 	//----------------------------------------------------------------//
 	static int			_insertProp				( lua_State* L );
+	static int			_nextEvent				( lua_State* L );
 	static int			_processOverlaps		( lua_State* L );
+	static int			_setBroadphase			( lua_State* L );
 	static int			_setCallback			( lua_State* L );
 
 	//----------------------------------------------------------------//
@@ -50,12 +82,19 @@ private:
 	void				ClearOverlaps			( MOAICollisionProp& prop );
 	void				DoCallback				( u32 eventID, MOAICollisionProp& prop0, MOAICollisionProp& prop1 );
 	void				DoCallback				( u32 eventID, MOAICollisionProp& prop0, MOAICollisionProp& prop1, const ZLBounds& bounds );
+	MOAIPropOverlap*	FindOverlap				( u32 hash, MOAICollisionProp& prop0, u32 type0, MOAICollisionProp& prop1, u32 type1 );
+	void				FlushEvents				();
+	void				FreeOverlap				( MOAIPropOverlap& overlap );
 	void				HandleOverlap			( MOAICollisionProp& prop0, u32 type0, MOAICollisionProp& prop1, u32 type1, const ZLBounds& bounds );
+	static u32			HashOverlapLink			( const MOAICollisionProp& prop, u32 type );
+	void				InsertOverlap			( MOAIPropOverlap& overlap );
 	void				InvalidateOverlaps		( MOAICollisionProp& prop, u32 nextPass );
 	void				MakeActive				( MOAICollisionProp& prop0 );
 	void				MakeInactive			( MOAICollisionProp& prop0 );
+	void				ProcessOverlap			( MOAICollisionProp& prop, MOAICollisionProp& other, u32 nextPass );
 	void				ProcessOverlaps			();
 	void				PruneOverlaps			( MOAICollisionProp& prop );
+	static u32			PushEvent				( MOAILuaState& state, u32 eventID, MOAICollisionProp& prop0, MOAICollisionProp& prop1, const ZLBounds& bounds );
 	void				Render					();
 	void				RemoveHull				( MOAICollisionProp& prop );
 
@@ -71,6 +110,11 @@ public:
 	
 	DECL_LUA_FACTORY ( MOAICollisionWorld )
 	
+	enum {
+		BROADPHASE_PARTITION,
+		BROADPHASE_SWEEP,
+	};
+	
 	enum {
 		OVERLAP_BEGIN,
 		OVERLAP_END,
@@ -436,3 +436,66 @@ void MOAIGfxStateVertexCache::WriteQuad ( const ZLVec2D* vtx, const ZLVec2D* uv,
 	
 	this->TransformAndWriteQuad ( vtxBuffer, uvBuffer );
 }
+
+//----------------------------------------------------------------//
+void MOAIGfxStateVertexCache::WriteQuadsRaw ( const ZLVec4D* vtx, const ZLVec2D* uv, const u32* colors, u32 totalQuads ) {
+
+	// four vertices and UVs and one color per quad, laid out for XYZWUVC. the vertex
+	// and UV transforms are *not* applied; quads go out in as few prims as will fit.
+
+	struct Vertex {
+		ZLVec4D		mVtx;
+		ZLVec2D		mUV;
+		u32			mColor;
+	};
+
+	MOAIGfxState& gfxState = MOAIGfxMgr::Get ().mGfxState;
+	MOAIVertexFormat* format = gfxState.GetCurrentVtxFormat ();
+	
+	u32 vtxSize = format ? format->GetVertexSize () : 0;
+	if ( vtxSize != sizeof ( Vertex )) return;
+	
+	u32 maxByVtx = ( u32 )( this->mVtxBuffer->GetLength () / ( vtxSize * 4 ));
+	u32 maxByIdx = ( u32 )( this->mIdxBuffer->GetLength () / ( INDEX_SIZE * 6 ));
+	u32 maxQuads = MIN ( maxByVtx, maxByIdx );
+	if ( !maxQuads ) return;
+	
+	Vertex quad [ 4 ];
+	
+	while ( totalQuads ) {
+	
+		u32 count = MIN ( totalQuads, maxQuads );
+	
+		if ( !this->BeginPrim ( ZGL_PRIM_TRIANGLES, count * 4, count * 6 )) return;
+		
+		for ( u32 i = 0; i < count; ++i ) {
+		
+			u32 color = colors [ i ];
+			
+			for ( u32 j = 0; j < 4; ++j ) {
+				quad [ j ].mVtx		= vtx [ j ];
+				quad [ j ].mUV		= uv [ j ];
+				quad [ j ].mColor	= color;
+			}
+			this->mVtxBuffer->WriteBytes ( quad, sizeof ( quad ));
+			
+			u16 base = ( u16 )( i * 4 );
+			
+			this->WriteIndex ( base + 0 ); // left top
+			this->WriteIndex ( base + 3 ); // left bottom
+			this->WriteIndex ( base + 2 ); // right bottom
+		
+			this->WriteIndex ( base + 0 ); // left top
+			this->WriteIndex ( base + 2 ); // right bottom
+			this->WriteIndex ( base + 1 ); // right top
+			
+			vtx += 4;
+			uv += 4;
+		}
+		
+		this->EndPrim ();
+		
+		colors += count;
+		totalQuads -= count;
+	}
+}
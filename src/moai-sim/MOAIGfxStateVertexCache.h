@@ -98,6 +98,7 @@ public:
 	void			WriteQuad						( const ZLVec2D* vtx, const ZLVec2D* uv, float xOff, float yOff, float zOff );
 	void			WriteQuad						( const ZLVec2D* vtx, const ZLVec2D* uv, float xOff, float yOff, float zOff, float xScale, float yScale );
 	void			WriteQuad						( const ZLVec2D* vtx, const ZLVec2D* uv, float xOff, float yOff, float zOff, float xScale, float yScale, float uOff, float vOff, float uScale, float vScale );
+	void			WriteQuadsRaw					( const ZLVec4D* vtx, const ZLVec2D* uv, const u32* colors, u32 totalQuads );
 	
 	//----------------------------------------------------------------//
 	inline void WritePenColor4b () {
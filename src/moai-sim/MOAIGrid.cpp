@@ -246,7 +246,13 @@ int MOAIGrid::_toggleTileFlags ( lua_State* L ) {
 void MOAIGrid::Fill ( u32 value ) {
 
 	this->mTiles.Fill ( value );
-	return;
+	this->LogReset ();
+}
+
+//----------------------------------------------------------------//
+u32 MOAIGrid::GetChangedCell ( u32 version ) const {
+
+	return this->mChangeLog [ version % CHANGE_LOG_SIZE ];
 }
 
 //----------------------------------------------------------------//
@@ -275,7 +281,32 @@ u32 MOAIGrid::GetTile ( int xTile, int yTile ) const {
 }
 
 //----------------------------------------------------------------//
-MOAIGrid::MOAIGrid () {
+// true if every change made after sinceVersion can be read back with
+// GetChangedCell; false if there was a bulk change or the log wrapped
+bool MOAIGrid::IsChangeLogged ( u32 sinceVersion ) const {
+
+	u32 changes = this->mVersion - sinceVersion;
+	return (( changes <= CHANGE_LOG_SIZE ) && ( changes <= ( this->mVersion - this->mResetVersion )));
+}
+
+//----------------------------------------------------------------//
+void MOAIGrid::LogChange ( u32 addr ) {
+
+	this->mVersion++;
+	this->mChangeLog [ this->mVersion % CHANGE_LOG_SIZE ] = addr;
+}
+
+//----------------------------------------------------------------//
+void MOAIGrid::LogReset () {
+
+	this->mVersion++;
+	this->mResetVersion = this->mVersion;
+}
+
+//----------------------------------------------------------------//
+MOAIGrid::MOAIGrid () :
+	mVersion ( 0 ),
+	mResetVersion ( 0 ) {
 	
 	RTTI_SINGLE ( MOAIGridSpace )
 }
@@ -291,6 +322,7 @@ void MOAIGrid::OnResize () {
 
 	this->mTiles.Init ( this->GetTotalCells ());
 	this->mTiles.Fill ( 0 );
+	this->LogReset ();
 }
 
 //----------------------------------------------------------------//
@@ -351,6 +383,8 @@ void MOAIGrid::SerializeIn ( MOAILuaState& state, MOAIDeserializer& serializer )
 	}
 	
 	lua_pop ( state, 1 );
+	
+	this->LogReset ();
 }
 
 //----------------------------------------------------------------//
@@ -377,6 +411,7 @@ void MOAIGrid::SetTile ( int addr, u32 tile ) {
 	if ( size ) {
 		addr = addr % size;
 		this->mTiles [ addr ] = tile;
+		this->LogChange ( addr );
 	}
 }
 
@@ -389,6 +424,7 @@ void MOAIGrid::SetTile ( int xTile, int yTile, u32 tile ) {
 		u32 addr = this->GetCellAddr ( coord );
 		if ( addr < this->mTiles.Size ()) {
 			this->mTiles [ addr ] = tile;
+			this->LogChange ( addr );
 		}
 	}
 }
@@ -399,7 +435,9 @@ size_t MOAIGrid::StreamTilesIn ( ZLStream* stream ) {
 	if ( !stream ) return 0;
 	
 	size_t size = this->mTiles.Size () * sizeof ( u32 );
-	return stream->ReadBytes ( this->mTiles, size );
+	size = stream->ReadBytes ( this->mTiles, size );
+	this->LogReset ();
+	return size;
 }
 
 //----------------------------------------------------------------//
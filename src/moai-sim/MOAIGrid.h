@@ -20,8 +20,15 @@ class MOAIGrid :
 	public MOAIGridSpace {
 private:
 
+	static const u32 CHANGE_LOG_SIZE = 1024;
+
 	ZLLeanArray < u32 >			mTiles; // TODO: fix size
 
+	// lets dependents (e.g. path hierarchies) repair only what changed
+	u32							mVersion;
+	u32							mResetVersion;
+	u32							mChangeLog [ CHANGE_LOG_SIZE ];
+
 	//----------------------------------------------------------------//
 	static int		_clearTileFlags		( lua_State* L );
 	static int		_fill				( lua_State* L );
@@ -37,16 +44,22 @@ private:
 protected:
 
 	//----------------------------------------------------------------//
+	void			LogChange			( u32 addr );
+	void			LogReset			();
 	void			OnResize			();
 
 public:
 	
 	DECL_LUA_FACTORY ( MOAIGrid )
 	
+	GET_CONST ( u32, Version, mVersion )
+	
 	//----------------------------------------------------------------//
 	void			Fill				( u32 value );
+	u32				GetChangedCell		( u32 version ) const;
 	u32				GetTile				( int addr ) const;
 	u32				GetTile				( int xTile, int yTile ) const;
+	bool			IsChangeLogged		( u32 sinceVersion ) const;
 					MOAIGrid			();
 					~MOAIGrid			();
 	void			RegisterLuaClass	( MOAILuaState& state );
@@ -26,6 +26,24 @@ public:
 // local
 //================================================================//
 
+//----------------------------------------------------------------//
+/**	@lua	setClusterSize
+	@text	Set the cluster size used by the HIERARCHICAL search mode.
+			Forces the hierarchy to be rebuilt on next use.
+
+	@in		MOAIGridPathGraph self
+	@opt	number size						Default value is 16.
+	@out	nil
+*/
+int MOAIGridPathGraph::_setClusterSize ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIGridPathGraph, "U" )
+
+	self->mClusterSize = MAX ( 1, state.GetValue < int >( 2, DEFAULT_CLUSTER_SIZE ));
+	self->mHierarchyValid = false;
+	
+	return 0;
+}
+
 //----------------------------------------------------------------//
 /**	@lua	setGrid
 	@text	Set graph data to use for pathfinding. 
@@ -47,6 +65,48 @@ int MOAIGridPathGraph::_setGrid ( lua_State* L ) {
 // MOAIGridPathGraph
 //================================================================//
 
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::AffirmHierarchy ( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, bool diagonals ) {
+
+	MOAIGrid& grid = *this->mGrid;
+	
+	int width = grid.GetWidth ();
+	int height = grid.GetHeight ();
+	
+	bool rebuild = (
+		!this->mHierarchyValid ||
+		!this->mHierarchy.IsMatch ( width, height, this->mClusterSize, params.mHCost, params.mVCost, params.mDCost, diagonals ) ||
+		( this->mHierarchyMask != pathFinder.GetMask ()) ||
+		( this->mHierarchyDeck != pathFinder.GetTerrainDeck ()) ||
+		!grid.IsChangeLogged ( this->mHierarchyVersion )
+	);
+	
+	if ( rebuild ) {
+	
+		this->mHierarchy.Init ( width, height, this->mClusterSize, params.mHCost, params.mVCost, params.mDCost, diagonals );
+		
+		int totalCells = grid.GetTotalCells ();
+		for ( int addr = 0; addr < totalCells; ++addr ) {
+			this->mHierarchy.SetPassable ( addr, pathFinder.CheckMask ( grid.GetTile ( addr )));
+		}
+		
+		this->mHierarchyValid = true;
+		this->mHierarchyMask = pathFinder.GetMask ();
+		this->mHierarchyDeck = pathFinder.GetTerrainDeck ();
+	}
+	else {
+	
+		// replay only the tiles changed since the last query
+		for ( u32 version = this->mHierarchyVersion; version != grid.GetVersion (); ) {
+			u32 addr = grid.GetChangedCell ( ++version );
+			this->mHierarchy.SetPassable (( int )addr, pathFinder.CheckMask ( grid.GetTile (( int )addr )));
+		}
+	}
+	
+	this->mHierarchyVersion = grid.GetVersion ();
+	this->mHierarchy.Update ();
+}
+
 //----------------------------------------------------------------//
 float MOAIGridPathGraph::ComputeHeuristic ( MOAIGridPathGraphParams& params, const MOAICellCoord& c0, const MOAICellCoord& c1 ) {
 
@@ -78,7 +138,90 @@ float MOAIGridPathGraph::ComputeHeuristic ( MOAIGridPathGraphParams& params, con
 }
 
 //----------------------------------------------------------------//
-MOAIGridPathGraph::MOAIGridPathGraph () {
+u32 MOAIGridPathGraph::GetNodeCount () {
+
+	return this->mGrid ? ( u32 )this->mGrid->GetTotalCells () : 0;
+}
+
+//----------------------------------------------------------------//
+u32 MOAIGridPathGraph::GetSearchMode ( MOAIPathFinder& pathFinder ) {
+
+	if ( !this->mGrid || ( this->mGrid->GetShape () != MOAIGridSpace::RECT_SHAPE )) return DEFAULT_SEARCH;
+	
+	// jump points and cluster distances both assume uniform move costs
+	if ( pathFinder.GetTerrainDeck () && pathFinder.GetWeights ().Size ()) return DEFAULT_SEARCH;
+	
+	u32 flags = pathFinder.GetFlags ();
+	
+	if ( flags & HIERARCHICAL ) return HIERARCHICAL_SEARCH;
+	if (( flags & JUMP_POINTS ) && !( flags & NO_DIAGONALS )) return JUMP_POINT_SEARCH;
+	
+	return DEFAULT_SEARCH;
+}
+
+//----------------------------------------------------------------//
+bool MOAIGridPathGraph::IsOpen ( MOAIPathFinder& pathFinder, int xTile, int yTile ) {
+
+	MOAICellCoord coord ( xTile, yTile );
+	return this->mGrid->IsValidCoord ( coord ) && pathFinder.CheckMask ( this->mGrid->GetTile ( xTile, yTile ));
+}
+
+//----------------------------------------------------------------//
+// steps from ( xTile, yTile ) in direction ( dx, dy ) until it finds a jump
+// point (the target, or a cell with a forced neighbor); returns false if it
+// runs into a wall first
+bool MOAIGridPathGraph::Jump ( MOAIPathFinder& pathFinder, int targetID, int& xTile, int& yTile, int dx, int dy ) {
+
+	for ( ;; ) {
+	
+		xTile += dx;
+		yTile += dy;
+		
+		int x = xTile;
+		int y = yTile;
+		
+		if ( !this->IsOpen ( pathFinder, x, y )) return false;
+		if ( this->mGrid->GetCellAddr ( x, y ) == targetID ) return true;
+		
+		if ( dx && dy ) {
+		
+			if (( !this->IsOpen ( pathFinder, x - dx, y ) && this->IsOpen ( pathFinder, x - dx, y + dy )) ||
+				( !this->IsOpen ( pathFinder, x, y - dy ) && this->IsOpen ( pathFinder, x + dx, y - dy ))) {
+				return true;
+			}
+			
+			int sx = x;
+			int sy = y;
+			if ( this->Jump ( pathFinder, targetID, sx, sy, dx, 0 )) return true;
+			
+			sx = x;
+			sy = y;
+			if ( this->Jump ( pathFinder, targetID, sx, sy, 0, dy )) return true;
+		}
+		else if ( dx ) {
+		
+			if (( !this->IsOpen ( pathFinder, x, y + 1 ) && this->IsOpen ( pathFinder, x + dx, y + 1 )) ||
+				( !this->IsOpen ( pathFinder, x, y - 1 ) && this->IsOpen ( pathFinder, x + dx, y - 1 ))) {
+				return true;
+			}
+		}
+		else {
+		
+			if (( !this->IsOpen ( pathFinder, x + 1, y ) && this->IsOpen ( pathFinder, x + 1, y + dy )) ||
+				( !this->IsOpen ( pathFinder, x - 1, y ) && this->IsOpen ( pathFinder, x - 1, y + dy ))) {
+				return true;
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+MOAIGridPathGraph::MOAIGridPathGraph () :
+	mHierarchyValid ( false ),
+	mClusterSize ( DEFAULT_CLUSTER_SIZE ),
+	mHierarchyVersion ( 0 ),
+	mHierarchyMask ( 0 ),
+	mHierarchyDeck ( 0 ) {
 	
 	RTTI_SINGLE ( MOAIGridPathGraph )
 }
@@ -89,6 +232,149 @@ MOAIGridPathGraph::~MOAIGridPathGraph () {
 	this->SetGrid ( 0 );
 }
 
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::PushHierarchyNeighbors ( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, int nodeID, bool diagonals ) {
+
+	this->AffirmHierarchy ( pathFinder, params, diagonals );
+	
+	MOAIGridPathHierarchy& hierarchy = this->mHierarchy;
+	
+	int targetID = pathFinder.GetTargetNodeID ();
+	bool targetInCluster = (
+		( targetID >= 0 ) &&
+		( targetID < this->mGrid->GetTotalCells ()) &&
+		hierarchy.IsPassable ( targetID ) &&
+		( hierarchy.GetClusterID ( targetID ) == hierarchy.GetClusterID ( nodeID ))
+	);
+	
+	if ( pathFinder.GetParentNodeID ( nodeID ) < 0 ) {
+	
+		// the start cell isn't part of the abstract graph; link it to its cluster's entrances
+		hierarchy.SearchFrom ( nodeID );
+		
+		const MOAIGridPathCluster& cluster = hierarchy.GetCluster ( hierarchy.GetClusterID ( nodeID ));
+		size_t totalEntrances = cluster.mEntrances.GetTop ();
+		
+		for ( size_t i = 0; i < totalEntrances; ++i ) {
+			int entranceID = cluster.mEntrances [ i ].mNodeID;
+			float dist = hierarchy.GetDistance ( entranceID );
+			if (( entranceID != nodeID ) && ( dist < FLT_MAX )) {
+				this->PushWaypoint ( pathFinder, params, entranceID, dist );
+			}
+		}
+		
+		if ( targetInCluster ) {
+			float dist = hierarchy.GetDistance ( targetID );
+			if ( dist < FLT_MAX ) {
+				this->PushWaypoint ( pathFinder, params, targetID, dist );
+			}
+		}
+	}
+	else if ( targetInCluster ) {
+	
+		float dist = hierarchy.GetGoalDistance ( targetID, nodeID );
+		if ( dist < FLT_MAX ) {
+			this->PushWaypoint ( pathFinder, params, targetID, dist );
+		}
+	}
+	
+	const MOAIGridPathEdge* edges = 0;
+	u32 totalEdges = hierarchy.GetEdges ( nodeID, edges );
+	
+	for ( u32 i = 0; i < totalEdges; ++i ) {
+		this->PushWaypoint ( pathFinder, params, edges [ i ].mNodeID, edges [ i ].mCost );
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::PushJumpPoints ( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, int nodeID ) {
+
+	MOAICellCoord coord = this->mGrid->GetCellCoord ( nodeID );
+	
+	int x = coord.mX;
+	int y = coord.mY;
+	
+	int dirs [ 8 ][ 2 ];
+	u32 totalDirs = 0;
+	
+	int parentID = pathFinder.GetParentNodeID ( nodeID );
+	
+	if ( parentID < 0 ) {
+	
+		for ( int dy = -1; dy <= 1; ++dy ) {
+			for ( int dx = -1; dx <= 1; ++dx ) {
+				if ( dx || dy ) {
+					dirs [ totalDirs ][ 0 ] = dx;
+					dirs [ totalDirs++ ][ 1 ] = dy;
+				}
+			}
+		}
+	}
+	else {
+	
+		// prune to the natural and forced neighbors for the direction of travel
+		MOAICellCoord parent = this->mGrid->GetCellCoord ( parentID );
+		
+		int dx = ( x > parent.mX ) - ( x < parent.mX );
+		int dy = ( y > parent.mY ) - ( y < parent.mY );
+		
+		if ( dx && dy ) {
+		
+			dirs [ totalDirs ][ 0 ] = dx;	dirs [ totalDirs++ ][ 1 ] = 0;
+			dirs [ totalDirs ][ 0 ] = 0;	dirs [ totalDirs++ ][ 1 ] = dy;
+			dirs [ totalDirs ][ 0 ] = dx;	dirs [ totalDirs++ ][ 1 ] = dy;
+			
+			if ( !this->IsOpen ( pathFinder, x - dx, y ) && this->IsOpen ( pathFinder, x - dx, y + dy )) {
+				dirs [ totalDirs ][ 0 ] = -dx;	dirs [ totalDirs++ ][ 1 ] = dy;
+			}
+			if ( !this->IsOpen ( pathFinder, x, y - dy ) && this->IsOpen ( pathFinder, x + dx, y - dy )) {
+				dirs [ totalDirs ][ 0 ] = dx;	dirs [ totalDirs++ ][ 1 ] = -dy;
+			}
+		}
+		else if ( dx ) {
+		
+			dirs [ totalDirs ][ 0 ] = dx;	dirs [ totalDirs++ ][ 1 ] = 0;
+			
+			if ( !this->IsOpen ( pathFinder, x, y + 1 ) && this->IsOpen ( pathFinder, x + dx, y + 1 )) {
+				dirs [ totalDirs ][ 0 ] = dx;	dirs [ totalDirs++ ][ 1 ] = 1;
+			}
+			if ( !this->IsOpen ( pathFinder, x, y - 1 ) && this->IsOpen ( pathFinder, x + dx, y - 1 )) {
+				dirs [ totalDirs ][ 0 ] = dx;	dirs [ totalDirs++ ][ 1 ] = -1;
+			}
+		}
+		else {
+		
+			dirs [ totalDirs ][ 0 ] = 0;	dirs [ totalDirs++ ][ 1 ] = dy;
+			
+			if ( !this->IsOpen ( pathFinder, x + 1, y ) && this->IsOpen ( pathFinder, x + 1, y + dy )) {
+				dirs [ totalDirs ][ 0 ] = 1;	dirs [ totalDirs++ ][ 1 ] = dy;
+			}
+			if ( !this->IsOpen ( pathFinder, x - 1, y ) && this->IsOpen ( pathFinder, x - 1, y + dy )) {
+				dirs [ totalDirs ][ 0 ] = -1;	dirs [ totalDirs++ ][ 1 ] = dy;
+			}
+		}
+	}
+	
+	int targetID = pathFinder.GetTargetNodeID ();
+	
+	for ( u32 i = 0; i < totalDirs; ++i ) {
+	
+		int dx = dirs [ i ][ 0 ];
+		int dy = dirs [ i ][ 1 ];
+		
+		int jx = x;
+		int jy = y;
+		
+		if ( this->Jump ( pathFinder, targetID, jx, jy, dx, dy )) {
+		
+			int steps = MAX ( abs ( jx - x ), abs ( jy - y ));
+			float moveCost = ( dx && dy ) ? params.mDCost : ( dx ? params.mHCost : params.mVCost );
+			
+			this->PushWaypoint ( pathFinder, params, this->mGrid->GetCellAddr ( jx, jy ), steps * moveCost );
+		}
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIGridPathGraph::PushNeighbor ( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, u32 tile0, int xTile, int yTile, float moveCost ) {
 
@@ -147,6 +433,18 @@ void MOAIGridPathGraph::PushNeighbors ( MOAIPathFinder& pathFinder, int nodeID )
 			params.mDCost = sqrtf (( params.mHCost * params.mHCost ) + ( params.mVCost * params.mVCost ));
 			params.mZCost = 0.0f;
 			
+			u32 mode = this->GetSearchMode ( pathFinder );
+			
+			if ( mode == HIERARCHICAL_SEARCH ) {
+				this->PushHierarchyNeighbors ( pathFinder, params, nodeID, ( flags & NO_DIAGONALS ) == 0 );
+				break;
+			}
+			
+			if ( mode == JUMP_POINT_SEARCH ) {
+				this->PushJumpPoints ( pathFinder, params, nodeID );
+				break;
+			}
+			
 			this->PushNeighbor ( pathFinder, params, tile0, xTile - 1, yTile, params.mHCost );
 			this->PushNeighbor ( pathFinder, params, tile0, xTile + 1, yTile, params.mHCost );
 			this->PushNeighbor ( pathFinder, params, tile0, xTile, yTile + 1, params.mVCost );
@@ -241,6 +539,64 @@ void MOAIGridPathGraph::PushNeighbors ( MOAIPathFinder& pathFinder, int nodeID )
 	}
 }
 
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::PushWaypoint ( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, int nodeID, float cost ) {
+
+	if ( pathFinder.IsVisited ( nodeID )) return;
+	
+	MOAICellCoord coord = this->mGrid->GetCellCoord ( nodeID );
+	MOAICellCoord targetCoord = this->mGrid->GetCellCoord ( pathFinder.GetTargetNodeID ());
+	
+	float g = cost * params.mGWeight;
+	float h = this->ComputeHeuristic ( params, coord, targetCoord ) * params.mHWeight;
+	
+	pathFinder.PushState ( nodeID, g, h );
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathGraph::RefinePath ( MOAIPathFinder& pathFinder, ZLLeanArray < int >& path ) {
+
+	u32 mode = this->GetSearchMode ( pathFinder );
+	if (( mode == DEFAULT_SEARCH ) || ( path.Size () < 2 )) return;
+	
+	ZLLeanStack < int > refined;
+	refined.Push () = path [ 0 ];
+	
+	for ( size_t i = 1; i < path.Size (); ++i ) {
+	
+		int from = path [ i - 1 ];
+		int to = path [ i ];
+		
+		if ( mode == HIERARCHICAL_SEARCH ) {
+		
+			// consecutive waypoints share a cluster unless they're a one-step border crossing
+			if ( !this->mHierarchy.BuildSubpath ( from, to, refined )) {
+				refined.Push () = to;
+			}
+		}
+		else {
+		
+			// jump point segments are straight or diagonal
+			MOAICellCoord c0 = this->mGrid->GetCellCoord ( from );
+			MOAICellCoord c1 = this->mGrid->GetCellCoord ( to );
+			
+			int dx = ( c1.mX > c0.mX ) - ( c1.mX < c0.mX );
+			int dy = ( c1.mY > c0.mY ) - ( c1.mY < c0.mY );
+			
+			while (( c0.mX != c1.mX ) || ( c0.mY != c1.mY )) {
+				if ( c0.mX != c1.mX ) c0.mX += dx;
+				if ( c0.mY != c1.mY ) c0.mY += dy;
+				refined.Push () = this->mGrid->GetCellAddr ( c0 );
+			}
+		}
+	}
+	
+	path.Init ( refined.GetTop ());
+	for ( size_t i = 0; i < refined.GetTop (); ++i ) {
+		path [ i ] = refined [ i ];
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIGridPathGraph::RegisterLuaClass ( MOAILuaState& state ) {
 
@@ -249,6 +605,8 @@ void MOAIGridPathGraph::RegisterLuaClass ( MOAILuaState& state ) {
 	state.SetField ( -1, "EUCLIDEAN_DISTANCE", ( u32 )EUCLIDEAN_DISTANCE );
 	
 	state.SetField ( -1, "NO_DIAGONALS", ( u32 )NO_DIAGONALS );
+	state.SetField ( -1, "JUMP_POINTS", ( u32 )JUMP_POINTS );
+	state.SetField ( -1, "HIERARCHICAL", ( u32 )HIERARCHICAL );
 }
 
 //----------------------------------------------------------------//
@@ -256,6 +614,7 @@ void MOAIGridPathGraph::RegisterLuaFuncs ( MOAILuaState& state ) {
 	MOAIPathGraph::RegisterLuaFuncs ( state );
 	
 	luaL_Reg regTable [] = {
+		{ "setClusterSize",		_setClusterSize },
 		{ "setGrid",			_setGrid },
 		{ NULL, NULL }
 	};
@@ -267,4 +626,5 @@ void MOAIGridPathGraph::RegisterLuaFuncs ( MOAILuaState& state ) {
 void MOAIGridPathGraph::SetGrid ( MOAIGrid* grid ) {
 
 	this->mGrid.Set ( *this, grid );
+	this->mHierarchyValid = false;
 }
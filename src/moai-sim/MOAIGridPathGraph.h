@@ -5,16 +5,30 @@
 #define	MOAIGRIDPATHGRAPH_H
 
 #include <moai-sim/MOAIGrid.h>
+#include <moai-sim/MOAIGridPathHierarchy.h>
 #include <moai-sim/MOAIPathGraph.h>
 
 class MOAIGridPathGraphParams;
 class MOAIPathFinder;
+class MOAIPathTerrainDeck;
 
 //================================================================//
 // MOAIGridPathGraph
 //================================================================//
 /**	@lua	MOAIGridPathGraph
 	@text	Pathfinder graph adapter for MOAIGrid.
+	
+			On rectangular grids without terrain weights, two faster
+			search modes may be selected with MOAIPathFinder.setFlags ():
+			JUMP_POINTS (Jump Point Search; requires diagonals) and
+			HIERARCHICAL (HPA* over clusters of cells). The hierarchy is
+			built on first use and repaired per cluster as tiles change.
+			HIERARCHICAL paths are near-optimal, not optimal. Both modes
+			return the same contiguous cell paths as the default search.
+	
+	@const	NO_DIAGONALS
+	@const	JUMP_POINTS
+	@const	HIERARCHICAL
 */
 class MOAIGridPathGraph :
 	public MOAIPathGraph {
@@ -28,15 +42,40 @@ private:
 		D_MOVE_COST,
 	};
 
+	enum {
+		DEFAULT_SEARCH,
+		JUMP_POINT_SEARCH,
+		HIERARCHICAL_SEARCH,
+	};
+
+	static const int DEFAULT_CLUSTER_SIZE = 16;
+
 	MOAILuaSharedPtr < MOAIGrid > mGrid;
 
+	MOAIGridPathHierarchy	mHierarchy;
+	bool					mHierarchyValid;
+	int						mClusterSize;
+	u32						mHierarchyVersion;		// grid version the hierarchy reflects
+	u32						mHierarchyMask;
+	MOAIPathTerrainDeck*	mHierarchyDeck;			// for comparison only
+
 	//----------------------------------------------------------------//
+	static int		_setClusterSize				( lua_State* L );
 	static int		_setGrid					( lua_State* L );
 
 	//----------------------------------------------------------------//
+	void			AffirmHierarchy				( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, bool diagonals );
 	float			ComputeHeuristic			( MOAIGridPathGraphParams& params, const MOAICellCoord& c0, const MOAICellCoord& c1 );
+	u32				GetNodeCount				();
+	u32				GetSearchMode				( MOAIPathFinder& pathFinder );
+	bool			IsOpen						( MOAIPathFinder& pathFinder, int xTile, int yTile );
+	bool			Jump						( MOAIPathFinder& pathFinder, int targetID, int& xTile, int& yTile, int dx, int dy );
+	void			PushHierarchyNeighbors		( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, int nodeID, bool diagonals );
+	void			PushJumpPoints				( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, int nodeID );
 	void			PushNeighbor				( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, u32 tile0, int xTile, int yTile, float moveCost );
 	void			PushNeighbors				( MOAIPathFinder& pathFinder, int nodeID );
+	void			PushWaypoint				( MOAIPathFinder& pathFinder, MOAIGridPathGraphParams& params, int nodeID, float cost );
+	void			RefinePath					( MOAIPathFinder& pathFinder, ZLLeanArray < int >& path );
 
 public:
 	
@@ -46,10 +85,14 @@ public:
 		DIAGONAL_DISTANCE,
 	};
 	
-	static const u32 NO_DIAGONALS = 0x00000001;
+	static const u32 NO_DIAGONALS	= 0x00000001;
+	static const u32 JUMP_POINTS	= 0x00000002;
+	static const u32 HIERARCHICAL	= 0x00000004;
 	
 	DECL_LUA_FACTORY ( MOAIGridPathGraph )
 	
+	GET ( MOAIGrid*, Grid, mGrid )
+	
 	//----------------------------------------------------------------//
 					MOAIGridPathGraph			();
 					~MOAIGridPathGraph			();
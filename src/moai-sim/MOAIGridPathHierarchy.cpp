@@ -0,0 +1,504 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#include <moai-sim/MOAIGridPathHierarchy.h>
+
+//================================================================//
+// local
+//================================================================//
+
+static const int sMoves [ 8 ][ 2 ] = {
+	{ -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 },
+	{ -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 },
+};
+
+//================================================================//
+// MOAIGridPathSearchEntry
+//================================================================//
+
+//----------------------------------------------------------------//
+MOAIGridPathSearchEntry MOAIGridPathSearchEntry::HeapPop ( ZLLeanStack < MOAIGridPathSearchEntry >& heap ) {
+
+	MOAIGridPathSearchEntry* data = heap.Data ();
+	MOAIGridPathSearchEntry top = data [ 0 ];
+	MOAIGridPathSearchEntry last = heap.Pop ();
+
+	size_t size = heap.GetTop ();
+	if ( size ) {
+
+		size_t index = 0;
+		for ( size_t child = 1; child < size; child = ( index << 1 ) + 1 ) {
+			if ((( child + 1 ) < size ) && ( data [ child + 1 ].mDist < data [ child ].mDist )) {
+				child++;
+			}
+			if ( last.mDist <= data [ child ].mDist ) break;
+			data [ index ] = data [ child ];
+			index = child;
+		}
+		data [ index ] = last;
+	}
+	return top;
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathSearchEntry::HeapPush ( ZLLeanStack < MOAIGridPathSearchEntry >& heap, float dist, u32 idx ) {
+
+	heap.Push ();
+	MOAIGridPathSearchEntry* data = heap.Data ();
+
+	size_t index = heap.GetTop () - 1;
+	while ( index ) {
+		size_t parent = ( index - 1 ) >> 1;
+		if ( data [ parent ].mDist <= dist ) break;
+		data [ index ] = data [ parent ];
+		index = parent;
+	}
+	data [ index ].mDist = dist;
+	data [ index ].mIndex = idx;
+}
+
+//================================================================//
+// MOAIGridPathHierarchy
+//================================================================//
+
+//----------------------------------------------------------------//
+bool MOAIGridPathHierarchy::BuildSubpath ( int from, int to, ZLLeanStack < int >& path ) {
+
+	if ( this->GetClusterID ( from ) != this->GetClusterID ( to )) return false;
+
+	if ( this->mSearchID != from ) {
+		this->SearchFrom ( from );
+	}
+
+	u32 idx = this->GetLocalIndex ( to );
+	if ( this->mDist [ idx ] == FLT_MAX ) return false;
+
+	u32 start = this->GetLocalIndex ( from );
+
+	size_t size = 0;
+	for ( u32 cursor = idx; cursor != start; cursor = this->mParent [ cursor ], ++size );
+
+	int x0 = (( from % this->mWidth ) / this->mClusterSize ) * this->mClusterSize;
+	int y0 = (( from / this->mWidth ) / this->mClusterSize ) * this->mClusterSize;
+
+	size_t base = path.GetTop ();
+	path.SetTop ( base + size );
+
+	for ( u32 cursor = idx; cursor != start; cursor = this->mParent [ cursor ]) {
+		int x = x0 + ( int )( cursor % this->mClusterSize );
+		int y = y0 + ( int )( cursor / this->mClusterSize );
+		path [ base + ( --size )] = ( y * this->mWidth ) + x;
+	}
+	return true;
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathHierarchy::Clear () {
+
+	this->mWidth = 0;
+	this->mHeight = 0;
+	this->mClustersWide = 0;
+	this->mClustersHigh = 0;
+
+	this->mPassable.Clear ();
+	this->mClusters.Clear ();
+	this->mDirty.Reset ();
+
+	this->mSearchID = -1;
+	this->mGoalID = -1;
+}
+
+//----------------------------------------------------------------//
+const MOAIGridPathCluster& MOAIGridPathHierarchy::GetCluster ( u32 clusterID ) const {
+
+	return this->mClusters [ clusterID ];
+}
+
+//----------------------------------------------------------------//
+u32 MOAIGridPathHierarchy::GetClusterID ( int addr ) const {
+
+	int x = addr % this->mWidth;
+	int y = addr / this->mWidth;
+	return ( u32 )((( y / this->mClusterSize ) * this->mClustersWide ) + ( x / this->mClusterSize ));
+}
+
+//----------------------------------------------------------------//
+float MOAIGridPathHierarchy::GetDistance ( int addr ) const {
+
+	if (( this->mSearchID < 0 ) || ( this->GetClusterID ( addr ) != this->GetClusterID ( this->mSearchID ))) return FLT_MAX;
+	return this->mDist [ this->GetLocalIndex ( addr )];
+}
+
+//----------------------------------------------------------------//
+u32 MOAIGridPathHierarchy::GetEdges ( int addr, const MOAIGridPathEdge*& edges ) const {
+
+	const MOAIGridPathCluster& cluster = this->mClusters [ this->GetClusterID ( addr )];
+
+	size_t totalEntrances = cluster.mEntrances.GetTop ();
+	for ( size_t i = 0; i < totalEntrances; ++i ) {
+		const MOAIGridPathEntrance& entrance = cluster.mEntrances [ i ];
+		if ( entrance.mNodeID == addr ) {
+			edges = &cluster.mEdges [ entrance.mBase ];
+			return entrance.mTotal;
+		}
+	}
+	return 0;
+}
+
+//----------------------------------------------------------------//
+float MOAIGridPathHierarchy::GetGoalDistance ( int goal, int addr ) {
+
+	if ( this->GetClusterID ( addr ) != this->GetClusterID ( goal )) return FLT_MAX;
+
+	// costs are symmetric, so one search from the goal serves every entrance
+	if ( this->mGoalID != goal ) {
+		this->Search ( goal, this->mGoalDist, 0 );
+		this->mGoalID = goal;
+	}
+	return this->mGoalDist [ this->GetLocalIndex ( addr )];
+}
+
+//----------------------------------------------------------------//
+u32 MOAIGridPathHierarchy::GetLocalIndex ( int addr ) const {
+
+	int x = addr % this->mWidth;
+	int y = addr / this->mWidth;
+	return ( u32 )((( y % this->mClusterSize ) * this->mClusterSize ) + ( x % this->mClusterSize ));
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathHierarchy::Init ( int width, int height, int clusterSize, float hCost, float vCost, float dCost, bool diagonals ) {
+
+	this->Clear ();
+
+	if (( width <= 0 ) || ( height <= 0 ) || ( clusterSize <= 0 )) return;
+
+	this->mWidth = width;
+	this->mHeight = height;
+	this->mClusterSize = clusterSize;
+	this->mClustersWide = ( width + clusterSize - 1 ) / clusterSize;
+	this->mClustersHigh = ( height + clusterSize - 1 ) / clusterSize;
+
+	this->mHCost = hCost;
+	this->mVCost = vCost;
+	this->mDCost = dCost;
+	this->mDiagonals = diagonals;
+
+	this->mPassable.Init ( width * height );
+	this->mPassable.Fill ( 0 );
+
+	u32 totalClusters = ( u32 )( this->mClustersWide * this->mClustersHigh );
+	this->mClusters.Init ( totalClusters );
+
+	for ( u32 i = 0; i < totalClusters; ++i ) {
+		this->mClusters [ i ].mIsDirty = true;
+		this->mDirty.Push ( i );
+	}
+
+	u32 clusterCells = ( u32 )( clusterSize * clusterSize );
+	this->mDist.Init ( clusterCells );
+	this->mParent.Init ( clusterCells );
+	this->mGoalDist.Init ( clusterCells );
+}
+
+//----------------------------------------------------------------//
+bool MOAIGridPathHierarchy::IsMatch ( int width, int height, int clusterSize, float hCost, float vCost, float dCost, bool diagonals ) const {
+
+	return (
+		( this->mWidth == width ) &&
+		( this->mHeight == height ) &&
+		( this->mClusterSize == clusterSize ) &&
+		( this->mHCost == hCost ) &&
+		( this->mVCost == vCost ) &&
+		( this->mDCost == dCost ) &&
+		( this->mDiagonals == diagonals )
+	);
+}
+
+//----------------------------------------------------------------//
+bool MOAIGridPathHierarchy::IsPassable ( int addr ) const {
+
+	return this->mPassable [ addr ] != 0;
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathHierarchy::MarkDirty ( int x, int y ) {
+
+	// a cell on a cluster border also changes the entrances of its neighbors
+	for ( int dy = -1; dy <= 1; ++dy ) {
+		for ( int dx = -1; dx <= 1; ++dx ) {
+
+			int nx = x + dx;
+			int ny = y + dy;
+
+			if (( nx < 0 ) || ( ny < 0 ) || ( nx >= this->mWidth ) || ( ny >= this->mHeight )) continue;
+
+			u32 clusterID = this->GetClusterID (( ny * this->mWidth ) + nx );
+			MOAIGridPathCluster& cluster = this->mClusters [ clusterID ];
+
+			if ( !cluster.mIsDirty ) {
+				cluster.mIsDirty = true;
+				this->mDirty.Push ( clusterID );
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+MOAIGridPathHierarchy::MOAIGridPathHierarchy () :
+	mWidth ( 0 ),
+	mHeight ( 0 ),
+	mClusterSize ( 0 ),
+	mClustersWide ( 0 ),
+	mClustersHigh ( 0 ),
+	mHCost ( 0.0f ),
+	mVCost ( 0.0f ),
+	mDCost ( 0.0f ),
+	mDiagonals ( true ),
+	mSearchID ( -1 ),
+	mGoalID ( -1 ) {
+}
+
+//----------------------------------------------------------------//
+MOAIGridPathHierarchy::~MOAIGridPathHierarchy () {
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathHierarchy::RebuildCluster ( u32 clusterID ) {
+
+	MOAIGridPathCluster& cluster = this->mClusters [ clusterID ];
+
+	cluster.mEntrances.Reset ();
+	cluster.mEdges.Reset ();
+	cluster.mIsDirty = false;
+
+	this->mTransitions.Reset ();
+
+	int x0 = ( int )( clusterID % this->mClustersWide ) * this->mClusterSize;
+	int y0 = ( int )( clusterID / this->mClustersWide ) * this->mClusterSize;
+	int x1 = MIN ( x0 + this->mClusterSize, this->mWidth );
+	int y1 = MIN ( y0 + this->mClusterSize, this->mHeight );
+
+	int width = x1 - x0;
+	int height = y1 - y0;
+
+	if ( x0 > 0 )				this->ScanBorder ( x0, y0, 0, 1, height, -1, 0, this->mHCost );
+	if ( x1 < this->mWidth )	this->ScanBorder ( x1 - 1, y0, 0, 1, height, 1, 0, this->mHCost );
+	if ( y0 > 0 )				this->ScanBorder ( x0, y0, 1, 0, width, 0, -1, this->mVCost );
+	if ( y1 < this->mHeight )	this->ScanBorder ( x0, y1 - 1, 1, 0, width, 0, 1, this->mVCost );
+
+	if ( this->mDiagonals ) {
+		if (( x0 > 0 ) && ( y0 > 0 ))								this->ScanBorder ( x0, y0, 0, 0, 1, -1, -1, this->mDCost );
+		if (( x1 < this->mWidth ) && ( y0 > 0 ))					this->ScanBorder ( x1 - 1, y0, 0, 0, 1, 1, -1, this->mDCost );
+		if (( x0 > 0 ) && ( y1 < this->mHeight ))					this->ScanBorder ( x0, y1 - 1, 0, 0, 1, -1, 1, this->mDCost );
+		if (( x1 < this->mWidth ) && ( y1 < this->mHeight ))		this->ScanBorder ( x1 - 1, y1 - 1, 0, 0, 1, 1, 1, this->mDCost );
+	}
+
+	size_t totalTransitions = this->mTransitions.GetTop ();
+
+	// a corner cell may cross more than one border; give it a single entrance
+	for ( size_t i = 0; i < totalTransitions; ++i ) {
+
+		int nodeID = this->mTransitions [ i ].mFrom;
+
+		size_t j = 0;
+		for ( ; j < cluster.mEntrances.GetTop (); ++j ) {
+			if ( cluster.mEntrances [ j ].mNodeID == nodeID ) break;
+		}
+		if ( j == cluster.mEntrances.GetTop ()) {
+			cluster.mEntrances.Push ().mNodeID = nodeID;
+		}
+	}
+
+	size_t totalEntrances = cluster.mEntrances.GetTop ();
+
+	for ( size_t i = 0; i < totalEntrances; ++i ) {
+
+		int nodeID = cluster.mEntrances [ i ].mNodeID;
+		u32 base = ( u32 )cluster.mEdges.GetTop ();
+
+		for ( size_t j = 0; j < totalTransitions; ++j ) {
+			const MOAIGridPathTransition& transition = this->mTransitions [ j ];
+			if ( transition.mFrom == nodeID ) {
+				MOAIGridPathEdge& edge = cluster.mEdges.Push ();
+				edge.mNodeID = transition.mTo;
+				edge.mCost = transition.mCost;
+			}
+		}
+
+		this->Search ( nodeID, this->mDist, 0 );
+
+		for ( size_t j = 0; j < totalEntrances; ++j ) {
+			if ( j == i ) continue;
+
+			int otherID = cluster.mEntrances [ j ].mNodeID;
+			float dist = this->mDist [ this->GetLocalIndex ( otherID )];
+
+			if ( dist < FLT_MAX ) {
+				MOAIGridPathEdge& edge = cluster.mEdges.Push ();
+				edge.mNodeID = otherID;
+				edge.mCost = dist;
+			}
+		}
+
+		MOAIGridPathEntrance& entrance = cluster.mEntrances [ i ];
+		entrance.mBase = base;
+		entrance.mTotal = ( u32 )cluster.mEdges.GetTop () - base;
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathHierarchy::ScanBorder ( int x, int y, int stepX, int stepY, int length, int crossX, int crossY, float cost ) {
+
+	// one transition at the middle of each run of cells open on both sides
+	int runStart = -1;
+
+	for ( int i = 0; i <= length; ++i ) {
+
+		bool open = false;
+
+		if ( i < length ) {
+			int addr = (( y + ( stepY * i )) * this->mWidth ) + ( x + ( stepX * i ));
+			int cross = addr + ( crossY * this->mWidth ) + crossX;
+			open = this->mPassable [ addr ] && this->mPassable [ cross ];
+		}
+
+		if ( open ) {
+			if ( runStart < 0 ) {
+				runStart = i;
+			}
+		}
+		else if ( runStart >= 0 ) {
+
+			int mid = runStart + (( i - 1 - runStart ) / 2 );
+			int addr = (( y + ( stepY * mid )) * this->mWidth ) + ( x + ( stepX * mid ));
+
+			MOAIGridPathTransition& transition = this->mTransitions.Push ();
+			transition.mFrom = addr;
+			transition.mTo = addr + ( crossY * this->mWidth ) + crossX;
+			transition.mCost = cost;
+
+			runStart = -1;
+		}
+	}
+
+	if ( !( this->mDiagonals && ( stepX || stepY ))) return;
+
+	// with diagonals, a cell may also cross where neither straight crossing is open
+	int step = ( stepY * this->mWidth ) + stepX;
+
+	for ( int i = 0; i < length; ++i ) {
+
+		int addr = (( y + ( stepY * i )) * this->mWidth ) + ( x + ( stepX * i ));
+		int cross = addr + ( crossY * this->mWidth ) + crossX;
+
+		if ( !this->mPassable [ addr ] || this->mPassable [ cross ]) continue;
+
+		for ( int side = -1; side <= 1; side += 2 ) {
+
+			int j = i + side;
+			if (( j < 0 ) || ( j >= length )) continue;
+
+			if ( this->mPassable [ cross + ( side * step )] && !this->mPassable [ addr + ( side * step )]) {
+
+				MOAIGridPathTransition& transition = this->mTransitions.Push ();
+				transition.mFrom = addr;
+				transition.mTo = cross + ( side * step );
+				transition.mCost = this->mDCost;
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+// Dijkstra from addr over the passable cells of its cluster. The start
+// cell itself doesn't need to be passable.
+void MOAIGridPathHierarchy::Search ( int addr, float* dist, u32* parent ) {
+
+	this->mSearchID = -1;
+
+	int size = this->mClusterSize;
+	int x0 = (( addr % this->mWidth ) / size ) * size;
+	int y0 = (( addr / this->mWidth ) / size ) * size;
+	int x1 = MIN ( x0 + size, this->mWidth );
+	int y1 = MIN ( y0 + size, this->mHeight );
+
+	u32 totalCells = ( u32 )( size * size );
+	for ( u32 i = 0; i < totalCells; ++i ) {
+		dist [ i ] = FLT_MAX;
+	}
+
+	float costs [ 8 ] = {
+		this->mHCost, this->mHCost, this->mVCost, this->mVCost,
+		this->mDCost, this->mDCost, this->mDCost, this->mDCost,
+	};
+	u32 totalMoves = this->mDiagonals ? 8 : 4;
+
+	u32 start = this->GetLocalIndex ( addr );
+	dist [ start ] = 0.0f;
+	if ( parent ) {
+		parent [ start ] = NO_PARENT;
+	}
+
+	this->mHeap.Reset ();
+	MOAIGridPathSearchEntry::HeapPush ( this->mHeap, 0.0f, start );
+
+	while ( this->mHeap.GetTop ()) {
+
+		MOAIGridPathSearchEntry entry = MOAIGridPathSearchEntry::HeapPop ( this->mHeap );
+		if ( entry.mDist > dist [ entry.mIndex ]) continue;
+
+		int x = x0 + ( int )( entry.mIndex % size );
+		int y = y0 + ( int )( entry.mIndex / size );
+
+		for ( u32 i = 0; i < totalMoves; ++i ) {
+
+			int nx = x + sMoves [ i ][ 0 ];
+			int ny = y + sMoves [ i ][ 1 ];
+
+			if (( nx < x0 ) || ( ny < y0 ) || ( nx >= x1 ) || ( ny >= y1 )) continue;
+			if ( !this->mPassable [( ny * this->mWidth ) + nx ]) continue;
+
+			u32 idx = ( u32 )((( ny - y0 ) * size ) + ( nx - x0 ));
+			float nd = entry.mDist + costs [ i ];
+
+			if ( nd < dist [ idx ]) {
+				dist [ idx ] = nd;
+				if ( parent ) {
+					parent [ idx ] = entry.mIndex;
+				}
+				MOAIGridPathSearchEntry::HeapPush ( this->mHeap, nd, idx );
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathHierarchy::SearchFrom ( int addr ) {
+
+	this->Search ( addr, this->mDist, this->mParent );
+	this->mSearchID = addr;
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathHierarchy::SetPassable ( int addr, bool passable ) {
+
+	u8 value = passable ? 1 : 0;
+	if ( this->mPassable [ addr ] == value ) return;
+
+	this->mPassable [ addr ] = value;
+	this->MarkDirty ( addr % this->mWidth, addr / this->mWidth );
+}
+
+//----------------------------------------------------------------//
+void MOAIGridPathHierarchy::Update () {
+
+	if ( !this->mDirty.GetTop ()) return;
+
+	while ( this->mDirty.GetTop ()) {
+		this->RebuildCluster ( this->mDirty.Pop ());
+	}
+	this->mSearchID = -1;
+	this->mGoalID = -1;
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAIGRIDPATHHIERARCHY_H
+#define	MOAIGRIDPATHHIERARCHY_H
+
+//================================================================//
+// MOAIGridPathEdge
+//================================================================//
+class MOAIGridPathEdge {
+public:
+
+	int			mNodeID;		// cell address
+	float		mCost;
+};
+
+//================================================================//
+// MOAIGridPathEntrance
+//================================================================//
+class MOAIGridPathEntrance {
+public:
+
+	int			mNodeID;		// cell address
+	u32			mBase;			// first edge in the cluster's edge list
+	u32			mTotal;
+};
+
+//================================================================//
+// MOAIGridPathTransition
+//================================================================//
+class MOAIGridPathTransition {
+public:
+
+	int			mFrom;
+	int			mTo;
+	float		mCost;
+};
+
+//================================================================//
+// MOAIGridPathSearchEntry
+//================================================================//
+class MOAIGridPathSearchEntry {
+public:
+
+	float		mDist;
+	u32			mIndex;
+
+	//----------------------------------------------------------------//
+	static MOAIGridPathSearchEntry		HeapPop			( ZLLeanStack < MOAIGridPathSearchEntry >& heap );
+	static void							HeapPush		( ZLLeanStack < MOAIGridPathSearchEntry >& heap, float dist, u32 idx );
+};
+
+//================================================================//
+// MOAIGridPathCluster
+//================================================================//
+class MOAIGridPathCluster {
+public:
+
+	ZLLeanStack < MOAIGridPathEntrance, 16 >	mEntrances;
+	ZLLeanStack < MOAIGridPathEdge, 64 >		mEdges;
+	bool										mIsDirty;
+};
+
+//================================================================//
+// MOAIGridPathHierarchy
+//================================================================//
+// Abstraction of a rectangular grid for HPA* queries. The grid is split
+// into square clusters; each run of open cells along a shared cluster
+// border gets one entrance on either side. Entrances are linked across
+// the border and, inside each cluster, to every other entrance they can
+// reach. Clusters are rebuilt individually when cells change.
+class MOAIGridPathHierarchy {
+private:
+
+	int				mWidth;
+	int				mHeight;
+	int				mClusterSize;
+	int				mClustersWide;
+	int				mClustersHigh;
+
+	float			mHCost;
+	float			mVCost;
+	float			mDCost;
+	bool			mDiagonals;
+
+	ZLLeanArray < u8 >							mPassable;
+	ZLLeanArray < MOAIGridPathCluster >			mClusters;
+	ZLLeanStack < u32 >							mDirty;
+
+	ZLLeanStack < MOAIGridPathTransition, 32 >	mTransitions;
+
+	// scratch for searches confined to one cluster (indexed by local cell)
+	ZLLeanArray < float >						mDist;
+	ZLLeanArray < u32 >							mParent;
+	ZLLeanStack < MOAIGridPathSearchEntry >		mHeap;
+	int											mSearchID;
+
+	// distances to the current goal
+	ZLLeanArray < float >						mGoalDist;
+	int											mGoalID;
+
+	//----------------------------------------------------------------//
+	u32				GetLocalIndex			( int addr ) const;
+	void			MarkDirty				( int x, int y );
+	void			RebuildCluster			( u32 clusterID );
+	void			ScanBorder				( int x, int y, int stepX, int stepY, int length, int crossX, int crossY, float cost );
+	void			Search					( int addr, float* dist, u32* parent );
+
+public:
+
+	static const u32 NO_PARENT = ( u32 )-1;
+
+	//----------------------------------------------------------------//
+	bool							BuildSubpath				( int from, int to, ZLLeanStack < int >& path );
+	void							Clear						();
+	const MOAIGridPathCluster&		GetCluster					( u32 clusterID ) const;
+	u32								GetClusterID				( int addr ) const;
+	float							GetDistance					( int addr ) const;
+	u32								GetEdges					( int addr, const MOAIGridPathEdge*& edges ) const;
+	float							GetGoalDistance				( int goal, int addr );
+	void							Init						( int width, int height, int clusterSize, float hCost, float vCost, float dCost, bool diagonals );
+	bool							IsMatch						( int width, int height, int clusterSize, float hCost, float vCost, float dCost, bool diagonals ) const;
+	bool							IsPassable					( int addr ) const;
+									MOAIGridPathHierarchy		();
+									~MOAIGridPathHierarchy		();
+	void							SearchFrom					( int addr );
+	void							SetPassable					( int addr, bool passable );
+	void							Update						();
+};
+
+#endif
@@ -393,6 +393,38 @@ void MOAIInputMgr::SetDeviceHardwareInfo ( u8 deviceID, cc8* hardwareInfo ) {
 	}
 }
 
+//----------------------------------------------------------------//
+void MOAIInputMgr::SnapshotIn ( ZLStream& stream ) {
+
+	// only the pending event queue is restored; sensor state is not part of the snapshot
+	this->mTimebase		= stream.Read < double >( this->mTimebase );
+	this->mTimestamp	= stream.Read < double >( this->mTimestamp );
+
+	u32 size = stream.Read < u32 >( 0 );
+
+	this->DiscardAll ();
+	if ( size ) {
+		this->WriteStream ( stream, size );
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIInputMgr::SnapshotOut ( ZLStream& stream ) {
+
+	size_t cursor = this->GetCursor ();
+	size_t size = this->GetLength ();
+
+	stream.Write < double >( this->mTimebase );
+	stream.Write < double >( this->mTimestamp );
+	stream.Write < u32 >(( u32 )size );
+
+	if ( size ) {
+		this->Seek ( 0, SEEK_SET );
+		stream.WriteStream ( *this, size );
+		this->SetCursor ( cursor );
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIInputMgr::SuspendEvents ( bool suspend ) {
 
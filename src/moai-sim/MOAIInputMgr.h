@@ -93,6 +93,8 @@ public:
 	void				SetDevice					( u8 deviceID, cc8* name ); // back compat
 	void				SetDeviceActive				( u8 deviceID, bool active );
 	void				SetDeviceHardwareInfo		( u8 deviceID, cc8* hardwareInfo );
+	void				SnapshotIn					( ZLStream& stream );
+	void				SnapshotOut					( ZLStream& stream );
 	void				SuspendEvents				( bool suspend );
 	void				Update						( double timestep );
 
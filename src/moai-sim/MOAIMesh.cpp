@@ -11,6 +11,7 @@
 #include <moai-sim/MOAIIndexBuffer.h>
 #include <moai-sim/MOAIMaterialMgr.h>
 #include <moai-sim/MOAIMesh.h>
+#include <moai-sim/MOAIMeshBVH.h>
 #include <moai-sim/MOAIMeshSparseQuadTree.h>
 #include <moai-sim/MOAIMeshTernaryTree.h>
 #include <moai-sim/MOAIRegion.h>
@@ -198,6 +199,37 @@ ZLVec3D MOAIMeshPrimReader::ReadCoord ( u32 idx ) const {
 // local
 //================================================================//
 
+//----------------------------------------------------------------//
+/**	@lua	buildBVH
+	@text	Builds a bounding volume hierarchy over the mesh's triangles
+			for ray and point queries. Once built, intersectRay,
+			getClosestHit and getPrimsForPoint use it instead of testing
+			every prim. Prims that aren't triangles are left out. The
+			hierarchy is a snapshot; rebuild it (or read a saved one)
+			after changing the mesh.
+	
+	@in		MOAIMesh self
+	@opt	number targetPrimsPerNode		Default value is 4.
+	@opt	number vertexBufferIndex		Default value is 1.
+	@out	nil
+*/
+int MOAIMesh::_buildBVH ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIMesh, "U" )
+
+	u32 targetPrimsPerNode		= state.GetValue < u32 >( 2, MOAIMeshBVH::DEFAULT_TARGET_PRIMS_PER_NODE );
+	u32 vertexBufferIndex		= state.GetValue < u32 >( 3, 1 ) - 1;
+
+	MOAIMeshPrimReader coordReader;
+	
+	if ( coordReader.Init ( *self, vertexBufferIndex )) {
+	
+		MOAIMeshBVH* bvh = new MOAIMeshBVH ();
+		bvh->Init ( coordReader, targetPrimsPerNode );
+		self->SetPartition ( bvh );
+	}
+	return 0;
+}
+
 //----------------------------------------------------------------//
 // TODO: doxygen
 int MOAIMesh::_buildQuadTree ( lua_State* L ) {
@@ -212,7 +244,7 @@ int MOAIMesh::_buildQuadTree ( lua_State* L ) {
 	
 		MOAIMeshSparseQuadTree* quadTree = new MOAIMeshSparseQuadTree ();
 		quadTree->Init ( coordReader, targetPrimsPerNode );
-		self->mPartition = quadTree;
+		self->SetPartition ( quadTree );
 	}
 	return 0;
 }
@@ -232,7 +264,49 @@ int MOAIMesh::_buildTernaryTree ( lua_State* L ) {
 	
 		MOAIMeshTernaryTree* ternaryTree = new MOAIMeshTernaryTree ();
 		ternaryTree->Init ( coordReader, targetPrimsPerNode, axisMask );
-		self->mPartition = ternaryTree;
+		self->SetPartition ( ternaryTree );
+	}
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	getClosestHit
+	@text	Casts a ray against the mesh's triangles and returns the
+			nearest hit, with the barycentric weights of the hit point.
+			The ray starts at loc and runs along vec without limit; time
+			is measured in lengths of vec. The weight of the triangle's
+			first vertex is 1 - u - v.
+	
+	@in		MOAIMesh self
+	@in		number x
+	@in		number y
+	@in		number z
+	@in		number dx
+	@in		number dy
+	@in		number dz
+	@out	number prim				Index of the triangle hit, or nil on a miss.
+	@out	number time
+	@out	number x
+	@out	number y
+	@out	number z
+	@out	number u				Weight of the triangle's second vertex.
+	@out	number v				Weight of the triangle's third vertex.
+*/
+int MOAIMesh::_getClosestHit ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIMesh, "UNNNNNN" )
+	
+	ZLVec3D loc		= state.GetValue < ZLVec3D >( 2, ZLVec3D::ORIGIN );
+	ZLVec3D vec		= state.GetValue < ZLVec3D >( 5, ZLVec3D::ORIGIN );
+	
+	MOAIMeshHit hit;
+	if ( self->FindClosestHit ( loc, vec, hit )) {
+	
+		state.Push ( hit.mPrim + 1 );
+		state.Push ( hit.mTime );
+		state.Push ( hit.mPoint );
+		state.Push ( hit.mU );
+		state.Push ( hit.mV );
+		return 7;
 	}
 	return 0;
 }
@@ -255,7 +329,33 @@ int MOAIMesh::_getPrimsForPoint ( lua_State* L ) {
 	ZLBox meshBounds = self->GetBounds ();
 	if ((( is3D ) && meshBounds.Contains ( point )) || meshBounds.Contains ( point, ZLBox::PLANE_XY )) {
 		
-		if ( primReader.Init ( *self, 0 )) {
+		if ( self->mPartition && self->mPartition->CanQuery ()) {
+		
+			ZLLeanStack < u32 > prims;
+			self->mPartition->FindPrimsForPoint ( point, is3D, prims );
+			
+			u32 basePrim = state.GetValue < u32 >( 5, 1 ) - 1;
+			u32 nPrims = state.GetValue < u32 >( 6, ( u32 )-1 );
+			
+			// report in prim order, as the linear scan does
+			u32 top = ( u32 )prims.GetTop ();
+			for ( u32 i = 1; i < top; ++i ) {
+				u32 prim = prims [ i ];
+				u32 j = i;
+				for ( ; ( j > 0 ) && ( prims [ j - 1 ] > prim ); --j ) {
+					prims [ j ] = prims [ j - 1 ];
+				}
+				prims [ j ] = prim;
+			}
+			
+			for ( u32 i = 0; i < top; ++i ) {
+				if (( prims [ i ] >= basePrim ) && ( prims [ i ] < nPrims )) {
+					state.Push ( prims [ i ] + 1 );
+					totalPrims++;
+				}
+			}
+		}
+		else if ( primReader.Init ( *self, 0 )) {
 			
 			u32 basePrim = state.GetValue < u32 >( 5, 1 ) - 1;
 			u32 nPrims = state.GetValue < u32 >( 6, primReader.GetTotalPrims ());
@@ -352,7 +452,14 @@ int MOAIMesh::_intersectRay ( lua_State* L ) {
 	float bestTime = 0.0f;
 	ZLVec3D bestHit;
 	
-	if ( primReader.Init ( *self, 0 )) {
+	if ( self->mPartition && self->mPartition->CanQuery ()) {
+	
+		MOAIMeshHit hit;
+		hasHit = self->mPartition->FindClosestHit ( loc, vec, hit );
+		bestTime = hit.mTime;
+		bestHit = hit.mPoint;
+	}
+	else if ( primReader.Init ( *self, 0 )) {
 	
 		u32 totalMeshPrims = primReader.GetTotalPrims ();
 		
@@ -366,6 +473,9 @@ int MOAIMesh::_intersectRay ( lua_State* L ) {
 				
 				if ( ZLSect::VecToTriangle ( loc, vec, prim.mCoords [ 0 ], prim.mCoords [ 1 ], prim.mCoords [ 2 ], time, hit ) == ZLSect::SECT_HIT ) {
 				
+					// hits behind the origin are ignored, as they are by the partition
+					if ( time < 0.0f ) continue;
+				
 					if (( !hasHit ) || ( time < bestTime )) {
 						bestTime = time;
 						bestHit = hit;
@@ -395,6 +505,40 @@ int MOAIMesh::_printPartition ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	readBVH
+	@text	Loads a bounding volume hierarchy saved by writeBVH, so it
+			doesn't have to be rebuilt at load. The hierarchy carries
+			its own copy of the triangles; make sure it was written for
+			this mesh. The stream must report its length, so the header
+			can be checked against it before anything is allocated.
+	
+	@in		MOAIMesh self
+	@in		MOAIStream stream
+	@out	boolean success
+*/
+int MOAIMesh::_readBVH ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIMesh, "UU" )
+
+	MOAIStream* stream = state.GetLuaObject < MOAIStream >( 2, true );
+	bool success = false;
+	
+	if ( stream ) {
+	
+		MOAIMeshBVH* bvh = new MOAIMeshBVH ();
+		success = bvh->Read ( *stream );
+		
+		if ( success ) {
+			self->SetPartition ( bvh );
+		}
+		else {
+			delete ( bvh );
+		}
+	}
+	state.Push ( success );
+	return 1;
+}
+
 //----------------------------------------------------------------//
 // TODO: doxygen
 int MOAIMesh::_readPrimCoords ( lua_State* L ) {
@@ -503,6 +647,26 @@ int MOAIMesh::_setTotalElements ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	writeBVH
+	@text	Saves the mesh's bounding volume hierarchy to a stream. See
+			readBVH. Does nothing unless the mesh has a BVH.
+	
+	@in		MOAIMesh self
+	@in		MOAIStream stream
+	@out	boolean success
+*/
+int MOAIMesh::_writeBVH ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIMesh, "UU" )
+
+	MOAIStream* stream = state.GetLuaObject < MOAIStream >( 2, true );
+	
+	bool success = stream && self->mPartition && self->mPartition->Write ( *stream );
+	
+	state.Push ( success );
+	return 1;
+}
+
 //================================================================//
 // MOAIMesh
 //================================================================//
@@ -576,6 +740,46 @@ void MOAIMesh::DrawIndex ( u32 idx, MOAIMeshSpan* span ) {
 	}
 }
 
+//----------------------------------------------------------------//
+bool MOAIMesh::FindClosestHit ( const ZLVec3D& loc, const ZLVec3D& vec, MOAIMeshHit& hit ) {
+
+	if ( this->mPartition && this->mPartition->CanQuery ()) {
+		return this->mPartition->FindClosestHit ( loc, vec, hit );
+	}
+
+	MOAIMeshPrimReader primReader;
+	if ( !primReader.Init ( *this, 0 )) return false;
+	
+	bool hasHit = false;
+	hit.mTime = FLT_MAX;
+	
+	u32 totalMeshPrims = primReader.GetTotalPrims ();
+	for ( u32 i = 0; i < totalMeshPrims; ++i ) {
+	
+		MOAIMeshPrimCoords prim;
+		if ( primReader.GetPrimCoords ( i, prim ) && ( prim.mPrimSize == MOAIMeshPrimCoords::PRIM_TRIANGLE )) {
+		
+			ZLVec3D e1 = prim.mCoords [ 1 ] - prim.mCoords [ 0 ];
+			ZLVec3D e2 = prim.mCoords [ 2 ] - prim.mCoords [ 0 ];
+			
+			float t, u, v;
+			if ( MOAIMeshBVH::IntersectTriangle ( prim.mCoords [ 0 ], e1, e2, loc, vec, hit.mTime, t, u, v )) {
+				hit.mPrim = i;
+				hit.mTime = t;
+				hit.mU = u;
+				hit.mV = v;
+				hasHit = true;
+			}
+		}
+	}
+	
+	if ( hasHit ) {
+		hit.mPoint = loc;
+		hit.mPoint.Add ( vec, hit.mTime );
+	}
+	return hasHit;
+}
+
 //----------------------------------------------------------------//
 MOAIMesh::MOAIMesh () :
 	mTotalElements ( 0 ),
@@ -596,6 +800,7 @@ MOAIMesh::MOAIMesh () :
 MOAIMesh::~MOAIMesh () {
 
 	this->SetIndexBuffer ( 0 );
+	this->SetPartition ( 0 );
 }
 
 //----------------------------------------------------------------//
@@ -627,12 +832,15 @@ void MOAIMesh::RegisterLuaFuncs ( MOAILuaState& state ) {
 	MOAIVertexArray::RegisterLuaFuncs ( state );
 
 	luaL_Reg regTable [] = {
+		{ "buildBVH",					_buildBVH },
 		{ "buildQuadTree",				_buildQuadTree },
 		{ "buildTernaryTree",			_buildTernaryTree },
+		{ "getClosestHit",				_getClosestHit },
 		{ "getPrimsForPoint",			_getPrimsForPoint },
 		{ "getRegionForPrim",			_getRegionForPrim },
 		{ "intersectRay",				_intersectRay },
 		{ "printPartition",				_printPartition },
+		{ "readBVH",					_readBVH },
 		{ "readPrimCoords",				_readPrimCoords },
 		{ "reserveVAOs",				_reserveVAOs },
 		{ "reserveVertexBuffers",		_reserveVertexBuffers },
@@ -642,6 +850,7 @@ void MOAIMesh::RegisterLuaFuncs ( MOAILuaState& state ) {
 		{ "setPrimType",				_setPrimType },
 		{ "setTotalElements",			_setTotalElements },
 		{ "setVertexBuffer",			_setVertexBuffer },
+		{ "writeBVH",					_writeBVH },
 		{ NULL, NULL }
 	};
 	
@@ -733,6 +942,15 @@ void MOAIMesh::SetIndexBuffer ( MOAIIndexBuffer* indexBuffer ) {
 	this->mIndexBuffer.Set ( *this, indexBuffer );
 }
 
+//----------------------------------------------------------------//
+void MOAIMesh::SetPartition ( MOAIMeshPartition* partition ) {
+
+	if ( this->mPartition ) {
+		delete ( this->mPartition );
+	}
+	this->mPartition = partition;
+}
+
 //================================================================//
 // ::implementation::
 //================================================================//
@@ -10,6 +10,7 @@
 
 class MOAIIndexBuffer;
 class MOAIMesh;
+class MOAIMeshHit;
 class MOAIMeshPartition;
 class MOAISelectionSpan;
 class MOAITextureBase;
@@ -110,18 +111,22 @@ protected:
 	MOAIMeshPartition*	mPartition;
 
 	//----------------------------------------------------------------//
+	static int			_buildBVH					( lua_State* L );
 	static int			_buildQuadTree				( lua_State* L );
 	static int			_buildTernaryTree			( lua_State* L );
+	static int			_getClosestHit				( lua_State* L );
 	static int			_getPrimsForPoint			( lua_State* L );
 	static int			_getRegionForPrim			( lua_State* L );
 	static int			_intersectRay				( lua_State* L );
 	static int			_printPartition				( lua_State* L );
+	static int			_readBVH					( lua_State* L );
 	static int			_readPrimCoords				( lua_State* L );
 	static int			_setBounds					( lua_State* L );
 	static int			_setIndexBuffer				( lua_State* L );
 	static int			_setPenWidth				( lua_State* L );
 	static int			_setPrimType				( lua_State* L );
 	static int			_setTotalElements			( lua_State* L );
+	static int			_writeBVH					( lua_State* L );
 
 	//----------------------------------------------------------------//
 	ZLBounds			MOAIDeck_ComputeMaxBounds		();
@@ -139,6 +144,7 @@ public:
 	void				ClearBounds					();
 	u32					CountPrims					() const;
 	void				DrawIndex					( u32 idx, MOAIMeshSpan* span );
+	bool				FindClosestHit				( const ZLVec3D& loc, const ZLVec3D& vec, MOAIMeshHit& hit );
 						MOAIMesh					();
 						~MOAIMesh					();
 	void				RegisterLuaClass			( MOAILuaState& state );
@@ -149,6 +155,7 @@ public:
 	void				SerializeOut				( MOAILuaState& state, MOAISerializer& serializer );
 	void				SetBounds					( const ZLBox& bounds );
 	void				SetIndexBuffer				( MOAIIndexBuffer* indexBuffer );
+	void				SetPartition				( MOAIMeshPartition* partition );
 };
 
 #endif
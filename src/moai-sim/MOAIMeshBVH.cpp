@@ -0,0 +1,549 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+
+#include <moai-sim/MOAIMesh.h>
+#include <moai-sim/MOAIMeshBVH.h>
+
+//================================================================//
+// MOAIMeshBVHBuilder
+//================================================================//
+
+//----------------------------------------------------------------//
+void MOAIMeshBVHBuilder::Build ( MOAIMeshBVH& bvh, const MOAIMeshPrimReader& primReader, u32 targetPrimsPerNode ) {
+
+	u32 totalMeshPrims = primReader.GetTotalPrims ();
+	if ( !totalMeshPrims ) return;
+
+	this->mPrims.Init ( totalMeshPrims );
+
+	u32 totalPrims = 0;
+	for ( u32 i = 0; i < totalMeshPrims; ++i ) {
+
+		MOAIMeshPrimCoords prim;
+		if ( primReader.GetPrimCoords ( i, prim ) && ( prim.mPrimSize == MOAIMeshPrimCoords::PRIM_TRIANGLE )) {
+
+			Prim& buildPrim = this->mPrims [ totalPrims++ ];
+
+			buildPrim.mIndex = prim.mIndex;
+			buildPrim.mBounds = prim.GetBounds ();
+			buildPrim.mBounds.Bless ();
+			buildPrim.mBounds.GetCenter ( buildPrim.mCentroid );
+
+			buildPrim.mCoords [ 0 ] = prim.mCoords [ 0 ];
+			buildPrim.mCoords [ 1 ] = prim.mCoords [ 1 ];
+			buildPrim.mCoords [ 2 ] = prim.mCoords [ 2 ];
+		}
+	}
+
+	if ( !totalPrims ) return;
+
+	this->mOrder.Init ( totalPrims );
+	for ( u32 i = 0; i < totalPrims; ++i ) {
+		this->mOrder [ i ] = i;
+	}
+
+	// a binary tree over n leaves never needs more than 2n - 1 nodes
+	this->mNodes.Init (( totalPrims * 2 ) - 1 );
+	this->mTotalNodes = 1;
+	this->mTargetPrimsPerNode = targetPrimsPerNode > 0 ? targetPrimsPerNode : 1;
+
+	this->BuildRecurse ( 0, 0, totalPrims, 0 );
+
+	bvh.mNodes.Init ( this->mTotalNodes );
+	memcpy ( bvh.mNodes.Data (), this->mNodes.Data (), this->mTotalNodes * sizeof ( MOAIMeshBVHNode ));
+
+	// copy the triangles out in leaf order
+	bvh.mTriangles.Init ( totalPrims );
+	for ( u32 i = 0; i < totalPrims; ++i ) {
+
+		const Prim& prim = this->mPrims [ this->mOrder [ i ]];
+		MOAIMeshBVHTriangle& triangle = bvh.mTriangles [ i ];
+
+		triangle.mV0	= prim.mCoords [ 0 ];
+		triangle.mE1	= prim.mCoords [ 1 ] - prim.mCoords [ 0 ];
+		triangle.mE2	= prim.mCoords [ 2 ] - prim.mCoords [ 0 ];
+		triangle.mIndex	= prim.mIndex;
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIMeshBVHBuilder::BuildRecurse ( u32 nodeIdx, u32 base, u32 count, u32 depth ) {
+
+	ZLBox bounds;
+	ZLBox centroidBounds;
+
+	for ( u32 i = 0; i < count; ++i ) {
+		const Prim& prim = this->mPrims [ this->mOrder [ base + i ]];
+		bounds.Grow ( prim.mBounds, i == 0 );
+		centroidBounds.Grow ( prim.mCentroid, i == 0 );
+	}
+
+	MOAIMeshBVHNode& node = this->mNodes [ nodeIdx ];
+
+	node.mMin [ 0 ] = bounds.mMin.mX;
+	node.mMin [ 1 ] = bounds.mMin.mY;
+	node.mMin [ 2 ] = bounds.mMin.mZ;
+
+	node.mMax [ 0 ] = bounds.mMax.mX;
+	node.mMax [ 1 ] = bounds.mMax.mY;
+	node.mMax [ 2 ] = bounds.mMax.mZ;
+
+	// the query stack holds one entry per level, so stop splitting short of it
+	u32 leftCount = 0;
+	if (( count > this->mTargetPrimsPerNode ) && ( depth < ( MOAIMeshBVH::MAX_DEPTH - 1 ))) {
+		leftCount = this->Split ( base, count, bounds, centroidBounds );
+	}
+
+	if ( !leftCount ) {
+		node.mOffset = base;
+		node.mCount = count;
+		return;
+	}
+
+	node.mCount = 0;
+
+	// first child directly follows its parent
+	u32 leftIdx = this->mTotalNodes++;
+	assert ( leftIdx == ( nodeIdx + 1 ));
+	this->BuildRecurse ( leftIdx, base, leftCount, depth + 1 );
+
+	u32 rightIdx = this->mTotalNodes++;
+	this->mNodes [ nodeIdx ].mOffset = rightIdx;
+	this->BuildRecurse ( rightIdx, base + leftCount, count - leftCount, depth + 1 );
+}
+
+//----------------------------------------------------------------//
+u32 MOAIMeshBVHBuilder::Split ( u32 base, u32 count, const ZLBox& bounds, const ZLBox& centroidBounds ) {
+
+	// binned surface area heuristic: bin the centroids along each axis and
+	// cost each bin boundary as a split. a prim test costs 1, as does the
+	// extra traversal step.
+
+	float parentArea = MOAIMeshBVHBuilder::SurfaceArea ( bounds );
+	float invParentArea = parentArea > 0.0f ? 1.0f / parentArea : 0.0f;
+
+	float bestCost = ( float )count;
+	u32 bestAxis = 3;
+	u32 bestBin = 0;
+
+	u32* order = this->mOrder.Data ();
+
+	for ( u32 axis = 0; axis < 3; ++axis ) {
+
+		float cMin = centroidBounds.mMin.GetComponent ( axis );
+		float extent = centroidBounds.mMax.GetComponent ( axis ) - cMin;
+		if ( extent <= 0.0f ) continue;
+
+		float binScale = ( float )TOTAL_BINS / extent;
+
+		u32 binCounts [ TOTAL_BINS ];
+		ZLBox binBounds [ TOTAL_BINS ];
+		memset ( binCounts, 0, sizeof ( binCounts ));
+
+		for ( u32 i = 0; i < count; ++i ) {
+
+			const Prim& prim = this->mPrims [ order [ base + i ]];
+
+			u32 bin = ( u32 )(( prim.mCentroid.GetComponent ( axis ) - cMin ) * binScale );
+			bin = bin < TOTAL_BINS ? bin : TOTAL_BINS - 1;
+
+			binBounds [ bin ].Grow ( prim.mBounds, binCounts [ bin ] == 0 );
+			binCounts [ bin ]++;
+		}
+
+		// sweep from the right to get the cost of everything past each boundary
+		float rightArea [ TOTAL_BINS ];
+		u32 rightCount [ TOTAL_BINS ];
+
+		ZLBox sweep;
+		u32 sweepCount = 0;
+
+		for ( u32 i = TOTAL_BINS - 1; i > 0; --i ) {
+			if ( binCounts [ i ]) {
+				sweep.Grow ( binBounds [ i ], sweepCount == 0 );
+				sweepCount += binCounts [ i ];
+			}
+			rightArea [ i ] = sweepCount ? MOAIMeshBVHBuilder::SurfaceArea ( sweep ) : 0.0f;
+			rightCount [ i ] = sweepCount;
+		}
+
+		sweepCount = 0;
+
+		for ( u32 i = 0; i < ( TOTAL_BINS - 1 ); ++i ) {
+
+			if ( binCounts [ i ]) {
+				sweep.Grow ( binBounds [ i ], sweepCount == 0 );
+				sweepCount += binCounts [ i ];
+			}
+
+			if ( !( sweepCount && rightCount [ i + 1 ])) continue;
+
+			float leftArea = MOAIMeshBVHBuilder::SurfaceArea ( sweep );
+			float cost = 1.0f + ((( leftArea * sweepCount ) + ( rightArea [ i + 1 ] * rightCount [ i + 1 ])) * invParentArea );
+
+			if ( cost < bestCost ) {
+				bestCost = cost;
+				bestAxis = axis;
+				bestBin = i;
+			}
+		}
+	}
+
+	if ( bestAxis < 3 ) {
+
+		float cMin = centroidBounds.mMin.GetComponent ( bestAxis );
+		float binScale = ( float )TOTAL_BINS / ( centroidBounds.mMax.GetComponent ( bestAxis ) - cMin );
+
+		// partition the run in place around the chosen boundary
+		u32 left = base;
+		u32 right = base + count;
+
+		while ( left < right ) {
+
+			const Prim& prim = this->mPrims [ order [ left ]];
+
+			u32 bin = ( u32 )(( prim.mCentroid.GetComponent ( bestAxis ) - cMin ) * binScale );
+			bin = bin < TOTAL_BINS ? bin : TOTAL_BINS - 1;
+
+			if ( bin <= bestBin ) {
+				left++;
+			}
+			else {
+				u32 swap = order [ left ];
+				order [ left ] = order [ --right ];
+				order [ right ] = swap;
+			}
+		}
+
+		u32 leftCount = left - base;
+		if (( leftCount > 0 ) && ( leftCount < count )) return leftCount;
+	}
+
+	// nothing worth splitting on; stacked or coincident prims still have to
+	// be broken up if there are too many for one leaf
+	return count > MAX_LEAF_PRIMS ? count / 2 : 0;
+}
+
+//----------------------------------------------------------------//
+float MOAIMeshBVHBuilder::SurfaceArea ( const ZLBox& box ) {
+
+	float w = box.mMax.mX - box.mMin.mX;
+	float h = box.mMax.mY - box.mMin.mY;
+	float d = box.mMax.mZ - box.mMin.mZ;
+
+	return (( w * h ) + ( h * d ) + ( d * w )) * 2.0f;
+}
+
+//================================================================//
+// MOAIMeshBVH
+//================================================================//
+
+//----------------------------------------------------------------//
+bool MOAIMeshBVH::CanQuery () const {
+
+	return this->mNodes.Size () > 0;
+}
+
+//----------------------------------------------------------------//
+void MOAIMeshBVH::Clear () {
+
+	this->mNodes.Clear ();
+	this->mTriangles.Clear ();
+}
+
+//----------------------------------------------------------------//
+bool MOAIMeshBVH::FindClosestHit ( const ZLVec3D& loc, const ZLVec3D& vec, MOAIMeshHit& hit ) const {
+
+	if ( !this->mNodes.Size ()) return false;
+
+	const MOAIMeshBVHNode* nodes = this->mNodes.Data ();
+	const MOAIMeshBVHTriangle* triangles = this->mTriangles.Data ();
+
+	// a huge finite reciprocal instead of infinity keeps the slab test free of NaNs
+	float origin [ 3 ] = { loc.mX, loc.mY, loc.mZ };
+	float invVec [ 3 ];
+	for ( u32 i = 0; i < 3; ++i ) {
+		float c = vec.GetComponent ( i );
+		invVec [ i ] = c != 0.0f ? 1.0f / c : ( c < 0.0f ? -1e30f : 1e30f );
+	}
+
+	float bestTime = FLT_MAX;
+	u32 bestTriangle = 0;
+	float bestU = 0.0f;
+	float bestV = 0.0f;
+
+	if ( MOAIMeshBVH::IntersectBox ( nodes [ 0 ], origin, invVec, bestTime ) == FLT_MAX ) return false;
+
+	u32 stack [ MAX_DEPTH ];
+	u32 top = 0;
+	u32 nodeIdx = 0;
+
+	while ( true ) {
+
+		const MOAIMeshBVHNode& node = nodes [ nodeIdx ];
+
+		if ( node.mCount ) {
+
+			u32 end = node.mOffset + node.mCount;
+			for ( u32 i = node.mOffset; i < end; ++i ) {
+
+				const MOAIMeshBVHTriangle& triangle = triangles [ i ];
+
+				float t, u, v;
+				if ( MOAIMeshBVH::IntersectTriangle ( triangle.mV0, triangle.mE1, triangle.mE2, loc, vec, bestTime, t, u, v )) {
+					bestTime = t;
+					bestTriangle = i;
+					bestU = u;
+					bestV = v;
+				}
+			}
+		}
+		else {
+
+			u32 nearIdx = nodeIdx + 1;
+			u32 farIdx = node.mOffset;
+
+			float nearTime = MOAIMeshBVH::IntersectBox ( nodes [ nearIdx ], origin, invVec, bestTime );
+			float farTime = MOAIMeshBVH::IntersectBox ( nodes [ farIdx ], origin, invVec, bestTime );
+
+			if ( farTime < nearTime ) {
+				u32 swapIdx = nearIdx;
+				nearIdx = farIdx;
+				farIdx = swapIdx;
+
+				float swapTime = nearTime;
+				nearTime = farTime;
+				farTime = swapTime;
+			}
+
+			if ( nearTime != FLT_MAX ) {
+				if ( farTime != FLT_MAX ) {
+					assert ( top < MAX_DEPTH );
+					stack [ top++ ] = farIdx;
+				}
+				nodeIdx = nearIdx;
+				continue;
+			}
+		}
+
+		if ( !top ) break;
+		nodeIdx = stack [ --top ];
+	}
+
+	if ( bestTime == FLT_MAX ) return false;
+
+	const MOAIMeshBVHTriangle& triangle = triangles [ bestTriangle ];
+
+	hit.mPrim = triangle.mIndex;
+	hit.mTime = bestTime;
+	hit.mU = bestU;
+	hit.mV = bestV;
+
+	hit.mPoint = loc;
+	hit.mPoint.Add ( vec, bestTime );
+
+	return true;
+}
+
+//----------------------------------------------------------------//
+void MOAIMeshBVH::FindPrimsForPoint ( const ZLVec3D& point, bool is3D, ZLLeanStack < u32 >& prims ) const {
+
+	if ( !this->mNodes.Size ()) return;
+
+	const MOAIMeshBVHNode* nodes = this->mNodes.Data ();
+	const MOAIMeshBVHTriangle* triangles = this->mTriangles.Data ();
+
+	// matches the linear scan in MOAIMesh: a prim passes if it contains the
+	// point in the XY plane (or in 3D, if asked), so only X and Y prune nodes
+	ZLVec2D point2D = point.Vec2D ();
+
+	u32 stack [ MAX_DEPTH ];
+	u32 top = 0;
+	stack [ top++ ] = 0;
+
+	while ( top ) {
+
+		const MOAIMeshBVHNode& node = nodes [ stack [ --top ]];
+		u32 nodeIdx = ( u32 )( &node - nodes );
+
+		if (( point.mX < node.mMin [ 0 ]) || ( point.mX > node.mMax [ 0 ]) || ( point.mY < node.mMin [ 1 ]) || ( point.mY > node.mMax [ 1 ])) continue;
+
+		if ( node.mCount ) {
+
+			u32 end = node.mOffset + node.mCount;
+			for ( u32 i = node.mOffset; i < end; ++i ) {
+
+				const MOAIMeshBVHTriangle& triangle = triangles [ i ];
+
+				ZLVec3D v1 = triangle.mV0 + triangle.mE1;
+				ZLVec3D v2 = triangle.mV0 + triangle.mE2;
+
+				if (( is3D && ZLBarycentric::PointInTriangle ( triangle.mV0, v1, v2, point )) || ZLBarycentric::PointInTriangle ( triangle.mV0.Vec2D (), v1.Vec2D (), v2.Vec2D (), point2D )) {
+					prims.Push ( triangle.mIndex );
+				}
+			}
+		}
+		else {
+			assert (( top + 2 ) <= MAX_DEPTH );
+			stack [ top++ ] = node.mOffset;
+			stack [ top++ ] = nodeIdx + 1;
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIMeshBVH::Init ( const MOAIMeshPrimReader& primReader, u32 targetPrimsPerNode ) {
+
+	this->Clear ();
+
+	MOAIMeshBVHBuilder builder;
+	builder.Build ( *this, primReader, targetPrimsPerNode );
+}
+
+//----------------------------------------------------------------//
+// returns the entry time, or FLT_MAX on a miss. branch free so the three
+// axes can be evaluated side by side.
+float MOAIMeshBVH::IntersectBox ( const MOAIMeshBVHNode& node, const float* loc, const float* invVec, float maxTime ) {
+
+	float tx0 = ( node.mMin [ 0 ] - loc [ 0 ]) * invVec [ 0 ];
+	float tx1 = ( node.mMax [ 0 ] - loc [ 0 ]) * invVec [ 0 ];
+	float ty0 = ( node.mMin [ 1 ] - loc [ 1 ]) * invVec [ 1 ];
+	float ty1 = ( node.mMax [ 1 ] - loc [ 1 ]) * invVec [ 1 ];
+	float tz0 = ( node.mMin [ 2 ] - loc [ 2 ]) * invVec [ 2 ];
+	float tz1 = ( node.mMax [ 2 ] - loc [ 2 ]) * invVec [ 2 ];
+
+	float tNear = ZLFloat::Max ( ZLFloat::Max ( ZLFloat::Min ( tx0, tx1 ), ZLFloat::Min ( ty0, ty1 )), ZLFloat::Max ( ZLFloat::Min ( tz0, tz1 ), 0.0f ));
+	float tFar = ZLFloat::Min ( ZLFloat::Min ( ZLFloat::Max ( tx0, tx1 ), ZLFloat::Max ( ty0, ty1 )), ZLFloat::Min ( ZLFloat::Max ( tz0, tz1 ), maxTime ));
+
+	return tNear <= tFar ? tNear : FLT_MAX;
+}
+
+//----------------------------------------------------------------//
+// double sided Moller-Trumbore; t is along vec, u and v weight v1 and v2
+bool MOAIMeshBVH::IntersectTriangle ( const ZLVec3D& v0, const ZLVec3D& e1, const ZLVec3D& e2, const ZLVec3D& loc, const ZLVec3D& vec, float maxTime, float& t, float& u, float& v ) {
+
+	ZLVec3D p = ZLVec3D::Cross ( vec, e2 );
+	float det = e1.Dot ( p );
+
+	if (( det > -FLT_EPSILON ) && ( det < FLT_EPSILON )) return false;
+	float invDet = 1.0f / det;
+
+	ZLVec3D s = loc - v0;
+	u = s.Dot ( p ) * invDet;
+	if (( u < 0.0f ) || ( u > 1.0f )) return false;
+
+	ZLVec3D q = ZLVec3D::Cross ( s, e1 );
+	v = vec.Dot ( q ) * invDet;
+	if (( v < 0.0f ) || (( u + v ) > 1.0f )) return false;
+
+	t = e2.Dot ( q ) * invDet;
+	return ( t >= 0.0f ) && ( t < maxTime );
+}
+
+//----------------------------------------------------------------//
+MOAIMeshBVH::MOAIMeshBVH () {
+}
+
+//----------------------------------------------------------------//
+MOAIMeshBVH::~MOAIMeshBVH () {
+}
+
+//----------------------------------------------------------------//
+void MOAIMeshBVH::Print () {
+
+	u32 totalLeaves = 0;
+	u32 maxLeafPrims = 0;
+
+	for ( size_t i = 0; i < this->mNodes.Size (); ++i ) {
+		const MOAIMeshBVHNode& node = this->mNodes [ i ];
+		if ( node.mCount ) {
+			totalLeaves++;
+			maxLeafPrims = node.mCount > maxLeafPrims ? node.mCount : maxLeafPrims;
+		}
+	}
+
+	printf ( "MOAIMeshBVH: %d nodes, %d leaves, %d triangles, %d max per leaf\n", ( int )this->mNodes.Size (), ( int )totalLeaves, ( int )this->mTriangles.Size (), ( int )maxLeafPrims );
+}
+
+//----------------------------------------------------------------//
+bool MOAIMeshBVH::Read ( ZLStream& stream ) {
+
+	this->Clear ();
+
+	if ( stream.Read < u32 >( 0 ).mValue != STREAM_MAGIC ) return false;
+	if ( stream.Read < u32 >( 0 ).mValue != STREAM_VERSION ) return false;
+
+	u32 totalNodes = stream.Read < u32 >( 0 ).mValue;
+	u32 totalTriangles = stream.Read < u32 >( 0 ).mValue;
+
+	// a binary tree over n leaves has fewer than 2n nodes; widened so a huge count can't wrap
+	if ( !( totalNodes && totalTriangles && (( u64 )totalNodes < (( u64 )totalTriangles * 2 )))) return false;
+
+	// don't trust the counts with an allocation until the stream is known to hold that much
+	u64 nodeBytes = ( u64 )totalNodes * sizeof ( MOAIMeshBVHNode );
+	u64 triangleBytes = ( u64 )totalTriangles * sizeof ( MOAIMeshBVHTriangle );
+
+	size_t length = stream.GetLength ();
+	size_t cursor = stream.GetCursor ();
+	
+	// ( size_t )-1 is ZLStream's unknown length
+	if (( length == ( size_t )-1 ) || ( cursor > length )) return false;
+	if (( nodeBytes + triangleBytes ) > ( u64 )( length - cursor )) return false;
+
+	if ( this->mNodes.Init ( totalNodes ) != ZL_OK ) return false;
+	if ( this->mTriangles.Init ( totalTriangles ) != ZL_OK ) {
+		this->Clear ();
+		return false;
+	}
+
+	bool valid = ( stream.ReadBytes ( this->mNodes.Data (), ( size_t )nodeBytes ).mValue == nodeBytes );
+	valid = valid && ( stream.ReadBytes ( this->mTriangles.Data (), ( size_t )triangleBytes ).mValue == triangleBytes );
+
+	// make sure the queries can't walk off the arrays or overflow their fixed stacks. children
+	// always come after their parent, so one forward pass sees every parent before its children.
+	ZLLeanArray < u32 > depths;
+	valid = valid && ( depths.Init ( totalNodes ) == ZL_OK );
+	depths.Fill ( 0 );
+	
+	for ( u32 i = 0; valid && ( i < totalNodes ); ++i ) {
+		const MOAIMeshBVHNode& node = this->mNodes [ i ];
+		if ( node.mCount ) {
+			valid = ( node.mOffset < totalTriangles ) && ( node.mCount <= ( totalTriangles - node.mOffset ));
+		}
+		else {
+			valid = (( i + 1 ) < totalNodes ) && ( node.mOffset > ( i + 1 )) && ( node.mOffset < totalNodes );
+			
+			// the builder stops splitting at MAX_DEPTH - 1, which is what the stacks are sized for
+			u32 childDepth = depths [ i ] + 1;
+			valid = valid && ( childDepth < MAX_DEPTH );
+			
+			if ( valid ) {
+				depths [ i + 1 ] = MAX ( depths [ i + 1 ], childDepth );
+				depths [ node.mOffset ] = MAX ( depths [ node.mOffset ], childDepth );
+			}
+		}
+	}
+
+	if ( !valid ) {
+		this->Clear ();
+	}
+	return valid;
+}
+
+//----------------------------------------------------------------//
+bool MOAIMeshBVH::Write ( ZLStream& stream ) const {
+
+	if ( !this->mNodes.Size ()) return false;
+
+	stream.Write < u32 >( STREAM_MAGIC );
+	stream.Write < u32 >( STREAM_VERSION );
+	stream.Write < u32 >(( u32 )this->mNodes.Size ());
+	stream.Write < u32 >(( u32 )this->mTriangles.Size ());
+
+	stream.WriteBytes ( this->mNodes.Data (), this->mNodes.Size () * sizeof ( MOAIMeshBVHNode ));
+	stream.WriteBytes ( this->mTriangles.Data (), this->mTriangles.Size () * sizeof ( MOAIMeshBVHTriangle ));
+	
+	return true;
+}
@@ -0,0 +1,126 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAIMESHBVH_H
+#define	MOAIMESHBVH_H
+
+#include <moai-sim/MOAIMeshPartition.h>
+
+class MOAIMeshBVH;
+
+//================================================================//
+// MOAIMeshBVHNode
+//================================================================//
+// nodes are stored depth first in one array. an interior node's first child
+// follows it directly; mOffset is the second child. a leaf's triangles are
+// the run [ mOffset, mOffset + mCount ).
+class MOAIMeshBVHNode {
+private:
+
+	friend class MOAIMeshBVH;
+	friend class MOAIMeshBVHBuilder;
+
+	float		mMin [ 3 ];
+	u32			mOffset;
+	float		mMax [ 3 ];
+	u32			mCount;		// zero for interior nodes
+};
+
+//================================================================//
+// MOAIMeshBVHTriangle
+//================================================================//
+// stored in leaf order with edges precomputed for the ray test
+class MOAIMeshBVHTriangle {
+private:
+
+	friend class MOAIMeshBVH;
+	friend class MOAIMeshBVHBuilder;
+
+	ZLVec3D		mV0;
+	ZLVec3D		mE1;		// v1 - v0
+	ZLVec3D		mE2;		// v2 - v0
+	u32			mIndex;		// prim index in the mesh
+};
+
+//================================================================//
+// MOAIMeshBVHBuilderPrim
+//================================================================//
+class MOAIMeshBVHBuilderPrim {
+private:
+
+	friend class MOAIMeshBVHBuilder;
+
+	ZLBox		mBounds;
+	ZLVec3D		mCentroid;
+	ZLVec3D		mCoords [ 3 ];
+	u32			mIndex;
+};
+
+//================================================================//
+// MOAIMeshBVHBuilder
+//================================================================//
+class MOAIMeshBVHBuilder {
+private:
+
+	friend class MOAIMeshBVH;
+
+	static const u32 TOTAL_BINS		= 16;
+	static const u32 MAX_LEAF_PRIMS	= 64;
+
+	typedef MOAIMeshBVHBuilderPrim Prim;
+
+	ZLLeanArray < Prim >				mPrims;
+	ZLLeanArray < u32 >					mOrder;
+	ZLLeanArray < MOAIMeshBVHNode >		mNodes;
+	u32									mTotalNodes;
+	u32									mTargetPrimsPerNode;
+
+	//----------------------------------------------------------------//
+	void			Build					( MOAIMeshBVH& bvh, const MOAIMeshPrimReader& primReader, u32 targetPrimsPerNode );
+	void			BuildRecurse			( u32 nodeIdx, u32 base, u32 count, u32 depth );
+	u32				Split					( u32 base, u32 count, const ZLBox& bounds, const ZLBox& centroidBounds );
+	static float	SurfaceArea				( const ZLBox& box );
+};
+
+//================================================================//
+// MOAIMeshBVH
+//================================================================//
+// TODO: doxygen
+class MOAIMeshBVH :
+	public MOAIMeshPartition {
+private:
+
+	friend class MOAIMeshBVHBuilder;
+
+	static const u32 STREAM_MAGIC		= 0x4842564D; // 'MVBH'
+	static const u32 STREAM_VERSION		= 1;
+	static const u32 MAX_DEPTH			= 64;
+
+	ZLLeanArray < MOAIMeshBVHNode >			mNodes;
+	ZLLeanArray < MOAIMeshBVHTriangle >		mTriangles;
+
+	//----------------------------------------------------------------//
+	static float	IntersectBox			( const MOAIMeshBVHNode& node, const float* loc, const float* invVec, float maxTime );
+
+public:
+
+	static const u32	DEFAULT_TARGET_PRIMS_PER_NODE = 4;
+
+	GET_CONST ( size_t, TotalNodes, mNodes.Size ())
+	GET_CONST ( size_t, TotalTriangles, mTriangles.Size ())
+
+	//----------------------------------------------------------------//
+	bool		CanQuery					() const;
+	void		Clear						();
+	bool		FindClosestHit				( const ZLVec3D& loc, const ZLVec3D& vec, MOAIMeshHit& hit ) const;
+	void		FindPrimsForPoint			( const ZLVec3D& point, bool is3D, ZLLeanStack < u32 >& prims ) const;
+	void		Init						( const MOAIMeshPrimReader& primReader, u32 targetPrimsPerNode );
+	static bool	IntersectTriangle			( const ZLVec3D& v0, const ZLVec3D& e1, const ZLVec3D& e2, const ZLVec3D& loc, const ZLVec3D& vec, float maxTime, float& t, float& u, float& v );
+				MOAIMeshBVH					();
+				~MOAIMeshBVH				();
+	void		Print						();
+	bool		Read						( ZLStream& stream );
+	bool		Write						( ZLStream& stream ) const;
+};
+
+#endif
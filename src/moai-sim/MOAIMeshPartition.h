@@ -4,17 +4,37 @@
 #ifndef	MOAIMESHPARTITION_H
 #define	MOAIMESHPARTITION_H
 
+//================================================================//
+// MOAIMeshHit
+//================================================================//
+class MOAIMeshHit {
+public:
+
+	u32			mPrim;		// index of the prim that was hit
+	float		mTime;		// along the ray vector
+	ZLVec3D		mPoint;
+	float		mU;			// barycentric weight of the prim's second vertex
+	float		mV;			// barycentric weight of the prim's third vertex
+};
+
 //================================================================//
 // MOAIMeshPartition
 //================================================================//
 // TODO: doxygen
 class MOAIMeshPartition {
 public:
-	
+
 	//----------------------------------------------------------------//
 						MOAIMeshPartition			() {}
 	virtual				~MOAIMeshPartition			() {}
 	virtual void		Print						() {}
+
+	// partitions that can answer queries override these; the mesh falls
+	// back on a linear scan of its prims otherwise
+	virtual bool		CanQuery					() const { return false; }
+	virtual bool		FindClosestHit				( const ZLVec3D& loc, const ZLVec3D& vec, MOAIMeshHit& hit ) const { UNUSED ( loc ); UNUSED ( vec ); UNUSED ( hit ); return false; }
+	virtual void		FindPrimsForPoint			( const ZLVec3D& point, bool is3D, ZLLeanStack < u32 >& prims ) const { UNUSED ( point ); UNUSED ( is3D ); UNUSED ( prims ); }
+	virtual bool		Write						( ZLStream& stream ) const { UNUSED ( stream ); return false; }
 };
 
 #endif
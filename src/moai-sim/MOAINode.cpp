@@ -525,6 +525,18 @@ u32 MOAINode::GetAttrFlags ( u32 attrID ) {
 	return attr.GetFlags ();
 }
 
+//----------------------------------------------------------------//
+bool MOAINode::HasPullLinks () {
+
+	return this->mPullLinks != 0;
+}
+
+//----------------------------------------------------------------//
+bool MOAINode::HasUpdateListeners () {
+
+	return this->HasListener ( EVENT_NODE_PRE_UPDATE ) || this->HasListener ( EVENT_NODE_POST_UPDATE );
+}
+
 //----------------------------------------------------------------//
 bool MOAINode::IsNodeUpstream ( MOAINode* node ) {
 
@@ -676,6 +688,16 @@ void MOAINode::RemoveDepLink ( MOAIDepLink& link ) {
 	link.Update ();
 }
 
+//----------------------------------------------------------------//
+// for nodes whose state was written directly (i.e. by a bulk update); schedules
+// everything downstream without putting this node through an update
+void MOAINode::ScheduleDependents () {
+
+	if ( MOAINodeMgr::Get ().IsValid ()) {
+		this->ExtendUpdate ();
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAINode::ScheduleUpdate () {
 	
@@ -130,10 +130,13 @@ public:
 	void			DepNodeUpdate			();
 	void			ForceUpdate				();
 	u32				GetAttrFlags			( u32 attrID );
+	bool			HasPullLinks			();
+	bool			HasUpdateListeners		();
 					MOAINode				();
 					~MOAINode				();
 	void			RegisterLuaClass		( MOAILuaState& state );
 	void			RegisterLuaFuncs		( MOAILuaState& state );
+	void			ScheduleDependents		();
 	void			ScheduleUpdate			();
 	void			SetAttrLink				( int attrID, MOAINode* srcNode, int srcAttrID );
 	void			SetNodeLink				( MOAINode& srcNode );
@@ -4,11 +4,15 @@
 #ifndef	MOAIPARTICLE_H
 #define	MOAIPARTICLE_H
 
-class MOAIParticleState;
+#include <moai-sim/host_particles.h>
+
+class MOAIMaterial;
 
 //================================================================//
 // MOAIParticle
 //================================================================//
+// Innate particle registers. The particles themselves are stored by
+// MOAIParticleSystem as parallel arrays.
 class MOAIParticle {
 public:
 
@@ -19,14 +23,134 @@ public:
 		PARTICLE_DY,
 		TOTAL_PARTICLE_REG,
 	};
+};
+
+//================================================================//
+// MOAIParticleBatch
+//================================================================//
+// Scratch for updating a run of adjacent particles that share a state.
+// Registers are stored as columns of SIZE floats so each script
+// instruction is a tight loop over the whole batch; script sprites are
+// stored one row per sprite instruction.
+class MOAIParticleBatch {
+public:
+
+	static const u32 SIZE = 64;
+
+	u32									mFirst;				// index of the first particle in the system
+	u32									mTotal;
+	float								mT0 [ SIZE ];
+	float								mT1 [ SIZE ];
+
+	ZLLeanArray < float >				mRegisters;
+	ZLLeanArray < AKUParticleSprite >	mSprites;
+	u32									mTotalSprites;		// rows
+	
+	//----------------------------------------------------------------//
+	MOAIParticleBatch () :
+		mFirst ( 0 ),
+		mTotal ( 0 ),
+		mTotalSprites ( 0 ) {
+	}
+};
+
+//================================================================//
+// MOAIParticleSpriteBatch
+//================================================================//
+// Scratch for drawing a run of sprites that share a material straight
+// into the vertex cache. Sprite transforms and deck quads are staged as
+// columns, expanded to display space in one pass, then written as quads.
+class MOAIParticleSpriteBatch {
+public:
+
+	static const u32 SIZE = 64;
+
+	u32					mTotal;
+	MOAIMaterial*		mMaterial;
+
+	float				mX [ SIZE ];
+	float				mY [ SIZE ];
+	float				mCos [ SIZE ];
+	float				mSin [ SIZE ];
+	float				mXScl [ SIZE ];
+	float				mYScl [ SIZE ];
+	float				mQuadX [ 4 ][ SIZE ];
+	float				mQuadY [ 4 ][ SIZE ];
+	
+	ZLVec4D				mVtx [ SIZE * 4 ];
+	ZLVec2D				mUV [ SIZE * 4 ];
+	u32					mColors [ SIZE ];
+	
+	//----------------------------------------------------------------//
+	MOAIParticleSpriteBatch () :
+		mTotal ( 0 ),
+		mMaterial ( 0 ) {
+	}
+};
+
+//================================================================//
+// MOAIParticleRandom
+//================================================================//
+// Small xorshift generator. Each particle system owns one so its
+// simulation draws the same numbers however the systems are scheduled.
+class MOAIParticleRandom {
+private:
+
+	u32		mState;
+
+public:
+
+	GET_SET ( u32, State, mState )
+
+	//----------------------------------------------------------------//
+	MOAIParticleRandom () :
+		mState ( 0x9e3779b9 ) {
+	}
+
+	//----------------------------------------------------------------//
+	u32 Next () {
+	
+		u32 x = this->mState;
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		this->mState = x;
+		return x;
+	}
+
+	//----------------------------------------------------------------//
+	float Rand () {
+	
+		// top 24 bits; [ 0, 1 ] like ZLFloat::Rand
+		return ( float )( this->Next () >> 8 ) / ( float )0x00ffffff;
+	}
+
+	//----------------------------------------------------------------//
+	float Rand ( float range ) {
+	
+		return this->Rand () * range;
+	}
+
+	//----------------------------------------------------------------//
+	float Rand ( float lower, float upper ) {
+	
+		return ( lower != upper ) ? lower + ( this->Rand () * ( upper - lower )) : lower;
+	}
 
-	float					mAge;
-	float					mTerm;
-	float					mMass;
-	MOAIParticleState*		mState;
-	float*					mData;
+	//----------------------------------------------------------------//
+	int RandInt () {
+	
+		return ( int )( this->Next () >> 1 );
+	}
 
-	MOAIParticle*			mNext;
+	//----------------------------------------------------------------//
+	void Seed ( u32 seed ) {
+	
+		// scramble so nearby seeds give unrelated streams; zero is a fixed point
+		seed = ( seed ^ 0x5bd1e995 ) * 0x9e3779b1;
+		seed ^= seed >> 15;
+		this->mState = seed ? seed : 0x9e3779b9;
+	}
 };
 
 #endif
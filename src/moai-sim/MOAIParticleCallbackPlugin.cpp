@@ -29,7 +29,8 @@ MOAIParticleCallbackPlugin::~MOAIParticleCallbackPlugin () {
 }
 
 //----------------------------------------------------------------//
-void MOAIParticleCallbackPlugin::OnInit ( float* particle, float* registers ) {
+void MOAIParticleCallbackPlugin::OnInit ( float* particle, float* registers, MOAIParticleRandom& random ) {
+	UNUSED ( random );
 
 	if ( this->mInitFunc ) {
 		this->mInitFunc ( particle, registers );
@@ -27,7 +27,7 @@ public:
 	void			Init							( AKUParticleInitFunc initFunc, AKUParticleRenderFunc renderFunc, int size );
 					MOAIParticleCallbackPlugin		();
 					~MOAIParticleCallbackPlugin		();
-	void			OnInit							( float* particle, float* registers );
+	void			OnInit							( float* particle, float* registers, MOAIParticleRandom& random );
 	void			OnRender						( float* particle, float* registers, AKUParticleSprite* sprite, float t0, float t1, float term );
 	void			RegisterLuaClass				( MOAILuaState& state );
 	void			RegisterLuaFuncs				( MOAILuaState& state );
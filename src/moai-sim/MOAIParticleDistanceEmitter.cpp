@@ -48,9 +48,9 @@ int MOAIParticleDistanceEmitter::_setDistance ( lua_State* L ) {
 //================================================================//
 
 //----------------------------------------------------------------//
-float MOAIParticleDistanceEmitter::GetRandomDistance () {
+float MOAIParticleDistanceEmitter::GetRandomDistance ( MOAIParticleRandom& random ) {
 
-	return ZLFloat::Rand ( this->mMinDistance, this->mMaxDistance );
+	return random.Rand ( this->mMinDistance, this->mMaxDistance );
 }
 
 //----------------------------------------------------------------//
@@ -98,6 +98,26 @@ void MOAIParticleDistanceEmitter::SetDistanceRange ( float min, float max ) {
 	this->mMaxDistance = max;
 }
 
+//----------------------------------------------------------------//
+void MOAIParticleDistanceEmitter::SnapshotIn ( ZLStream& stream ) {
+
+	MOAIParticleEmitter::SnapshotIn ( stream );
+
+	this->mReset			= stream.Read < bool >( this->mReset );
+	this->mEmitLoc			= stream.Read < ZLVec3D >( this->mEmitLoc );
+	this->mEmitDistance		= stream.Read < float >( this->mEmitDistance );
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleDistanceEmitter::SnapshotOut ( ZLStream& stream ) {
+
+	MOAIParticleEmitter::SnapshotOut ( stream );
+
+	stream.Write < bool >( this->mReset );
+	stream.Write < ZLVec3D >( this->mEmitLoc );
+	stream.Write < float >( this->mEmitDistance );
+}
+
 //================================================================//
 // ::implementation::
 //================================================================//
@@ -110,21 +130,17 @@ void MOAIParticleDistanceEmitter::MOAIAction_Update ( double step ) {
 }
 
 //----------------------------------------------------------------//
-void MOAIParticleDistanceEmitter::MOAINode_Update () {
+void MOAIParticleDistanceEmitter::MOAIParticleEmitter_Emit ( MOAIParticleSystem& system, u32 total ) {
+	UNUSED ( total );
 
-	MOAITransform::MOAINode_Update ();
-
-	if ( !this->mSystem ) {
-		this->mReset = true;
-		return;
-	}
+	MOAIParticleRandom& random = system.GetRandom ();
 
 	ZLVec3D loc = this->mLocalToWorldMtx.GetTranslation ();
 	float dist = ZLDist::VecToVec ( loc, this->mEmitLoc );
 
 	if ( this->mReset ) {
 		
-		this->mEmitDistance = this->GetRandomDistance ();
+		this->mEmitDistance = this->GetRandomDistance ( random );
 		this->mEmitLoc = loc;
 		this->mReset = false;
 		
@@ -159,19 +175,19 @@ void MOAIParticleDistanceEmitter::MOAINode_Update () {
 			
 			offset.Append ( this->mLocalToWorldMtx );
 			
-			u32 emission = this->GetRandomEmission ();
+			u32 emission = this->GetRandomEmission ( random );
 			
 			ZLVec3D particleLoc;
 			ZLVec3D particleVec;
 			
 			for ( u32 i = 0; i < emission; ++i ) {
 				
-				this->GetRandomParticle ( particleLoc, particleVec );
+				this->GetRandomParticle ( random, particleLoc, particleVec );
 				
 				offset.Transform ( particleLoc );
 				offset.TransformVec ( particleVec );
 				
-				this->mSystem->PushParticle (
+				system.PushParticle (
 					particleLoc.mX + ( this->mEmitLoc.mX - loc.mX ),
 					particleLoc.mY + ( this->mEmitLoc.mY - loc.mY ),
 					particleVec.mX,
@@ -185,7 +201,17 @@ void MOAIParticleDistanceEmitter::MOAINode_Update () {
 			this->mEmitLoc.Add ( emitStep );
 			
 			dist -= this->mEmitDistance;
-			this->mEmitDistance = this->GetRandomDistance ();
+			this->mEmitDistance = this->GetRandomDistance ( random );
 		}
 	}
 }
+
+//----------------------------------------------------------------//
+void MOAIParticleDistanceEmitter::MOAINode_Update () {
+
+	MOAIParticleEmitter::MOAINode_Update ();
+
+	if ( !this->mSystem ) {
+		this->mReset = true;
+	}
+}
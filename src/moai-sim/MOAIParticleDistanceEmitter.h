@@ -30,11 +30,12 @@ private:
 	static int		_setDistance			( lua_State* L );
 	
 	//----------------------------------------------------------------//
-	float			GetRandomDistance		();
+	float			GetRandomDistance		( MOAIParticleRandom& random );
 	
 	//----------------------------------------------------------------//
-	void			MOAIAction_Update		( double step );
-	void			MOAINode_Update			();
+	void			MOAIAction_Update				( double step );
+	void			MOAIParticleEmitter_Emit		( MOAIParticleSystem& system, u32 total );
+	void			MOAINode_Update					();
 
 public:
 	
@@ -46,6 +47,8 @@ public:
 	void			RegisterLuaClass				( MOAILuaState& state );
 	void			RegisterLuaFuncs				( MOAILuaState& state );
 	void			SetDistanceRange				( float min, float max );
+	void			SnapshotIn						( ZLStream& stream );
+	void			SnapshotOut						( ZLStream& stream );
 };
 
 #endif
@@ -191,6 +191,12 @@ int MOAIParticleEmitter::_surge ( lua_State* L ) {
 // MOAIParticleEmitter
 //================================================================//
 
+//----------------------------------------------------------------//
+void MOAIParticleEmitter::Emit ( MOAIParticleSystem& system, u32 total ) {
+
+	this->MOAIParticleEmitter_Emit ( system, total );
+}
+
 //----------------------------------------------------------------//
 u32 MOAIParticleEmitter::GetRandomEmission () {
 
@@ -198,13 +204,19 @@ u32 MOAIParticleEmitter::GetRandomEmission () {
 }
 
 //----------------------------------------------------------------//
-void MOAIParticleEmitter::GetRandomParticle ( ZLVec3D& loc, ZLVec3D& vec ) {
+u32 MOAIParticleEmitter::GetRandomEmission ( MOAIParticleRandom& random ) {
+
+	return ( u32 )random.Rand (( float )this->mMinEmission, ( float )this->mMaxEmission );
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleEmitter::GetRandomParticle ( MOAIParticleRandom& random, ZLVec3D& loc, ZLVec3D& vec ) {
 	
 	switch ( this->mShapeID ) {
 	
 		case CIRCLE:
 			
-			loc = this->GetRandomVec ( 0.0f, 360.0f, this->mInnerRadius, this->mOuterRadius );
+			loc = this->GetRandomVec ( random, 0.0f, 360.0f, this->mInnerRadius, this->mOuterRadius );
 			break;
 
 		default:
@@ -217,20 +229,20 @@ void MOAIParticleEmitter::GetRandomParticle ( ZLVec3D& loc, ZLVec3D& vec ) {
 
 		case RECT:
 		
-			loc.mX = ZLFloat::Rand ( this->mRect.mXMin, this->mRect.mXMax );
-			loc.mY = ZLFloat::Rand ( this->mRect.mYMin, this->mRect.mYMax );
+			loc.mX = random.Rand ( this->mRect.mXMin, this->mRect.mXMax );
+			loc.mY = random.Rand ( this->mRect.mYMin, this->mRect.mYMax );
 			loc.mZ = 0.0f;
 			break;
 	}
 	
-	vec = this->GetRandomVec ( this->mMinAngle, this->mMaxAngle, this->mMinMagnitude, this->mMaxMagnitude );
+	vec = this->GetRandomVec ( random, this->mMinAngle, this->mMaxAngle, this->mMinMagnitude, this->mMaxMagnitude );
 }
 
 //----------------------------------------------------------------//
-ZLVec3D MOAIParticleEmitter::GetRandomVec ( float minAngle, float maxAngle, float min, float max ) {
+ZLVec3D MOAIParticleEmitter::GetRandomVec ( MOAIParticleRandom& random, float minAngle, float maxAngle, float min, float max ) {
 
-	float r = ZLFloat::Rand ( minAngle, maxAngle ) * ( float )D2R;
-	float m = ZLFloat::Rand ( min, max );
+	float r = random.Rand ( minAngle, maxAngle ) * ( float )D2R;
+	float m = random.Rand ( min, max );
 	
 	ZLVec3D vec;
 	vec.mX = Cos ( r ) * m;
@@ -337,6 +349,20 @@ void MOAIParticleEmitter::SetMagnitudeRange ( float min, float max ) {
 	this->mMaxMagnitude = max;
 }
 
+//----------------------------------------------------------------//
+void MOAIParticleEmitter::SnapshotIn ( ZLStream& stream ) {
+
+	MOAITransform::SnapshotIn ( stream );
+	MOAIAction::SnapshotIn ( stream );
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleEmitter::SnapshotOut ( ZLStream& stream ) {
+
+	MOAITransform::SnapshotOut ( stream );
+	MOAIAction::SnapshotOut ( stream );
+}
+
 //----------------------------------------------------------------//
 void MOAIParticleEmitter::Surge ( u32 total ) {
 	
@@ -354,26 +380,33 @@ bool MOAIParticleEmitter::MOAIAction_IsDone () {
 	return false;
 }
 
+//----------------------------------------------------------------//
+void MOAIParticleEmitter::MOAIParticleEmitter_Emit ( MOAIParticleSystem& system, u32 total ) {
+
+	// may run on a worker thread; see MOAIParticleSystem::RunJob ()
+	MOAIParticleRandom& random = system.GetRandom ();
+
+	ZLVec3D loc;
+	ZLVec3D vec;
+	for ( u32 i = 0; i < total; ++i ) {
+		this->GetRandomParticle ( random, loc, vec );
+		this->mLocalToWorldMtx.Transform ( loc );
+		
+		if ( this->MaskParticle ( loc )) {
+		
+			this->mLocalToWorldMtx.TransformVec ( vec );
+			system.PushParticle ( loc.mX, loc.mY, vec.mX, vec.mY, this->mParticleState );
+		}
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIParticleEmitter::MOAINode_Update () {
 
 	MOAITransform::MOAINode_Update ();
 	
 	if ( this->mSystem ) {
-
-		ZLVec3D loc;
-		ZLVec3D vec;
-		for ( u32 i = 0; i < this->mEmission; ++i ) {
-			this->GetRandomParticle ( loc, vec );
-			this->mLocalToWorldMtx.Transform ( loc );
-			
-			if ( this->MaskParticle ( loc )) {
-			
-				this->mLocalToWorldMtx.TransformVec ( vec );
-				this->mSystem->PushParticle ( loc.mX, loc.mY, vec.mX, vec.mY, this->mParticleState );
-			}
-		}
+		this->mSystem->PushEmitter ( *this, this->mEmission );
 	}
-	
 	this->mEmission = 0;
 }
@@ -5,6 +5,7 @@
 #define	MOAIPARTICLEEMITTER_H
 
 #include <moai-sim/MOAIAction.h>
+#include <moai-sim/MOAIParticle.h>
 #include <moai-sim/MOAITransform.h>
 
 class MOAIParticleSystem;
@@ -55,13 +56,15 @@ protected:
 	
 	//----------------------------------------------------------------//
 	u32				GetRandomEmission		();
-	void			GetRandomParticle		( ZLVec3D& loc, ZLVec3D& vec ); // in local space
-	ZLVec3D			GetRandomVec			( float minAngle, float maxAngle, float min, float max );
+	u32				GetRandomEmission		( MOAIParticleRandom& random );
+	void			GetRandomParticle		( MOAIParticleRandom& random, ZLVec3D& loc, ZLVec3D& vec ); // in local space
+	ZLVec3D			GetRandomVec			( MOAIParticleRandom& random, float minAngle, float maxAngle, float min, float max );
 	bool			MaskParticle			( const ZLVec3D& loc );
 
 	//----------------------------------------------------------------//
-	bool			MOAIAction_IsDone		();
-	void			MOAINode_Update			();
+	bool			MOAIAction_IsDone				();
+	virtual void	MOAIParticleEmitter_Emit		( MOAIParticleSystem& system, u32 total );
+	void			MOAINode_Update					();
 
 public:
 	
@@ -77,6 +80,7 @@ public:
 	SET ( u32, ShapeID, mShapeID )
 
 	//----------------------------------------------------------------//
+	void			Emit					( MOAIParticleSystem& system, u32 total );
 					MOAIParticleEmitter		();
 					~MOAIParticleEmitter	();
 	void			RegisterLuaClass		( MOAILuaState& state );
@@ -86,6 +90,8 @@ public:
 	void			SetAngleRange			( float min, float max );
 	void			SetEmissionRange		( u32 min, u32 max );
 	void			SetMagnitudeRange		( float min, float max );
+	void			SnapshotIn				( ZLStream& stream );
+	void			SnapshotOut				( ZLStream& stream );
 	void			Surge					( u32 total );
 };
 
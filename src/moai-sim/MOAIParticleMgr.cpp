@@ -0,0 +1,135 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#include <moai-sim/MOAIParticleMgr.h>
+#include <moai-sim/MOAIParticleSystem.h>
+
+//================================================================//
+// local
+//================================================================//
+
+//----------------------------------------------------------------//
+/**	@lua	getWorkerCount
+	@text	Returns the number of worker threads.
+	
+	@out	number count
+*/
+int MOAIParticleMgr::_getWorkerCount ( lua_State* L ) {
+	MOAI_LUA_SETUP_SINGLE ( MOAIParticleMgr, "" )
+
+	state.Push ( self->mWorkers.GetWorkerCount ());
+	return 1;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	setWorkerCount
+	@text	Sets the number of worker threads used to simulate threaded
+			particle systems, in addition to the main thread.
+	
+	@opt	number count			Default value is 0.
+	@out	nil
+*/
+int MOAIParticleMgr::_setWorkerCount ( lua_State* L ) {
+	MOAI_LUA_SETUP_SINGLE ( MOAIParticleMgr, "" )
+
+	self->mWorkers.SetWorkerCount ( state.GetValue < u32 >( 1, 0 ));
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	update
+	@text	Runs and joins any pending threaded particle updates. Called
+			by the sim every step; only needed when driving systems by
+			hand.
+	
+	@out	nil
+*/
+int MOAIParticleMgr::_update ( lua_State* L ) {
+	MOAI_LUA_SETUP_SINGLE ( MOAIParticleMgr, "" )
+
+	self->Update ();
+	return 0;
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleMgr::_updateSystem ( void* param, u32 idx ) {
+
+	MOAIParticleMgr* self = ( MOAIParticleMgr* )param;
+	self->mSystems [ idx ]->RunJob ();
+}
+
+//================================================================//
+// MOAIParticleMgr
+//================================================================//
+
+//----------------------------------------------------------------//
+void MOAIParticleMgr::AffirmSystem ( MOAIParticleSystem& system ) {
+
+	if ( system.mIsQueued ) return;
+
+	this->LuaRetain ( &system );
+	this->mSystems.Push ( &system );
+	system.mIsQueued = true;
+}
+
+//----------------------------------------------------------------//
+MOAIParticleMgr::MOAIParticleMgr () {
+
+	RTTI_SINGLE ( MOAILuaObject )
+}
+
+//----------------------------------------------------------------//
+MOAIParticleMgr::~MOAIParticleMgr () {
+
+	this->mWorkers.Stop ();
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleMgr::RegisterLuaClass ( MOAILuaState& state ) {
+
+	luaL_Reg regTable [] = {
+		{ "getWorkerCount",			_getWorkerCount },
+		{ "setWorkerCount",			_setWorkerCount },
+		{ "update",					_update },
+		{ NULL, NULL }
+	};
+
+	luaL_register ( state, 0, regTable );
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleMgr::RegisterLuaFuncs ( MOAILuaState& state ) {
+	UNUSED ( state );
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleMgr::Update () {
+
+	u32 total = ( u32 )this->mSystems.GetTop ();
+	if ( !total ) return;
+
+	// a system may have picked up a callback plugin since it was queued; run
+	// those here and move the rest to the front for the workers
+	u32 threaded = 0;
+	for ( u32 i = 0; i < total; ++i ) {
+		MOAIParticleSystem* system = this->mSystems [ i ];
+		if ( system->IsThreaded ()) {
+			this->mSystems [ i ] = this->mSystems [ threaded ];
+			this->mSystems [ threaded++ ] = system;
+		}
+		else {
+			system->RunJob ();
+		}
+	}
+
+	this->mWorkers.Run ( _updateSystem, this, threaded );
+
+	// anything touching the node graph or Lua happens back on this thread
+	for ( u32 i = 0; i < total; ++i ) {
+		MOAIParticleSystem* system = this->mSystems [ i ];
+		system->FinishJob ();
+		this->LuaRelease ( system );
+	}
+	this->mSystems.Reset ();
+}
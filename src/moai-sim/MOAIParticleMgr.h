@@ -0,0 +1,50 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAIPARTICLEMGR_H
+#define	MOAIPARTICLEMGR_H
+
+#include <moai-util/MOAIWorkerPool.h>
+
+class MOAIParticleSystem;
+
+//================================================================//
+// MOAIParticleMgr
+//================================================================//
+/**	@lua	MOAIParticleMgr
+	@text	Runs the simulation of threaded particle systems. Systems
+			put in threaded mode defer their updates and emitter spawns
+			until the end of the action pass; the manager then runs
+			them across a pool of worker threads and joins before nodes
+			are updated. The main thread always takes part, so a worker
+			count of zero simulates the same systems serially.
+*/
+class MOAIParticleMgr :
+	public ZLContextClass < MOAIParticleMgr, MOAILuaObject > {
+private:
+
+	MOAIWorkerPool								mWorkers;
+	ZLLeanStack < MOAIParticleSystem*, 32 >		mSystems;
+
+	//----------------------------------------------------------------//
+	static int		_getWorkerCount			( lua_State* L );
+	static int		_setWorkerCount			( lua_State* L );
+	static int		_update					( lua_State* L );
+
+	//----------------------------------------------------------------//
+	static void		_updateSystem			( void* param, u32 idx );
+
+public:
+
+	DECL_LUA_SINGLETON ( MOAIParticleMgr )
+
+	//----------------------------------------------------------------//
+	void			AffirmSystem			( MOAIParticleSystem& system );
+					MOAIParticleMgr			();
+					~MOAIParticleMgr		();
+	void			RegisterLuaClass		( MOAILuaState& state );
+	void			RegisterLuaFuncs		( MOAILuaState& state );
+	void			Update					();
+};
+
+#endif
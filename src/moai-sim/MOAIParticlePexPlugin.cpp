@@ -188,41 +188,41 @@ MOAIParticlePexPlugin::~MOAIParticlePexPlugin () {
 }
 
 //----------------------------------------------------------------//
-void  MOAIParticlePexPlugin::OnInit ( float* particle, float* registers ) {
+void  MOAIParticlePexPlugin::OnInit ( float* particle, float* registers, MOAIParticleRandom& random ) {
 
 	// Set colors.
 	for ( int i = 0; i < 4; i++ ) {
 
 		if ( mStartColorRegister [ i ] > -1 ) {
 			float minVal = mStartColor [ i ] - mStartColorVariance [ i ] < 0 ? 0 : mStartColor [ i ] - mStartColorVariance [ i ];
-			registers[mStartColorRegister [ i ]] = ZLFloat::Rand ( minVal,  mStartColor [ i ] + mStartColorVariance [ i ]);
+			registers[mStartColorRegister [ i ]] = random.Rand ( minVal,  mStartColor [ i ] + mStartColorVariance [ i ]);
 		}	
 
 			
 		if ( mFinishColorRegister [ i ]  > -1 ) {
 			float minVal = mFinishColor [ i ] - mFinishColorVariance [ i ] < 0 ? 0 : mFinishColor [ i ] - mFinishColorVariance [ i ];
-			registers[mFinishColorRegister [ i ]] =ZLFloat::Rand ( minVal,  mFinishColor [ i ] + mFinishColorVariance [ i ]);
+			registers[mFinishColorRegister [ i ]] =random.Rand ( minVal,  mFinishColor [ i ] + mFinishColorVariance [ i ]);
 		}
 			
 	}
 
 	if ( mStartSizeRegister > -1 ) {
 		float minVal = mStartSize - mStartSizeVariance < 0 ? 0 :  mStartSize - mStartSizeVariance;
-		registers [ mStartSizeRegister ] = ZLFloat::Rand ( minVal,  mStartSize + mStartSizeVariance );
+		registers [ mStartSizeRegister ] = random.Rand ( minVal,  mStartSize + mStartSizeVariance );
 	}
 
 			
 	if ( mFinishSizeRegister > -1 ) {
 		float minVal = mFinishSize - mFinishSizeVariance < 0 ? 0 :  mFinishSize - mFinishSizeVariance;
-		registers [ mFinishSizeRegister ] = ZLFloat::Rand ( minVal,  mFinishSize + mFinishSizeVariance );
+		registers [ mFinishSizeRegister ] = random.Rand ( minVal,  mFinishSize + mFinishSizeVariance );
 	}
 
 	if ( mRotStartRegister > -1 )
-		registers [ mRotStartRegister] = ZLFloat::Rand ( mRotStart-mRotStartVariance, mRotStart+mRotStartVariance );
+		registers [ mRotStartRegister] = random.Rand ( mRotStart-mRotStartVariance, mRotStart+mRotStartVariance );
 	
 
 	if ( mRotEndRegister > -1 ) {
-		registers [ mRotStartRegister ] = ZLFloat::Rand ( mRotEnd-mRotEndVariance, mRotEnd+mRotEndVariance );
+		registers [ mRotStartRegister ] = random.Rand ( mRotEnd-mRotEndVariance, mRotEnd+mRotEndVariance );
 	}
 
 	float angleStartDeg;
@@ -237,7 +237,7 @@ void  MOAIParticlePexPlugin::OnInit ( float* particle, float* registers ) {
 	}
 
 	if ( mAngleRegister > -1 ) {
-		angleStartDeg += ZLFloat::Rand ( -mAngleVariance, + mAngleVariance );
+		angleStartDeg += random.Rand ( -mAngleVariance, + mAngleVariance );
 	}
 	
 	particle [ MOAIParticle::PARTICLE_DX ] = Cos ( angleStartDeg * ( float )D2R );
@@ -247,7 +247,7 @@ void  MOAIParticlePexPlugin::OnInit ( float* particle, float* registers ) {
 	
 		// Set initial speed
 		if ( mSpeedRegister > -1 ) {
-			registers [ mSpeedRegister ] = ZLFloat::Rand ( mSpeed - mSpeedVariance, mSpeed + mSpeedVariance );
+			registers [ mSpeedRegister ] = random.Rand ( mSpeed - mSpeedVariance, mSpeed + mSpeedVariance );
 			registers [ mDirectionXRegister ] = particle [ MOAIParticle::PARTICLE_DX ] * registers [ mSpeedRegister ];
 			registers [ mDirectionYRegister ] = particle [ MOAIParticle::PARTICLE_DY ] * registers [ mSpeedRegister ];
 		}
@@ -257,18 +257,18 @@ void  MOAIParticlePexPlugin::OnInit ( float* particle, float* registers ) {
 		}
 		
 		if ( mRadialAccelRegister > -1 ) {
-			registers [ mRadialAccelRegister ] = ZLFloat::Rand ( mRadialAcceleration - mRadialAccelVariance, mRadialAcceleration + mRadialAccelVariance );
+			registers [ mRadialAccelRegister ] = random.Rand ( mRadialAcceleration - mRadialAccelVariance, mRadialAcceleration + mRadialAccelVariance );
 		}
 
 
 		if ( mTanAccelRegister > -1 ) {
-			registers [ mTanAccelRegister ] = ZLFloat::Rand ( mTanAccel - mTanAccelVariance, mTanAccel + mTanAccelVariance );
+			registers [ mTanAccelRegister ] = random.Rand ( mTanAccel - mTanAccelVariance, mTanAccel + mTanAccelVariance );
 		}
 	}
 	else {
 	
 		if ( mRotPerSecondVariance != 0 ) {
-			float randVal =  ZLFloat::Rand ( mRotPerSecond - mRotPerSecondVariance, mRotPerSecond + mRotPerSecondVariance );
+			float randVal =  random.Rand ( mRotPerSecond - mRotPerSecondVariance, mRotPerSecond + mRotPerSecondVariance );
 			registers [ mRotPerSecondRegister ] = randVal;
 		}
 		else {
@@ -276,7 +276,7 @@ void  MOAIParticlePexPlugin::OnInit ( float* particle, float* registers ) {
 		}
 		
 		if ( mMaxRadiusRegister > -1 ) {
-			registers [ mMaxRadiusRegister ] = ZLFloat::Rand ( mMaxRadius - mMaxRadiusVariance, mMaxRadius + mMaxRadiusVariance );
+			registers [ mMaxRadiusRegister ] = random.Rand ( mMaxRadius - mMaxRadiusVariance, mMaxRadius + mMaxRadiusVariance );
 			particle [ MOAIParticle::PARTICLE_X ] += Cos ( angleStartDeg * ( float )D2R ) * registers [ mMaxRadiusRegister ];
 			particle [ MOAIParticle::PARTICLE_Y ] += Sin ( angleStartDeg * ( float )D2R ) * registers [ mMaxRadiusRegister ];
 		}
@@ -289,8 +289,8 @@ void  MOAIParticlePexPlugin::OnInit ( float* particle, float* registers ) {
 	}
 
 	// pick a slightly different source position, based on mSourcePos
-	registers [ mStartXRegister ] = particle [ MOAIParticle::PARTICLE_X ] + mSourcePos [ 0 ] + ZLFloat::Rand ( -mSourcePosVariance [ 0 ], + mSourcePosVariance [ 0 ]);
-	registers [ mStartYRegister ] = particle [ MOAIParticle::PARTICLE_Y ] + mSourcePos [ 1 ] + ZLFloat::Rand ( -mSourcePosVariance [ 1 ], + mSourcePosVariance [ 1 ]);
+	registers [ mStartXRegister ] = particle [ MOAIParticle::PARTICLE_X ] + mSourcePos [ 0 ] + random.Rand ( -mSourcePosVariance [ 0 ], + mSourcePosVariance [ 0 ]);
+	registers [ mStartYRegister ] = particle [ MOAIParticle::PARTICLE_Y ] + mSourcePos [ 1 ] + random.Rand ( -mSourcePosVariance [ 1 ], + mSourcePosVariance [ 1 ]);
 
 	particle [ MOAIParticle::PARTICLE_X ] = registers [ mStartXRegister ];
 	particle [ MOAIParticle::PARTICLE_Y ] = registers [ mStartYRegister ];
@@ -136,7 +136,7 @@ public:
 	//----------------------------------------------------------------//
 					MOAIParticlePexPlugin		();
 					~MOAIParticlePexPlugin		();
-	void			OnInit						( float* particle, float* registers );
+	void			OnInit						( float* particle, float* registers, MOAIParticleRandom& random );
 	void			OnRender					( float* particle, float* registers, AKUParticleSprite* sprite, float t0, float t1, float term );
 	void			RegisterLuaClass			( MOAILuaState& state );
 	void			RegisterLuaFuncs			( MOAILuaState& state );
@@ -5,6 +5,7 @@
 #define	MOAIPARTICLEPLUGIN_H
 
 #include <moai-sim/host_particles.h>
+#include <moai-sim/MOAIParticle.h>
 
 //================================================================//
 // MOAIParticlePlugin
@@ -26,7 +27,7 @@ public:
 	//----------------------------------------------------------------//
 					MOAIParticlePlugin			();
 					~MOAIParticlePlugin			();	
-	virtual void	OnInit						( float* particle, float* registers ) = 0;
+	virtual void	OnInit						( float* particle, float* registers, MOAIParticleRandom& random ) = 0;
 	virtual void	OnRender					( float* particle, float* registers, AKUParticleSprite* sprite, float t0, float t1, float term ) = 0;
 	void			RegisterLuaClass			( MOAILuaState& state );
 	void			RegisterLuaFuncs			( MOAILuaState& state );
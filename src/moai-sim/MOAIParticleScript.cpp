@@ -63,6 +63,69 @@
 		*( dst++ ) = *( bytecode++ );							\
 		*( dst++ ) = *( bytecode++ );
 
+// batched versions resolve each operand to a column of BATCH_SIZE floats;
+// constants and live registers are broadcast into scratch columns
+#define BATCH_SIZE MOAIParticleBatch::SIZE
+
+#define READ_COLUMN_ADDR(reg,bytecode)							\
+	type = *( bytecode++ );										\
+	regIdx = *( bytecode++ );									\
+	reg = 0;													\
+																\
+	if ( type == PARAM_TYPE_SPRITE_REG ) {						\
+		reg = &spriteRegisters [ regIdx * BATCH_SIZE ];			\
+	}															\
+	else if ( type == PARAM_TYPE_PARTICLE_REG ) {				\
+		reg = &particleRegisters [ regIdx * BATCH_SIZE ];		\
+	}
+
+#define READ_COLUMN_VALUE(var,bytecode)							\
+	type = *( bytecode++ );										\
+	if ( type == PARAM_TYPE_CONST ) {							\
+		dst = ( u8* )&value;									\
+		*( dst++ ) = *( bytecode++ );							\
+		*( dst++ ) = *( bytecode++ );							\
+		*( dst++ ) = *( bytecode++ );							\
+		*( dst++ ) = *( bytecode++ );							\
+		var = &tempRegisters [ ( temp++ ) * BATCH_SIZE ];		\
+		_fill ( var, value, total );							\
+	}															\
+	else {														\
+		regIdx = *( bytecode++ );								\
+																\
+		if ( type == PARAM_TYPE_SPRITE_REG ) {					\
+			var = &spriteRegisters [ regIdx * BATCH_SIZE ];		\
+		}														\
+		else if ( type == PARAM_TYPE_PARTICLE_REG ) {			\
+			var = &particleRegisters [ regIdx * BATCH_SIZE ];	\
+		}														\
+		else {													\
+			value = ( type == PARAM_TYPE_LIVE_REG ) ? this->mLiveRegisters [ regIdx ] : 0.0f;	\
+			var = &tempRegisters [ ( temp++ ) * BATCH_SIZE ];	\
+			_fill ( var, value, total );						\
+		}														\
+	}
+
+//================================================================//
+// local
+//================================================================//
+
+//----------------------------------------------------------------//
+static void _copy ( float* column, const float* src, u32 total ) {
+
+	for ( u32 i = 0; i < total; ++i ) {
+		column [ i ] = src [ i ];
+	}
+}
+
+//----------------------------------------------------------------//
+static void _fill ( float* column, float value, u32 total ) {
+
+	for ( u32 i = 0; i < total; ++i ) {
+		column [ i ] = value;
+	}
+}
+
 //================================================================//
 // MOAIParticleScript
 //================================================================//
@@ -652,10 +715,32 @@ u8* MOAIParticleScript::Compile () {
 	Instruction end;
 	end.Init ( END, "" );
 
+	this->mBatchable = true;
+	this->mParticleRegTop = 0;
+	this->mTotalSprites = 0;
+
 	u32 size = 0;
 	FOREACH ( InstructionIt, instructionIt, this->mInstructions ) {
 		Instruction& instruction = *instructionIt;
 		size += instruction.GetSize ();
+		
+		if ( instruction.mOpcode == SPRITE ) {
+			this->mTotalSprites++;
+		}
+		
+		for ( u32 i = 0; instruction.mFormat && instruction.mFormat [ i ]; ++i ) {
+		
+			cc8 c = instruction.mFormat [ i ];
+			u8 type = instruction.mTypes [ i ];
+			
+			if (( c == 'R' ) && ( type == PARAM_TYPE_LIVE_REG )) {
+				this->mBatchable = false;
+			}
+			
+			if ((( c == 'R' ) || ( c == 'V' )) && ( type == PARAM_TYPE_PARTICLE_REG )) {
+				this->mParticleRegTop = MAX ( this->mParticleRegTop, instruction.mParams [ i ] + 1 );
+			}
+		}
 	}
 	size += end.GetSize ();
 	
@@ -681,7 +766,10 @@ u8* MOAIParticleScript::Compile () {
 
 //----------------------------------------------------------------//
 MOAIParticleScript::MOAIParticleScript () :
-	mCompiled ( false ) {
+	mCompiled ( false ),
+	mBatchable ( true ),
+	mParticleRegTop ( 0 ),
+	mTotalSprites ( 0 ) {
 
 	int i;
 	
@@ -708,6 +796,42 @@ MOAIParticleScript::Instruction& MOAIParticleScript::PushInstruction ( u32 op, c
 	return this->mInstructions.back ();
 }
 
+//----------------------------------------------------------------//
+void MOAIParticleScript::CaptureSprites ( AKUParticleSprite* sprites, const float* registers, u32 total ) {
+
+	const float* xLoc		= &registers [ SPRITE_X_LOC * BATCH_SIZE ];
+	const float* yLoc		= &registers [ SPRITE_Y_LOC * BATCH_SIZE ];
+	const float* rot		= &registers [ SPRITE_ROT * BATCH_SIZE ];
+	const float* xScl		= &registers [ SPRITE_X_SCL * BATCH_SIZE ];
+	const float* yScl		= &registers [ SPRITE_Y_SCL * BATCH_SIZE ];
+	const float* red		= &registers [ SPRITE_RED * BATCH_SIZE ];
+	const float* green		= &registers [ SPRITE_GREEN * BATCH_SIZE ];
+	const float* blue		= &registers [ SPRITE_BLUE * BATCH_SIZE ];
+	const float* opacity	= &registers [ SPRITE_OPACITY * BATCH_SIZE ];
+	const float* glow		= &registers [ SPRITE_GLOW * BATCH_SIZE ];
+	const float* idx		= &registers [ SPRITE_IDX * BATCH_SIZE ];
+
+	for ( u32 i = 0; i < total; ++i ) {
+	
+		AKUParticleSprite& sprite = sprites [ i ];
+	
+		sprite.mXLoc		= xLoc [ i ];
+		sprite.mYLoc		= yLoc [ i ];
+		
+		sprite.mZRot		= rot [ i ];
+		
+		sprite.mXScl		= xScl [ i ];
+		sprite.mYScl		= yScl [ i ];
+		
+		sprite.mRed			= red [ i ] * opacity [ i ];
+		sprite.mGreen		= green [ i ] * opacity [ i ];
+		sprite.mBlue		= blue [ i ] * opacity [ i ];
+		sprite.mAlpha		= opacity [ i ] * ( 1.0f - glow [ i ]);
+		
+		sprite.mGfxID		= ZLFloat::ToInt ( idx [ i ]);
+	}
+}
+
 //----------------------------------------------------------------//
 u64 MOAIParticleScript::Pack64 ( u32 low, u32 hi ) {
 
@@ -818,6 +942,22 @@ void MOAIParticleScript::RegisterLuaFuncs ( MOAILuaState& state ) {
 	luaL_register ( state, 0, regTable );
 }
 
+//----------------------------------------------------------------//
+void MOAIParticleScript::ResetBatchRegisters ( float* spriteRegisters, const float* particleRegisters, const MOAIParticleSystem& system, u32 total ) {
+
+	_copy ( &spriteRegisters [ SPRITE_X_LOC * BATCH_SIZE ], &particleRegisters [ MOAIParticle::PARTICLE_X * BATCH_SIZE ], total );
+	_copy ( &spriteRegisters [ SPRITE_Y_LOC * BATCH_SIZE ], &particleRegisters [ MOAIParticle::PARTICLE_Y * BATCH_SIZE ], total );
+	_fill ( &spriteRegisters [ SPRITE_ROT * BATCH_SIZE ], 0.0f, total );
+	_fill ( &spriteRegisters [ SPRITE_X_SCL * BATCH_SIZE ], 1.0f, total );
+	_fill ( &spriteRegisters [ SPRITE_Y_SCL * BATCH_SIZE ], 1.0f, total );
+	_fill ( &spriteRegisters [ SPRITE_RED * BATCH_SIZE ], system.mR, total );
+	_fill ( &spriteRegisters [ SPRITE_GREEN * BATCH_SIZE ], system.mG, total );
+	_fill ( &spriteRegisters [ SPRITE_BLUE * BATCH_SIZE ], system.mB, total );
+	_fill ( &spriteRegisters [ SPRITE_OPACITY * BATCH_SIZE ], system.mA, total );
+	_fill ( &spriteRegisters [ SPRITE_GLOW * BATCH_SIZE ], 0.0f, total );
+	_fill ( &spriteRegisters [ SPRITE_IDX * BATCH_SIZE ], 1.0f, total );
+}
+
 //----------------------------------------------------------------//
 void MOAIParticleScript::ResetRegisters ( float* spriteRegisters, float* particleRegisters, const MOAIParticleSystem &system ) {
 
@@ -835,18 +975,18 @@ void MOAIParticleScript::ResetRegisters ( float* spriteRegisters, float* particl
 }
 
 //----------------------------------------------------------------//
-void MOAIParticleScript::Run ( MOAIParticleSystem& system, MOAIParticle& particle, float t0, float t1 ) {
+void MOAIParticleScript::Run ( MOAIParticleSystem& system, float* registers, float age, float t0, float t1 ) {
 
 	u8* dst;
 	u8* bytecode = this->mBytecode;
 	if ( !bytecode ) return;
 	
 	float particleRegisters [ MAX_PARTICLE_REGISTERS ];
-	memcpy ( particleRegisters, particle.mData, sizeof ( float ) * system.mParticleSize );
+	memcpy ( particleRegisters, registers, sizeof ( float ) * system.mParticleSize );
 	
 	float spriteRegisters [ TOTAL_SPRITE_REG ];
 	
-	spriteRegisters [ PARTICLE_AGE ] = particle.mAge;
+	spriteRegisters [ PARTICLE_AGE ] = age;
 	spriteRegisters [ PARTICLE_TIME ] = t1;
 	
 	float* r0;
@@ -1027,7 +1167,7 @@ void MOAIParticleScript::Run ( MOAIParticleSystem& system, MOAIParticle& particl
 				READ_VALUE  ( v3, bytecode );
 				
 				if ( r0 ) {
-					*r0 = v0 + ( float )( sin ( v1 + ( particle.mAge * v2 )) * v3 );
+					*r0 = v0 + ( float )( sin ( v1 + ( age * v2 )) * v3 );
 				}
 				break;
 			
@@ -1038,7 +1178,7 @@ void MOAIParticleScript::Run ( MOAIParticleSystem& system, MOAIParticle& particl
 				READ_VALUE	( v1, bytecode );
 				
 				if ( r0 ) {
-					*r0 = ZLFloat::Rand ( v0, v1 );
+					*r0 = system.mRandom.Rand ( v0, v1 );
 				}
 				break;
 				
@@ -1049,7 +1189,7 @@ void MOAIParticleScript::Run ( MOAIParticleSystem& system, MOAIParticle& particl
 				READ_VALUE	( v1, bytecode );
 				
 				if ( r0 ) {
-					*r0 = ( v0 != v1 ) ? v0 + ( rand () % ( int )( v1 - v0 + 1)) : v0;
+					*r0 = ( v0 != v1 ) ? v0 + ( system.mRandom.RandInt () % ( int )( v1 - v0 + 1)) : v0;
 				}
 				break;
 
@@ -1060,8 +1200,8 @@ void MOAIParticleScript::Run ( MOAIParticleSystem& system, MOAIParticle& particl
 				READ_VALUE	( v0, bytecode );
 				READ_VALUE	( v1, bytecode );
 				
-				v2 = ZLFloat::Rand ( 360.0f ) * ( float )D2R;
-				v3 = ZLFloat::Rand ( v0,  v1 );
+				v2 = system.mRandom.Rand ( 360.0f ) * ( float )D2R;
+				v3 = system.mRandom.Rand ( v0,  v1 );
 				
 				if ( r0 ) {
 					*r0 = Cos ( v2 ) * v3;
@@ -1177,9 +1317,469 @@ void MOAIParticleScript::Run ( MOAIParticleSystem& system, MOAIParticle& particl
 		}
 	}
 	
-	memcpy ( particle.mData, particleRegisters, sizeof ( float ) * system.mParticleSize );
+	memcpy ( registers, particleRegisters, sizeof ( float ) * system.mParticleSize );
 	
 	if ( push ) {
 		this->PushSprite ( system, spriteRegisters );
 	}
 }
+
+//----------------------------------------------------------------//
+void MOAIParticleScript::RunBatch ( MOAIParticleSystem& system, MOAIParticleBatch& batch ) {
+
+	u8* dst;
+	u8* bytecode = this->mBytecode;
+	
+	if ( !bytecode ) return;
+	
+	u32 total = batch.mTotal;
+	u32 particleSize = system.mParticleSize;
+	u32 particleColumns = MAX ( particleSize, this->mParticleRegTop );
+	u32 totalColumns = particleColumns + TOTAL_SPRITE_REG + TEMP_REG_COUNT;
+	
+	if ( batch.mRegisters.Size () < ( totalColumns * BATCH_SIZE )) {
+		batch.mRegisters.Init ( totalColumns * BATCH_SIZE );
+	}
+	
+	u32 totalRows = this->mTotalSprites * BATCH_SIZE;
+	if ( batch.mSprites.Size () < totalRows ) {
+		batch.mSprites.Init ( totalRows );
+	}
+	
+	float* particleRegisters = batch.mRegisters;
+	float* spriteRegisters = &particleRegisters [ particleColumns * BATCH_SIZE ];
+	float* tempRegisters = &spriteRegisters [ TOTAL_SPRITE_REG * BATCH_SIZE ];
+	
+	float* data = system.GetParticleData ( batch.mFirst );
+	const float* age = &system.mAge [ batch.mFirst ];
+	
+	// gather
+	for ( u32 i = 0; i < total; ++i ) {
+		const float* row = &data [ i * particleSize ];
+		for ( u32 j = 0; j < particleSize; ++j ) {
+			particleRegisters [( j * BATCH_SIZE ) + i ] = row [ j ];
+		}
+	}
+	
+	for ( u32 j = particleSize; j < particleColumns; ++j ) {
+		_fill ( &particleRegisters [ j * BATCH_SIZE ], 0.0f, total );
+	}
+	
+	_copy ( &spriteRegisters [ PARTICLE_AGE * BATCH_SIZE ], age, total );
+	_copy ( &spriteRegisters [ PARTICLE_TIME * BATCH_SIZE ], batch.mT1, total );
+	
+	const float* t0 = batch.mT0;
+	const float* t1 = batch.mT1;
+	
+	float* r0;
+	float* r1;
+	float* r2;
+	float* r3;
+	float* v0;
+	float* v1;
+	float* v2;
+	float* v3;
+	float value;
+	u32 i0;
+	
+	u8 type;
+	u8 regIdx;
+	u32 temp;
+
+	bool push = false;
+	u32 row = 0;
+	
+	for ( u8 opcode = *( bytecode++ ); opcode != END; opcode = *( bytecode++ )) {
+		
+		temp = 0;
+		
+		switch ( opcode ) {
+
+			case ABS: // RV
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = fabsf ( v0 [ i ]);
+					}
+				}
+				break;
+			
+			case ADD: // RVV
+				
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				READ_COLUMN_VALUE	( v1, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = v0 [ i ] + v1 [ i ];
+					}
+				}
+				break;
+			
+			case ANGLE_VEC: // RRV
+				
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_ADDR	( r1, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+
+				if ( r0 && r1 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						float angle = v0 [ i ] * ( float )D2R;
+						r0 [ i ] = ( float )( Cos ( angle ));
+						r1 [ i ] = ( float )( Sin ( angle ));
+					}
+				}
+				break;
+			
+			case COLOR: // RRRR
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_ADDR	( r1, bytecode );
+				READ_COLUMN_ADDR	( r2, bytecode );
+				READ_COLUMN_ADDR	( r3, bytecode );
+
+				if ( r0 && r1 && r2 ) {
+					_fill ( r0, system.mR, total );
+					_fill ( r1, system.mG, total );
+					_fill ( r2, system.mB, total );
+					// allow Alpha to be omitted.
+					if ( r3 ) {
+						_fill ( r3, system.mA, total );
+					}
+				}
+				break;
+			
+			case COS: // RVV
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = ( float )( cos ( v0 [ i ]));
+					}
+				}
+				break;
+
+			case CYCLE: // RVVV
+				
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				READ_COLUMN_VALUE	( v1, bytecode );
+				READ_COLUMN_VALUE	( v2, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+					
+						float range = v2 [ i ] - v1 [ i ];
+						range = ( range < 0.0f ) ? -range : range;
+						
+						float cycle = ( v0 [ i ] - v1 [ i ]) / range;
+						int cycleIdx = ZLFloat::ToInt ( ZLFloat::Floor ( cycle ));
+						float cycleDec = cycle - ( float )cycleIdx;
+						
+						if ( cycleIdx & 0x01 ) {
+							cycleDec = 1.0f - cycleDec;
+						}
+						r0 [ i ] = v1 [ i ] + ( cycleDec * range );
+					}
+				}
+				break;
+			
+			case DIV: // RVV
+				
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				READ_COLUMN_VALUE	( v1, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = v0 [ i ] / v1 [ i ];
+					}
+				}
+				break;
+			
+			case EASE: // RVVI
+				
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				READ_COLUMN_VALUE	( v1, bytecode );
+				READ_INT			( i0, bytecode );
+				
+				if ( r0 ) {
+				
+					if ( i0 == ZLInterpolate::kFlat ) {
+						for ( u32 i = 0; i < total; ++i ) {
+							r0 [ i ] = ( t1 [ i ] < 1.0f ) ? v0 [ i ] : v1 [ i ];
+						}
+					}
+					else {
+					
+						// curve first so the lerp is a clean loop
+						v2 = &tempRegisters [ temp * BATCH_SIZE ];
+						for ( u32 i = 0; i < total; ++i ) {
+							v2 [ i ] = ZLInterpolate::Curve ( i0, t1 [ i ]);
+						}
+						
+						for ( u32 i = 0; i < total; ++i ) {
+							r0 [ i ] = v0 [ i ] + (( v1 [ i ] - v0 [ i ]) * v2 [ i ]);
+						}
+					}
+				}
+				break;
+			
+			case EASE_DELTA: // RVVI
+				
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				READ_COLUMN_VALUE	( v1, bytecode );
+				READ_INT			( i0, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+					
+						float e0 = ZLInterpolate::Interpolate ( i0, v0 [ i ], v1 [ i ], t0 [ i ]);
+						float e1 = ZLInterpolate::Interpolate ( i0, v0 [ i ], v1 [ i ], t1 [ i ]);
+						
+						r0 [ i ] += ( e1 - e0 );
+					}
+				}
+				break;
+			
+			case MUL: // RVV
+				
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				READ_COLUMN_VALUE	( v1, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = v0 [ i ] * v1 [ i ];
+					}
+				}
+				break;
+			
+			case NORM:
+				
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_ADDR	( r1, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				READ_COLUMN_VALUE	( v1, bytecode );
+
+				if ( r0 && r1 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+					
+						float x = v0 [ i ];
+						float y = v1 [ i ];
+						float length = Sqrt (( x * x ) + ( y * y ));
+						
+						if ( length ) {
+							r0 [ i ] = ( float )( x / length );
+							r1 [ i ] = ( float )( y / length );
+						}
+						else {
+							r0 [ i ] = 0;
+							r1 [ i ] = 0;
+						}
+					}
+				}
+				break;
+			
+			case OSCILLATE: // RV
+
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				READ_COLUMN_VALUE	( v1, bytecode );
+				READ_COLUMN_VALUE	( v2, bytecode );
+				READ_COLUMN_VALUE	( v3, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = v0 [ i ] + ( float )( sin ( v1 [ i ] + ( age [ i ] * v2 [ i ])) * v3 [ i ]);
+					}
+				}
+				break;
+			
+			case RAND: // RVV
+				
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				READ_COLUMN_VALUE	( v1, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = system.mRandom.Rand ( v0 [ i ], v1 [ i ]);
+					}
+				}
+				break;
+				
+			case RAND_INT:
+				
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				READ_COLUMN_VALUE	( v1, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						float lower = v0 [ i ];
+						float upper = v1 [ i ];
+						r0 [ i ] = ( lower != upper ) ? lower + ( system.mRandom.RandInt () % ( int )( upper - lower + 1 )) : lower;
+					}
+				}
+				break;
+
+			case RAND_VEC: // RRVV
+				
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_ADDR	( r1, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				READ_COLUMN_VALUE	( v1, bytecode );
+				
+				for ( u32 i = 0; i < total; ++i ) {
+				
+					float angle = system.mRandom.Rand ( 360.0f ) * ( float )D2R;
+					float length = system.mRandom.Rand ( v0 [ i ], v1 [ i ]);
+					
+					if ( r0 ) {
+						r0 [ i ] = Cos ( angle ) * length;
+					}
+					
+					if ( r1 ) {
+						r1 [ i ] = -Sin ( angle ) * length;
+					}
+				}
+				break;
+
+			case SET: // RV
+				
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				
+				if ( r0 && ( r0 != v0 )) {
+					_copy ( r0, v0, total );
+				}
+				break;
+			
+			case SIN: // RV
+
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = ( float )( sin ( v0 [ i ]));
+					}
+				}
+				break;
+
+			case SPRITE: //
+				
+				if ( push ) {
+					this->CaptureSprites ( &batch.mSprites [ row++ * BATCH_SIZE ], spriteRegisters, total );
+				}
+				this->ResetBatchRegisters ( spriteRegisters, particleRegisters, system, total );
+				push = true;
+				break;
+
+			case STEP: // RVV
+
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				READ_COLUMN_VALUE	( v1, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = v0 [ i ] < v1 [ i ] ? 0.0f : 1.0f;
+					}
+				}
+				break;
+			
+			case SUB: // RVV
+				
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				READ_COLUMN_VALUE	( v1, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = v0 [ i ] - v1 [ i ];
+					}
+				}
+				break;
+
+			case TAN: // RV
+
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = ( float )( tan ( v0 [ i ]));
+					}
+				}
+				break;
+
+			case TIME: // RVV
+				
+				READ_COLUMN_ADDR	( r0, bytecode );
+				
+				if ( r0 ) {
+					_copy ( r0, t1, total );
+				}
+				break;
+			
+			case VEC_ANGLE: // RVV
+				
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				READ_COLUMN_VALUE	( v1, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+						r0 [ i ] = ( float )( atan2 ( v0 [ i ], v1 [ i ]) * R2D );
+					}
+				}
+				break;
+			
+			case WRAP: // RVVV
+				
+				READ_COLUMN_ADDR	( r0, bytecode );
+				READ_COLUMN_VALUE	( v0, bytecode );
+				READ_COLUMN_VALUE	( v1, bytecode );
+				READ_COLUMN_VALUE	( v2, bytecode );
+				
+				if ( r0 ) {
+					for ( u32 i = 0; i < total; ++i ) {
+					
+						float x = v0 [ i ];
+						float range = v2 [ i ] - v1 [ i ];
+						
+						while ( x < v1 [ i ]) {
+							x += range;
+						}
+						
+						while ( x >= v2 [ i ]) {
+							x -= range;
+						}
+						
+						r0 [ i ] = x;
+					}
+				}
+				break;
+		}
+	}
+	
+	// scatter
+	for ( u32 i = 0; i < total; ++i ) {
+		float* row = &data [ i * particleSize ];
+		for ( u32 j = 0; j < particleSize; ++j ) {
+			row [ j ] = particleRegisters [( j * BATCH_SIZE ) + i ];
+		}
+	}
+	
+	if ( push ) {
+		this->CaptureSprites ( &batch.mSprites [ row++ * BATCH_SIZE ], spriteRegisters, total );
+	}
+	batch.mTotalSprites = row;
+}
@@ -4,7 +4,7 @@
 #ifndef	MOAIPARTICLESCRIPT_H
 #define	MOAIPARTICLESCRIPT_H
 
-class MOAIParticle;
+class MOAIParticleBatch;
 class MOAIParticleState;
 class MOAIParticleSystem;
 
@@ -45,6 +45,7 @@ private:
 	static const u32 MAX_PARTICLE_REGISTERS = 256;
 	static const u32 PARTICLE_REGISTER_MASK = 0x000000ff;
 	static const u32 LIVE_REG_COUNT = 16;
+	static const u32 TEMP_REG_COUNT = 6; // scratch columns for batched constants
 
 	// "temporary" registers
 	enum {
@@ -125,6 +126,11 @@ private:
 	bool	mCompiled;
 	float	mLiveRegisters [ LIVE_REG_COUNT ]; // TODO: OK to let user reserve these?
 
+	// set by Compile (); scripts that write live registers run per particle
+	bool	mBatchable;
+	u32		mParticleRegTop;
+	u32		mTotalSprites;
+
 	//----------------------------------------------------------------//
 	static int		_abs				( lua_State* L );
 	static int		_add				( lua_State* L );
@@ -156,15 +162,19 @@ private:
 	static int		_wrap				( lua_State* L );
 	
 	//----------------------------------------------------------------//
+	void			CaptureSprites			( AKUParticleSprite* sprites, const float* registers, u32 total );
 	static u64		Pack64					( u32 low, u32 hi );
 	Instruction&	PushInstruction			( u32 op, cc8* format );
 	void			PushSprite				( MOAIParticleSystem& system, float* registers );
+	void			ResetBatchRegisters		( float* spriteRegisters, const float* particleRegisters, const MOAIParticleSystem& system, u32 total );
 	void			ResetRegisters			( float* spriteRegisters, float* particleRegisters, const MOAIParticleSystem& );
 
 public:
 	
 	DECL_LUA_FACTORY ( MOAIParticleScript )
 	
+	GET_CONST ( bool, Batchable, mBatchable )
+	
 	enum {
 		PARAM_TYPE_FLAG				= 0x00,
 		PARAM_TYPE_CONST			= 0x01,
@@ -182,7 +192,8 @@ public:
 					~MOAIParticleScript		();
 	void			RegisterLuaClass		( MOAILuaState& state );
 	void			RegisterLuaFuncs		( MOAILuaState& state );
-	void			Run						( MOAIParticleSystem& system, MOAIParticle& particle, float t0, float t1 );
+	void			Run						( MOAIParticleSystem& system, float* registers, float age, float t0, float t1 );
+	void			RunBatch				( MOAIParticleSystem& system, MOAIParticleBatch& batch );
 };
 
 #endif
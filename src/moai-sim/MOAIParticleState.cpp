@@ -199,6 +199,30 @@ void MOAIParticleState::ClearForces () {
 	}
 }
 
+//----------------------------------------------------------------//
+void MOAIParticleState::FinishParticle ( MOAIParticleSystem& system, u32 idx, float t0, float t1 ) {
+
+	MOAIParticlePlugin* plugin = this->mPlugin;
+	if ( plugin ) {
+		
+		float* r = system.GetParticleData ( idx );
+		
+		AKUParticleSprite sprite;
+		plugin->OnRender ( r, &r [ MOAIParticle::TOTAL_PARTICLE_REG ], &sprite, t0, t1, system.mTerm [ idx ]);
+		system.PushSprite ( sprite );
+	}
+
+	if ( system.mAge [ idx ] >= system.mTerm [ idx ]) {
+		
+		if ( this->mNext ) {
+			this->mNext->InitParticle ( system, idx );
+		}
+		else {
+			system.mParticleStates [ idx ] = 0;
+		}
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIParticleState::GatherForces ( ZLVec3D& loc, ZLVec3D& velocity, float mass, float step ) {
 
@@ -223,21 +247,45 @@ void MOAIParticleState::GatherForces ( ZLVec3D& loc, ZLVec3D& velocity, float ma
 }
 
 //----------------------------------------------------------------//
-void MOAIParticleState::InitParticle ( MOAIParticleSystem& system, MOAIParticle& particle ) {
+void MOAIParticleState::InitParticle ( MOAIParticleSystem& system, u32 idx ) {
+
+	float* r = system.GetParticleData ( idx );
 
 	if ( this->mInit ) {
-		this->mInit->Run ( system, particle, 0.0f, 0.0f );
+		this->mInit->Run ( system, r, system.mAge [ idx ], 0.0f, 0.0f );
 	}
 	
 	MOAIParticlePlugin* plugin = this->mPlugin;
 	if ( plugin ) {
-		plugin->OnInit ( particle.mData, &particle.mData [ MOAIParticle::TOTAL_PARTICLE_REG ]);
+		plugin->OnInit ( r, &r [ MOAIParticle::TOTAL_PARTICLE_REG ], system.mRandom );
 	}
 	
-	particle.mAge = 0.0f;
-	particle.mTerm = ZLFloat::Rand ( this->mTermRange [ 0 ], this->mTermRange [ 1 ]);
-	particle.mMass = ZLFloat::Rand ( this->mMassRange [ 0 ], this->mMassRange [ 1 ]);
-	particle.mState = this;
+	system.mAge [ idx ] = 0.0f;
+	system.mTerm [ idx ] = system.mRandom.Rand ( this->mTermRange [ 0 ], this->mTermRange [ 1 ]);
+	system.mMass [ idx ] = system.mRandom.Rand ( this->mMassRange [ 0 ], this->mMassRange [ 1 ]);
+	system.mParticleStates [ idx ] = this;
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleState::IntegrateParticle ( float* registers, float mass, float step ) {
+
+	ZLVec3D loc;
+	ZLVec3D vel;
+	
+	loc.mX = registers [ MOAIParticle::PARTICLE_X ];
+	loc.mY = registers [ MOAIParticle::PARTICLE_Y ];
+	loc.mZ = 0.0f;
+	
+	vel.mX = registers [ MOAIParticle::PARTICLE_DX ];
+	vel.mY = registers [ MOAIParticle::PARTICLE_DY ];
+	vel.mZ = 0.0f;
+	
+	this->GatherForces ( loc, vel, mass, step );
+	
+	registers [ MOAIParticle::PARTICLE_X ]	= loc.mX;
+	registers [ MOAIParticle::PARTICLE_Y ]	= loc.mY;
+	registers [ MOAIParticle::PARTICLE_DX ]	= vel.mX;
+	registers [ MOAIParticle::PARTICLE_DY ]	= vel.mY;
 }
 
 //----------------------------------------------------------------//
@@ -302,56 +350,51 @@ void MOAIParticleState::RegisterLuaFuncs ( MOAILuaState& state ) {
 }
 
 //----------------------------------------------------------------//
-void MOAIParticleState::ProcessParticle ( MOAIParticleSystem& system, MOAIParticle& particle, float step ) {
+void MOAIParticleState::ProcessParticles ( MOAIParticleSystem& system, MOAIParticleBatch& batch, float step ) {
 
-	float t0 = particle.mAge / particle.mTerm;
-	particle.mAge += step;
+	u32 first = batch.mFirst;
+	u32 total = batch.mTotal;
+	u32 particleSize = system.mParticleSize;
 	
-	if ( particle.mAge > particle.mTerm ) {
-		particle.mAge = particle.mTerm;
-	}
+	float* age			= &system.mAge [ first ];
+	const float* term	= &system.mTerm [ first ];
+	const float* mass	= &system.mMass [ first ];
+	float* registers	= system.GetParticleData ( first );
 	
-	float t1 = particle.mAge / particle.mTerm;
+	float* t0 = batch.mT0;
+	float* t1 = batch.mT1;
 	
-	float* r = particle.mData;
+	for ( u32 i = 0; i < total; ++i ) {
 	
-	ZLVec3D loc;
-	ZLVec3D vel;
-	
-	loc.mX = r [ MOAIParticle::PARTICLE_X ];
-	loc.mY = r [ MOAIParticle::PARTICLE_Y ];
-	loc.mZ = 0.0f;
+		t0 [ i ] = age [ i ] / term [ i ];
+		age [ i ] = MIN ( age [ i ] + step, term [ i ]);
+		t1 [ i ] = age [ i ] / term [ i ];
+	}
 	
-	vel.mX = r [ MOAIParticle::PARTICLE_DX ];
-	vel.mY = r [ MOAIParticle::PARTICLE_DY ];
-	vel.mZ = 0.0f;
+	for ( u32 i = 0; i < total; ++i ) {
+		this->IntegrateParticle ( &registers [ i * particleSize ], mass [ i ], step );
+	}
 	
-	this->GatherForces ( loc, vel, particle.mMass, step );
+	MOAIParticleScript* render = this->mRender;
+	bool batched = render && system.mScriptBatching && render->GetBatchable ();
 	
-	r [ MOAIParticle::PARTICLE_X ]	= loc.mX;
-	r [ MOAIParticle::PARTICLE_Y ]	= loc.mY;
-	r [ MOAIParticle::PARTICLE_DX ]	= vel.mX;
-	r [ MOAIParticle::PARTICLE_DY ]	= vel.mY;
-
-	if ( this->mRender ) {
-		this->mRender->Run ( system, particle, t0, t1 );
+	batch.mTotalSprites = 0;
+	if ( batched ) {
+		render->RunBatch ( system, batch );
 	}
 	
-	MOAIParticlePlugin* plugin = this->mPlugin;
-	if ( plugin ) {
-		
-		AKUParticleSprite sprite;
-		plugin->OnRender ( particle.mData, &particle.mData [ MOAIParticle::TOTAL_PARTICLE_REG ], &sprite, t0, t1, particle.mTerm );
-		system.PushSprite ( sprite );
-	}
-
-	if ( particle.mAge >= particle.mTerm ) {
-		
-		if ( this->mNext ) {
-			this->mNext->InitParticle ( system, particle );
+	// sprites go out per particle: script sprites, then the plugin sprite
+	u32 totalSprites = batch.mTotalSprites;
+	for ( u32 i = 0; i < total; ++i ) {
+	
+		if ( batched ) {
+			for ( u32 j = 0; j < totalSprites; ++j ) {
+				system.PushSprite ( batch.mSprites [( j * MOAIParticleBatch::SIZE ) + i ]);
+			}
 		}
-		else {
-			particle.mState = 0;
+		else if ( render ) {
+			render->Run ( system, &registers [ i * particleSize ], age [ i ], t0 [ i ], t1 [ i ]);
 		}
+		this->FinishParticle ( system, first + i, t0 [ i ], t1 [ i ]);
 	}
 }
@@ -48,9 +48,11 @@ private:
 	static int		_setTerm				( lua_State* L );
 
 	//----------------------------------------------------------------//
+	void			FinishParticle			( MOAIParticleSystem& system, u32 idx, float t0, float t1 );
 	void			GatherForces			( ZLVec3D& loc, ZLVec3D& velocity, float mass, float step );
-	void			InitParticle			( MOAIParticleSystem& system, MOAIParticle& particle );
-	void			ProcessParticle			( MOAIParticleSystem& system, MOAIParticle& particle, float step );
+	void			InitParticle			( MOAIParticleSystem& system, u32 idx );
+	void			IntegrateParticle		( float* registers, float mass, float step );
+	void			ProcessParticles		( MOAIParticleSystem& system, MOAIParticleBatch& batch, float step );
 
 public:
 
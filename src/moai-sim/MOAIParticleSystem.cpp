@@ -5,8 +5,15 @@
 #include <float.h>
 #include <moai-sim/MOAIDeck.h>
 #include <moai-sim/MOAIGfxMgr.h>
+#include <moai-sim/MOAIMaterialMgr.h>
+#include <moai-sim/MOAIParticleCallbackPlugin.h>
+#include <moai-sim/MOAIParticleEmitter.h>
+#include <moai-sim/MOAIParticleMgr.h>
 #include <moai-sim/MOAIParticleState.h>
 #include <moai-sim/MOAIParticleSystem.h>
+#include <moai-sim/MOAIQuadBrush.h>
+#include <moai-sim/MOAIShaderMgr.h>
+#include <moai-sim/MOAISpriteDeck2D.h>
 #include <moai-sim/MOAITextureBase.h>
 
 class MOAIDataBuffer;
@@ -94,7 +101,7 @@ int  MOAIParticleSystem::_isIdle( lua_State* L ) {
 	
 	MOAI_LUA_SETUP ( MOAIParticleSystem, "U" )
 
-	bool result = !self->mHead;
+	bool result = !self->mTotalParticles;
 
 	lua_pushboolean ( state, result );
 	return 1;
@@ -219,6 +226,25 @@ int MOAIParticleSystem::_reserveStates ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	setDirectDraw
+	@text	Controls whether sprites drawn from a MOAISpriteDeck2D are
+			expanded straight into the vertex cache, one run per
+			material, instead of being drawn through the deck one at a
+			time. Indices that name lists of more than one sprite, and
+			other kinds of deck, always draw through the deck.
+ 
+	@in		MOAIParticleSystem self
+	@opt	boolean directDraw			Default value is true.
+	@out	nil
+*/
+int MOAIParticleSystem::_setDirectDraw ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIParticleSystem, "U" )
+
+	self->mDirectDraw = state.GetValue < bool >( 2, true );
+	return 0;
+}
+
 //----------------------------------------------------------------//
 /**	@lua	setDrawOrder
 	@text	Set draw order of sprites in particle system
@@ -250,6 +276,43 @@ int MOAIParticleSystem::_setComputeBounds ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	setScriptBatching
+	@text	Controls whether render scripts run over runs of up to 64
+			particles in the same state at once. Batching is skipped
+			for scripts that write live registers. Batched and
+			unbatched updates consume random numbers in a different
+			order but otherwise give the same results.
+	
+	@in		MOAIParticleSystem self
+	@opt	boolean batching			Default value is true.
+	@out	nil
+*/
+int MOAIParticleSystem::_setScriptBatching ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIParticleSystem, "U" )
+
+	self->mScriptBatching = state.GetValue < bool >( 2, true );
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	setSeed
+	@text	Seeds the system's random number generator. Every random
+			draw made while simulating the system (emitter spawns,
+			state term and mass, script and plugin randoms) comes from
+			this stream.
+	
+	@in		MOAIParticleSystem self
+	@in		number seed
+	@out	nil
+*/
+int MOAIParticleSystem::_setSeed ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIParticleSystem, "UN" )
+
+	self->mRandom.Seed ( state.GetValue < u32 >( 2, 0 ));
+	return 0;
+}
+
 //----------------------------------------------------------------//
 /**	@lua	setSpriteColor
 	@text	Set the color of the most recently added sprite.
@@ -320,6 +383,33 @@ int MOAIParticleSystem::_setState ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	setThreaded
+	@text	In threaded mode the system's updates and the spawns of its
+			emitters are deferred to MOAIParticleMgr, which runs them on
+			worker threads at the end of the action pass. Emitter spawns
+			from one node update are made at the start of the system's
+			next update, which is also when an unthreaded system would
+			first simulate them.
+			
+			Threaded systems must not share scripts that write live
+			registers or emitters with other systems. A system with a
+			MOAIParticleCallbackPlugin on any of its states (or the states
+			they lead to) always updates serially, since its callbacks
+			may call back into Lua. Emissions still pending when a
+			snapshot is taken are not part of the snapshot.
+	
+	@in		MOAIParticleSystem self
+	@opt	boolean threaded			Default value is true.
+	@out	nil
+*/
+int MOAIParticleSystem::_setThreaded ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIParticleSystem, "U" )
+
+	self->mThreaded = state.GetValue < bool >( 2, true );
+	return 0;
+}
+
 //----------------------------------------------------------------//
 /**	@lua	surge
 	@text	Release a batch emission or particles into the system.
@@ -362,24 +452,247 @@ void MOAIParticleSystem::ClearStates () {
 }
 
 //----------------------------------------------------------------//
-void MOAIParticleSystem::ClearQueue () {
+void MOAIParticleSystem::CompactParticles () {
 
-	this->mHead = 0;
-	this->mTail = 0;
+	// stable, so the survivors keep their push order
+	u32 particleSize = this->mParticleSize;
+	u32 total = this->mTotalParticles;
+	u32 live = 0;
+	
+	for ( u32 i = 0; i < total; ++i ) {
+	
+		u32 src = this->GetParticleIdx ( i );
+		if ( !this->mParticleStates [ src ]) continue;
+		
+		if ( live != i ) {
+		
+			u32 dst = this->GetParticleIdx ( live );
+			
+			this->mAge [ dst ]				= this->mAge [ src ];
+			this->mTerm [ dst ]				= this->mTerm [ src ];
+			this->mMass [ dst ]				= this->mMass [ src ];
+			this->mParticleStates [ dst ]	= this->mParticleStates [ src ];
+			
+			memcpy ( this->GetParticleData ( dst ), this->GetParticleData ( src ), particleSize * sizeof ( float ));
+		}
+		live++;
+	}
+	
+	this->mTotalParticles = live;
+	if ( !live ) {
+		this->mParticleBase = 0;
+	}
 }
 
 //----------------------------------------------------------------//
-void MOAIParticleSystem::EnqueueParticle ( MOAIParticle& particle ) {
+void MOAIParticleSystem::DrawSprite ( const AKUParticleSprite& sprite ) {
 
-	if ( this->mTail ) {
-		this->mTail->mNext = &particle;
+	MOAIGfxState& gfxState = MOAIGfxMgr::Get ().mGfxState;
+	
+	gfxState.SetPenColor ( sprite.mRed, sprite.mGreen, sprite.mBlue, sprite.mAlpha );
+	
+	ZLAffine3D spriteMtx;
+	spriteMtx.ScRoTr ( sprite.mXScl, sprite.mYScl, 1.0f, 0.0f, 0.0f, sprite.mZRot * ( float )D2R, sprite.mXLoc, sprite.mYLoc, 0.0f );
+	
+	ZLAffine3D drawingMtx = this->GetLocalToWorldMtx ();
+	drawingMtx.Prepend ( spriteMtx );
+	
+	gfxState.SetMtx ( MOAIGfxState::MODEL_TO_WORLD_MTX, drawingMtx );
+	
+	//this->mDeck->Draw ( this->mIndex + ( u32 )sprite.mGfxID, this->mMaterialBatch );
+	this->mDeck->Draw ( this->mIndex + ( u32 )sprite.mGfxID );
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleSystem::DrawSpritesDirect ( MOAISpriteDeck2D& deck ) {
+
+	MOAIGfxState& gfxState = MOAIGfxMgr::Get ().mGfxState;
+	MOAIParticleSpriteBatch& batch = this->mSpriteBatch;
+	
+	// sprites are expanded straight to display space
+	gfxState.SetMtx ( MOAIGfxState::MODEL_TO_WORLD_MTX, this->GetLocalToWorldMtx ());
+	ZLMatrix4x4 mtx = gfxState.GetMtx ( MOAIGfxState::MODEL_TO_DISPLAY_MTX );
+	
+	ZLMatrix4x4 uvMtx = gfxState.GetMtx ( MOAIGfxState::UV_TO_MODEL_MTX );
+	bool transformUV = !uvMtx.IsIdent ();
+	
+	ZLColorVec ambient = gfxState.GetAmbientColor ();
+	
+	u32 maxSprites = ( u32 )this->mSprites.Size ();
+	u32 total = this->mSpriteTop;
+	u32 base = 0;
+	if ( total > maxSprites ) {
+		base = total % maxSprites;
+		total = maxSprites;
 	}
-	else {
-		this->mHead = &particle;
+	
+	// sprites tend to share a handful of deck indices; keep the last lookup
+	bool hasQuad = false;
+	bool isDirect = false;
+	u32 quadIdx = 0;
+	ZLQuad modelQuad;
+	ZLQuad uvQuad;
+	MOAIMaterial* material = 0;
+	
+	batch.mTotal = 0;
+	
+	for ( u32 i = 0; i < total; ++i ) {
+
+		u32 idx;
+		if ( this->mDrawOrder == ORDER_NORMAL ) {
+			idx = ( base + i ) % maxSprites;
+		}
+		else {
+			idx = ( base + ( total - 1 - i )) % maxSprites;
+		}
+		
+		const AKUParticleSprite& sprite = this->mSprites [ idx ];
+		u32 deckIdx = this->mIndex + ( u32 )sprite.mGfxID;
+		
+		if ( !( hasQuad && ( deckIdx == quadIdx ))) {
+		
+			hasQuad = true;
+			quadIdx = deckIdx;
+			isDirect = deck.GetQuad ( deckIdx, modelQuad, uvQuad, material );
+			
+			if ( isDirect && transformUV ) {
+				uvMtx.TransformQuad ( uvQuad.mV );
+			}
+		}
+		
+		if ( batch.mTotal && (( batch.mTotal == MOAIParticleSpriteBatch::SIZE ) || ( !isDirect ) || ( material != batch.mMaterial ))) {
+			this->FlushSpriteBatch ( mtx );
+		}
+		
+		if ( !isDirect ) {
+			this->DrawSprite ( sprite );
+			continue;
+		}
+		
+		u32 n = batch.mTotal++;
+		batch.mMaterial = material;
+		
+		float rot = sprite.mZRot * ( float )D2R;
+		
+		batch.mX [ n ]		= sprite.mXLoc;
+		batch.mY [ n ]		= sprite.mYLoc;
+		batch.mCos [ n ]	= Cos ( rot );
+		batch.mSin [ n ]	= Sin ( rot );
+		batch.mXScl [ n ]	= sprite.mXScl;
+		batch.mYScl [ n ]	= sprite.mYScl;
+		
+		for ( u32 j = 0; j < 4; ++j ) {
+			batch.mQuadX [ j ][ n ] = modelQuad.mV [ j ].mX;
+			batch.mQuadY [ j ][ n ] = modelQuad.mV [ j ].mY;
+			batch.mUV [( n * 4 ) + j ] = uvQuad.mV [ j ];
+		}
+		
+		batch.mColors [ n ] = ZLColor::PackRGBA (
+			ambient.mR * sprite.mRed,
+			ambient.mG * sprite.mGreen,
+			ambient.mB * sprite.mBlue,
+			ambient.mA * sprite.mAlpha
+		);
 	}
 	
-	particle.mNext = 0;
-	this->mTail = &particle;
+	if ( batch.mTotal ) {
+		this->FlushSpriteBatch ( mtx );
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleSystem::FinishJob () {
+
+	this->ReleaseEmissions ();
+	this->mPendingSteps.Reset ();
+	this->mIsQueued = false;
+	
+	if ( this->mScheduleAfterJob ) {
+		this->ScheduleUpdate ();
+	}
+	this->mScheduleAfterJob = false;
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleSystem::FlushSpriteBatch ( const ZLMatrix4x4& mtx ) {
+
+	MOAIParticleSpriteBatch& batch = this->mSpriteBatch;
+	u32 total = batch.mTotal;
+	
+	float m00 = mtx.m [ ZLMatrix4x4::C0_R0 ];
+	float m01 = mtx.m [ ZLMatrix4x4::C1_R0 ];
+	float m03 = mtx.m [ ZLMatrix4x4::C3_R0 ];
+	
+	float m10 = mtx.m [ ZLMatrix4x4::C0_R1 ];
+	float m11 = mtx.m [ ZLMatrix4x4::C1_R1 ];
+	float m13 = mtx.m [ ZLMatrix4x4::C3_R1 ];
+	
+	float m20 = mtx.m [ ZLMatrix4x4::C0_R2 ];
+	float m21 = mtx.m [ ZLMatrix4x4::C1_R2 ];
+	float m23 = mtx.m [ ZLMatrix4x4::C3_R2 ];
+	
+	float m30 = mtx.m [ ZLMatrix4x4::C0_R3 ];
+	float m31 = mtx.m [ ZLMatrix4x4::C1_R3 ];
+	float m33 = mtx.m [ ZLMatrix4x4::C3_R3 ];
+	
+	// scale, rotate and translate each corner, then take it to display space; the
+	// inner loop has no branches or lookups so it vectorizes
+	for ( u32 j = 0; j < 4; ++j ) {
+	
+		const float* qx = batch.mQuadX [ j ];
+		const float* qy = batch.mQuadY [ j ];
+		ZLVec4D* vtx = &batch.mVtx [ j ];
+	
+		for ( u32 i = 0; i < total; ++i ) {
+		
+			float lx = qx [ i ] * batch.mXScl [ i ];
+			float ly = qy [ i ] * batch.mYScl [ i ];
+			
+			float x = ( lx * batch.mCos [ i ]) - ( ly * batch.mSin [ i ]) + batch.mX [ i ];
+			float y = ( lx * batch.mSin [ i ]) + ( ly * batch.mCos [ i ]) + batch.mY [ i ];
+			
+			ZLVec4D& v = vtx [ i * 4 ];
+			
+			v.mX = ( m00 * x ) + ( m01 * y ) + m03;
+			v.mY = ( m10 * x ) + ( m11 * y ) + m13;
+			v.mZ = ( m20 * x ) + ( m21 * y ) + m23;
+			v.mW = ( m30 * x ) + ( m31 * y ) + m33;
+		}
+	}
+	
+	MOAIMaterialMgr& materialStack = MOAIMaterialMgr::Get ();
+	MOAIGfxState& gfxState = MOAIGfxMgr::Get ().mGfxState;
+	
+	materialStack.Push ( batch.mMaterial );
+	materialStack.SetShader ( MOAIShaderMgr::DECK2D_SHADER );
+	materialStack.LoadGfxState ();
+	
+	MOAIQuadBrush::BindVertexFormat ();
+	gfxState.WriteQuadsRaw ( batch.mVtx, batch.mUV, batch.mColors, total );
+	
+	materialStack.Pop ();
+	
+	batch.mTotal = 0;
+}
+
+//----------------------------------------------------------------//
+float* MOAIParticleSystem::GetParticleData ( u32 idx ) {
+
+	return &this->mParticleData [ idx * this->mParticleSize ];
+}
+
+//----------------------------------------------------------------//
+u32 MOAIParticleSystem::GetParticleIdx ( u32 i ) const {
+
+	u32 idx = this->mParticleBase + i;
+	u32 maxParticles = ( u32 )this->mAge.Size ();
+	return idx < maxParticles ? idx : idx - maxParticles;
+}
+
+//----------------------------------------------------------------//
+MOAIParticleRandom& MOAIParticleSystem::GetRandom () {
+
+	return this->mRandom;
 }
 
 //----------------------------------------------------------------//
@@ -391,6 +704,17 @@ MOAIParticleState* MOAIParticleSystem::GetState ( u32 id ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+u32 MOAIParticleSystem::GetStateID ( const MOAIParticleState* state ) const {
+
+	if ( state ) {
+		for ( u32 i = 0; i < this->mStates.Size (); ++i ) {
+			if ( this->mStates [ i ] == state ) return i;
+		}
+	}
+	return ( u32 )-1;
+}
+
 //----------------------------------------------------------------//
 AKUParticleSprite* MOAIParticleSystem::GetTopSprite () {
 
@@ -401,17 +725,49 @@ AKUParticleSprite* MOAIParticleSystem::GetTopSprite () {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+bool MOAIParticleSystem::IsThreaded () const {
+
+	if ( !this->mThreaded ) return false;
+
+	// callback plugins are free to call into Lua, so they have to run on the main thread
+	for ( u32 i = 0; i < this->mStates.Size (); ++i ) {
+	
+		// follow the mNext chain; the slow pointer stops us if it loops
+		MOAIParticleState* slow = this->mStates [ i ];
+		MOAIParticleState* fast = slow;
+		
+		for ( u32 step = 0; fast; ++step ) {
+		
+			MOAIParticlePlugin* plugin = fast->mPlugin;
+			if ( plugin && plugin->AsType < MOAIParticleCallbackPlugin >()) return false;
+			
+			fast = fast->mNext;
+			
+			if ( step & 1 ) {
+				slow = slow->mNext;
+			}
+			if ( fast == slow ) break;
+		}
+	}
+	return true;
+}
+
 //----------------------------------------------------------------//
 MOAIParticleSystem::MOAIParticleSystem () :
 	mParticleSize ( 0 ),
+	mParticleBase ( 0 ),
+	mTotalParticles ( 0 ),
 	mCapParticles ( false ),
 	mCapSprites ( false ),
-	mHead ( 0 ),
-	mTail ( 0 ),
-	mFree ( 0 ),
 	mSpriteTop ( 0 ),
 	mDrawOrder ( ORDER_NORMAL ),
-	mComputeBounds ( false ) {
+	mComputeBounds ( false ),
+	mScriptBatching ( true ),
+	mDirectDraw ( true ),
+	mThreaded ( false ),
+	mIsQueued ( false ),
+	mScheduleAfterJob ( false ) {
 	
 	RTTI_BEGIN
 		RTTI_EXTEND ( MOAIGraphicsProp )
@@ -421,14 +777,44 @@ MOAIParticleSystem::MOAIParticleSystem () :
 	// prop's index is *added* to particle's index;
 	// should be initialized to 0 instead of 1
 	this->mIndex = 0;
+	
+	// follow the global seed unless told otherwise
+	this->mRandom.Seed (( u32 )rand ());
 }
 
 //----------------------------------------------------------------//
 MOAIParticleSystem::~MOAIParticleSystem () {
 
+	this->ReleaseEmissions ();
 	this->ClearStates ();
 }
 
+//----------------------------------------------------------------//
+void MOAIParticleSystem::PushEmitter ( MOAIParticleEmitter& emitter, u32 total ) {
+
+	if ( !this->IsThreaded ()) {
+		emitter.Emit ( *this, total );
+		return;
+	}
+	
+	// an emitter updated more than once before the job emits once
+	for ( u32 i = 0; i < this->mPendingEmissions.GetTop (); ++i ) {
+		MOAIParticleEmission& emission = this->mPendingEmissions [ i ];
+		if ( emission.mEmitter == &emitter ) {
+			emission.mTotal += total;
+			return;
+		}
+	}
+	
+	this->LuaRetain ( &emitter );
+	
+	MOAIParticleEmission& emission = this->mPendingEmissions.Push ();
+	emission.mEmitter = &emitter;
+	emission.mTotal = total;
+	
+	MOAIParticleMgr::Get ().AffirmSystem ( *this );
+}
+
 //----------------------------------------------------------------//
 bool MOAIParticleSystem::PushParticle ( float x, float y ) {
 	
@@ -444,43 +830,42 @@ bool MOAIParticleSystem::PushParticle ( float x, float y, float dx, float dy ) {
 //----------------------------------------------------------------//
 bool MOAIParticleSystem::PushParticle ( float x, float y, float dx, float dy, u32 stateIdx ) {
 	
-	if (( !this->mFree ) && this->mCapParticles ) {
+	u32 maxParticles = ( u32 )this->mAge.Size ();
+	bool full = ( this->mTotalParticles >= maxParticles );
+	
+	if ( full && this->mCapParticles ) {
 		return false;
 	}
 	
 	MOAIParticleState* state = this->GetState ( stateIdx );
 	if ( !state ) return false;
 	
-	MOAIParticle* particle = 0;
+	if ( !maxParticles ) return false;
+	
+	u32 idx;
 	
-	if ( this->mFree ) {
-		particle = this->mFree;
-		this->mFree = particle->mNext;
+	if ( full ) {
+		// wrap: the oldest particle is overwritten and becomes the newest
+		idx = this->mParticleBase;
+		this->mParticleBase = this->GetParticleIdx ( 1 );
 	}
-	else if ( this->mHead ) {
-		particle = this->mHead;
-		this->mHead = particle->mNext;
+	else {
+		idx = this->GetParticleIdx ( this->mTotalParticles++ );
 	}
 	
-	if ( particle ) {
-		
-		float* r = particle->mData;
-		
-		r [ MOAIParticle::PARTICLE_X ] = x;
-		r [ MOAIParticle::PARTICLE_Y ] = y;
-		r [ MOAIParticle::PARTICLE_DX ] = dx;
-		r [ MOAIParticle::PARTICLE_DY ] = dy;
-		
-		for ( u32 i = MOAIParticle::TOTAL_PARTICLE_REG; i < this->mParticleSize; ++i ) {
-			r [ i ] = 0.0f;
-		}
-		
-		state->InitParticle ( *this, *particle );
-		this->EnqueueParticle ( *particle );
-		
-		return true;
+	float* r = this->GetParticleData ( idx );
+	
+	r [ MOAIParticle::PARTICLE_X ] = x;
+	r [ MOAIParticle::PARTICLE_Y ] = y;
+	r [ MOAIParticle::PARTICLE_DX ] = dx;
+	r [ MOAIParticle::PARTICLE_DY ] = dy;
+	
+	for ( u32 i = MOAIParticle::TOTAL_PARTICLE_REG; i < this->mParticleSize; ++i ) {
+		r [ i ] = 0.0f;
 	}
-	return false;
+	
+	state->InitParticle ( *this, idx );
+	return true;
 }
 
 //----------------------------------------------------------------//
@@ -550,11 +935,15 @@ void MOAIParticleSystem::RegisterLuaFuncs ( MOAILuaState& state ) {
 		{ "reserveParticles",	_reserveParticles },
 		{ "reserveSprites",		_reserveSprites },
 		{ "reserveStates",		_reserveStates },
+		{ "setDirectDraw",		_setDirectDraw },
 		{ "setDrawOrder",		_setDrawOrder },
 		{ "setComputeBounds",	_setComputeBounds },
+		{ "setScriptBatching",	_setScriptBatching },
+		{ "setSeed",			_setSeed },
 		{ "setSpriteColor",		_setSpriteColor },
 		{ "setSpriteDeckIdx",	_setSpriteDeckIdx },
 		{ "setState",			_setState },
+		{ "setThreaded",		_setThreaded },
 		{ "surge",				_surge },
 		{ NULL, NULL }
 	};
@@ -562,33 +951,38 @@ void MOAIParticleSystem::RegisterLuaFuncs ( MOAILuaState& state ) {
 	luaL_register ( state, 0, regTable );
 }
 
+//----------------------------------------------------------------//
+void MOAIParticleSystem::ReleaseEmissions () {
+
+	for ( u32 i = 0; i < this->mPendingEmissions.GetTop (); ++i ) {
+		this->LuaRelease ( this->mPendingEmissions [ i ].mEmitter );
+	}
+	this->mPendingEmissions.Reset ();
+}
+
 //----------------------------------------------------------------//
 void MOAIParticleSystem::ReserveParticles ( u32 maxParticles, u32 particleSize ) {
 	
 	particleSize += MOAIParticle::TOTAL_PARTICLE_REG;
 	
-	this->mHead = 0;
-	this->mTail = 0;
-	this->mFree = 0;
-	
 	this->mParticleSize = particleSize;
+	this->mParticleBase = 0;
+	this->mTotalParticles = 0;
+	
+	this->mAge.Init ( maxParticles );
+	this->mAge.Fill ( 0.0f );
+	
+	this->mTerm.Init ( maxParticles );
+	this->mTerm.Fill ( 0.0f );
+	
+	this->mMass.Init ( maxParticles );
+	this->mMass.Fill ( 0.0f );
+	
+	this->mParticleStates.Init ( maxParticles );
+	this->mParticleStates.Fill ( 0 );
 	
-	this->mParticles.Init ( maxParticles );
 	this->mParticleData.Init ( maxParticles * particleSize );
 	this->mParticleData.Fill ( 0.0f );
-	
-	for ( u32 i = 0; i < maxParticles; ++i ) {
-		MOAIParticle& particle = this->mParticles [ i ];
-		particle.mNext = this->mFree;
-		this->mFree = &particle;
-		
-		if ( particleSize ) {
-			particle.mData = &this->mParticleData [ i * particleSize ];
-		}
-		else {
-			particle.mData = 0;
-		}
-	}
 }
 
 //----------------------------------------------------------------//
@@ -604,6 +998,22 @@ void MOAIParticleSystem::ReserveStates ( u32 total ) {
 	this->mStates.Fill ( 0 );
 }
 
+//----------------------------------------------------------------//
+void MOAIParticleSystem::RunJob () {
+
+	// may run on a worker thread: no Lua, no node graph
+	for ( u32 i = 0; i < this->mPendingEmissions.GetTop (); ++i ) {
+		MOAIParticleEmission& emission = this->mPendingEmissions [ i ];
+		emission.mEmitter->Emit ( *this, emission.mTotal );
+	}
+	
+	for ( u32 i = 0; i < this->mPendingSteps.GetTop (); ++i ) {
+		if ( this->Step ( this->mPendingSteps [ i ])) {
+			this->mScheduleAfterJob = true;
+		}
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIParticleSystem::SerializeIn ( MOAILuaState& state, MOAIDeserializer& serializer ) {
 
@@ -618,18 +1028,8 @@ void MOAIParticleSystem::SerializeOut ( MOAILuaState& state, MOAISerializer& ser
 	MOAIAction::SerializeOut ( state, serializer );
 }
 
-//================================================================//
-// ::implementation::
-//================================================================//
-
 //----------------------------------------------------------------//
-bool MOAIParticleSystem::MOAIAction_IsDone () {
-
-	return false;
-}
-
-//----------------------------------------------------------------//
-void MOAIParticleSystem::MOAIAction_Update ( double step ) {
+bool MOAIParticleSystem::Step ( float step ) {
 
 	bool schedule = ( this->mSpriteTop > 0 );
 
@@ -638,36 +1038,143 @@ void MOAIParticleSystem::MOAIAction_Update ( double step ) {
 
 	this->mParticleBounds.Init ( 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f );
 
-	// if particles
-	if ( this->mHead ) {
-
-		// grab the head then clear out the queue
-		MOAIParticle* cursor = this->mHead;
-		this->ClearQueue ();
+	u32 total = this->mTotalParticles;
+	if ( total ) {
+	
+		MOAIParticleBatch& batch = this->mBatch;
+		u32 maxParticles = ( u32 )this->mAge.Size ();
+		
+		// update runs of adjacent particles that share a state; runs also
+		// break at the end of the ring so each one is contiguous
+		for ( u32 i = 0; i < total; i += batch.mTotal ) {
 		
-		// update the particles and rebuild the queue
-		while ( cursor ) {
-			MOAIParticle* particle = cursor;
-			cursor = cursor->mNext;
+			u32 first = this->GetParticleIdx ( i );
+			MOAIParticleState* state = this->mParticleStates [ first ];
 			
-			// update the particle
-			if ( particle->mState ) {
-				particle->mState->ProcessParticle ( *this, *particle,( float )step );
-			}
+			u32 limit = MIN ( total - i, maxParticles - first );
+			limit = MIN ( limit, MOAIParticleBatch::SIZE );
 			
-			// if is still to be killed, move it to the free list, else put it back in the queue
-			if ( !particle->mState ) {
-				particle->mNext = this->mFree;
-				this->mFree = particle;
+			u32 count = 1;
+			while (( count < limit ) && ( this->mParticleStates [ first + count ] == state )) {
+				count++;
 			}
-			else {
-				// and put it back in the queue
-				this->EnqueueParticle ( *particle );
+			
+			batch.mFirst = first;
+			batch.mTotal = count;
+			
+			if ( state ) {
+				state->ProcessParticles ( *this, batch, step );
 			}
 		}
+		
+		// drop the particles that expired
+		this->CompactParticles ();
 	}
 	
-	if ( schedule || this->mSpriteTop ) {
+	return schedule || ( this->mSpriteTop > 0 );
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleSystem::SnapshotIn ( ZLStream& stream ) {
+
+	MOAIGraphicsProp::SnapshotIn ( stream );
+	MOAIAction::SnapshotIn ( stream );
+
+	this->mRandom.SetState ( stream.Read < u32 >( this->mRandom.GetState ()));
+
+	u32 totalParticles		= stream.Read < u32 >( 0 );
+	u32 particleSize		= stream.Read < u32 >( 0 );
+	u32 totalSprites		= stream.Read < u32 >( 0 );
+
+	size_t columnBytes		= totalParticles * sizeof ( float );
+	size_t particleBytes	= totalParticles * (( sizeof ( float ) * 3 ) + sizeof ( u32 ));
+	size_t dataBytes		= totalParticles * particleSize * sizeof ( float );
+	size_t spriteBytes		= totalSprites * sizeof ( AKUParticleSprite );
+	size_t skip				= ( sizeof ( u32 ) * 3 ) + particleBytes + dataBytes + spriteBytes + sizeof ( ZLBox );
+
+	// the snapshot is only valid against the same reservation; skip it otherwise
+	if (( totalParticles != this->mAge.Size ()) || ( particleSize != this->mParticleSize ) || ( totalSprites != this->mSprites.Size ())) {
+		stream.Seek (( long )skip, SEEK_CUR );
+		return;
+	}
+
+	this->mParticleBase		= stream.Read < u32 >( 0 );
+	this->mTotalParticles	= stream.Read < u32 >( 0 );
+
+	stream.ReadBytes ( this->mAge.Data (), columnBytes );
+	stream.ReadBytes ( this->mTerm.Data (), columnBytes );
+	stream.ReadBytes ( this->mMass.Data (), columnBytes );
+
+	for ( u32 i = 0; i < totalParticles; ++i ) {
+		this->mParticleStates [ i ] = this->GetState ( stream.Read < u32 >(( u32 )-1 ));
+	}
+
+	stream.ReadBytes ( this->mParticleData.Data (), dataBytes );
+
+	this->mSpriteTop = stream.Read < u32 >( 0 );
+	stream.ReadBytes ( this->mSprites.Data (), spriteBytes );
+
+	this->mParticleBounds = stream.Read < ZLBox >( this->mParticleBounds );
+
+	this->ScheduleUpdate ();
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleSystem::SnapshotOut ( ZLStream& stream ) {
+
+	MOAIGraphicsProp::SnapshotOut ( stream );
+	MOAIAction::SnapshotOut ( stream );
+
+	stream.Write < u32 >( this->mRandom.GetState ());
+
+	u32 totalParticles	= ( u32 )this->mAge.Size ();
+	u32 totalSprites	= ( u32 )this->mSprites.Size ();
+
+	stream.Write < u32 >( totalParticles );
+	stream.Write < u32 >( this->mParticleSize );
+	stream.Write < u32 >( totalSprites );
+
+	stream.Write < u32 >( this->mParticleBase );
+	stream.Write < u32 >( this->mTotalParticles );
+
+	size_t columnBytes = totalParticles * sizeof ( float );
+	stream.WriteBytes ( this->mAge.Data (), columnBytes );
+	stream.WriteBytes ( this->mTerm.Data (), columnBytes );
+	stream.WriteBytes ( this->mMass.Data (), columnBytes );
+
+	// states are stored as indices
+	for ( u32 i = 0; i < totalParticles; ++i ) {
+		stream.Write < u32 >( this->GetStateID ( this->mParticleStates [ i ]));
+	}
+
+	stream.WriteBytes ( this->mParticleData.Data (), totalParticles * this->mParticleSize * sizeof ( float ));
+
+	stream.Write < u32 >( this->mSpriteTop );
+	stream.WriteBytes ( this->mSprites.Data (), totalSprites * sizeof ( AKUParticleSprite ));
+
+	stream.Write < ZLBox >( this->mParticleBounds );
+}
+
+//================================================================//
+// ::implementation::
+//================================================================//
+
+//----------------------------------------------------------------//
+bool MOAIParticleSystem::MOAIAction_IsDone () {
+
+	return false;
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleSystem::MOAIAction_Update ( double step ) {
+
+	if ( this->IsThreaded ()) {
+		this->mPendingSteps.Push (( float )step );
+		MOAIParticleMgr::Get ().AffirmSystem ( *this );
+		return;
+	}
+
+	if ( this->Step (( float )step )) {
 		this->ScheduleUpdate ();
 	}
 }
@@ -680,44 +1187,35 @@ void MOAIParticleSystem::MOAIDrawable_Draw ( int subPrimID ) {
 	if ( !this->mDeck ) return;
 	if ( this->IsClear ()) return;
 
-	MOAIGfxState& gfxState = MOAIGfxMgr::Get ().mGfxState;
-	
 	this->PushGfxState ();
 	this->LoadUVTransform ();
 
-	ZLAffine3D drawingMtx;
-	ZLAffine3D spriteMtx;
+	MOAISpriteDeck2D* spriteDeck = this->mDirectDraw ? this->mDeck->AsType < MOAISpriteDeck2D >() : 0;
 	
-	u32 maxSprites = ( u32 )this->mSprites.Size ();
-	u32 total = this->mSpriteTop;
-	u32 base = 0;
-	if ( total > maxSprites ) {
-		base = total % maxSprites;
-		total = maxSprites;
+	if ( spriteDeck ) {
+		this->DrawSpritesDirect ( *spriteDeck );
 	}
+	else {
 	
-	for ( u32 i = 0; i < total; ++i ) {
-
-		u32 idx;
-		if ( this->mDrawOrder == ORDER_NORMAL ) {
-			idx = ( base + i ) % maxSprites;
+		u32 maxSprites = ( u32 )this->mSprites.Size ();
+		u32 total = this->mSpriteTop;
+		u32 base = 0;
+		if ( total > maxSprites ) {
+			base = total % maxSprites;
+			total = maxSprites;
 		}
-		else {
-			idx = ( base + ( total - 1 - i )) % maxSprites;
-		}
-				
-		AKUParticleSprite& sprite = this->mSprites [ idx ];
-		gfxState.SetPenColor ( sprite.mRed, sprite.mGreen, sprite.mBlue, sprite.mAlpha );
-		
-		spriteMtx.ScRoTr ( sprite.mXScl, sprite.mYScl, 1.0f, 0.0f, 0.0f, sprite.mZRot * ( float )D2R, sprite.mXLoc, sprite.mYLoc, 0.0f );
-		
-		drawingMtx = this->GetLocalToWorldMtx ();
-		drawingMtx.Prepend ( spriteMtx );
 		
-		gfxState.SetMtx ( MOAIGfxState::MODEL_TO_WORLD_MTX, drawingMtx );
-		
-		//this->mDeck->Draw ( this->mIndex + ( u32 )sprite.mGfxID, this->mMaterialBatch );
-		this->mDeck->Draw ( this->mIndex + ( u32 )sprite.mGfxID );
+		for ( u32 i = 0; i < total; ++i ) {
+
+			u32 idx;
+			if ( this->mDrawOrder == ORDER_NORMAL ) {
+				idx = ( base + i ) % maxSprites;
+			}
+			else {
+				idx = ( base + ( total - 1 - i )) % maxSprites;
+			}
+			this->DrawSprite ( this->mSprites [ idx ]);
+		}
 	}
 	
 	this->PopGfxState ();
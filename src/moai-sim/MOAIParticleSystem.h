@@ -10,8 +10,20 @@
 #include <moai-sim/MOAIParticle.h>
 
 class MOAIDeck;
+class MOAIParticleEmitter;
 class MOAIParticleScript;
 class MOAIParticleState;
+class MOAISpriteDeck2D;
+
+//================================================================//
+// MOAIParticleEmission
+//================================================================//
+class MOAIParticleEmission {
+public:
+
+	MOAIParticleEmitter*	mEmitter;
+	u32						mTotal;		// surged particles
+};
 
 //================================================================//
 // MOAIParticleSystem
@@ -25,17 +37,21 @@ class MOAIParticleSystem :
 private:
 
 	ZLLeanArray < MOAIParticleState* >	mStates;
-	ZLLeanArray < MOAIParticle >		mParticles;
-	ZLLeanArray < float >				mParticleData;
+	
+	// live particles are kept dense and in push order in a ring of
+	// parallel arrays; mParticleBase is the oldest
+	ZLLeanArray < float >				mAge;
+	ZLLeanArray < float >				mTerm;
+	ZLLeanArray < float >				mMass;
+	ZLLeanArray < MOAIParticleState* >	mParticleStates;
+	ZLLeanArray < float >				mParticleData;		// mParticleSize registers per particle
 	u32									mParticleSize;
+	u32									mParticleBase;
+	u32									mTotalParticles;
 	
 	bool								mCapParticles;
 	bool								mCapSprites;
 	
-	MOAIParticle*						mHead;
-	MOAIParticle*						mTail;
-	MOAIParticle*						mFree;
-	
 	ZLLeanArray < AKUParticleSprite >	mSprites;
 	u32									mSpriteTop;
 	u32									mDrawOrder;
@@ -43,6 +59,21 @@ private:
 	bool								mComputeBounds;
 	ZLBox								mParticleBounds;
 	
+	bool								mScriptBatching;
+	MOAIParticleBatch					mBatch;
+	
+	bool								mDirectDraw;
+	MOAIParticleSpriteBatch				mSpriteBatch;
+	
+	MOAIParticleRandom					mRandom;
+	
+	// threaded mode: steps and emissions wait here for MOAIParticleMgr
+	bool										mThreaded;
+	bool										mIsQueued;
+	bool										mScheduleAfterJob;
+	ZLLeanStack < float, 4 >					mPendingSteps;
+	ZLLeanStack < MOAIParticleEmission, 8 >		mPendingEmissions;
+	
 	//----------------------------------------------------------------//
 	static int		_capParticles			( lua_State* L );
 	static int		_capSprites				( lua_State* L );
@@ -56,18 +87,29 @@ private:
 	static int		_reserveSprites			( lua_State* L );
 	static int		_reserveStates			( lua_State* L );
 	static int		_setComputeBounds		( lua_State* L );
+	static int		_setDirectDraw			( lua_State* L );
 	static int		_setDrawOrder			( lua_State* L );
+	static int		_setScriptBatching		( lua_State* L );
+	static int		_setSeed				( lua_State* L );
 	static int		_setSpriteColor			( lua_State* L );
 	static int		_setSpriteDeckIdx		( lua_State* L );
 	static int		_setState				( lua_State* L );
+	static int		_setThreaded			( lua_State* L );
 	static int		_surge					( lua_State* L );
 	
 	//----------------------------------------------------------------//
 	void					ClearStates				();
-	void					ClearQueue				();
-	void					EnqueueParticle			( MOAIParticle& particle );
+	void					CompactParticles		();
+	void					DrawSprite				( const AKUParticleSprite& sprite );
+	void					DrawSpritesDirect		( MOAISpriteDeck2D& deck );
+	void					FlushSpriteBatch		( const ZLMatrix4x4& mtx );
+	float*					GetParticleData			( u32 idx );
+	u32						GetParticleIdx			( u32 i ) const;
 	AKUParticleSprite*		GetTopSprite			();
 	MOAIParticleState*		GetState				( u32 id );
+	u32						GetStateID				( const MOAIParticleState* state ) const;
+	void					ReleaseEmissions		();
+	bool					Step					( float step );
 	
 	//----------------------------------------------------------------//
 	bool					MOAIAction_IsDone						();
@@ -83,14 +125,19 @@ public:
 	};
 
 	friend class MOAIParticleEngine;
+	friend class MOAIParticleMgr;
 	friend class MOAIParticleScript;
 	friend class MOAIParticleState;
 	
 	DECL_LUA_FACTORY ( MOAIParticleSystem )
 
 	//----------------------------------------------------------------//
+	void			FinishJob				();
+	MOAIParticleRandom&		GetRandom				();
+	bool			IsThreaded				() const;
 					MOAIParticleSystem		();
 					~MOAIParticleSystem		();
+	void			PushEmitter				( MOAIParticleEmitter& emitter, u32 total );
 	bool			PushParticle			( float x, float y );
 	bool			PushParticle			( float x, float y, float dx, float dy );
 	bool			PushParticle			( float x, float y, float dx, float dy, u32 stateIdx );
@@ -101,10 +148,13 @@ public:
 	void			ReserveRects			( u32 total );
 	void			ReserveSprites			( u32 maxSprites );
 	void			ReserveStates			( u32 total );
+	void			RunJob					();
 	void			SerializeIn				( MOAILuaState& state, MOAIDeserializer& serializer );
 	void			SerializeOut			( MOAILuaState& state, MOAISerializer& serializer );
 	void			SetConstant				( u32 idx, float value );
 	void			SetRect					( u32 idx, ZLRect& rect );
+	void			SnapshotIn				( ZLStream& stream );
+	void			SnapshotOut				( ZLStream& stream );
 };
 
 #endif
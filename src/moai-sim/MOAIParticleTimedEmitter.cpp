@@ -80,6 +80,24 @@ void MOAIParticleTimedEmitter::SetFrequencyRange ( float min, float max ) {
 	this->mMaxFrequency = max;
 }
 
+//----------------------------------------------------------------//
+void MOAIParticleTimedEmitter::SnapshotIn ( ZLStream& stream ) {
+
+	MOAIParticleEmitter::SnapshotIn ( stream );
+
+	this->mTime			= stream.Read < float >( this->mTime );
+	this->mEmitTime		= stream.Read < float >( this->mEmitTime );
+}
+
+//----------------------------------------------------------------//
+void MOAIParticleTimedEmitter::SnapshotOut ( ZLStream& stream ) {
+
+	MOAIParticleEmitter::SnapshotOut ( stream );
+
+	stream.Write < float >( this->mTime );
+	stream.Write < float >( this->mEmitTime );
+}
+
 //================================================================//
 // ::implementation::
 //================================================================//
@@ -42,6 +42,8 @@ public:
 	void			RegisterLuaClass			( MOAILuaState& state );
 	void			RegisterLuaFuncs			( MOAILuaState& state );
 	void			SetFrequencyRange			( float min, float max );
+	void			SnapshotIn					( ZLStream& stream );
+	void			SnapshotOut					( ZLStream& stream );
 };
 
 #endif
@@ -36,6 +36,9 @@ void MOAIPartitionCell::ExtractProps ( MOAIPartitionCell& cell, MOAIPartitionLev
 		}
 	
 		cell.mHulls.Join ( cell.mHulls, this->mHulls );
+		
+		cell.mBoundsValid = false;
+		this->mBoundsValid = false;
 	}
 }
 
@@ -118,21 +121,59 @@ void MOAIPartitionCell::GatherHulls ( MOAIPartitionResultBuffer& results, const
 //----------------------------------------------------------------//
 void MOAIPartitionCell::GatherHulls ( MOAIPartitionResultBuffer& results, const MOAIPartitionHull* ignore, const ZLFrustum& frustum, u32 interfaceMask, u32 queryMask ) {
 
+	u32 cullMask = ZLFrustum::CULL_ALL;
+
+	// test the whole cell first: hulls in a cell that is entirely inside the
+	// frustum need no tests of their own, and the rest only need the tests the
+	// cell straddles
+	if ( this->mBoundsValid ) {
+	
+		u32 result = frustum.Classify ( this->mBounds, cullMask, this->mCullPlane );
+		
+		if ( result == ZLFrustum::BOX_OUTSIDE ) return;
+		
+		if ( result == ZLFrustum::BOX_INSIDE ) {
+			this->GatherHulls ( results, ignore, interfaceMask, queryMask );
+			return;
+		}
+	}
+
+	bool rebuildBounds = !this->mBoundsValid;
+	bool boundsValid = true;
+
 	HullIt propIt = this->mHulls.Head ();
 	for ( ; propIt; propIt = propIt->Next ()) {
 		MOAIPartitionHull* hull = propIt->Data ();
 		
+		if ( rebuildBounds ) {
+			if ( hull->mWorldBounds.mStatus == ZLBounds::ZL_BOUNDS_OK ) {
+				this->mBounds.Grow ( hull->mWorldBounds, propIt == this->mHulls.Head ());
+			}
+			else {
+				boundsValid = false;
+			}
+		}
+		
 		if (( hull != ignore ) && ( hull->mInterfaceMask & interfaceMask ) && ( hull->mQueryMask & queryMask )) {
-			if ( !frustum.Cull ( hull->mWorldBounds )) {
+		
+			u32 hullMask = cullMask;
+			if ( frustum.Classify ( hull->mWorldBounds, hullMask, hull->mCullPlane ) != ZLFrustum::BOX_OUTSIDE ) {
 				hull->AddToSortBuffer ( results );
 			}
 		}
 	}
+	
+	if ( rebuildBounds ) {
+		this->mBoundsValid = boundsValid && ( this->mHulls.Count () > 0 );
+	}
 }
 
 //----------------------------------------------------------------//
 void MOAIPartitionCell::InsertHull ( MOAIPartitionHull& hull ) {
 
+	// also called when a hull moves within the cell
+	this->mBoundsValid = false;
+
 	if ( hull.mCell == this ) return;
 
 	if ( hull.mCell ) {
@@ -143,7 +184,9 @@ void MOAIPartitionCell::InsertHull ( MOAIPartitionHull& hull ) {
 }
 
 //----------------------------------------------------------------//
-MOAIPartitionCell::MOAIPartitionCell () {
+MOAIPartitionCell::MOAIPartitionCell () :
+	mBoundsValid ( false ),
+	mCullPlane ( 0 ) {
 }
 
 //----------------------------------------------------------------//
@@ -157,6 +200,7 @@ void MOAIPartitionCell::RemoveHull ( MOAIPartitionHull& hull ) {
 	if ( hull.mCell != this ) return;
 	
 	this->mHulls.Remove ( hull.mLinkInCell );
+	this->mBoundsValid = false;
 	hull.mCell = 0;
 }
 
@@ -22,6 +22,12 @@ private:
 	typedef ZLLeanList < MOAIPartitionHull* >::Iterator HullIt;
 	ZLLeanList < MOAIPartitionHull* > mHulls;
 
+	// bounds of every hull in the cell, for frustum culling; invalidated when hulls
+	// come, go or move, and rebuilt by the next frustum query that visits the cell
+	ZLBox		mBounds;
+	bool		mBoundsValid;
+	u32			mCullPlane;
+
 	//----------------------------------------------------------------//
 	void			Clear					();
 	void			ExtractProps			( MOAIPartitionCell& cell, MOAIPartitionLevel* level );
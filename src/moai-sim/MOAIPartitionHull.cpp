@@ -507,6 +507,7 @@ MOAIPartitionHull::MOAIPartitionHull () :
 	mInterfaceMask ( 0 ),
 	mQueryMask ( 0xffffffff ),
 	mPriority ( UNKNOWN_PRIORITY ),
+	mCullPlane ( 0 ),
 	mFlags ( 0 ),
 	mBoundsPad ( 0.0f, 0.0f, 0.0f ),
 	mHitGranularity ( HIT_TEST_COARSE ) {
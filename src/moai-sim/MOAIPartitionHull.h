@@ -50,6 +50,8 @@ protected:
 	u32							mQueryMask;
 	s32							mPriority;
 	
+	u32							mCullPlane;		// frustum plane that last culled the hull
+	
 	ZLBounds					mWorldBounds;
 
 	//----------------------------------------------------------------//
@@ -272,54 +272,43 @@ int MOAIPathFinder::_setWeight ( lua_State* L ) {
 //================================================================//
 
 //----------------------------------------------------------------//
-void MOAIPathFinder::BuildPath ( MOAIPathState* state ) {
+void MOAIPathFinder::AffirmStates () {
+
+	u32 totalNodes = this->mGraph ? this->mGraph->GetNodeCount () : 0;
+
+	MOAIPathState blank;
+	blank.mGeneration = 0;
+
+	this->mStates.Grow ( totalNodes, blank );
+	this->mOpen.Grow ( totalNodes );
+
+	// bumping the generation invalidates every state without touching the table
+	this->mGeneration++;
+	if ( !this->mGeneration ) {
+		this->mStates.Fill ( blank );
+		this->mGeneration = 1;
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIPathFinder::BuildPath ( u32 nodeID ) {
 
 	u32 size = 0;
-	for ( MOAIPathState* cursor = state; cursor; cursor = cursor->mParent, ++size );
+	for ( u32 cursor = nodeID; cursor != NO_NODE; cursor = this->mStates [ cursor ].mParent, ++size );
 	
 	this->mPath.Init ( size );
-	for ( MOAIPathState* cursor = state; cursor; cursor = cursor->mParent ) {
-		this->mPath [ --size ] = cursor->mNodeID;
+	for ( u32 cursor = nodeID; cursor != NO_NODE; cursor = this->mStates [ cursor ].mParent ) {
+		this->mPath [ --size ] = ( int )cursor;
 	}
 	
+	this->mGraph->RefinePath ( *this, this->mPath );
 	this->ClearVisitation ();
 }
 
 //----------------------------------------------------------------//
 void MOAIPathFinder::ClearVisitation () {
 
-	while ( this->mOpen ) {
-		MOAIPathState* state = this->mOpen;
-		this->mOpen = this->mOpen->mNext;
-		delete state;
-	}
-	
-	while ( this->mClosed ) {
-		MOAIPathState* state = this->mClosed;
-		this->mClosed = this->mClosed->mNext;
-		delete state;
-	}
-}
-
-//----------------------------------------------------------------//
-void MOAIPathFinder::CloseState ( MOAIPathState* stateToClose ) {
-	
-	MOAIPathState* cursor = this->mOpen;
-	this->mOpen = 0;
-	
-	while ( cursor ) {
-		MOAIPathState* state = cursor;
-		cursor = cursor->mNext;
-		
-		if ( state == stateToClose ) {
-			state->mNext = this->mClosed;
-			this->mClosed = state;
-		}
-		else {
-			state->mNext = this->mOpen;
-			this->mOpen = state;
-		}
-	}
+	this->mOpenSize = 0;
 }
 
 //----------------------------------------------------------------//
@@ -365,48 +354,107 @@ float MOAIPathFinder::ComputeTerrainCost ( float moveCost, u32 terrain0, u32 ter
 //----------------------------------------------------------------//
 bool MOAIPathFinder::FindPath ( int iterations ) {
 	
-	if ( !this->mState ) {
+	if ( !this->mGraph ) return false;
+	
+	if ( this->mState == NO_NODE ) {
+		this->AffirmStates ();
 		this->PushState ( this->mStartNodeID, 0.0f, 0.0f );
 	}
 	
 	bool noIterations = iterations <= 0;
 	
-	for ( ; this->mOpen && (( iterations > 0 ) || noIterations ); iterations-- ) {
+	for ( ; this->mOpenSize && (( iterations > 0 ) || noIterations ); iterations-- ) {
 		
 		this->mState = this->NextState ();
 
-		if ( this->mState->mNodeID == this->mTargetNodeID ) {
+		if ( this->mState == ( u32 )this->mTargetNodeID ) {
 			this->BuildPath ( this->mState );
 			return false;
 		}
 
-		this->CloseState ( this->mState );
-		this->mGraph->PushNeighbors ( *this, this->mState->mNodeID );
+		this->mGraph->PushNeighbors ( *this, this->mState );
 	}
-	return this->mOpen ? true : false;
+	return this->mOpenSize ? true : false;
 }
 
 //----------------------------------------------------------------//
-bool MOAIPathFinder::IsVisited ( int nodeID ) {
+// parent of a node visited by the current search, or -1
+int MOAIPathFinder::GetParentNodeID ( int nodeID ) const {
 
-	for ( MOAIPathState* state = this->mOpen; state; state = state->mNext ) {
-		if ( state->mNodeID == nodeID ) return true;
+	if (( u32 )nodeID >= this->mStates.Size ()) return -1;
+
+	const MOAIPathState& state = this->mStates [ nodeID ];
+	if (( state.mGeneration != this->mGeneration ) || ( state.mParent == NO_NODE )) return -1;
+	return ( int )state.mParent;
+}
+
+//----------------------------------------------------------------//
+void MOAIPathFinder::HeapDown ( u32 index ) {
+
+	u32* heap = this->mOpen.Data ();
+	u32 nodeID = heap [ index ];
+	float score = this->mStates [ nodeID ].mEstimatedScore;
+
+	for ( u32 child = ( index << 1 ) + 1; child < this->mOpenSize; child = ( index << 1 ) + 1 ) {
+		
+		float childScore = this->mStates [ heap [ child ]].mEstimatedScore;
+		
+		if (( child + 1 ) < this->mOpenSize ) {
+			float rightScore = this->mStates [ heap [ child + 1 ]].mEstimatedScore;
+			if ( rightScore < childScore ) {
+				child++;
+				childScore = rightScore;
+			}
+		}
+		
+		if ( score <= childScore ) break;
+		
+		heap [ index ] = heap [ child ];
+		this->mStates [ heap [ index ]].mHeapIndex = index;
+		index = child;
 	}
-	
-	for ( MOAIPathState* state = this->mClosed; state; state = state->mNext ) {
-		if ( state->mNodeID == nodeID ) return true;
+	heap [ index ] = nodeID;
+	this->mStates [ nodeID ].mHeapIndex = index;
+}
+
+//----------------------------------------------------------------//
+void MOAIPathFinder::HeapUp ( u32 index ) {
+
+	u32* heap = this->mOpen.Data ();
+	u32 nodeID = heap [ index ];
+	float score = this->mStates [ nodeID ].mEstimatedScore;
+
+	while ( index ) {
+		
+		u32 parent = ( index - 1 ) >> 1;
+		if ( this->mStates [ heap [ parent ]].mEstimatedScore <= score ) break;
+		
+		heap [ index ] = heap [ parent ];
+		this->mStates [ heap [ index ]].mHeapIndex = index;
+		index = parent;
 	}
-	
-	return false;
+	heap [ index ] = nodeID;
+	this->mStates [ nodeID ].mHeapIndex = index;
+}
+
+//----------------------------------------------------------------//
+// true if the node has been closed; open nodes may be pushed again
+// and PushState will keep whichever path is cheaper
+bool MOAIPathFinder::IsVisited ( int nodeID ) {
+
+	if (( u32 )nodeID >= this->mStates.Size ()) return true;
+
+	const MOAIPathState& state = this->mStates [ nodeID ];
+	return (( state.mGeneration == this->mGeneration ) && ( state.mHeapIndex == CLOSED ));
 }
 
 //----------------------------------------------------------------//
 MOAIPathFinder::MOAIPathFinder () :
-	mOpen ( 0 ),
-	mClosed ( 0 ),
+	mOpenSize ( 0 ),
+	mGeneration ( 0 ),
 	mStartNodeID ( 0 ),
 	mTargetNodeID ( 0 ),
-	mState ( 0 ),
+	mState ( NO_NODE ),
 	mMask ( 0xffffffff ),
 	mHeuristic ( 0 ),
 	mFlags ( 0 ),
@@ -418,41 +466,56 @@ MOAIPathFinder::MOAIPathFinder () :
 
 //----------------------------------------------------------------//
 MOAIPathFinder::~MOAIPathFinder () {
-
-	this->ClearVisitation ();
 	
 	this->mGraph.Set ( *this, 0 );
 	this->mTerrainDeck.Set ( *this, 0 );
 }
 
 //----------------------------------------------------------------//
-MOAIPathState* MOAIPathFinder::NextState () {
-
-	MOAIPathState* state = this->mOpen;
-	MOAIPathState* best = state;
-	state = state->mNext;
+u32 MOAIPathFinder::NextState () {
 
-	for ( ; state; state = state->mNext ) {
-		if ( state->mEstimatedScore < best->mEstimatedScore ) {
-			best = state;
-		}
+	u32* heap = this->mOpen.Data ();
+	u32 best = heap [ 0 ];
+	
+	this->mOpenSize--;
+	if ( this->mOpenSize ) {
+		heap [ 0 ] = heap [ this->mOpenSize ];
+		this->HeapDown ( 0 );
 	}
+	
+	this->mStates [ best ].mHeapIndex = CLOSED;
 	return best;
 }
 
 //----------------------------------------------------------------//
 void MOAIPathFinder::PushState ( int nodeID, float cost, float estimate ) {
 	
-	MOAIPathState* state = new MOAIPathState ();
-	state->mNodeID = nodeID;
-	state->mParent = this->mState;
-
-	state->mNext = this->mOpen;
-	this->mOpen = state;
+	if (( u32 )nodeID >= this->mStates.Size ()) return;
+	
+	float parentScore = ( this->mState != NO_NODE ) ? this->mStates [ this->mState ].mCumulatedScore : 0.0f;
+	float cumulatedScore = parentScore + cost;
+	
+	MOAIPathState& state = this->mStates [ nodeID ];
+	
+	if ( state.mGeneration == this->mGeneration ) {
+		
+		// already open: decrease key if this path is cheaper
+		if (( state.mHeapIndex == CLOSED ) || ( state.mCumulatedScore <= cumulatedScore )) return;
+		
+		state.mParent = this->mState;
+		state.mCumulatedScore = cumulatedScore;
+		state.mEstimatedScore = cumulatedScore + estimate;
+		this->HeapUp ( state.mHeapIndex );
+		return;
+	}
+	
+	state.mGeneration = this->mGeneration;
+	state.mParent = this->mState;
+	state.mCumulatedScore = cumulatedScore;
+	state.mEstimatedScore = cumulatedScore + estimate;
 	
-	float parentScore = state->mParent ? state->mParent->mCumulatedScore : 0.0f;
-	state->mCumulatedScore = parentScore + cost;
-	state->mEstimatedScore = state->mCumulatedScore + estimate;
+	this->mOpen [ this->mOpenSize ] = ( u32 )nodeID;
+	this->HeapUp ( this->mOpenSize++ );
 }
 
 //----------------------------------------------------------------//
@@ -486,7 +549,7 @@ void MOAIPathFinder::RegisterLuaFuncs ( MOAILuaState& state ) {
 //----------------------------------------------------------------//
 void MOAIPathFinder::Reset () {
 
-	this->mState = 0;
+	this->mState = NO_NODE;
 	this->mPath.Clear ();
 
 	this->ClearVisitation ();
@@ -21,14 +21,15 @@ public:
 //================================================================//
 // MOAIPathState
 //================================================================//
+// one per graph node; only valid if mGeneration matches the finder's
 class MOAIPathState {
 private:
 
 	friend class MOAIPathFinder;
 
-	int					mNodeID;
-	MOAIPathState*		mParent;
-	MOAIPathState*		mNext;
+	u32					mGeneration;
+	u32					mParent;		// node ID
+	u32					mHeapIndex;		// position in open heap, or CLOSED
 	
 	float				mCumulatedScore;
 	float				mEstimatedScore;
@@ -52,16 +53,18 @@ private:
 	ZLLeanArray < MOAIPathWeight > mWeights;
 	ZLLeanArray < int >	mPath;
 
-	// TODO: optimize implementation with memory pool of path states
-	// and binary heap of open paths
+	static const u32 NO_NODE	= ( u32 )-1;
+	static const u32 CLOSED		= ( u32 )-1;
 
-	MOAIPathState*		mOpen;
-	MOAIPathState*		mClosed;
+	ZLLeanArray < MOAIPathState >	mStates;	// indexed by node ID; reused across searches
+	ZLLeanArray < u32 >				mOpen;		// binary heap of node IDs, ordered by estimated score
+	u32								mOpenSize;
+	u32								mGeneration;
 	
 	int					mStartNodeID;
 	int					mTargetNodeID;
 
-	MOAIPathState*		mState; // used while expanding open set
+	u32					mState; // node being expanded, or NO_NODE before the search starts
 
 	u32					mMask;
 
@@ -87,10 +90,12 @@ private:
 	static int			_setWeight					( lua_State* L );
 
 	//----------------------------------------------------------------//
-	void				BuildPath			( MOAIPathState* state );
+	void				AffirmStates		();
+	void				BuildPath			( u32 nodeID );
 	void				ClearVisitation		();
-	void				CloseState			( MOAIPathState* stateToClose );
-	MOAIPathState*		NextState			();
+	void				HeapDown			( u32 index );
+	void				HeapUp				( u32 index );
+	u32					NextState			();
 	void				Reset				();
 
 public:
@@ -98,7 +103,9 @@ public:
 	DECL_LUA_FACTORY ( MOAIPathFinder )
 	
 	GET ( const ZLLeanArray < MOAIPathWeight >&, Weights, mWeights );
+	GET ( MOAIPathGraph*, Graph, mGraph );
 	GET ( int, TargetNodeID, mTargetNodeID );
+	GET ( MOAIPathTerrainDeck*, TerrainDeck, mTerrainDeck );
 	GET ( u32, Mask, mMask );
 	GET ( u32, Heuristic, mHeuristic )
 	GET ( u32, Flags, mFlags )
@@ -109,6 +116,7 @@ public:
 	bool		CheckMask				( u32 terrain );
 	float		ComputeTerrainCost		( float moveCost, u32 terrain0, u32 terrain1 );
 	bool		FindPath				( int iterations );
+	int			GetParentNodeID			( int nodeID ) const;
 	bool		IsVisited				( int nodeID );
 				MOAIPathFinder			();
 				~MOAIPathFinder			();
@@ -24,6 +24,13 @@ MOAIPathGraph::MOAIPathGraph () {
 MOAIPathGraph::~MOAIPathGraph () {
 }
 
+//----------------------------------------------------------------//
+// graphs that search over waypoints may fill in the skipped nodes here
+void MOAIPathGraph::RefinePath ( MOAIPathFinder& pathFinder, ZLLeanArray < int >& path ) {
+	UNUSED ( pathFinder );
+	UNUSED ( path );
+}
+
 //----------------------------------------------------------------//
 void MOAIPathGraph::RegisterLuaClass ( MOAILuaState& state ) {
 	UNUSED ( state );
@@ -21,7 +21,9 @@ protected:
 	static int		_setHeuristic			( lua_State* L );
 
 	//----------------------------------------------------------------//
+	virtual u32		GetNodeCount			() = 0;
 	virtual void	PushNeighbors			( MOAIPathFinder& pathFinder, int nodeID ) = 0;
+	virtual void	RefinePath				( MOAIPathFinder& pathFinder, ZLLeanArray < int >& path );
 
 public:
 
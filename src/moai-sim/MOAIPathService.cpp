@@ -0,0 +1,606 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#include <moai-sim/MOAIGridPathGraph.h>
+#include <moai-sim/MOAIPathFinder.h>
+#include <moai-sim/MOAIPathService.h>
+#include <moai-sim/MOAIPathTerrainDeck.h>
+
+//================================================================//
+// local
+//================================================================//
+
+static const int sMoves [ 8 ][ 2 ] = {
+	{ -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 },
+	{ -1, -1 }, { 1, -1 }, { -1, 1 }, { 1, 1 },
+};
+
+//----------------------------------------------------------------//
+static MOAIGrid* _getGrid ( MOAIPathFinder& pathFinder ) {
+
+	MOAIPathGraph* graph = pathFinder.GetGraph ();
+	MOAIGridPathGraph* gridGraph = graph ? graph->AsType < MOAIGridPathGraph >() : 0;
+	MOAIGrid* grid = gridGraph ? gridGraph->GetGrid () : 0;
+
+	return ( grid && ( grid->GetShape () == MOAIGridSpace::RECT_SHAPE )) ? grid : 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	addRequest
+	@text	Queue a request for the next call to findPaths ().
+
+	@in		MOAIPathService self
+	@in		number startNodeID
+	@in		number targetNodeID
+	@out	number index				Index of the request's path in the results.
+*/
+int MOAIPathService::_addRequest ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIPathService, "UNN" )
+
+	MOAIPathRequest& request = self->mRequests.Push ();
+
+	request.mStartNodeID	= state.GetValue < int >( 2, 1 ) - 1;
+	request.mTargetNodeID	= state.GetValue < int >( 3, 1 ) - 1;
+	request.mIndex			= ( u32 )self->mRequests.GetTop () - 1;
+	request.mBase			= 0;
+	request.mSize			= 0;
+
+	state.Push ( request.mIndex + 1 );
+	return 1;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	clearRequests
+	@text	Discard all queued requests.
+
+	@in		MOAIPathService self
+	@out	nil
+*/
+int MOAIPathService::_clearRequests ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIPathService, "U" )
+
+	self->mRequests.Reset ();
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	findPaths
+	@text	Solve all queued requests as one batch, spread across the
+			given task queues. Requests with the same target always go
+			to the same queue. When the last task is done, the callback
+			is called on the main thread with a table of paths (in
+			request order), the batch ID and the snapshot version the
+			paths were found on. Each path is a table of node IDs from
+			start to target; it's empty if there is no path.
+
+			The queued requests are cleared.
+
+	@in		MOAIPathService self
+	@in		function onFinish
+	@in		MOAITaskQueue queue
+	@opt	MOAITaskQueue ...			Additional queues to share the batch.
+	@out	number batchID				Or nil if the batch couldn't be started.
+*/
+int MOAIPathService::_findPaths ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIPathService, "UFU" )
+
+	u32 totalRequests = ( u32 )self->mRequests.GetTop ();
+	if ( !totalRequests ) return 0;
+
+	ZLLeanStack < MOAITaskQueue*, 8 > queues;
+
+	int top = state.GetTop ();
+	for ( int i = 3; i <= top; ++i ) {
+		MOAITaskQueue* queue = state.GetLuaObject < MOAITaskQueue >( i, true );
+		if ( queue ) {
+			queues.Push ( queue );
+		}
+	}
+
+	u32 totalQueues = ( u32 )queues.GetTop ();
+	if ( !totalQueues ) return 0;
+
+	if ( !self->AffirmSnapshot ( false )) {
+		MOAILogF ( L, ZLLog::LOG_ERROR, "MOAIPathService: path finder needs a MOAIGridPathGraph with a rectangular grid\n" );
+		return 0;
+	}
+
+	MOAIPathBatch* batch = new MOAIPathBatch ();
+	batch->Retain ();
+
+	batch->mBatchID = ++self->mBatchID;
+	batch->mVersion = self->mVersion;
+	batch->mPendingTasks = 0;
+	batch->mOnFinish.SetRef ( state, 2 );
+
+	lua_createtable ( state, totalRequests, 0 );
+	batch->mResults.SetRef ( state, -1 );
+	state.Pop ( 1 );
+
+	ZLLeanArray < MOAIPathServiceTask* > tasks;
+	tasks.Init ( totalQueues );
+	tasks.Fill ( 0 );
+
+	for ( u32 i = 0; i < totalRequests; ++i ) {
+
+		const MOAIPathRequest& request = self->mRequests [ i ];
+
+		// requests that share a target must share a task to share a search
+		u32 slot = ( u32 )request.mTargetNodeID % totalQueues;
+
+		if ( !tasks [ slot ]) {
+			tasks [ slot ] = new MOAIPathServiceTask ();
+			tasks [ slot ]->Init ( *self->mSnapshot, *batch );
+			batch->mPendingTasks++;
+		}
+		tasks [ slot ]->AddRequest ( request );
+	}
+
+	for ( u32 i = 0; i < totalQueues; ++i ) {
+		if ( tasks [ i ]) {
+			tasks [ i ]->Start ( *queues [ i ], MOAIMainThreadTaskSubscriber::Get ());
+		}
+	}
+
+	self->mRequests.Reset ();
+
+	state.Push ( batch->mBatchID );
+	batch->Release ();
+
+	return 1;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	getVersion
+	@text	Return the version of the current snapshot. Compare against
+			the version passed to a findPaths () callback to tell if the
+			paths were found on an older snapshot.
+
+	@in		MOAIPathService self
+	@out	number version				0 if no snapshot has been taken.
+*/
+int MOAIPathService::_getVersion ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIPathService, "U" )
+
+	state.Push ( self->mSnapshot ? self->mSnapshot->mVersion : 0 );
+	return 1;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	setPathFinder
+	@text	Set the path finder whose graph, terrain mask, terrain weights,
+			flags and G weight are used to answer requests.
+
+	@in		MOAIPathService self
+	@opt	MOAIPathFinder pathFinder	Default value is nil.
+	@out	nil
+*/
+int MOAIPathService::_setPathFinder ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIPathService, "U" )
+
+	self->mPathFinder.Set ( *self, state.GetLuaObject < MOAIPathFinder >( 2, true ));
+
+	if ( self->mSnapshot ) {
+		self->mSnapshot->Release ();
+		self->mSnapshot = 0;
+	}
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	snapshot
+	@text	Force a new snapshot of the path finder's graph and terrain
+			settings. Batches already in flight keep their snapshot.
+
+	@in		MOAIPathService self
+	@out	number version				Or nil if the path finder isn't usable.
+*/
+int MOAIPathService::_snapshot ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIPathService, "U" )
+
+	if ( self->AffirmSnapshot ( true )) {
+		state.Push ( self->mSnapshot->mVersion );
+		return 1;
+	}
+	return 0;
+}
+
+//================================================================//
+// MOAIPathSnapshot
+//================================================================//
+
+//----------------------------------------------------------------//
+float MOAIPathSnapshot::GetMoveCost ( int from, int to, float moveCost ) const {
+
+	float cost = moveCost;
+
+	if (( this->mFlags [ from ] & WEIGHTED ) && ( this->mFlags [ to ] & WEIGHTED )) {
+		cost += moveCost * ( this->mLeaveCost [ from ] + this->mEnterCost [ to ]);
+	}
+	return cost * this->mGWeight;
+}
+
+//----------------------------------------------------------------//
+bool MOAIPathSnapshot::Init ( MOAIPathFinder& pathFinder, u32 version ) {
+
+	MOAIGrid* grid = _getGrid ( pathFinder );
+	if ( !grid ) return false;
+
+	this->mVersion		= version;
+	this->mGrid			= grid;
+	this->mGridVersion	= grid->GetVersion ();
+
+	this->mWidth		= grid->GetWidth ();
+	this->mHeight		= grid->GetHeight ();
+
+	this->mHCost		= grid->GetCellWidth ();
+	this->mVCost		= grid->GetCellHeight ();
+	this->mDCost		= sqrtf (( this->mHCost * this->mHCost ) + ( this->mVCost * this->mVCost ));
+	this->mGWeight		= pathFinder.GetGWeight ();
+	this->mDiagonals	= ( pathFinder.GetFlags () & MOAIGridPathGraph::NO_DIAGONALS ) == 0;
+
+	MOAIPathTerrainDeck* deck = pathFinder.GetTerrainDeck ();
+	const ZLLeanArray < MOAIPathWeight >& weights = pathFinder.GetWeights ();
+	u32 vectorSize = deck ? MIN ( deck->GetVectorSize (), ( u32 )weights.Size ()) : 0;
+
+	u32 totalCells = ( u32 )( this->mWidth * this->mHeight );
+	this->mFlags.Init ( totalCells );
+
+	if ( vectorSize ) {
+		this->mEnterCost.Init ( totalCells );
+		this->mLeaveCost.Init ( totalCells );
+	}
+	else {
+		this->mEnterCost.Clear ();
+		this->mLeaveCost.Clear ();
+	}
+
+	for ( u32 i = 0; i < totalCells; ++i ) {
+
+		u32 tile = grid->GetTile (( int )i );
+		u8 flags = pathFinder.CheckMask ( tile ) ? PASSABLE : 0;
+
+		// matches MOAIPathFinder::ComputeTerrainCost, which ignores hidden tiles
+		if ( vectorSize && ( tile & MOAITileFlags::CODE_MASK ) && !( tile & MOAITileFlags::HIDDEN )) {
+
+			const float* vector = deck->GetVector ( tile & MOAITileFlags::CODE_MASK );
+
+			float enter = 0.0f;
+			float leave = 0.0f;
+
+			for ( u32 j = 0; j < vectorSize; ++j ) {
+
+				const MOAIPathWeight& weight = weights [ j ];
+
+				float delta = vector [ j ] * weight.mDeltaScale;
+				float penalty = vector [ j ] * 0.5f * weight.mPenaltyScale;
+
+				enter += penalty + delta;
+				leave += penalty - delta;
+			}
+			this->mEnterCost [ i ] = enter;
+			this->mLeaveCost [ i ] = leave;
+			flags |= WEIGHTED;
+		}
+		this->mFlags [ i ] = flags;
+	}
+	return true;
+}
+
+//----------------------------------------------------------------//
+bool MOAIPathSnapshot::IsMatch ( MOAIPathFinder& pathFinder ) const {
+
+	MOAIGrid* grid = _getGrid ( pathFinder );
+
+	return (
+		grid &&
+		( grid == this->mGrid ) &&
+		( grid->GetVersion () == this->mGridVersion ) &&
+		( grid->GetWidth () == this->mWidth ) &&
+		( grid->GetHeight () == this->mHeight )
+	);
+}
+
+//----------------------------------------------------------------//
+MOAIPathSnapshot::MOAIPathSnapshot () :
+	mVersion ( 0 ),
+	mGrid ( 0 ),
+	mGridVersion ( 0 ),
+	mWidth ( 0 ),
+	mHeight ( 0 ),
+	mHCost ( 0.0f ),
+	mVCost ( 0.0f ),
+	mDCost ( 0.0f ),
+	mGWeight ( 1.0f ),
+	mDiagonals ( true ) {
+}
+
+//----------------------------------------------------------------//
+MOAIPathSnapshot::~MOAIPathSnapshot () {
+}
+
+//================================================================//
+// MOAIPathServiceTask
+//================================================================//
+
+//----------------------------------------------------------------//
+void MOAIPathServiceTask::AddRequest ( const MOAIPathRequest& request ) {
+
+	this->mRequests.Push ( request );
+}
+
+//----------------------------------------------------------------//
+void MOAIPathServiceTask::Execute () {
+
+	const MOAIPathSnapshot& snapshot = *this->mSnapshot;
+	u32 totalCells = ( u32 )( snapshot.mWidth * snapshot.mHeight );
+
+	this->mDist.Init ( totalCells );
+	this->mNext.Init ( totalCells );
+	this->mVisited.Init ( totalCells );
+	this->mVisited.Fill ( 0 );
+	this->mStarts.Init ( totalCells );
+	this->mStarts.Fill ( 0 );
+	this->mSearchID = 0;
+
+	u32 totalRequests = ( u32 )this->mRequests.GetTop ();
+
+	ZLLeanArray < bool > solved;
+	solved.Init ( totalRequests );
+	solved.Fill ( false );
+
+	for ( u32 i = 0; i < totalRequests; ++i ) {
+		if ( !solved [ i ]) {
+			this->SolveGroup ( i, solved );
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIPathServiceTask::Init ( MOAIPathSnapshot& snapshot, MOAIPathBatch& batch ) {
+
+	// the subscriber releases tasks on the main thread, so the matching
+	// releases in the destructor happen there too
+	this->mSnapshot = &snapshot;
+	this->mSnapshot->Retain ();
+
+	this->mBatch = &batch;
+	this->mBatch->Retain ();
+}
+
+//----------------------------------------------------------------//
+MOAIPathServiceTask::MOAIPathServiceTask () :
+	mSnapshot ( 0 ),
+	mBatch ( 0 ),
+	mSearchID ( 0 ) {
+}
+
+//----------------------------------------------------------------//
+MOAIPathServiceTask::~MOAIPathServiceTask () {
+
+	if ( this->mSnapshot ) {
+		this->mSnapshot->Release ();
+	}
+
+	if ( this->mBatch ) {
+		this->mBatch->Release ();
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIPathServiceTask::Publish () {
+
+	MOAIScopedLuaState state = MOAILuaRuntime::Get ().State ();
+	MOAIPathBatch& batch = *this->mBatch;
+
+	if ( batch.mResults.PushRef ( state )) {
+
+		int results = state.GetTop ();
+		u32 totalRequests = ( u32 )this->mRequests.GetTop ();
+
+		for ( u32 i = 0; i < totalRequests; ++i ) {
+
+			const MOAIPathRequest& request = this->mRequests [ i ];
+
+			lua_createtable ( state, request.mSize, 0 );
+			for ( u32 j = 0; j < request.mSize; ++j ) {
+				state.Push ( this->mPaths [ request.mBase + j ] + 1 );
+				lua_rawseti ( state, -2, j + 1 );
+			}
+			lua_rawseti ( state, results, request.mIndex + 1 );
+		}
+		state.Pop ( 1 );
+	}
+
+	if ( batch.mPendingTasks && ( --batch.mPendingTasks == 0 )) {
+		if ( batch.mOnFinish.PushRef ( state )) {
+			batch.mResults.PushRef ( state );
+			state.Push ( batch.mBatchID );
+			state.Push ( batch.mVersion );
+			state.DebugCall ( 3, 0 );
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIPathServiceTask::SearchFrom ( int targetID, u32 totalStarts ) {
+
+	const MOAIPathSnapshot& snapshot = *this->mSnapshot;
+
+	int width = snapshot.mWidth;
+	int height = snapshot.mHeight;
+	int totalMoves = snapshot.mDiagonals ? 8 : 4;
+	u32 searchID = this->mSearchID;
+
+	this->mVisited [ targetID ] = searchID;
+	this->mDist [ targetID ] = 0.0f;
+	this->mNext [ targetID ] = targetID;
+
+	this->mHeap.Reset ();
+	MOAIGridPathSearchEntry::HeapPush ( this->mHeap, 0.0f, ( u32 )targetID );
+
+	while ( this->mHeap.GetTop ()) {
+
+		MOAIGridPathSearchEntry entry = MOAIGridPathSearchEntry::HeapPop ( this->mHeap );
+		int nodeID = ( int )entry.mIndex;
+
+		if ( entry.mDist > this->mDist [ nodeID ]) continue;
+
+		if ( this->mStarts [ nodeID ] == searchID ) {
+			this->mStarts [ nodeID ] = 0;
+			if ( --totalStarts == 0 ) break;
+		}
+
+		// starts may sit on blocked cells; they're reached but not passed through
+		if ( !( snapshot.mFlags [ nodeID ] & MOAIPathSnapshot::PASSABLE )) continue;
+
+		int x = nodeID % width;
+		int y = nodeID / width;
+
+		for ( int i = 0; i < totalMoves; ++i ) {
+
+			int nx = x + sMoves [ i ][ 0 ];
+			int ny = y + sMoves [ i ][ 1 ];
+
+			if (( nx < 0 ) || ( nx >= width ) || ( ny < 0 ) || ( ny >= height )) continue;
+
+			int neighborID = ( ny * width ) + nx;
+
+			if ( !( snapshot.mFlags [ neighborID ] & MOAIPathSnapshot::PASSABLE ) && ( this->mStarts [ neighborID ] != searchID )) continue;
+
+			float moveCost = ( i < 4 ) ? (( i < 2 ) ? snapshot.mHCost : snapshot.mVCost ) : snapshot.mDCost;
+
+			// searching backward: the move is from the neighbor to this node
+			float dist = entry.mDist + snapshot.GetMoveCost ( neighborID, nodeID, moveCost );
+
+			if (( this->mVisited [ neighborID ] != searchID ) || ( dist < this->mDist [ neighborID ])) {
+				this->mVisited [ neighborID ] = searchID;
+				this->mDist [ neighborID ] = dist;
+				this->mNext [ neighborID ] = nodeID;
+				MOAIGridPathSearchEntry::HeapPush ( this->mHeap, dist, ( u32 )neighborID );
+			}
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIPathServiceTask::SolveGroup ( u32 first, ZLLeanArray < bool >& solved ) {
+
+	const MOAIPathSnapshot& snapshot = *this->mSnapshot;
+
+	int totalCells = snapshot.mWidth * snapshot.mHeight;
+	u32 totalRequests = ( u32 )this->mRequests.GetTop ();
+	int targetID = this->mRequests [ first ].mTargetNodeID;
+
+	bool isValid = ( targetID >= 0 ) && ( targetID < totalCells ) && ( snapshot.mFlags [ targetID ] & MOAIPathSnapshot::PASSABLE );
+
+	u32 searchID = ++this->mSearchID;
+	u32 totalStarts = 0;
+
+	if ( isValid ) {
+		for ( u32 i = first; i < totalRequests; ++i ) {
+
+			const MOAIPathRequest& request = this->mRequests [ i ];
+			if ( solved [ i ] || ( request.mTargetNodeID != targetID )) continue;
+
+			int startID = request.mStartNodeID;
+			if (( startID >= 0 ) && ( startID < totalCells ) && ( this->mStarts [ startID ] != searchID )) {
+				this->mStarts [ startID ] = searchID;
+				totalStarts++;
+			}
+		}
+	}
+
+	if ( totalStarts ) {
+		this->SearchFrom ( targetID, totalStarts );
+	}
+
+	for ( u32 i = first; i < totalRequests; ++i ) {
+
+		MOAIPathRequest& request = this->mRequests [ i ];
+		if ( solved [ i ] || ( request.mTargetNodeID != targetID )) continue;
+
+		solved [ i ] = true;
+		request.mBase = ( u32 )this->mPaths.GetTop ();
+		request.mSize = 0;
+
+		int startID = request.mStartNodeID;
+		if ( !( totalStarts && ( startID >= 0 ) && ( startID < totalCells ) && ( this->mVisited [ startID ] == searchID ))) continue;
+
+		for ( int nodeID = startID; ; nodeID = this->mNext [ nodeID ]) {
+			this->mPaths.Push () = nodeID;
+			request.mSize++;
+			if ( nodeID == targetID ) break;
+		}
+	}
+}
+
+//================================================================//
+// MOAIPathService
+//================================================================//
+
+//----------------------------------------------------------------//
+bool MOAIPathService::AffirmSnapshot ( bool force ) {
+
+	if ( !force && this->mSnapshot && this->mPathFinder && this->mSnapshot->IsMatch ( *this->mPathFinder )) return true;
+
+	if ( this->mSnapshot ) {
+		this->mSnapshot->Release ();
+		this->mSnapshot = 0;
+	}
+
+	if ( !this->mPathFinder ) return false;
+
+	MOAIPathSnapshot* snapshot = new MOAIPathSnapshot ();
+
+	if ( !snapshot->Init ( *this->mPathFinder, this->mVersion + 1 )) {
+		delete snapshot;
+		return false;
+	}
+
+	snapshot->Retain ();
+	this->mSnapshot = snapshot;
+	this->mVersion++;
+
+	return true;
+}
+
+//----------------------------------------------------------------//
+MOAIPathService::MOAIPathService () :
+	mSnapshot ( 0 ),
+	mVersion ( 0 ),
+	mBatchID ( 0 ) {
+
+	RTTI_SINGLE ( MOAILuaObject )
+}
+
+//----------------------------------------------------------------//
+MOAIPathService::~MOAIPathService () {
+
+	if ( this->mSnapshot ) {
+		this->mSnapshot->Release ();
+	}
+	this->mPathFinder.Set ( *this, 0 );
+}
+
+//----------------------------------------------------------------//
+void MOAIPathService::RegisterLuaClass ( MOAILuaState& state ) {
+	UNUSED ( state );
+}
+
+//----------------------------------------------------------------//
+void MOAIPathService::RegisterLuaFuncs ( MOAILuaState& state ) {
+
+	luaL_Reg regTable [] = {
+		{ "addRequest",				_addRequest },
+		{ "clearRequests",			_clearRequests },
+		{ "findPaths",				_findPaths },
+		{ "getVersion",				_getVersion },
+		{ "setPathFinder",			_setPathFinder },
+		{ "snapshot",				_snapshot },
+		{ NULL, NULL }
+	};
+
+	luaL_register ( state, 0, regTable );
+}
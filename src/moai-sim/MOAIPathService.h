@@ -0,0 +1,178 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAIPATHSERVICE_H
+#define	MOAIPATHSERVICE_H
+
+#include <moai-sim/MOAIGridPathHierarchy.h>
+
+class MOAIGrid;
+class MOAIPathFinder;
+
+//================================================================//
+// MOAIPathRequest
+//================================================================//
+class MOAIPathRequest {
+public:
+
+	int			mStartNodeID;
+	int			mTargetNodeID;
+	u32			mIndex;			// position in the batch
+	u32			mBase;			// first node in the task's path list
+	u32			mSize;
+};
+
+//================================================================//
+// MOAIPathSnapshot
+//================================================================//
+// Immutable copy of a rectangular grid graph with the terrain mask and
+// weights of a path finder baked in. Built on the main thread; read by
+// any number of tasks at once. Terrain cost is linear in the terrain
+// vectors, so it's split into a cost for leaving one cell and a cost
+// for entering the next.
+class MOAIPathSnapshot :
+	public ZLRefCountedObject {
+private:
+
+	friend class MOAIPathService;
+	friend class MOAIPathServiceTask;
+
+	enum {
+		PASSABLE	= 0x01,
+		WEIGHTED	= 0x02,
+	};
+
+	u32						mVersion;
+	MOAIGrid*				mGrid;				// for comparison only
+	u32						mGridVersion;
+
+	int						mWidth;
+	int						mHeight;
+
+	float					mHCost;
+	float					mVCost;
+	float					mDCost;
+	float					mGWeight;
+	bool					mDiagonals;
+
+	ZLLeanArray < u8 >		mFlags;
+	ZLLeanArray < float >	mEnterCost;
+	ZLLeanArray < float >	mLeaveCost;
+
+public:
+
+	//----------------------------------------------------------------//
+	float			GetMoveCost				( int from, int to, float moveCost ) const;
+	bool			Init					( MOAIPathFinder& pathFinder, u32 version );
+	bool			IsMatch					( MOAIPathFinder& pathFinder ) const;
+					MOAIPathSnapshot		();
+					~MOAIPathSnapshot		();
+};
+
+//================================================================//
+// MOAIPathBatch
+//================================================================//
+class MOAIPathBatch :
+	public ZLRefCountedObject {
+private:
+
+	friend class MOAIPathService;
+	friend class MOAIPathServiceTask;
+
+	MOAILuaStrongRef		mOnFinish;
+	MOAILuaStrongRef		mResults;
+	u32						mBatchID;
+	u32						mVersion;
+	u32						mPendingTasks;
+};
+
+//================================================================//
+// MOAIPathServiceTask
+//================================================================//
+// Solves one share of a batch. Requests are grouped by target; each
+// group is answered by a single reverse Dijkstra search from the target
+// that stops once every start in the group is settled.
+class MOAIPathServiceTask :
+	public MOAITask {
+private:
+
+	MOAIPathSnapshot*							mSnapshot;
+	MOAIPathBatch*								mBatch;
+
+	ZLLeanStack < MOAIPathRequest, 32 >			mRequests;
+	ZLLeanStack < int, 256 >					mPaths;
+
+	// search scratch (indexed by cell)
+	ZLLeanArray < float >						mDist;
+	ZLLeanArray < int >							mNext;
+	ZLLeanArray < u32 >							mVisited;
+	ZLLeanArray < u32 >							mStarts;
+	ZLLeanStack < MOAIGridPathSearchEntry >		mHeap;
+	u32											mSearchID;
+
+	//----------------------------------------------------------------//
+	void			Execute					();
+	void			Publish					();
+	void			SearchFrom				( int targetID, u32 totalStarts );
+	void			SolveGroup				( u32 first, ZLLeanArray < bool >& solved );
+
+public:
+
+	//----------------------------------------------------------------//
+	void			AddRequest				( const MOAIPathRequest& request );
+	void			Init					( MOAIPathSnapshot& snapshot, MOAIPathBatch& batch );
+					MOAIPathServiceTask		();
+					~MOAIPathServiceTask	();
+};
+
+//================================================================//
+// MOAIPathService
+//================================================================//
+/**	@lua	MOAIPathService
+	@text	Answers batches of path requests on background task queues.
+
+			Requests are solved against a versioned snapshot of a path
+			finder's grid graph, terrain mask and terrain weights, so the
+			grid may be edited while a batch is in flight. A new snapshot
+			is taken when the grid changes; call snapshot () after changing
+			the path finder's mask, weights or flags. Requests that share
+			a target share one search.
+
+			Only MOAIGridPathGraph on rectangular grids is supported.
+			Paths are optimal for the path finder's move and terrain
+			costs; the heuristic and search mode flags are ignored.
+*/
+class MOAIPathService :
+	public virtual MOAILuaObject {
+private:
+
+	MOAILuaSharedPtr < MOAIPathFinder >		mPathFinder;
+	MOAIPathSnapshot*						mSnapshot;
+	u32										mVersion;
+	u32										mBatchID;
+
+	ZLLeanStack < MOAIPathRequest, 32 >		mRequests;
+
+	//----------------------------------------------------------------//
+	static int		_addRequest				( lua_State* L );
+	static int		_clearRequests			( lua_State* L );
+	static int		_findPaths				( lua_State* L );
+	static int		_getVersion				( lua_State* L );
+	static int		_setPathFinder			( lua_State* L );
+	static int		_snapshot				( lua_State* L );
+
+	//----------------------------------------------------------------//
+	bool			AffirmSnapshot			( bool force );
+
+public:
+
+	DECL_LUA_FACTORY ( MOAIPathService )
+
+	//----------------------------------------------------------------//
+					MOAIPathService			();
+					~MOAIPathService		();
+	void			RegisterLuaClass		( MOAILuaState& state );
+	void			RegisterLuaFuncs		( MOAILuaState& state );
+};
+
+#endif
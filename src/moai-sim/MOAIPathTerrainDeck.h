@@ -19,6 +19,7 @@ class MOAIPathTerrainDeck :
 private:
 
 	friend class MOAIPathFinder;
+	friend class MOAIPathSnapshot;
 
 	ZLLeanArray < u32 >		mMasks;
 	ZLLeanArray < float >	mVectors;
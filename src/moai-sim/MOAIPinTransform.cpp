@@ -108,7 +108,7 @@ void MOAIPinTransform::MOAINode_Update () {
 	this->mDestLayer->GetWndToWorldMtx ().Transform ( loc );
 	
 	this->mLocalToWorldMtx.Translate ( loc.mX, loc.mY, loc.mZ );
-	this->mWorldToLocalMtx.Translate ( -loc.mX, -loc.mY, -loc.mZ );
+	this->InvalidateWorldToLocalMtx ();
 	
 	// Z component is at the back of the NDC's near plane
 	this->mFront = loc.mZ < -1.0f ? 0.0f : 1.0f;
@@ -11,6 +11,29 @@
 #include <moai-sim/MOAIVertexBuffer.h>
 #include <tesselator.h>
 
+//================================================================//
+// MOAIRegionCenterCompare
+//================================================================//
+class MOAIRegionCenterCompare {
+private:
+
+	const ZLVec2D*	mCenters;
+	bool			mSplitX;
+
+public:
+
+	//----------------------------------------------------------------//
+	bool operator () ( u32 a, u32 b ) const {
+		return this->mSplitX ? ( this->mCenters [ a ].mX < this->mCenters [ b ].mX ) : ( this->mCenters [ a ].mY < this->mCenters [ b ].mY );
+	}
+
+	//----------------------------------------------------------------//
+	MOAIRegionCenterCompare ( const ZLVec2D* centers, bool splitX ) :
+		mCenters ( centers ),
+		mSplitX ( splitX ) {
+	}
+};
+
 //================================================================//
 // lua
 //================================================================//
@@ -222,6 +245,36 @@ int MOAIRegion::_findExtremity ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	findPolygons
+	@text	Returns the indices of all polygons whose bounds overlap the
+			given rect. Uses the region's index if it has one (regions
+			are indexed when blessed). Indices are not returned in any
+			particular order.
+
+	@in		MOAIRegion self
+	@in		number xMin
+	@in		number yMin
+	@in		number xMax
+	@in		number yMax
+	@out	... indices
+*/
+int MOAIRegion::_findPolygons ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIRegion, "UNNNN" )
+
+	ZLRect rect = state.GetRect < float >( 2 );
+	rect.Bless ();
+
+	ZLLeanStack < u32 > polygons;
+	self->FindPolygons ( rect, polygons );
+
+	u32 top = ( u32 )polygons.GetTop ();
+	for ( u32 i = 0; i < top; ++i ) {
+		state.Push ( polygons [ i ] + 1 );
+	}
+	return ( int )top;
+}
+
 //----------------------------------------------------------------//
 // TODO: doxygen
 int MOAIRegion::_getDistance ( lua_State* L ) {
@@ -383,7 +436,7 @@ int MOAIRegion::_reserveVertices ( lua_State* L ) {
 	u32 idx		= state.GetValue < u32 >( 2, 1 ) - 1;
 	u32 size	= state.GetValue < u32 >( 3, 0 );
 	
-	self->mPolygons [ idx ].ReserveVertices ( size );
+	self->ReserveVertices ( idx, size );
 	
 	return 0;
 }
@@ -413,6 +466,7 @@ int MOAIRegion::_setVertex ( lua_State* L ) {
 	float y			= state.GetValue < float >( 5, 0.0f );
 	
 	self->mPolygons [ polyIdx ].SetVert ( vertIdx, x, y );
+	self->ClearIndex ();
 	
 	return 0;
 }
@@ -551,6 +605,42 @@ int MOAIRegion::AddFillContours ( SafeTesselator& tess, u32 mask ) const {
 	return 0; // since we're not tesselating here (and thus do not have any error case) we always report no error
 }
 
+//----------------------------------------------------------------//
+int MOAIRegion::AddOverlappingContours ( SafeTesselator& tess, const MOAIRegion& other, int windingRule, ZLLeanStack < const ZLPolygon2D* >& passThrough ) const {
+
+	int contours = 0;
+	size_t size = this->mPolygons.Size ();
+	
+	for ( size_t i = 0; i < size; ++i ) {
+	
+		const ZLPolygon2D& polygon = this->mPolygons [ i ];
+		if ( !polygon.GetInfo ()) continue; // same as AddFillContours with the default mask
+		
+		// a simple polygon whose bounds touch no other polygon's bounds has a winding of
+		// exactly +1 or -1 everywhere inside, so the rule alone decides whether it survives.
+		if ( polygon.Check ( ZLPolygon2D::HAS_AREA )) {
+		
+			const ZLRect& bounds = this->mPolygonBounds [ i ];
+			
+			if ( !( this->OverlapsPolygon ( bounds, i ) || other.OverlapsPolygon ( bounds, ( size_t )-1 ))) {
+			
+				float area = MOAIRegion::GetSignedArea ( polygon );
+				
+				if ( area != 0.0f ) {
+					if ( MOAIRegion::IsFilled ( windingRule, area > 0.0f ? 1 : -1 )) {
+						passThrough.Push ( &polygon );
+					}
+					continue;
+				}
+			}
+		}
+		
+		tess.AddPolygon ( polygon );
+		contours++;
+	}
+	return contours;
+}
+
 //----------------------------------------------------------------//
 void MOAIRegion::Append ( const MOAIRegion& regionA, const MOAIRegion& regionB ) {
 
@@ -578,6 +668,7 @@ void MOAIRegion::Bless () {
 	for ( size_t i = 0; i < size; ++i ) {
 		this->mPolygons [ i ].Bless ();
 	}
+	this->BuildIndex ();
 }
 
 //----------------------------------------------------------------//
@@ -633,10 +724,98 @@ void MOAIRegion::BooleanXor ( const MOAIRegion& regionA, const MOAIRegion& regio
 	this->CombineAndTesselate ( regionA, regionB, TESS_WINDING_ODD );
 }
 
+//----------------------------------------------------------------//
+void MOAIRegion::BuildIndex () {
+
+	this->ClearIndex ();
+
+	size_t size = this->mPolygons.Size ();
+	if ( !size ) return;
+
+	this->mPolygonBounds.Init ( size );
+	this->mIndexPolygons.Init ( size );
+
+	ZLLeanArray < ZLVec2D > centers;
+	centers.Init ( size );
+
+	u32 total = 0;
+	for ( size_t i = 0; i < size; ++i ) {
+	
+		const ZLPolygon2D& polygon = this->mPolygons [ i ];
+		size_t nVerts = polygon.GetSize ();
+		
+		ZLRect& bounds = this->mPolygonBounds [ i ];
+		bounds.Init ( 0.0f, 0.0f, 0.0f, 0.0f );
+		
+		// empty polygons can't contain or be near anything, so leave them out
+		if ( !nVerts ) continue;
+		
+		// measured here rather than taken from the polygon; polygons with fewer
+		// than three vertices don't get bounds when they're blessed
+		bounds.Init ( polygon.GetVertex ( 0 ));
+		for ( size_t j = 1; j < nVerts; ++j ) {
+			bounds.Grow ( polygon.GetVertex ( j ));
+		}
+		bounds.GetCenter ( centers [ i ]);
+		
+		this->mIndexPolygons [ total++ ] = ( u32 )i;
+	}
+	
+	if ( !total ) {
+		this->ClearIndex ();
+		return;
+	}
+	
+	// at least one polygon per leaf, so never more than 2n - 1 nodes
+	this->mIndexNodes.Init ( total * 2 );
+	u32 totalNodes = this->BuildIndexRecurse ( centers, 0, 0, total );
+	this->mIndexNodes.Resize ( totalNodes );
+}
+
+//----------------------------------------------------------------//
+u32 MOAIRegion::BuildIndexRecurse ( const ZLVec2D* centers, u32 nodeIdx, u32 base, u32 count ) {
+
+	u32* polygons = this->mIndexPolygons.Data () + base;
+	MOAIRegionIndexNode& node = this->mIndexNodes [ nodeIdx ];
+	
+	ZLRect centerBounds;
+	node.mBounds = this->mPolygonBounds [ polygons [ 0 ]];
+	centerBounds.Init ( centers [ polygons [ 0 ]]);
+	
+	for ( u32 i = 1; i < count; ++i ) {
+		node.mBounds.Grow ( this->mPolygonBounds [ polygons [ i ]]);
+		centerBounds.Grow ( centers [ polygons [ i ]]);
+	}
+	
+	if ( count <= INDEX_LEAF_POLYGONS ) {
+		node.mOffset = base;
+		node.mCount = count;
+		return nodeIdx + 1;
+	}
+	
+	// split at the median along the longer axis; it keeps the tree balanced no
+	// matter how the polygons are spread out
+	u32 half = count >> 1;
+	std::nth_element ( polygons, polygons + half, polygons + count, MOAIRegionCenterCompare ( centers, centerBounds.Width () >= centerBounds.Height ()));
+	
+	node.mCount = 0;
+	node.mOffset = this->BuildIndexRecurse ( centers, nodeIdx + 1, base, half );
+	return this->BuildIndexRecurse ( centers, node.mOffset, base + half, count - half );
+}
+
 //----------------------------------------------------------------//
 void MOAIRegion::Clear () {
 
 	this->mPolygons.Clear ();
+	this->ClearIndex ();
+}
+
+//----------------------------------------------------------------//
+void MOAIRegion::ClearIndex () {
+
+	this->mIndexNodes.Clear ();
+	this->mIndexPolygons.Clear ();
+	this->mPolygonBounds.Clear ();
 }
 
 //----------------------------------------------------------------//
@@ -676,13 +855,66 @@ int MOAIRegion::CombineAndTesselate ( const MOAIRegion& regionA, const MOAIRegio
 
 	SafeTesselator tess;
 	
-	regionA.AddFillContours ( tess );
-	regionB.AddFillContours ( tess );
+	bool indexedA = regionA.IsIndexed () || !regionA.GetSize ();
+	bool indexedB = regionB.IsIndexed () || !regionB.GetSize ();
 	
-	int error = tess.Tesselate ( windingRule, TESS_BOUNDARY_CONTOURS, 0, 0 );
+	if ( !( indexedA && indexedB )) {
+	
+		regionA.AddFillContours ( tess );
+		regionB.AddFillContours ( tess );
+		
+		int error = tess.Tesselate ( windingRule, TESS_BOUNDARY_CONTOURS, 0, 0 );
 
+		if ( !error ) {
+			this->Copy ( tess );
+			this->Bless ();
+			this->Cull ( *this, ZLPolygon2D::IS_CORRUPT );
+		}
+		return error;
+	}
+	
+	// only polygons that overlap something go to the tesselator; the rest are
+	// either dropped or copied straight across
+	ZLLeanStack < const ZLPolygon2D* > passThrough;
+	
+	int contours = regionA.AddOverlappingContours ( tess, regionB, windingRule, passThrough );
+	contours += regionB.AddOverlappingContours ( tess, regionA, windingRule, passThrough );
+	
+	int error = contours ? tess.Tesselate ( windingRule, TESS_BOUNDARY_CONTOURS, 0, 0 ) : 0;
+	
 	if ( !error ) {
-		this->Copy ( tess );
+	
+		const int* elems	= contours ? tessGetElements ( tess.mTess ) : 0;
+		int nelems			= contours ? tessGetElementCount ( tess.mTess ) : 0;
+		const float* verts	= contours ? tessGetVertices ( tess.mTess ) : 0;
+		
+		size_t nPassThrough = passThrough.GetTop ();
+		
+		// built on the side; this region may be one of the sources
+		MOAIRegion combined;
+		combined.ReservePolygons (( size_t )nelems + nPassThrough );
+		
+		for ( int i = 0; i < nelems; ++i ) {
+		
+			int b = elems [( i * 2 )];
+			int n = elems [( i * 2 ) + 1 ];
+			
+			combined.mPolygons [ i ].SetVertices (( ZLVec2D* )&verts [ b * 2 ], n );
+		}
+		
+		// the tesselator emits solid contours anticlockwise, so match it
+		for ( size_t i = 0; i < nPassThrough; ++i ) {
+		
+			ZLPolygon2D& polygon = combined.mPolygons [ nelems + i ];
+			polygon.Copy ( *passThrough [ i ]);
+			
+			if ( MOAIRegion::GetSignedArea ( polygon ) < 0.0f ) {
+				polygon.ReverseWinding ();
+			}
+		}
+		
+		this->ClearIndex ();
+		this->mPolygons.Take ( combined.mPolygons );
 		this->Bless ();
 		this->Cull ( *this, ZLPolygon2D::IS_CORRUPT );
 	}
@@ -720,6 +952,10 @@ void MOAIRegion::Copy ( const MOAIRegion& region ) {
 		for ( size_t i = 0; i < size; ++i ) {
 			this->mPolygons [ i ].Copy ( region.mPolygons [ i ]);
 		}
+		
+		this->mIndexNodes.CloneFrom ( region.mIndexNodes );
+		this->mIndexPolygons.CloneFrom ( region.mIndexPolygons );
+		this->mPolygonBounds.CloneFrom ( region.mPolygonBounds );
 	}
 }
 
@@ -780,6 +1016,10 @@ void MOAIRegion::Cull ( const MOAIRegion& region, u32 flag, bool checkArea, floa
 			this->mPolygons [ count++ ].Copy ( poly );
 		}
 	}
+	
+	if ( srcRegion->IsIndexed ()) {
+		this->BuildIndex ();
+	}
 }
 
 //----------------------------------------------------------------//
@@ -938,6 +1178,59 @@ bool MOAIRegion::FindExtremity ( ZLVec2D n, ZLVec2D& e ) {
 	return found;
 }
 
+//----------------------------------------------------------------//
+void MOAIRegion::FindPolygons ( const ZLRect& rect, ZLLeanStack < u32 >& polygons ) const {
+
+	if ( !this->mIndexNodes.Size ()) {
+	
+		size_t size = this->mPolygons.Size ();
+		for ( size_t i = 0; i < size; ++i ) {
+		
+			const ZLPolygon2D& polygon = this->mPolygons [ i ];
+			size_t nVerts = polygon.GetSize ();
+			if ( !nVerts ) continue;
+			
+			ZLRect bounds;
+			bounds.Init ( polygon.GetVertex ( 0 ));
+			for ( size_t j = 1; j < nVerts; ++j ) {
+				bounds.Grow ( polygon.GetVertex ( j ));
+			}
+			
+			if ( bounds.Overlap ( rect )) {
+				polygons.Push (( u32 )i );
+			}
+		}
+		return;
+	}
+
+	u32 stack [ INDEX_STACK_SIZE ];
+	u32 top = 0;
+	
+	stack [ top++ ] = 0;
+	
+	while ( top ) {
+	
+		u32 nodeIdx = stack [ --top ];
+		const MOAIRegionIndexNode& node = this->mIndexNodes [ nodeIdx ];
+		
+		if ( !node.mBounds.Overlap ( rect )) continue;
+		
+		if ( node.mCount ) {
+		
+			for ( u32 i = 0; i < node.mCount; ++i ) {
+				u32 polyIdx = this->mIndexPolygons [ node.mOffset + i ];
+				if ( this->mPolygonBounds [ polyIdx ].Overlap ( rect )) {
+					polygons.Push ( polyIdx );
+				}
+			}
+		}
+		else {
+			stack [ top++ ] = node.mOffset;
+			stack [ top++ ] = nodeIdx + 1;
+		}
+	}
+}
+
 //----------------------------------------------------------------//
 bool MOAIRegion::GetDistance ( const ZLVec2D& point, float& d ) const {
 
@@ -950,20 +1243,81 @@ bool MOAIRegion::GetDistance ( const ZLVec2D& point, float& d, ZLVec2D& p ) cons
 
 	bool foundResult = false;
 
-	for ( size_t i = 0; i < this->mPolygons.Size (); ++i ) {
+	if ( !this->mIndexNodes.Size ()) {
+
+		for ( size_t i = 0; i < this->mPolygons.Size (); ++i ) {
+		
+			ZLPolygon2D& poly = this->mPolygons [ i ];
+			
+			float		candidateD;
+			ZLVec2D		candidateP;
+			
+			if ( poly.GetDistance ( point, candidateD, candidateP )) {
+			
+				if (( !foundResult ) || ( candidateD < d )) {
+					d = candidateD;
+					p = candidateP;
+					foundResult = true;
+				}
+			}
+		}
+		return foundResult;
+	}
 	
-		ZLPolygon2D& poly = this->mPolygons [ i ];
+	// nearest first, skipping anything whose bounds are already farther away
+	// than the best edge. ties go to the lower polygon, as in the scan above.
+	u32 bestPoly = 0;
+	
+	u32 stack [ INDEX_STACK_SIZE ];
+	u32 top = 0;
+	
+	stack [ top++ ] = 0;
+	
+	while ( top ) {
+	
+		u32 nodeIdx = stack [ --top ];
+		const MOAIRegionIndexNode& node = this->mIndexNodes [ nodeIdx ];
+		
+		if ( foundResult && ( point.DistSqrd ( node.mBounds.GetNearestPoint ( point )) > ( d * d ))) continue;
 		
-		float		candidateD;
-		ZLVec2D		candidateP;
+		if ( node.mCount ) {
 		
-		if ( poly.GetDistance ( point, candidateD, candidateP )) {
+			for ( u32 i = 0; i < node.mCount; ++i ) {
+			
+				u32 polyIdx = this->mIndexPolygons [ node.mOffset + i ];
+				const ZLRect& bounds = this->mPolygonBounds [ polyIdx ];
+				
+				if ( foundResult && ( point.DistSqrd ( bounds.GetNearestPoint ( point )) > ( d * d ))) continue;
+				
+				float		candidateD;
+				ZLVec2D		candidateP;
+				
+				if ( this->mPolygons [ polyIdx ].GetDistance ( point, candidateD, candidateP )) {
+				
+					if (( !foundResult ) || ( candidateD < d ) || (( candidateD == d ) && ( polyIdx < bestPoly ))) {
+						d = candidateD;
+						p = candidateP;
+						bestPoly = polyIdx;
+						foundResult = true;
+					}
+				}
+			}
+		}
+		else {
 		
-			if (( !foundResult ) || ( candidateD < d )) {
-				d = candidateD;
-				p = candidateP;
-				foundResult = true;
+			u32 near = nodeIdx + 1;
+			u32 far = node.mOffset;
+			
+			const MOAIRegionIndexNode& nearNode = this->mIndexNodes [ near ];
+			const MOAIRegionIndexNode& farNode = this->mIndexNodes [ far ];
+			
+			if ( point.DistSqrd ( farNode.mBounds.GetNearestPoint ( point )) < point.DistSqrd ( nearNode.mBounds.GetNearestPoint ( point ))) {
+				near = far;
+				far = nodeIdx + 1;
 			}
+			
+			stack [ top++ ] = far;
+			stack [ top++ ] = near;
 		}
 	}
 	return foundResult;
@@ -981,6 +1335,19 @@ const ZLPolygon2D& MOAIRegion::GetPolygon ( u32 idx ) const {
 	return this->mPolygons [ idx ];
 }
 
+//----------------------------------------------------------------//
+float MOAIRegion::GetSignedArea ( const ZLPolygon2D& polygon ) {
+
+	// positive for anticlockwise, the tesselator's +1 winding
+	float area = 0.0f;
+	
+	size_t nVerts = polygon.GetSize ();
+	for ( size_t i = 0; i < nVerts; ++i ) {
+		area += polygon.GetVertex ( i ).Cross ( polygon.GetVertex (( i + 1 ) % nVerts ));
+	}
+	return area * 0.5f;
+}
+
 //----------------------------------------------------------------//
 u32 MOAIRegion::GetTriangles ( SafeTesselator& tess ) const {
 
@@ -1039,6 +1406,19 @@ ZLSizeResult MOAIRegion::GetVertices ( ZLStream& vtxStream ) const {
 	ZL_RETURN_SIZE_RESULT ( count, ZL_OK )
 }
 
+//----------------------------------------------------------------//
+bool MOAIRegion::IsFilled ( int windingRule, int winding ) {
+
+	switch ( windingRule ) {
+		case TESS_WINDING_ODD:			return ( winding & 1 ) != 0;
+		case TESS_WINDING_NONZERO:		return winding != 0;
+		case TESS_WINDING_POSITIVE:		return winding > 0;
+		case TESS_WINDING_NEGATIVE:		return winding < 0;
+		case TESS_WINDING_ABS_GEQ_TWO:	return ABS ( winding ) >= 2;
+	}
+	return false;
+}
+
 //----------------------------------------------------------------//
 MOAIRegion::MOAIRegion () {
 	
@@ -1049,6 +1429,38 @@ MOAIRegion::MOAIRegion () {
 MOAIRegion::~MOAIRegion () {
 }
 
+//----------------------------------------------------------------//
+bool MOAIRegion::OverlapsPolygon ( const ZLRect& rect, size_t exclude ) const {
+
+	if ( !this->mIndexNodes.Size ()) return false;
+
+	u32 stack [ INDEX_STACK_SIZE ];
+	u32 top = 0;
+	
+	stack [ top++ ] = 0;
+	
+	while ( top ) {
+	
+		u32 nodeIdx = stack [ --top ];
+		const MOAIRegionIndexNode& node = this->mIndexNodes [ nodeIdx ];
+		
+		if ( !node.mBounds.Overlap ( rect )) continue;
+		
+		if ( node.mCount ) {
+		
+			for ( u32 i = 0; i < node.mCount; ++i ) {
+				u32 polyIdx = this->mIndexPolygons [ node.mOffset + i ];
+				if (( polyIdx != exclude ) && this->mPolygonBounds [ polyIdx ].Overlap ( rect )) return true;
+			}
+		}
+		else {
+			stack [ top++ ] = node.mOffset;
+			stack [ top++ ] = nodeIdx + 1;
+		}
+	}
+	return false;
+}
+
 //----------------------------------------------------------------//
 void MOAIRegion::Pad ( const MOAIRegion& region, float pad ) {
 
@@ -1097,16 +1509,57 @@ bool MOAIRegion::PointInside ( const ZLVec2D& p, float pad ) const {
 
 	bool inside = false;
 
-	for ( size_t i = 0; i < nPolys; ++i ) {
+	if ( !this->mIndexNodes.Size ()) {
+
+		for ( size_t i = 0; i < nPolys; ++i ) {
+			
+			switch ( this->mPolygons [ i ].PointInside ( p )) {
+			
+				case ZLPolygon2D::POINT_ON_EDGE:
+					return true;
+				
+				case ZLPolygon2D::POINT_INSIDE:
+					inside = !inside;
+					break;
+			}
+		}
+		return inside;
+	}
+	
+	// parity only changes inside a polygon's bounds, so the rest can be skipped
+	u32 stack [ INDEX_STACK_SIZE ];
+	u32 top = 0;
+	
+	stack [ top++ ] = 0;
+	
+	while ( top ) {
+	
+		u32 nodeIdx = stack [ --top ];
+		const MOAIRegionIndexNode& node = this->mIndexNodes [ nodeIdx ];
+		
+		if ( !node.mBounds.Contains ( p )) continue;
 		
-		switch ( this->mPolygons [ i ].PointInside ( p )) {
+		if ( node.mCount ) {
 		
-			case ZLPolygon2D::POINT_ON_EDGE:
-				return true;
+			for ( u32 i = 0; i < node.mCount; ++i ) {
 			
-			case ZLPolygon2D::POINT_INSIDE:
-				inside = !inside;
-				break;
+				u32 polyIdx = this->mIndexPolygons [ node.mOffset + i ];
+				if ( !this->mPolygonBounds [ polyIdx ].Contains ( p )) continue;
+				
+				switch ( this->mPolygons [ polyIdx ].PointInside ( p )) {
+				
+					case ZLPolygon2D::POINT_ON_EDGE:
+						return true;
+					
+					case ZLPolygon2D::POINT_INSIDE:
+						inside = !inside;
+						break;
+				}
+			}
+		}
+		else {
+			stack [ top++ ] = node.mOffset;
+			stack [ top++ ] = nodeIdx + 1;
 		}
 	}
 	return inside;
@@ -1212,6 +1665,7 @@ void MOAIRegion::RegisterLuaFuncs ( MOAILuaState& state ) {
 		{ "drawDebug",			_drawDebug },
 		{ "edge",				_edge },
 		{ "findExtremity",		_findExtremity },
+		{ "findPolygons",		_findPolygons },
 		{ "getDistance",		_getDistance },
 		{ "getPolygon",			_getPolygon },
 		{ "getTriangles",		_getTriangles },
@@ -1237,15 +1691,18 @@ void MOAIRegion::RegisterLuaFuncs ( MOAILuaState& state ) {
 //----------------------------------------------------------------//
 ZLResultCode MOAIRegion::ReservePolygons ( size_t size ) {
 
+	this->ClearIndex ();
 	return this->mPolygons.Init ( size );
 }
 
 //----------------------------------------------------------------//
 ZLResultCode MOAIRegion::ReserveVertices ( size_t idx, size_t size ) {
 
+	this->ClearIndex ();
+
 	if ( idx >= this->mPolygons.Size ()) {
 	
-		ZLResultCode result = this->mPolygons.Grow ( idx );
+		ZLResultCode result = this->mPolygons.Grow ( idx + 1 );
 		if ( result != ZL_OK ) return result;
 	}
 	return this->mPolygons [ idx ].ReserveVertices ( size );
@@ -1269,7 +1726,7 @@ void MOAIRegion::SerializeIn ( MOAILuaState& state, MOAIDeserializer& serializer
 	UNUSED ( serializer );
 
 	size_t nPolys = ( int )lua_objlen ( state, -1 );
-	this->mPolygons.Init ( nPolys );
+	this->ReservePolygons ( nPolys );
 	
 	for ( size_t i = 0; i < nPolys; ++i ) {
 		ZLPolygon2D& poly = this->mPolygons [ i ];
@@ -1286,6 +1743,7 @@ void MOAIRegion::SerializeIn ( MOAILuaState& state, MOAIDeserializer& serializer
 		
 		state.Pop ( 1 );
 	}
+	this->BuildIndex ();
 }
 
 //----------------------------------------------------------------//
@@ -1326,6 +1784,7 @@ bool MOAIRegion::ShouldCull ( const ZLPolygon2D& poly, u32 flag, bool checkArea,
 void MOAIRegion::Snap ( const MOAIRegion& region, float xSnap, float ySnap ) {
 
 	this->Copy ( region );
+	this->ClearIndex ();
 	
 	size_t size = this->mPolygons.Size ();
 	
@@ -1405,6 +1864,7 @@ int MOAIRegion::Tesselate ( const MOAIRegion& region, int windingRule ) {
 void MOAIRegion::Transform ( const MOAIRegion& region, const ZLAffine2D& transform ) {
 
 	this->Copy ( region );
+	this->ClearIndex ();
 
 	size_t nPolys = this->mPolygons.Size ();
 	for ( size_t i = 0; i < nPolys; ++i ) {
@@ -11,6 +11,22 @@ class MOAIVertexFormat;
 
 class SafeTesselator;
 
+//================================================================//
+// MOAIRegionIndexNode
+//================================================================//
+// nodes are stored depth first in one array. an interior node's first child
+// follows it directly; mOffset is the second child. a leaf's polygons are
+// the run [ mOffset, mOffset + mCount ) of the region's index list.
+class MOAIRegionIndexNode {
+private:
+
+	friend class MOAIRegion;
+
+	ZLRect		mBounds;
+	u32			mOffset;
+	u32			mCount;		// zero for interior nodes
+};
+
 //================================================================//
 // MOAIRegion
 //================================================================//
@@ -19,8 +35,17 @@ class MOAIRegion :
 	public virtual MOAILuaObject {
 private:
 	
+	static const u32 INDEX_LEAF_POLYGONS	= 4;
+	static const u32 INDEX_STACK_SIZE		= 64;	// median splits keep the depth far below this
+	
 	ZLLeanArray < ZLPolygon2D > mPolygons;
 	
+	// bounds hierarchy over mPolygons. built by Bless () and dropped by
+	// anything that edits vertices, so a non-empty index is always current.
+	ZLLeanArray < MOAIRegionIndexNode >		mIndexNodes;
+	ZLLeanArray < u32 >						mIndexPolygons;
+	ZLLeanArray < ZLRect >					mPolygonBounds;		// by polygon; taken from the vertices, not the polygon's cached bounds
+	
 	//----------------------------------------------------------------//
 	static int		_append				( lua_State* L );
 	static int		_bless				( lua_State* L );
@@ -34,6 +59,7 @@ private:
 	static int		_drawDebug			( lua_State* L );
 	static int		_edge				( lua_State* L );
 	static int		_findExtremity		( lua_State* L );
+	static int		_findPolygons		( lua_State* L );
 	static int		_getDistance		( lua_State* L );
 	static int		_getPolygon			( lua_State* L );
 	static int		_getTriangles		( lua_State* L );
@@ -52,6 +78,13 @@ private:
 	static int		_translate			( lua_State* L );
 
 	//----------------------------------------------------------------//
+	int						AddOverlappingContours	( SafeTesselator& tess, const MOAIRegion& other, int windingRule, ZLLeanStack < const ZLPolygon2D* >& passThrough ) const;
+	void					BuildIndex				();
+	u32						BuildIndexRecurse		( const ZLVec2D* centers, u32 nodeIdx, u32 base, u32 count );
+	void					ClearIndex				();
+	static float			GetSignedArea			( const ZLPolygon2D& polygon );
+	static bool				IsFilled				( int windingRule, int winding );
+	bool					OverlapsPolygon			( const ZLRect& rect, size_t exclude ) const;
 	void					Read					( ZLStream& verts, ZLStream& polySizes );
 	bool					ShouldCull				( const ZLPolygon2D& poly, u32 flag, bool checkArea, float minArea );
 
@@ -73,6 +106,11 @@ public:
 
 	GET_CONST ( size_t, Size, mPolygons.Size ())
 
+	//----------------------------------------------------------------//
+	inline bool IsIndexed () const {
+		return ( this->mIndexNodes.Size () > 0 );
+	}
+
 	//----------------------------------------------------------------//
 	int						AddFillContours			( SafeTesselator& tess, u32 mask = 0xffffffff ) const;
 	void					Append					( const MOAIRegion& regionA, const MOAIRegion& regionB );
@@ -94,6 +132,7 @@ public:
 	void					DrawDebug				() const;
 	void					Edge					( const MOAIRegion& region, const ZLVec2D& offset );
 	bool					FindExtremity			( ZLVec2D n, ZLVec2D& e );
+	void					FindPolygons			( const ZLRect& rect, ZLLeanStack < u32 >& polygons ) const;
 	bool					GetDistance				( const ZLVec2D& point, float& d ) const;
 	bool					GetDistance				( const ZLVec2D& point, float& d, ZLVec2D& p ) const;
 	ZLPolygon2D&			GetPolygon				( u32 idx );
@@ -155,6 +155,24 @@ void MOAIShader::SetProgram ( MOAIShaderProgram* program ) {
 	}
 }
 
+//----------------------------------------------------------------//
+void MOAIShader::SetUniformArray ( u32 uniformID, const ZLAffine3D* values, u32 count ) {
+
+	if ( !( this->mProgram && values )) return;
+
+	MOAIShaderUniform* uniform = this->mProgram->GetUniform ( uniformID );
+	if ( !uniform ) return;
+
+	count = MIN ( count, uniform->mCount );
+
+	MOAIShaderUniformHandle handle = this->mProgram->GetUniformHandle ( this->mPendingUniformBuffer, uniformID );
+
+	for ( u32 i = 0; i < count; ++i ) {
+		handle.SetValue ( values [ i ]);
+		handle.Next ();
+	}
+}
+
 //----------------------------------------------------------------//
 void MOAIShader::UpdateUniforms () {
 
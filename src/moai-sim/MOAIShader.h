@@ -56,6 +56,7 @@ public:
 	void					ResizeUniformArray		( u32 uniformID, u32 count );
 	void					ScheduleTextures		();
 	void					SetProgram				( MOAIShaderProgram* program );
+	void					SetUniformArray			( u32 uniformID, const ZLAffine3D* values, u32 count );
 	void					UpdateUniforms			();
 };
 
@@ -5,6 +5,7 @@
 #include <moai-sim/MOAIDebugLines.h>
 #include <moai-sim/MOAIGfxMgr.h>
 #include <moai-sim/MOAINodeMgr.h>
+#include <moai-sim/MOAIParticleMgr.h>
 #include <moai-sim/MOAISim.h>
 #include <moai-sim/MOAITextureBase.h>
 #include <moai-sim/MOAIRenderMgr.h>
@@ -412,6 +413,44 @@ int MOAISim::_pauseTimer ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	resimulate
+	@text	Runs the given number of fixed sim steps. Use after restoring
+			a MOAISnapshot to bring the sim back up to the present
+			(rollback). Input queued in MOAIInputMgr is consumed by the
+			first step as usual.
+			
+			Called outside of a sim step, the steps run immediately.
+			Called from inside one (a coroutine, action or callback),
+			the request is recorded and the steps run as soon as the
+			current step finishes, so the action tree is never
+			re-entered. Requests made during the same step add up.
+			Calling resimulate from inside the resimulated steps raises
+			an error.
+	
+	@in		number steps
+	@out	number elapsed		Time spent, in seconds. nil if the steps were deferred.
+*/
+int MOAISim::_resimulate ( lua_State* L ) {
+
+	MOAILuaState state ( L );
+	u32 steps = state.GetValue < u32 >( 1, 1 );
+	
+	MOAISim& sim = MOAISim::Get ();
+	
+	if ( sim.mResimulating ) {
+		return luaL_error ( L, "MOAISim.resimulate called while already resimulating" );
+	}
+	
+	if ( sim.mStepping ) {
+		sim.mPendingResimulate += steps;
+		return 0;
+	}
+	
+	state.Push ( sim.Resimulate ( steps ));
+	return 1;
+}
+
 //----------------------------------------------------------------//
 /**	@lua	setBoostThreshold
 	@text	Sets the boost threshold, a scalar applied to step. If the gap
@@ -745,7 +784,10 @@ MOAISim::MOAISim () :
 	mHideCursorFunc ( 0 ),
 	mGCActive ( true ),
 	mSmoothIdx ( 0 ),
-	mGCStep ( 0 ) {
+	mGCStep ( 0 ),
+	mStepping ( false ),
+	mResimulating ( false ),
+	mPendingResimulate ( 0 ) {
 	
 	RTTI_SINGLE ( MOAIGlobalEventSource )
 	
@@ -866,6 +908,7 @@ void MOAISim::RegisterLuaClass ( MOAILuaState& state ) {
 		{ "hideCursor",					_hideCursor },
 		{ "openWindow",					_openWindow },
 		{ "pauseTimer",					_pauseTimer },
+		{ "resimulate",					_resimulate },
 		{ "setBoostThreshold",			_setBoostThreshold },
 		{ "setCpuBudget",				_setCpuBudget},
 		{ "setGCActive",				_setGCActive },
@@ -893,6 +936,18 @@ void MOAISim::RegisterLuaFuncs ( MOAILuaState& state ) {
 	UNUSED ( state );
 }
 
+//----------------------------------------------------------------//
+double MOAISim::Resimulate ( u32 steps ) {
+
+	if ( this->mResimulating || !steps ) return 0.0;
+	
+	this->mResimulating = true;
+	double elapsed = this->StepSim ( this->mStep, steps );
+	this->mResimulating = false;
+	
+	return elapsed;
+}
+
 //----------------------------------------------------------------//
 void MOAISim::Resume () {
 
@@ -944,6 +999,20 @@ double MOAISim::SmoothStep ( double step ) {
 	return ( count > 0 ) ? sum / count : step;
 }
 
+//----------------------------------------------------------------//
+void MOAISim::SnapshotIn ( ZLStream& stream ) {
+
+	this->mSimTime		= stream.Read < double >( this->mSimTime );
+	this->mStepCount	= stream.Read < u32 >( this->mStepCount );
+}
+
+//----------------------------------------------------------------//
+void MOAISim::SnapshotOut ( ZLStream& stream ) {
+
+	stream.Write < double >( this->mSimTime );
+	stream.Write < u32 >( this->mStepCount );
+}
+
 //----------------------------------------------------------------//
 double MOAISim::StepSim ( double step, u32 multiplier ) {
 
@@ -951,6 +1020,8 @@ double MOAISim::StepSim ( double step, u32 multiplier ) {
 
 	MOAIScopedLuaState state = MOAILuaRuntime::Get ().State ();
 
+	this->mStepping = true;
+
 	for ( u32 s = 0; s < multiplier; ++s ) {
 		
 		lua_gc ( state, LUA_GCSTOP, 0 );
@@ -962,6 +1033,7 @@ double MOAISim::StepSim ( double step, u32 multiplier ) {
 		double t = ZLDeviceTime::GetTimeInSeconds ();
 		MOAIInputMgr::Get ().Update ( step );
 		this->mActionTree->Update ( step );
+		MOAIParticleMgr::Get ().Update ();
 		this->mActionTreeTime = this->mActionTreeTime + ZLDeviceTime::GetTimeInSeconds () - t;
 		
 		t = ZLDeviceTime::GetTimeInSeconds ();
@@ -980,6 +1052,15 @@ double MOAISim::StepSim ( double step, u32 multiplier ) {
 			lua_gc ( state, LUA_GCSTEP, this->mGCStep );
 		}
 	}
+	
+	this->mStepping = false;
+	
+	// rollbacks asked for during the step run now that nothing is iterating the action tree
+	if ( this->mPendingResimulate ) {
+		u32 steps = this->mPendingResimulate;
+		this->mPendingResimulate = 0;
+		this->Resimulate ( steps );
+	}
 	return ZLDeviceTime::GetTimeInSeconds () - time;
 }
 
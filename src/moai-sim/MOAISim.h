@@ -112,6 +112,10 @@ private:
 	u32					mGCActive;
 	u32					mGCStep;
 	
+	bool				mStepping;				// set while StepSim is running the action tree and nodes
+	bool				mResimulating;			// set while Resimulate is stepping; guards against nested rollbacks
+	u32					mPendingResimulate;		// steps requested from inside a step; run once it returns
+	
 	MOAILuaMemberRef	mLuaGCFunc;
 	
 	MOAILuaSharedPtr < MOAIActionTree >		mActionMgr; // this is a sub-tree
@@ -139,6 +143,7 @@ private:
 	static int		_hideCursor					( lua_State* L );
 	static int		_openWindow					( lua_State* L );
 	static int		_pauseTimer					( lua_State* L );
+	static int		_resimulate					( lua_State* L );
 	static int		_setBoostThreshold			( lua_State* L );
 	static int		_setCpuBudget				( lua_State* L );
 	static int		_setGCActive				( lua_State* L );
@@ -219,8 +224,11 @@ public:
 	void			Pause						();
 	void			RegisterLuaClass			( MOAILuaState& state );
 	void			RegisterLuaFuncs			( MOAILuaState& state );
+	double			Resimulate					( u32 steps );
 	void			Resume						();
 	void			SetStep						( double step );
+	void			SnapshotIn					( ZLStream& stream );
+	void			SnapshotOut					( ZLStream& stream );
 	void			Update						();
 };
 
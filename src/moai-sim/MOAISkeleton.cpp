@@ -0,0 +1,509 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#include <moai-sim/MOAIAnimCurveBone.h>
+#include <moai-sim/MOAIGfxBuffer.h>
+#include <moai-sim/MOAIShader.h>
+#include <moai-sim/MOAISkeleton.h>
+#include <moai-sim/MOAIVertexFormat.h>
+
+//================================================================//
+// local
+//================================================================//
+
+//----------------------------------------------------------------//
+/**	@lua	getJointMtx
+	@text	Returns the world matrix of a joint as of the last update.
+
+	@in		MOAISkeleton self
+	@in		number jointID
+	@out	number... 12 matrix components (column major)
+*/
+int MOAISkeleton::_getJointMtx ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAISkeleton, "UN" )
+
+	u32 jointID = state.GetValue < u32 >( 2, 1 ) - 1;
+
+	if ( jointID < self->mWorld.Size ()) {
+		self->ForceUpdate ();
+		return state.Push ( self->mWorld [ jointID ]);
+	}
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	reserveJoints
+	@text	Reserves joints. All joints start as roots at the origin.
+
+	@in		MOAISkeleton self
+	@in		number total
+	@out	nil
+*/
+int MOAISkeleton::_reserveJoints ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAISkeleton, "UN" )
+
+	self->ReserveJoints ( state.GetValue < u32 >( 2, 0 ));
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	reservePalette
+	@text	Reserves palette entries. The palette is the array of
+			skinning matrices; a joint may appear in it any number of times.
+
+	@in		MOAISkeleton self
+	@in		number total
+	@out	nil
+*/
+int MOAISkeleton::_reservePalette ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAISkeleton, "UN" )
+
+	self->ReservePalette ( state.GetValue < u32 >( 2, 0 ));
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	setJoint
+	@text	Sets a joint's parent and rest pose. Parents must have a lower
+			index than their children.
+
+	@in		MOAISkeleton self
+	@in		number jointID
+	@opt	number parentID			Default value is 0 (no parent).
+	@opt	number x				Default value is 0.
+	@opt	number y				Default value is 0.
+	@opt	number z				Default value is 0.
+	@opt	number qx				Default value is 0.
+	@opt	number qy				Default value is 0.
+	@opt	number qz				Default value is 0.
+	@opt	number qw				Default value is 1.
+	@opt	number sx				Default value is 1.
+	@opt	number sy				Default value is 1.
+	@opt	number sz				Default value is 1.
+	@out	nil
+*/
+int MOAISkeleton::_setJoint ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAISkeleton, "UN" )
+
+	u32 jointID				= state.GetValue < u32 >( 2, 1 ) - 1;
+	u32 parentID			= state.GetValue < u32 >( 3, 0 ) - 1;
+	ZLVec3D position		= state.GetValue < ZLVec3D >( 4, ZLVec3D::ORIGIN );
+	ZLQuaternion rotation	= state.GetValue < ZLQuaternion >( 7, ZLQuaternion::IDENT );
+	ZLVec3D scale			= state.GetValue < ZLVec3D >( 11, ZLVec3D::AXIS );
+
+	if (( parentID != NO_PARENT ) && ( parentID >= jointID )) {
+		MOAILogF ( L, ZLLog::LOG_ERROR, "Joint %d: parent must precede child\n", jointID + 1 );
+		return 0;
+	}
+	self->SetJoint ( jointID, parentID, position, rotation, scale );
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	setJointCurve
+	@text	Binds a bone curve to a joint for the given clip. Joints
+			without a curve hold their rest pose.
+
+	@in		MOAISkeleton self
+	@in		number clip				One of MOAISkeleton.CLIP_A, MOAISkeleton.CLIP_B
+	@in		number jointID
+	@opt	MOAIAnimCurveBone curve	Pass nil to clear.
+	@out	nil
+*/
+int MOAISkeleton::_setJointCurve ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAISkeleton, "UNN" )
+
+	u32 clip		= state.GetValue < u32 >( 2, CLIP_A );
+	u32 jointID		= state.GetValue < u32 >( 3, 1 ) - 1;
+
+	self->SetJointCurve ( clip, jointID, state.GetLuaObject < MOAIAnimCurveBone >( 4, true ));
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	setPaletteEntry
+	@text	Maps a palette entry to a joint. The offset (inverse bind)
+			matrix is applied before the joint's world matrix.
+
+	@in		MOAISkeleton self
+	@in		number idx
+	@in		number jointID
+	@opt	number... 12 offset matrix components (column major). Default is identity.
+	@out	nil
+*/
+int MOAISkeleton::_setPaletteEntry ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAISkeleton, "UNN" )
+
+	u32 idx				= state.GetValue < u32 >( 2, 1 ) - 1;
+	u32 jointID			= state.GetValue < u32 >( 3, 1 ) - 1;
+	ZLAffine3D offset	= state.GetValue < ZLAffine3D >( 4, ZLAffine3D::IDENT );
+
+	self->SetPaletteEntry ( idx, jointID, offset );
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	setShader
+	@text	Sets a shader to receive the palette. On each update the
+			whole palette is written to the given uniform array.
+
+	@in		MOAISkeleton self
+	@opt	MOAIShader shader		Pass nil to clear.
+	@opt	number uniformID		Default value is 1.
+	@out	nil
+*/
+int MOAISkeleton::_setShader ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAISkeleton, "U" )
+
+	MOAIShader* shader	= state.GetLuaObject < MOAIShader >( 2, true );
+	u32 uniformID		= state.GetValue < u32 >( 3, 1 ) - 1;
+
+	self->SetShader ( shader, uniformID );
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	skin
+	@text	Skins a vertex buffer on the CPU using the current palette.
+			Coordinates and normals are transformed; all other attributes
+			are copied. Use this when the target can't skin in a shader.
+			The destination buffer is resized to match the source.
+
+	@in		MOAISkeleton self
+	@in		MOAIVertexBuffer src
+	@in		MOAIVertexBuffer dst
+	@in		variant format			MOAIVertexFormat or MOAIVertexFormatMgr format ID.
+	@out	boolean success
+*/
+int MOAISkeleton::_skin ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAISkeleton, "UUU" )
+
+	MOAIGfxBuffer* src			= state.GetLuaObject < MOAIGfxBuffer >( 2, true );
+	MOAIGfxBuffer* dst			= state.GetLuaObject < MOAIGfxBuffer >( 3, true );
+	MOAIVertexFormat* format	= MOAIVertexFormat::AffirmVertexFormat ( state, 4 );
+
+	bool result = ( src && dst && format ) ? self->Skin ( *src, *dst, *format ) : false;
+
+	state.Push ( result );
+	return 1;
+}
+
+//================================================================//
+// MOAISkeleton
+//================================================================//
+
+//----------------------------------------------------------------//
+void MOAISkeleton::Clear () {
+
+	for ( u32 i = 0; i < this->mJoints.Size (); ++i ) {
+		MOAISkeletonJoint& joint = this->mJoints [ i ];
+		joint.mCurves [ CLIP_A ].Set ( *this, 0 );
+		joint.mCurves [ CLIP_B ].Set ( *this, 0 );
+	}
+	this->mJoints.Clear ();
+	this->mWorld.Clear ();
+
+	this->mPaletteEntries.Clear ();
+	this->mPalette.Clear ();
+}
+
+//----------------------------------------------------------------//
+void MOAISkeleton::EvaluateJoint ( const MOAISkeletonJoint& joint, ZLAffine3D& local ) const {
+
+	ZLVec3D pos			= joint.mPosition;
+	ZLQuaternion rot	= joint.mRotation;
+	ZLVec3D scl			= joint.mScale;
+
+	const MOAIAnimCurveBone* curve = joint.mCurves [ CLIP_A ];
+	if ( curve && curve->Size ()) {
+		curve->GetValue ( this->mTime, pos, rot, scl );
+	}
+
+	if ( this->mBlend > 0.0f ) {
+
+		ZLVec3D pos1		= joint.mPosition;
+		ZLQuaternion rot1	= joint.mRotation;
+		ZLVec3D scl1		= joint.mScale;
+
+		curve = joint.mCurves [ CLIP_B ];
+		if ( curve && curve->Size ()) {
+			curve->GetValue ( this->mBlendTime, pos1, rot1, scl1 );
+		}
+
+		float t = this->mBlend < 1.0f ? this->mBlend : 1.0f;
+
+		pos.Lerp ( pos1, t );
+		scl.Lerp ( scl1, t );
+
+		// nlerp along the shorter arc; cheaper than slerp and fine for blending
+		float t0 = 1.0f - t;
+		float t1 = rot.Dot ( rot1 ) < 0.0f ? -t : t;
+
+		rot.mS		= ( rot.mS * t0 ) + ( rot1.mS * t1 );
+		rot.mV.mX	= ( rot.mV.mX * t0 ) + ( rot1.mV.mX * t1 );
+		rot.mV.mY	= ( rot.mV.mY * t0 ) + ( rot1.mV.mY * t1 );
+		rot.mV.mZ	= ( rot.mV.mZ * t0 ) + ( rot1.mV.mZ * t1 );
+		rot.Normalize ();
+	}
+	local = MOAIAnimCurveBone::Compose ( pos, rot, scl );
+}
+
+//----------------------------------------------------------------//
+const ZLAffine3D* MOAISkeleton::GetPalette () const {
+
+	return this->mPalette.Data ();
+}
+
+//----------------------------------------------------------------//
+MOAISkeleton::MOAISkeleton () :
+	mTime ( 0.0f ),
+	mBlendTime ( 0.0f ),
+	mBlend ( 0.0f ),
+	mUniformID ( 0 ) {
+
+	RTTI_SINGLE ( MOAINode )
+}
+
+//----------------------------------------------------------------//
+MOAISkeleton::~MOAISkeleton () {
+
+	this->Clear ();
+	this->mShader.Set ( *this, 0 );
+}
+
+//----------------------------------------------------------------//
+void MOAISkeleton::RegisterLuaClass ( MOAILuaState& state ) {
+
+	MOAINode::RegisterLuaClass ( state );
+
+	state.SetField ( -1, "ATTR_TIME", MOAISkeletonAttr::Pack ( ATTR_TIME ));
+	state.SetField ( -1, "ATTR_BLEND_TIME", MOAISkeletonAttr::Pack ( ATTR_BLEND_TIME ));
+	state.SetField ( -1, "ATTR_BLEND", MOAISkeletonAttr::Pack ( ATTR_BLEND ));
+
+	state.SetField ( -1, "CLIP_A", ( u32 )CLIP_A );
+	state.SetField ( -1, "CLIP_B", ( u32 )CLIP_B );
+}
+
+//----------------------------------------------------------------//
+void MOAISkeleton::RegisterLuaFuncs ( MOAILuaState& state ) {
+
+	MOAINode::RegisterLuaFuncs ( state );
+
+	luaL_Reg regTable [] = {
+		{ "getJointMtx",			_getJointMtx },
+		{ "reserveJoints",			_reserveJoints },
+		{ "reservePalette",			_reservePalette },
+		{ "setJoint",				_setJoint },
+		{ "setJointCurve",			_setJointCurve },
+		{ "setPaletteEntry",		_setPaletteEntry },
+		{ "setShader",				_setShader },
+		{ "skin",					_skin },
+		{ NULL, NULL }
+	};
+
+	luaL_register ( state, 0, regTable );
+}
+
+//----------------------------------------------------------------//
+void MOAISkeleton::ReserveJoints ( u32 total ) {
+
+	this->Clear ();
+
+	this->mJoints.Init ( total );
+	this->mWorld.Init ( total );
+
+	for ( u32 i = 0; i < total; ++i ) {
+		this->SetJoint ( i, NO_PARENT, ZLVec3D::ORIGIN, ZLQuaternion::IDENT, ZLVec3D::AXIS );
+		this->mWorld [ i ] = ZLAffine3D::IDENT;
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAISkeleton::ReservePalette ( u32 total ) {
+
+	this->mPaletteEntries.Init ( total );
+	this->mPalette.Init ( total );
+
+	for ( u32 i = 0; i < total; ++i ) {
+		this->SetPaletteEntry ( i, NO_PARENT, ZLAffine3D::IDENT );
+		this->mPalette [ i ] = ZLAffine3D::IDENT;
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAISkeleton::SetJoint ( u32 jointID, u32 parentID, const ZLVec3D& pos, const ZLQuaternion& rot, const ZLVec3D& scl ) {
+
+	if ( jointID < this->mJoints.Size ()) {
+		MOAISkeletonJoint& joint = this->mJoints [ jointID ];
+		joint.mParent		= parentID < jointID ? parentID : NO_PARENT;
+		joint.mPosition		= pos;
+		joint.mRotation		= rot;
+		joint.mScale		= scl;
+		this->ScheduleUpdate ();
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAISkeleton::SetJointCurve ( u32 clip, u32 jointID, MOAIAnimCurveBone* curve ) {
+
+	if (( clip < TOTAL_CLIPS ) && ( jointID < this->mJoints.Size ())) {
+		this->mJoints [ jointID ].mCurves [ clip ].Set ( *this, curve );
+		this->ScheduleUpdate ();
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAISkeleton::SetPaletteEntry ( u32 idx, u32 jointID, const ZLAffine3D& offset ) {
+
+	if ( idx < this->mPaletteEntries.Size ()) {
+		MOAISkeletonPaletteEntry& entry = this->mPaletteEntries [ idx ];
+		entry.mJointID		= jointID;
+		entry.mOffset		= offset;
+		this->ScheduleUpdate ();
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAISkeleton::SetShader ( MOAIShader* shader, u32 uniformID ) {
+
+	this->mShader.Set ( *this, shader );
+	this->mUniformID = uniformID;
+	this->ScheduleUpdate ();
+}
+
+//----------------------------------------------------------------//
+bool MOAISkeleton::Skin ( MOAIGfxBuffer& src, MOAIGfxBuffer& dst, const MOAIVertexFormat& format ) {
+
+	if ( &src == &dst ) return false;
+
+	const MOAIVertexAttribute* coordAttr		= format.GetAttributeByUse ( MOAIVertexFormat::ATTRIBUTE_COORD, 0 );
+	const MOAIVertexAttribute* normalAttr		= format.GetAttributeByUse ( MOAIVertexFormat::ATTRIBUTE_NORMAL, 0 );
+	const MOAIVertexAttribute* indexAttr		= format.GetAttributeByUse ( MOAIVertexFormat::ATTRIBUTE_BONE_INDICES, 0 );
+	const MOAIVertexAttribute* weightAttr		= format.GetAttributeByUse ( MOAIVertexFormat::ATTRIBUTE_BONE_WEIGHTS, 0 );
+
+	if ( !( coordAttr && indexAttr && weightAttr )) return false;
+
+	size_t vertexSize = format.GetVertexSize ();
+	size_t size = src.ZLCopyOnWrite::GetLength ();
+	const void* srcBuffer = src.ZLCopyOnWrite::GetBuffer ();
+
+	if ( !( vertexSize && size && srcBuffer )) return false;
+
+	this->ForceUpdate ();
+
+	if ( dst.ZLCopyOnWrite::GetLength () != size ) {
+		dst.Reserve (( u32 )size );
+	}
+	void* dstBuffer = dst.ZLCopyOnWrite::Invalidate ();
+	memcpy ( dstBuffer, srcBuffer, size );
+
+	const ZLAffine3D* palette = this->mPalette.Data ();
+	u32 paletteSize = ( u32 )this->mPalette.Size ();
+
+	u32 totalBones = MIN ( indexAttr->mSize, weightAttr->mSize );
+	totalBones = MIN ( totalBones, MAX_SKIN_BONES );
+
+	u32 totalVertices = ( u32 )( size / vertexSize );
+
+	for ( u32 i = 0; i < totalVertices; ++i ) {
+
+		ZLVec4D indices = MOAIVertexFormat::UnpackAttribute ( format.GetAttributeAddress ( *indexAttr, srcBuffer, i ), *indexAttr, 0.0f, 0.0f, 0.0f );
+		ZLVec4D weights = MOAIVertexFormat::UnpackAttribute ( format.GetAttributeAddress ( *weightAttr, srcBuffer, i ), *weightAttr, 0.0f, 0.0f, 0.0f );
+
+		const float boneIndices [ MAX_SKIN_BONES ] = { indices.mX, indices.mY, indices.mZ, indices.mW };
+		const float boneWeights [ MAX_SKIN_BONES ] = { weights.mX, weights.mY, weights.mZ, weights.mW };
+
+		// blend the weighted palette matrices; the inner loop is a flat
+		// multiply-add over 12 floats so the compiler can vectorize it
+		ZLAffine3D mtx;
+		memset ( mtx.m, 0, sizeof ( mtx.m ));
+
+		for ( u32 j = 0; j < totalBones; ++j ) {
+
+			float weight = boneWeights [ j ];
+			u32 boneID = ( u32 )boneIndices [ j ];
+
+			if (( weight == 0.0f ) || ( boneID >= paletteSize )) continue;
+
+			const float* bone = palette [ boneID ].m;
+			for ( u32 k = 0; k < ZLAffine3D::SIZE; ++k ) {
+				mtx.m [ k ] += bone [ k ] * weight;
+			}
+		}
+
+		ZLVec4D coord = MOAIVertexFormat::UnpackCoord ( format.GetAttributeAddress ( *coordAttr, srcBuffer, i ), *coordAttr );
+		ZLVec3D loc ( coord.mX, coord.mY, coord.mZ );
+		mtx.Transform ( loc );
+		MOAIVertexFormat::PackAttribute ( format.GetAttributeAddress ( *coordAttr, dstBuffer, i ), ZLVec4D ( loc.mX, loc.mY, loc.mZ, coord.mW ), *coordAttr );
+
+		if ( normalAttr ) {
+			ZLVec4D normal = MOAIVertexFormat::UnpackAttribute ( format.GetAttributeAddress ( *normalAttr, srcBuffer, i ), *normalAttr, 0.0f, 0.0f, 0.0f );
+			ZLVec3D vec ( normal.mX, normal.mY, normal.mZ );
+			mtx.TransformVec ( vec );
+			vec.NormSafe ();
+			MOAIVertexFormat::PackAttribute ( format.GetAttributeAddress ( *normalAttr, dstBuffer, i ), ZLVec4D ( vec.mX, vec.mY, vec.mZ, 0.0f ), *normalAttr );
+		}
+	}
+
+	dst.ScheduleForGPUUpdate ();
+	return true;
+}
+
+//================================================================//
+// ::implementation::
+//================================================================//
+
+//----------------------------------------------------------------//
+bool MOAISkeleton::MOAINode_ApplyAttrOp ( u32 attrID, MOAIAttribute& attr, u32 op ) {
+
+	if ( MOAISkeletonAttr::Check ( attrID )) {
+
+		switch ( UNPACK_ATTR ( attrID )) {
+			case ATTR_TIME:
+				this->mTime = attr.Apply ( this->mTime, op, MOAIAttribute::ATTR_READ_WRITE );
+				return true;
+			case ATTR_BLEND_TIME:
+				this->mBlendTime = attr.Apply ( this->mBlendTime, op, MOAIAttribute::ATTR_READ_WRITE );
+				return true;
+			case ATTR_BLEND:
+				this->mBlend = attr.Apply ( this->mBlend, op, MOAIAttribute::ATTR_READ_WRITE );
+				return true;
+		}
+	}
+	return false;
+}
+
+//----------------------------------------------------------------//
+void MOAISkeleton::MOAINode_Update () {
+
+	// joints are ordered parent first, so one forward pass builds every world matrix
+	u32 totalJoints = ( u32 )this->mJoints.Size ();
+	for ( u32 i = 0; i < totalJoints; ++i ) {
+
+		const MOAISkeletonJoint& joint = this->mJoints [ i ];
+		ZLAffine3D& world = this->mWorld [ i ];
+
+		this->EvaluateJoint ( joint, world );
+
+		if ( joint.mParent != NO_PARENT ) {
+			world.Append ( this->mWorld [ joint.mParent ]);
+		}
+	}
+
+	u32 paletteSize = ( u32 )this->mPaletteEntries.Size ();
+	for ( u32 i = 0; i < paletteSize; ++i ) {
+
+		const MOAISkeletonPaletteEntry& entry = this->mPaletteEntries [ i ];
+		ZLAffine3D& mtx = this->mPalette [ i ];
+
+		mtx = entry.mOffset;
+		if ( entry.mJointID < totalJoints ) {
+			mtx.Append ( this->mWorld [ entry.mJointID ]);
+		}
+	}
+
+	if ( this->mShader ) {
+		this->mShader->SetUniformArray ( this->mUniformID, this->mPalette.Data (), paletteSize );
+	}
+}
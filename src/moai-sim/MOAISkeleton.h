@@ -0,0 +1,128 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAISKELETON_H
+#define	MOAISKELETON_H
+
+#include <moai-sim/MOAINode.h>
+
+class MOAIAnimCurveBone;
+class MOAIGfxBuffer;
+class MOAIShader;
+class MOAIVertexFormat;
+
+//================================================================//
+// MOAISkeletonJoint
+//================================================================//
+class MOAISkeletonJoint {
+public:
+
+	u32				mParent;		// must be lower than the joint's own index (or NO_PARENT)
+
+	ZLVec3D			mPosition;		// rest pose; used when a clip has no curve for the joint
+	ZLQuaternion	mRotation;
+	ZLVec3D			mScale;
+
+	MOAILuaSharedPtr < MOAIAnimCurveBone > mCurves [ 2 ];
+};
+
+//================================================================//
+// MOAISkeletonPaletteEntry
+//================================================================//
+class MOAISkeletonPaletteEntry {
+public:
+
+	u32				mJointID;
+	ZLAffine3D		mOffset;		// inverse bind matrix
+};
+
+//================================================================//
+// MOAISkeleton
+//================================================================//
+/**	@lua	MOAISkeleton
+	@text	Evaluates a hierarchy of bone curves into a contiguous
+			matrix palette. Two clips may be blended. The palette may be
+			uploaded to a shader as a single uniform array or used to
+			skin a vertex buffer on the CPU.
+
+	@attr	ATTR_TIME
+	@attr	ATTR_BLEND_TIME
+	@attr	ATTR_BLEND
+
+	@const	CLIP_A
+	@const	CLIP_B
+*/
+class MOAISkeleton :
+	public virtual MOAINode {
+private:
+
+	static const u32 NO_PARENT = ( u32 )-1;
+	static const u32 MAX_SKIN_BONES = 4;
+
+	ZLLeanArray < MOAISkeletonJoint >			mJoints;
+	ZLLeanArray < MOAISkeletonPaletteEntry >	mPaletteEntries;
+
+	ZLLeanArray < ZLAffine3D >					mWorld;
+	ZLLeanArray < ZLAffine3D >					mPalette;
+
+	float			mTime;
+	float			mBlendTime;
+	float			mBlend;
+
+	MOAILuaSharedPtr < MOAIShader >		mShader;
+	u32									mUniformID;
+
+	//----------------------------------------------------------------//
+	static int		_getJointMtx			( lua_State* L );
+	static int		_reserveJoints			( lua_State* L );
+	static int		_reservePalette			( lua_State* L );
+	static int		_setJoint				( lua_State* L );
+	static int		_setJointCurve			( lua_State* L );
+	static int		_setPaletteEntry		( lua_State* L );
+	static int		_setShader				( lua_State* L );
+	static int		_skin					( lua_State* L );
+
+	//----------------------------------------------------------------//
+	void			EvaluateJoint			( const MOAISkeletonJoint& joint, ZLAffine3D& local ) const;
+
+	//----------------------------------------------------------------//
+	bool			MOAINode_ApplyAttrOp	( u32 attrID, MOAIAttribute& attr, u32 op );
+	void			MOAINode_Update			();
+
+public:
+
+	DECL_LUA_FACTORY ( MOAISkeleton )
+	DECL_ATTR_HELPER ( MOAISkeleton )
+
+	enum {
+		ATTR_TIME,
+		ATTR_BLEND_TIME,
+		ATTR_BLEND,
+		TOTAL_ATTR,
+	};
+
+	enum {
+		CLIP_A,
+		CLIP_B,
+		TOTAL_CLIPS,
+	};
+
+	GET_CONST ( size_t, PaletteSize, mPalette.Size ())
+
+	//----------------------------------------------------------------//
+	void				Clear					();
+	const ZLAffine3D*	GetPalette				() const;
+						MOAISkeleton			();
+						~MOAISkeleton			();
+	void				RegisterLuaClass		( MOAILuaState& state );
+	void				RegisterLuaFuncs		( MOAILuaState& state );
+	void				ReserveJoints			( u32 total );
+	void				ReservePalette			( u32 total );
+	void				SetJoint				( u32 jointID, u32 parentID, const ZLVec3D& pos, const ZLQuaternion& rot, const ZLVec3D& scl );
+	void				SetJointCurve			( u32 clip, u32 jointID, MOAIAnimCurveBone* curve );
+	void				SetPaletteEntry			( u32 idx, u32 jointID, const ZLAffine3D& offset );
+	void				SetShader				( MOAIShader* shader, u32 uniformID );
+	bool				Skin					( MOAIGfxBuffer& src, MOAIGfxBuffer& dst, const MOAIVertexFormat& format );
+};
+
+#endif
@@ -0,0 +1,251 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#include <moai-sim/MOAIInputMgr.h>
+#include <moai-sim/MOAISim.h>
+#include <moai-sim/MOAISnapshot.h>
+
+//================================================================//
+// local
+//================================================================//
+
+//----------------------------------------------------------------//
+/**	@lua	capture
+	@text	Writes the state of the sim and all objects into the arena,
+			replacing the previous capture.
+
+	@in		MOAISnapshot self
+	@out	number size			Bytes used, or nil if the arena was too small.
+*/
+int MOAISnapshot::_capture ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAISnapshot, "U" )
+
+	if ( self->Capture ()) {
+		state.Push (( u32 )self->mSize );
+		return 1;
+	}
+	MOAILogF ( L, ZLLog::LOG_ERROR, "MOAISnapshot: arena too small (%d bytes)\n", ( int )self->mArena.Size ());
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	getSize
+	@text	Returns the size of the last capture.
+
+	@in		MOAISnapshot self
+	@out	number size			Bytes used, or 0 if there is no valid capture.
+*/
+int MOAISnapshot::_getSize ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAISnapshot, "U" )
+
+	state.Push (( u32 )self->mSize );
+	return 1;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	reserve
+	@text	Preallocates the arena. Captures never allocate; a capture
+			that doesn't fit fails.
+
+	@in		MOAISnapshot self
+	@in		number size			Size of the arena in bytes.
+	@out	nil
+*/
+int MOAISnapshot::_reserve ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAISnapshot, "UN" )
+
+	self->Reserve ( state.GetValue < u32 >( 2, 0 ));
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	reserveObjects
+	@text	Reserves slots for objects to capture.
+
+	@in		MOAISnapshot self
+	@in		number total
+	@out	nil
+*/
+int MOAISnapshot::_reserveObjects ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAISnapshot, "UN" )
+
+	self->ReserveObjects ( state.GetValue < u32 >( 2, 0 ));
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	restore
+	@text	Restores the sim and all objects to the last capture.
+
+	@in		MOAISnapshot self
+	@out	boolean success		False if there is no valid capture.
+*/
+int MOAISnapshot::_restore ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAISnapshot, "U" )
+
+	state.Push ( self->Restore ());
+	return 1;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	setIncludeGlobals
+	@text	Controls whether the sim clock and the MOAIInputMgr event
+			queue are part of the snapshot.
+
+	@in		MOAISnapshot self
+	@opt	boolean include		Default value is true.
+	@out	nil
+*/
+int MOAISnapshot::_setIncludeGlobals ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAISnapshot, "U" )
+
+	self->mIncludeGlobals = state.GetValue < bool >( 2, true );
+	self->mSize = 0;
+	return 0;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	setObject
+	@text	Sets an object to capture. Changing the object list
+			invalidates the last capture.
+
+	@in		MOAISnapshot self
+	@in		number idx
+	@opt	MOAILuaObject object	Pass nil to clear.
+	@out	nil
+*/
+int MOAISnapshot::_setObject ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAISnapshot, "UN" )
+
+	u32 idx = state.GetValue < u32 >( 2, 1 ) - 1;
+	self->SetObject ( idx, state.GetLuaObject < MOAILuaObject >( 3, true ));
+	return 0;
+}
+
+//================================================================//
+// MOAISnapshot
+//================================================================//
+
+//----------------------------------------------------------------//
+bool MOAISnapshot::Capture () {
+
+	this->mSize = 0;
+
+	size_t capacity = this->mArena.Size ();
+	if ( !capacity ) return false;
+
+	this->mStream.SetBuffer ( this->mArena.Data (), capacity );
+
+	if ( this->mIncludeGlobals ) {
+		MOAISim::Get ().SnapshotOut ( this->mStream );
+		MOAIInputMgr::Get ().SnapshotOut ( this->mStream );
+	}
+
+	size_t totalObjects = this->mObjects.Size ();
+	for ( size_t i = 0; i < totalObjects; ++i ) {
+		MOAILuaObject* object = this->mObjects [ i ];
+		if ( object ) {
+			object->SnapshotOut ( this->mStream );
+		}
+	}
+
+	// ZLByteStream clips writes at capacity, so a full arena means the capture didn't fit
+	size_t size = this->mStream.GetLength ();
+	if ( size < capacity ) {
+		this->mSize = size;
+		return true;
+	}
+	return false;
+}
+
+//----------------------------------------------------------------//
+void MOAISnapshot::ClearObjects () {
+
+	for ( size_t i = 0; i < this->mObjects.Size (); ++i ) {
+		this->mObjects [ i ].Set ( *this, 0 );
+	}
+	this->mObjects.Clear ();
+	this->mSize = 0;
+}
+
+//----------------------------------------------------------------//
+MOAISnapshot::MOAISnapshot () :
+	mSize ( 0 ),
+	mIncludeGlobals ( true ) {
+
+	RTTI_SINGLE ( MOAILuaObject )
+}
+
+//----------------------------------------------------------------//
+MOAISnapshot::~MOAISnapshot () {
+
+	this->ClearObjects ();
+}
+
+//----------------------------------------------------------------//
+void MOAISnapshot::RegisterLuaClass ( MOAILuaState& state ) {
+	UNUSED ( state );
+}
+
+//----------------------------------------------------------------//
+void MOAISnapshot::RegisterLuaFuncs ( MOAILuaState& state ) {
+
+	luaL_Reg regTable [] = {
+		{ "capture",				_capture },
+		{ "getSize",				_getSize },
+		{ "reserve",				_reserve },
+		{ "reserveObjects",			_reserveObjects },
+		{ "restore",				_restore },
+		{ "setIncludeGlobals",		_setIncludeGlobals },
+		{ "setObject",				_setObject },
+		{ NULL, NULL }
+	};
+
+	luaL_register ( state, 0, regTable );
+}
+
+//----------------------------------------------------------------//
+void MOAISnapshot::Reserve ( size_t size ) {
+
+	this->mArena.Init ( size );
+	this->mSize = 0;
+}
+
+//----------------------------------------------------------------//
+void MOAISnapshot::ReserveObjects ( u32 total ) {
+
+	this->ClearObjects ();
+	this->mObjects.Init ( total );
+}
+
+//----------------------------------------------------------------//
+bool MOAISnapshot::Restore () {
+
+	if ( !this->mSize ) return false;
+
+	this->mStream.SetBuffer (( const void* )this->mArena.Data (), this->mArena.Size (), this->mSize );
+
+	if ( this->mIncludeGlobals ) {
+		MOAISim::Get ().SnapshotIn ( this->mStream );
+		MOAIInputMgr::Get ().SnapshotIn ( this->mStream );
+	}
+
+	size_t totalObjects = this->mObjects.Size ();
+	for ( size_t i = 0; i < totalObjects; ++i ) {
+		MOAILuaObject* object = this->mObjects [ i ];
+		if ( object ) {
+			object->SnapshotIn ( this->mStream );
+		}
+	}
+	return true;
+}
+
+//----------------------------------------------------------------//
+void MOAISnapshot::SetObject ( u32 idx, MOAILuaObject* object ) {
+
+	if ( idx < this->mObjects.Size ()) {
+		this->mObjects [ idx ].Set ( *this, object );
+		this->mSize = 0;
+	}
+}
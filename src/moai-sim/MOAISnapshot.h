@@ -0,0 +1,61 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef	MOAISNAPSHOT_H
+#define	MOAISNAPSHOT_H
+
+//================================================================//
+// MOAISnapshot
+//================================================================//
+/**	@lua	MOAISnapshot
+	@text	Binary snapshot of sim state, written into a preallocated
+			arena. Intended for rollback and replay: capture once per
+			step, restore, then call MOAISim.resimulate ().
+
+			Each object in the snapshot writes its own state (transforms,
+			actions, timers, particle systems). The sim clock and the
+			MOAIInputMgr event queue are included by default. Only state
+			is captured, not structure: the same objects must exist, with
+			the same reservations and attachments, when restoring.
+*/
+class MOAISnapshot :
+	public virtual MOAILuaObject {
+private:
+
+	ZLLeanArray < u8 >									mArena;
+	ZLByteStream										mStream;
+	size_t												mSize;
+
+	ZLLeanArray < MOAILuaSharedPtr < MOAILuaObject > >	mObjects;
+
+	bool												mIncludeGlobals;
+
+	//----------------------------------------------------------------//
+	static int		_capture				( lua_State* L );
+	static int		_getSize				( lua_State* L );
+	static int		_reserve				( lua_State* L );
+	static int		_reserveObjects			( lua_State* L );
+	static int		_restore				( lua_State* L );
+	static int		_setIncludeGlobals		( lua_State* L );
+	static int		_setObject				( lua_State* L );
+
+public:
+
+	DECL_LUA_FACTORY ( MOAISnapshot )
+
+	GET_CONST ( size_t, Size, mSize )
+
+	//----------------------------------------------------------------//
+	bool			Capture					();
+	void			ClearObjects			();
+					MOAISnapshot			();
+					~MOAISnapshot			();
+	void			RegisterLuaClass		( MOAILuaState& state );
+	void			RegisterLuaFuncs		( MOAILuaState& state );
+	void			Reserve					( size_t size );
+	void			ReserveObjects			( u32 total );
+	bool			Restore					();
+	void			SetObject				( u32 idx, MOAILuaObject* object );
+};
+
+#endif
@@ -452,6 +452,55 @@ MOAIDeck* MOAISpriteDeck2D::AffirmDeck ( MOAILuaState& state, int idx ) {
 //	return false;
 //}
 
+//----------------------------------------------------------------//
+bool MOAISpriteDeck2D::GetQuad ( u32 idx, ZLQuad& modelQuad, ZLQuad& uvQuad, MOAIMaterial*& material ) {
+
+	// resolves an index the same way MOAIDeck_Draw () does; fails for lists of more than one sprite
+
+	size_t totalSprites			= this->mSprites.Size ();
+	size_t totalSpriteLists		= this->mSpriteLists.Size ();
+	size_t totalQuads			= this->mQuads.Size ();
+	
+	if ( totalSprites ) {
+	
+		size_t spriteID = idx % totalSprites;
+	
+		if ( totalSpriteLists ) {
+		
+			MOAISpriteList& spriteList = this->mSpriteLists [ idx % totalSpriteLists ];
+			if ( spriteList.mTotalSprites != 1 ) return false;
+			spriteID = spriteList.mBaseSprite % totalSprites;
+		}
+		
+		MOAISprite& spritePair = this->mSprites [ spriteID ];
+		
+		modelQuad	= this->mQuads [ spritePair.mQuadID ];
+		uvQuad		= this->mUVQuads [ spritePair.mUVQuadID ];
+		material	= this->GetMaterial ( spritePair.mMaterialID );
+	}
+	else if ( totalQuads ) {
+	
+		size_t itemIdx = idx % totalQuads;
+		
+		modelQuad = this->mQuads [ itemIdx ];
+		
+		if ( itemIdx < this->mUVQuads.Size ()) {
+			uvQuad = this->mUVQuads [ itemIdx ];
+		}
+		else {
+			uvQuad.Init ( 0.0f, 1.0f, 1.0f, 0.0f );
+		}
+		material = this->GetMaterial (( u32 )itemIdx );
+	}
+	else {
+	
+		modelQuad.Init ( -0.5f, -0.5f, 0.5f, 0.5f );
+		uvQuad.Init ( 0.0f, 1.0f, 1.0f, 0.0f );
+		material = this->GetMaterial ();
+	}
+	return true;
+}
+
 //----------------------------------------------------------------//
 //bool MOAISpriteDeck2D::Inside ( u32 idx, MOAIMaterialBatch* materials, u32 granularity, ZLVec3D vec, float pad ) {
 //	UNUSED ( pad );
@@ -85,6 +85,7 @@ public:
 	//----------------------------------------------------------------//
 	static MOAIDeck*	AffirmDeck					( MOAILuaState& state, int idx );
 	bool				Contains					( u32 idx, const ZLVec2D& vec );
+	bool				GetQuad						( u32 idx, ZLQuad& modelQuad, ZLQuad& uvQuad, MOAIMaterial*& material );
 	void				DrawIndex					( u32 idx, MOAIMaterialBatch* materials, ZLVec3D offset, ZLVec3D scale );
 	bool				Inside						( u32 idx, MOAIMaterialBatch* materials, u32 granularity, ZLVec3D vec, float pad );
 						MOAISpriteDeck2D			();
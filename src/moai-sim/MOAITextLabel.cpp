@@ -1085,6 +1085,28 @@ void MOAITextLabel::SetText ( cc8* text ) {
 	this->ScheduleLayout ();
 }
 
+//----------------------------------------------------------------//
+void MOAITextLabel::SnapshotIn ( ZLStream& stream ) {
+
+	MOAIGraphicsProp::SnapshotIn ( stream );
+	MOAIAction::SnapshotIn ( stream );
+
+	this->mSpool	= stream.Read < float >( this->mSpool );
+	this->mSpeed	= stream.Read < float >( this->mSpeed );
+	this->mReveal	= stream.Read < u32 >( this->mReveal );
+}
+
+//----------------------------------------------------------------//
+void MOAITextLabel::SnapshotOut ( ZLStream& stream ) {
+
+	MOAIGraphicsProp::SnapshotOut ( stream );
+	MOAIAction::SnapshotOut ( stream );
+
+	stream.Write < float >( this->mSpool );
+	stream.Write < float >( this->mSpeed );
+	stream.Write < u32 >( this->mReveal );
+}
+
 //================================================================//
 // ::implementation::
 //================================================================//
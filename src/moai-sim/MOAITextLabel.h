@@ -240,6 +240,8 @@ public:
 	void				SerializeIn				( MOAILuaState& state, MOAIDeserializer& serializer );
 	void				SerializeOut			( MOAILuaState& state, MOAISerializer& serializer );
 	void				SetText					( cc8* text );
+	void				SnapshotIn				( ZLStream& stream );
+	void				SnapshotOut				( ZLStream& stream );
 };
 
 #endif
@@ -577,6 +577,38 @@ void MOAITimer::SetTime ( float time ) {
 	this->ScheduleUpdate ();
 }
 
+//----------------------------------------------------------------//
+void MOAITimer::SnapshotIn ( ZLStream& stream ) {
+
+	MOAIAction::SnapshotIn ( stream );
+
+	this->mTime				= stream.Read < float >( this->mTime );
+	this->mCycle			= stream.Read < float >( this->mCycle );
+	this->mSpeed			= stream.Read < float >( this->mSpeed );
+	this->mDirection		= stream.Read < float >( this->mDirection );
+	this->mMode				= stream.Read < u32 >( this->mMode );
+	this->mTimesExecuted	= stream.Read < float >( this->mTimesExecuted );
+	this->mStartTime		= stream.Read < float >( this->mStartTime );
+	this->mEndTime			= stream.Read < float >( this->mEndTime );
+
+	this->ScheduleUpdate ();
+}
+
+//----------------------------------------------------------------//
+void MOAITimer::SnapshotOut ( ZLStream& stream ) {
+
+	MOAIAction::SnapshotOut ( stream );
+
+	stream.Write < float >( this->mTime );
+	stream.Write < float >( this->mCycle );
+	stream.Write < float >( this->mSpeed );
+	stream.Write < float >( this->mDirection );
+	stream.Write < u32 >( this->mMode );
+	stream.Write < float >( this->mTimesExecuted );
+	stream.Write < float >( this->mStartTime );
+	stream.Write < float >( this->mEndTime );
+}
+
 //----------------------------------------------------------------//
 void MOAITimer::ToggleDirection () {
 
@@ -117,6 +117,8 @@ public:
 	void			SetSpan				( float span );
 	void			SetSpan				( float startTime, float endTime );
 	void			SetTime				( float time );
+	void			SnapshotIn			( ZLStream& stream );
+	void			SnapshotOut			( ZLStream& stream );
 	void			ToggleDirection		();
 };
 
@@ -1072,6 +1072,44 @@ void MOAITransform::SetScl ( float x, float y, float z ) {
 	this->mScale.mZ = z;
 }
 
+//----------------------------------------------------------------//
+void MOAITransform::SnapshotIn ( ZLStream& stream ) {
+
+	this->mPiv			= stream.Read < ZLVec3D >( this->mPiv );
+	this->mLoc			= stream.Read < ZLVec3D >( this->mLoc );
+	this->mScale		= stream.Read < ZLVec3D >( this->mScale );
+	this->mRot			= stream.Read < ZLVec3D >( this->mRot );
+
+	this->mShearYX		= stream.Read < float >( this->mShearYX );
+	this->mShearZX		= stream.Read < float >( this->mShearZX );
+	this->mShearXY		= stream.Read < float >( this->mShearXY );
+	this->mShearZY		= stream.Read < float >( this->mShearZY );
+	this->mShearXZ		= stream.Read < float >( this->mShearXZ );
+	this->mShearYZ		= stream.Read < float >( this->mShearYZ );
+
+	this->mEulerOrder	= stream.Read < u32 >( this->mEulerOrder );
+
+	this->ScheduleUpdate ();
+}
+
+//----------------------------------------------------------------//
+void MOAITransform::SnapshotOut ( ZLStream& stream ) {
+
+	stream.Write < ZLVec3D >( this->mPiv );
+	stream.Write < ZLVec3D >( this->mLoc );
+	stream.Write < ZLVec3D >( this->mScale );
+	stream.Write < ZLVec3D >( this->mRot );
+
+	stream.Write < float >( this->mShearYX );
+	stream.Write < float >( this->mShearZX );
+	stream.Write < float >( this->mShearXY );
+	stream.Write < float >( this->mShearZY );
+	stream.Write < float >( this->mShearXZ );
+	stream.Write < float >( this->mShearYZ );
+
+	stream.Write < u32 >( this->mEulerOrder );
+}
+
 //================================================================//
 // ::implementation::
 //================================================================//
@@ -1204,14 +1242,21 @@ void MOAITransform::MOAITransformBase_BuildLocalToWorldMtx ( ZLAffine3D& localTo
 		localToWorldMtx.m [ ZLAffine3D::C3_R2 ] = this->mLoc.mZ;
 	}
 	
-	ZLAffine3D shear;
-	shear.Shear ( this->mShearYX, this->mShearZX, this->mShearXY, this->mShearZY, this->mShearXZ, this->mShearYZ );
-	localToWorldMtx.Prepend ( shear );
+	// most transforms are never sheared; skip the full matrix multiply for those
+	if (( this->mShearYX != 0.0f ) || ( this->mShearZX != 0.0f ) || ( this->mShearXY != 0.0f ) || ( this->mShearZY != 0.0f ) || ( this->mShearXZ != 0.0f ) || ( this->mShearYZ != 0.0f )) {
+	
+		ZLAffine3D shear;
+		shear.Shear ( this->mShearYX, this->mShearZX, this->mShearXY, this->mShearZY, this->mShearXZ, this->mShearYZ );
+		localToWorldMtx.Prepend ( shear );
+	}
 	
 	if (( this->mPiv.mX != 0.0f ) || ( this->mPiv.mY != 0.0f ) || ( this->mPiv.mZ != 0.0f )) {
 		
-		ZLAffine3D pivot;
-		pivot.Translate ( -this->mPiv.mX, -this->mPiv.mY, -this->mPiv.mZ );
-		localToWorldMtx.Prepend ( pivot );
+		// prepending a translation only moves the origin; fold the pivot straight into the translation column
+		float* m = localToWorldMtx.m;
+		
+		m [ ZLAffine3D::C3_R0 ] -= ( m [ ZLAffine3D::C0_R0 ] * this->mPiv.mX ) + ( m [ ZLAffine3D::C1_R0 ] * this->mPiv.mY ) + ( m [ ZLAffine3D::C2_R0 ] * this->mPiv.mZ );
+		m [ ZLAffine3D::C3_R1 ] -= ( m [ ZLAffine3D::C0_R1 ] * this->mPiv.mX ) + ( m [ ZLAffine3D::C1_R1 ] * this->mPiv.mY ) + ( m [ ZLAffine3D::C2_R1 ] * this->mPiv.mZ );
+		m [ ZLAffine3D::C3_R2 ] -= ( m [ ZLAffine3D::C0_R2 ] * this->mPiv.mX ) + ( m [ ZLAffine3D::C1_R2 ] * this->mPiv.mY ) + ( m [ ZLAffine3D::C2_R2 ] * this->mPiv.mZ );
 	}
 }
@@ -149,6 +149,8 @@ public:
 	void					SetPiv						( float x, float y, float z );
 	void					SetRot						( float x, float y, float z );
 	void					SetScl						( float x, float y, float z );
+	void					SnapshotIn					( ZLStream& stream );
+	void					SnapshotOut					( ZLStream& stream );
 };
 
 #endif
@@ -324,11 +324,22 @@ const ZLAffine3D* MOAITransformBase::GetTransformTrait () const {
 //----------------------------------------------------------------//
 const ZLAffine3D& MOAITransformBase::GetWorldToLocalMtx () const {
 
+	if ( this->mWorldToLocalMtxDirty ) {
+		this->mWorldToLocalMtx.Inverse ( this->mLocalToWorldMtx );
+		this->mWorldToLocalMtxDirty = false;
+	}
 	return this->mWorldToLocalMtx;
 }
 
 //----------------------------------------------------------------//
-MOAITransformBase::MOAITransformBase () {
+void MOAITransformBase::InvalidateWorldToLocalMtx () {
+
+	this->mWorldToLocalMtxDirty = true;
+}
+
+//----------------------------------------------------------------//
+MOAITransformBase::MOAITransformBase () :
+	mWorldToLocalMtxDirty ( false ) {
 	
 	RTTI_SINGLE ( MOAINode )
 	
@@ -483,5 +494,5 @@ void MOAITransformBase::MOAINode_Update () {
 		}
 	}
 	
-	this->mWorldToLocalMtx.Inverse ( this->mLocalToWorldMtx );
+	this->InvalidateWorldToLocalMtx ();
 }
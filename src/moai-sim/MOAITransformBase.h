@@ -26,7 +26,10 @@ class MOAITransformBase :
 protected:
 	
 	ZLAffine3D		mLocalToWorldMtx;
-	ZLAffine3D		mWorldToLocalMtx;
+	
+	// inverse is only built on demand; most nodes are never queried for it
+	mutable ZLAffine3D		mWorldToLocalMtx;
+	mutable bool			mWorldToLocalMtxDirty;
 
 	//----------------------------------------------------------------//
 	static int	_getWorldDir		( lua_State* L );
@@ -44,6 +47,7 @@ protected:
 	static int	_worldToModel		( lua_State* L );
 
 	//----------------------------------------------------------------//
+	void				InvalidateWorldToLocalMtx					();
 	bool				MOAINode_ApplyAttrOp						( u32 attrID, MOAIAttribute& attr, u32 op );
 	void				MOAINode_Update								();
 	virtual void		MOAITransformBase_BuildLocalToWorldMtx		( ZLAffine3D& localToWorldMtx ) = 0;
@@ -9,6 +9,8 @@
 // local
 //================================================================//
 
+static const u32 NO_SLOT = ( u32 )-1;
+
 //----------------------------------------------------------------//
 /**	@lua	areNeighbors
 	@text	Checks if two nodes are neighbors.
@@ -80,19 +82,100 @@ int MOAIVecPathGraph::_getNodeCount ( lua_State* L ) {
 	return 1;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	loadEdges
+	@text	Bulk loads edges from a stream or data buffer. Each edge is
+			two u32 node IDs (one-based), followed by a float cost if
+			hasCosts is true. Edges are undirected and replace any
+			existing edge between the same nodes. Loading stops at the
+			end of the data; invalid node IDs are skipped.
+
+	@overload
+	
+		@in		MOAIVecPathGraph self
+		@in		MOAIStream stream
+		@in		number nEdges
+		@opt	boolean hasCosts		Default value is false.
+		@out	number nLoaded
+	
+	@overload
+	
+		@in		MOAIVecPathGraph self
+		@in		MOAIDataBuffer buffer
+		@opt	number nEdges			Default value is as many as the buffer holds.
+		@opt	boolean hasCosts		Default value is false.
+		@out	number nLoaded
+*/
+int MOAIVecPathGraph::_loadEdges ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIVecPathGraph, "UU" )
+
+	bool hasCosts = state.GetValue < bool >( 4, false );
+	u32 loaded = 0;
+
+	MOAIStream* stream = state.GetLuaObject < MOAIStream >( 2, false );
+	if ( stream ) {
+		loaded = self->LoadEdges ( *stream, state.GetValue < u32 >( 3, 0 ), hasCosts );
+	}
+	else {
+	
+		MOAIDataBuffer* buffer = state.GetLuaObject < MOAIDataBuffer >( 2, true );
+		if ( buffer ) {
+		
+			void* bytes = 0;
+			size_t size = 0;
+			ZLByteStream byteStream;
+
+			buffer->Lock ( &bytes, &size );
+			
+			byteStream.SetBuffer ( bytes, size );
+			byteStream.SetLength ( size );
+			
+			size_t recordSize = ( sizeof ( u32 ) * 2 ) + ( hasCosts ? sizeof ( float ) : 0 );
+			loaded = self->LoadEdges ( byteStream, state.GetValue < u32 >( 3, ( u32 )( size / recordSize )), hasCosts );
+			
+			buffer->Unlock ();
+		}
+	}
+	
+	state.Push ( loaded );
+	return 1;
+}
+
+//----------------------------------------------------------------//
+/**	@lua	reserveEdges
+	@text	Preallocates room for edge edits ahead of a large number of
+			calls to setNeighbors (). Each call uses two edits. Edits are
+			merged into the graph on the next query.
+
+	@in		MOAIVecPathGraph self
+	@in		number nEdits
+	@out	nil
+*/
+int MOAIVecPathGraph::_reserveEdges ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIVecPathGraph, "UN" )
+
+	self->ReserveEdges ( state.GetValue < u32 >( 2, 0 ));
+	return 0;
+}
+
 //----------------------------------------------------------------//
 /**	@lua	reserveNodes
-	@text	Reserves memory for a given number of nodes.
+	@text	Reserves memory for a given number of nodes. Clears all edges.
+			A dense graph keeps an N x N neighbor table instead of edge
+			lists; only use it for very small graphs. Dense graphs ignore
+			edge costs.
 
 	@in		MOAIVecPathGraph self
 	@in		number nNodes
+	@opt	boolean dense			Default value is false.
 	@out	nil
 */
 int MOAIVecPathGraph::_reserveNodes ( lua_State* L ) {
 	MOAI_LUA_SETUP ( MOAIVecPathGraph, "UN" )
 
 	u32 total = state.GetValue < u32 >( 2, 0 );
-	self->ReserveNodes ( total );
+	bool dense = state.GetValue < bool >( 3, false );
+	self->ReserveNodes ( total, dense );
 
 	return 0;
 }
@@ -105,6 +188,7 @@ int MOAIVecPathGraph::_reserveNodes ( lua_State* L ) {
 	@in		number nodeID1
 	@in		number nodeID2
 	@opt	boolean value			Whether the nodes are neighbors (true) or not (false). Defaults to true.
+	@opt	number cost				Cost of moving between the nodes. Defaults to the distance between them.
 	@out	nil
 */
 int MOAIVecPathGraph::_setNeighbors ( lua_State* L ) {
@@ -113,11 +197,12 @@ int MOAIVecPathGraph::_setNeighbors ( lua_State* L ) {
 	u32 id1 = state.GetValue < u32 >( 2, 1 ) - 1;
 	u32 id2 = state.GetValue < u32 >( 3, 1 ) - 1;
 	bool neighbors = state.GetValue < bool >( 4, true );
+	float cost = state.GetValue < float >( 5, -1.0f );
 
 	if ( MOAILogMgr::CheckIndexPlusOne ( id1, self->mNodes.Size (), L ) &&
 		MOAILogMgr::CheckIndexPlusOne ( id2, self->mNodes.Size (), L )) {
 
-		self->SetNeighbors ( id1, id2, neighbors );
+		self->SetNeighbors ( id1, id2, neighbors, cost );
 	}
 
 	return 0;
@@ -153,13 +238,128 @@ int MOAIVecPathGraph::_setNode ( lua_State* L ) {
 // MOAIVecPathGraph
 //================================================================//
 
+//----------------------------------------------------------------//
+void MOAIVecPathGraph::AffirmEdges () {
+
+	u32 totalEdits = ( u32 )this->mEdits.GetTop ();
+	if ( this->mDense || !totalEdits ) return;
+
+	u32 totalNodes = ( u32 )this->mNodes.Size ();
+	u32 totalEdges = ( u32 )this->mEdges.Size ();
+	u32 maxEdges = totalEdges + totalEdits;
+
+	// bucket the current edges, then the edits in order, by source node
+	ZLLeanArray < u32 > base;
+	base.Init ( totalNodes + 1 );
+	base.Fill ( 0 );
+
+	for ( u32 i = 0; i < totalNodes; ++i ) {
+		base [ i + 1 ] = this->mEdgeBase [ i + 1 ] - this->mEdgeBase [ i ];
+	}
+
+	for ( u32 i = 0; i < totalEdits; ++i ) {
+		base [ this->mEdits [ i ].mFrom + 1 ]++;
+	}
+
+	for ( u32 i = 0; i < totalNodes; ++i ) {
+		base [ i + 1 ] += base [ i ];
+	}
+
+	ZLLeanArray < u32 > cursor;
+	cursor.Init ( totalNodes );
+	memcpy ( cursor.Data (), base.Data (), totalNodes * sizeof ( u32 ));
+
+	ZLLeanArray < MOAIVecPathEdit > sorted;
+	sorted.Init ( maxEdges );
+
+	for ( u32 i = 0; i < totalNodes; ++i ) {
+		for ( u32 j = this->mEdgeBase [ i ]; j < this->mEdgeBase [ i + 1 ]; ++j ) {
+		
+			MOAIVecPathEdit& edit = sorted [ cursor [ i ]++ ];
+			edit.mFrom		= i;
+			edit.mTo		= this->mEdges [ j ].mNodeID;
+			edit.mCost		= this->mEdges [ j ].mCost;
+			edit.mRemove	= false;
+		}
+	}
+
+	for ( u32 i = 0; i < totalEdits; ++i ) {
+		const MOAIVecPathEdit& edit = this->mEdits [ i ];
+		sorted [ cursor [ edit.mFrom ]++ ] = edit;
+	}
+
+	// replay each bucket; later entries win for the same neighbor
+	ZLLeanArray < u32 > slots;
+	slots.Init ( totalNodes );
+	slots.Fill ( NO_SLOT );
+
+	ZLLeanArray < MOAIVecPathEdge > edges;
+	edges.Init ( maxEdges );
+
+	u32 top = 0;
+
+	for ( u32 i = 0; i < totalNodes; ++i ) {
+	
+		u32 rowBase = top;
+		
+		for ( u32 j = base [ i ]; j < base [ i + 1 ]; ++j ) {
+		
+			const MOAIVecPathEdit& edit = sorted [ j ];
+			u32 slot = slots [ edit.mTo ];
+			
+			if ( edit.mRemove ) {
+				if ( slot != NO_SLOT ) {
+					edges [ slot ].mNodeID = NO_SLOT;
+					slots [ edit.mTo ] = NO_SLOT;
+				}
+			}
+			else if ( slot != NO_SLOT ) {
+				edges [ slot ].mCost = edit.mCost;
+			}
+			else {
+				slots [ edit.mTo ] = top;
+				edges [ top ].mNodeID = edit.mTo;
+				edges [ top ].mCost = edit.mCost;
+				top++;
+			}
+		}
+		
+		// drop removed edges and reset the slots for the next row
+		u32 rowTop = rowBase;
+		for ( u32 j = rowBase; j < top; ++j ) {
+			if ( edges [ j ].mNodeID != NO_SLOT ) {
+				slots [ edges [ j ].mNodeID ] = NO_SLOT;
+				edges [ rowTop++ ] = edges [ j ];
+			}
+		}
+		top = rowTop;
+		this->mEdgeBase [ i ] = rowBase;
+	}
+	this->mEdgeBase [ totalNodes ] = top;
+
+	this->mEdges.Init ( top );
+	if ( top ) {
+		memcpy ( this->mEdges.Data (), edges.Data (), top * sizeof ( MOAIVecPathEdge ));
+	}
+	this->mEdits.Reset ();
+}
+
 //----------------------------------------------------------------//
 bool MOAIVecPathGraph::AreNeighbors ( u32 id1, u32 id2 ) {
 	
 	size_t total = this->mNodes.Size ();
 
 	if ( id1 < total && id2 < total ) {
-		return this->mNeighbors [ id1 * total + id2 ];
+	
+		if ( this->mDense ) {
+			return this->mNeighbors [ id1 * total + id2 ];
+		}
+		
+		this->AffirmEdges ();
+		
+		for ( u32 i = this->mEdgeBase [ id1 ]; i < this->mEdgeBase [ id1 + 1 ]; ++i ) {
+			if ( this->mEdges [ i ].mNodeID == id2 ) return true;
+		}
 	}
 
 	return false;
@@ -182,19 +382,80 @@ u32 MOAIVecPathGraph::GetNodeCount () {
 }
 
 //----------------------------------------------------------------//
-void MOAIVecPathGraph::PushNeighbors ( MOAIPathFinder& pathFinder, int nodeID ) {
+u32 MOAIVecPathGraph::LoadEdges ( ZLStream& stream, u32 total, bool hasCosts ) {
+
+	this->ReserveEdges ( total * 2 );
+
+	u32 totalNodes = ( u32 )this->mNodes.Size ();
+	u32 loaded = 0;
+
+	for ( u32 i = 0; i < total; ++i ) {
+	
+		u32 id1;
+		u32 id2;
+		float cost = -1.0f;
+		
+		if ( stream.Read < u32 >( id1, 0 ) != ZL_OK ) break;
+		if ( stream.Read < u32 >( id2, 0 ) != ZL_OK ) break;
+		if ( hasCosts && ( stream.Read < float >( cost, -1.0f ) != ZL_OK )) break;
+		
+		id1--;
+		id2--;
+		
+		if (( id1 < totalNodes ) && ( id2 < totalNodes )) {
+			this->SetNeighbors ( id1, id2, true, cost );
+			loaded++;
+		}
+	}
+	return loaded;
+}
+
+//----------------------------------------------------------------//
+void MOAIVecPathGraph::PushEdit ( u32 from, u32 to, float cost, bool remove ) {
+
+	MOAIVecPathEdit& edit = this->mEdits.Push ();
+	
+	edit.mFrom		= from;
+	edit.mTo		= to;
+	edit.mCost		= cost;
+	edit.mRemove	= remove;
+}
 
-	u32 total = ( u32 )this->mNodes.Size (); // TODO: cast
+//----------------------------------------------------------------//
+void MOAIVecPathGraph::PushNeighbors ( MOAIPathFinder& pathFinder, int nodeID ) {
 
 	ZLVec3D currentNode = this->GetNode ( nodeID );
 	ZLVec3D targetNode = this->GetNode ( pathFinder.GetTargetNodeID ());
 
-	for ( u32 neighborID = 0; neighborID < total; ++neighborID ) {
-		if ( this->AreNeighbors ( nodeID, neighborID ) &&
-			!pathFinder.IsVisited ( neighborID )) {
+	if ( this->mDense ) {
+
+		u32 total = ( u32 )this->mNodes.Size (); // TODO: cast
+
+		for ( u32 neighborID = 0; neighborID < total; ++neighborID ) {
+			if ( this->AreNeighbors ( nodeID, neighborID ) &&
+				!pathFinder.IsVisited ( neighborID )) {
+
+				ZLVec3D neighbor = this->GetNode ( neighborID );
+				float g = neighbor.Dist ( currentNode ) * pathFinder.GetGWeight ();
+				float h = neighbor.Dist ( targetNode ) * pathFinder.GetHWeight ();
+				pathFinder.PushState ( neighborID, g, h );
+			}
+		}
+		return;
+	}
+
+	this->AffirmEdges ();
+
+	for ( u32 i = this->mEdgeBase [ nodeID ]; i < this->mEdgeBase [ nodeID + 1 ]; ++i ) {
+	
+		const MOAIVecPathEdge& edge = this->mEdges [ i ];
+		u32 neighborID = edge.mNodeID;
+		
+		if ( !pathFinder.IsVisited ( neighborID )) {
 
 			ZLVec3D neighbor = this->GetNode ( neighborID );
-			float g = neighbor.Dist ( currentNode ) * pathFinder.GetGWeight ();
+			float cost = ( edge.mCost < 0.0f ) ? neighbor.Dist ( currentNode ) : edge.mCost;
+			float g = cost * pathFinder.GetGWeight ();
 			float h = neighbor.Dist ( targetNode ) * pathFinder.GetHWeight ();
 			pathFinder.PushState ( neighborID, g, h );
 		}
@@ -215,6 +476,8 @@ void MOAIVecPathGraph::RegisterLuaFuncs ( MOAILuaState& state ) {
 		{ "areNeighbors",			_areNeighbors },
 		{ "getNode",				_getNode },
 		{ "getNodeCount",			_getNodeCount },
+		{ "loadEdges",				_loadEdges },
+		{ "reserveEdges",			_reserveEdges },
 		{ "reserveNodes",			_reserveNodes },
 		{ "setNeighbors",			_setNeighbors },
 		{ "setNode",				_setNode },
@@ -225,21 +488,51 @@ void MOAIVecPathGraph::RegisterLuaFuncs ( MOAILuaState& state ) {
 }
 
 //----------------------------------------------------------------//
-void MOAIVecPathGraph::ReserveNodes ( u32 total ) {
+void MOAIVecPathGraph::ReserveEdges ( u32 total ) {
+
+	if ( !this->mDense ) {
+		this->mEdits.Grow ( this->mEdits.GetTop () + total );
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIVecPathGraph::ReserveNodes ( u32 total, bool dense ) {
 
 	this->mNodes.Init ( total );
-	this->mNeighbors.Init ( total * total );
-	this->mNeighbors.Fill ( false );
+	this->mDense = dense;
+	
+	this->mEdges.Clear ();
+	this->mEdits.Reset ();
+	
+	if ( dense ) {
+		this->mNeighbors.Init ( total * total );
+		this->mNeighbors.Fill ( false );
+		this->mEdgeBase.Clear ();
+	}
+	else {
+		this->mNeighbors.Clear ();
+		this->mEdgeBase.Init ( total + 1 );
+		this->mEdgeBase.Fill ( 0 );
+	}
 }
 
 //----------------------------------------------------------------//
-void MOAIVecPathGraph::SetNeighbors ( u32 id1, u32 id2, bool value ) {
+void MOAIVecPathGraph::SetNeighbors ( u32 id1, u32 id2, bool value, float cost ) {
 	
 	size_t total = this->mNodes.Size ();
 
 	if (( id1 < total ) && ( id2 < total )) {
-		this->mNeighbors [ id1 * total + id2 ] = value;
-		this->mNeighbors [ id2 * total + id1 ] = value;
+	
+		if ( this->mDense ) {
+			this->mNeighbors [ id1 * total + id2 ] = value;
+			this->mNeighbors [ id2 * total + id1 ] = value;
+			return;
+		}
+		
+		this->PushEdit ( id1, id2, cost, !value );
+		if ( id1 != id2 ) {
+			this->PushEdit ( id2, id1, cost, !value );
+		}
 	}
 }
 
@@ -252,9 +545,13 @@ void MOAIVecPathGraph::SetNode ( u32 id, const ZLVec3D& node ) {
 }
 
 //----------------------------------------------------------------//
-MOAIVecPathGraph::MOAIVecPathGraph () {
+MOAIVecPathGraph::MOAIVecPathGraph () :
+	mDense ( false ) {
 	
 	RTTI_SINGLE ( MOAIPathGraph )
+	
+	this->mEdgeBase.Init ( 1 );
+	this->mEdgeBase.Fill ( 0 );
 }
 
 //----------------------------------------------------------------//
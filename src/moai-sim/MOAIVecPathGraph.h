@@ -8,30 +8,79 @@
 
 class MOAIPathFinder;
 
+//================================================================//
+// MOAIVecPathEdge
+//================================================================//
+class MOAIVecPathEdge {
+public:
+
+	u32			mNodeID;
+	float		mCost;		// negative to use the distance between the nodes
+};
+
+//================================================================//
+// MOAIVecPathEdit
+//================================================================//
+// queued change to a node's edge list; applied before the next query
+class MOAIVecPathEdit {
+public:
+
+	u32			mFrom;
+	u32			mTo;
+	float		mCost;
+	bool		mRemove;
+};
+
+//================================================================//
+// MOAIVecPathGraph
+//================================================================//
+/**	@lua	MOAIVecPathGraph
+	@text	Pathfinder graph of nodes in 3D space. Edges are kept as
+			per-node lists (compressed sparse rows) with an optional cost
+			per edge; edits are batched and merged into the lists before
+			the next query. Very small graphs may instead reserve a dense
+			N x N neighbor table, which only supports distance costs.
+*/
 class MOAIVecPathGraph :
 	public MOAIPathGraph {
 private:
 
 	friend class MOAIPathFinder;
 	
-	ZLLeanArray < ZLVec3D >	mNodes;
-	ZLLeanArray < bool >	mNeighbors;
+	static const u32 EDIT_CHUNK_SIZE = 1024;
+
+	ZLLeanArray < ZLVec3D >								mNodes;
+	bool												mDense;
+	
+	// dense mode
+	ZLLeanArray < bool >								mNeighbors;
+	
+	// sparse mode: edges of node i are [ mEdgeBase [ i ], mEdgeBase [ i + 1 ])
+	ZLLeanArray < u32 >									mEdgeBase;
+	ZLLeanArray < MOAIVecPathEdge >						mEdges;
+	ZLLeanStack < MOAIVecPathEdit, EDIT_CHUNK_SIZE >	mEdits;
 	
 	//----------------------------------------------------------------//
 	static int		_areNeighbors				( lua_State* L );
 	static int		_getNode					( lua_State* L );
 	static int		_getNodeCount				( lua_State* L );
+	static int		_loadEdges					( lua_State* L );
+	static int		_reserveEdges				( lua_State* L );
 	static int		_reserveNodes				( lua_State* L );
 	static int		_setNeighbors				( lua_State* L );
 	static int		_setNode					( lua_State* L );
 
 	//----------------------------------------------------------------//
+	void			AffirmEdges					();
 	bool			AreNeighbors				( u32 id1, u32 id2 );
 	ZLVec3D			GetNode						( u32 id );
 	u32				GetNodeCount				();
+	u32				LoadEdges					( ZLStream& stream, u32 total, bool hasCosts );
+	void			PushEdit					( u32 from, u32 to, float cost, bool remove );
 	void			PushNeighbors				( MOAIPathFinder& pathFinder, int nodeID );
-	void			ReserveNodes				( u32 total );
-	void			SetNeighbors				( u32 id1, u32 id2, bool value );
+	void			ReserveEdges				( u32 total );
+	void			ReserveNodes				( u32 total, bool dense );
+	void			SetNeighbors				( u32 id1, u32 id2, bool value, float cost );
 	void			SetNode						( u32 id, const ZLVec3D& node );
 
 public:
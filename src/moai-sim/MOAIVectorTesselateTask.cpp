@@ -0,0 +1,291 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#include <moai-sim/MOAIGeometryWriter.h>
+#include <moai-sim/MOAIIndexBuffer.h>
+#include <moai-sim/MOAIVectorShape.h>
+#include <moai-sim/MOAIVectorTesselateTask.h>
+#include <moai-sim/MOAIVertexBuffer.h>
+#include <moai-sim/MOAIVertexFormat.h>
+
+//================================================================//
+// MOAIVectorTesselateTask
+//================================================================//
+
+//----------------------------------------------------------------//
+void MOAIVectorTesselateTask::_tesselateChunk ( void* param, u32 idx ) {
+
+	MOAIVectorTesselateTask* task = ( MOAIVectorTesselateTask* )param;
+	MOAIVectorTesselateTaskChunk& chunk = task->mChunks [ idx ];
+
+	for ( u32 i = chunk.mBase; i < chunk.mTop; ++i ) {
+		MOAIVectorShape* shape = task->mDrawing.mShapeStack [ i ];
+		chunk.mError = shape->Tesselate ( *chunk.mContext, chunk.mVtxStream, chunk.mIdxStream, *task->mFormat, task->mFlags );
+		if ( chunk.mError ) return;
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIVectorTesselateTask::Execute () {
+
+	if ( this->mRegion ) {
+		this->mTotal = this->mDrawing.Tesselate ( this->mResult, this->mFlags );
+	}
+	else if ( this->mChunks.Size ()) {
+		this->mTotal = this->TesselateChunks ();
+	}
+	else {
+		this->mTotal = this->mDrawing.Tesselate ( this->mVtxStream, this->mIdxStream, *this->mFormat, this->mFlags );
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIVectorTesselateTask::Init ( MOAIVectorTesselator& source, MOAIVertexBuffer& vtxBuffer, MOAIIndexBuffer& idxBuffer, MOAIVertexFormat& format, u32 idxSizeInBytes, u32 flags ) {
+
+	this->mVtxBuffer = &vtxBuffer;
+	this->mIdxBuffer = &idxBuffer;
+	this->mFormat = &format;
+	this->mIdxSizeInBytes = idxSizeInBytes;
+	this->mFlags = flags;
+
+	this->mVtxBuffer->LuaRetain ();
+	this->mIdxBuffer->LuaRetain ();
+	this->mFormat->LuaRetain ();
+
+	this->TakeShapes ( source );
+	this->InitChunks ();
+}
+
+//----------------------------------------------------------------//
+void MOAIVectorTesselateTask::Init ( MOAIVectorTesselator& source, MOAIRegion& region, u32 flags ) {
+
+	this->mRegion = &region;
+	this->mFlags = flags;
+	
+	this->mRegion->LuaRetain ();
+	
+	this->TakeShapes ( source );
+}
+
+//----------------------------------------------------------------//
+void MOAIVectorTesselateTask::InitChunks () {
+
+	// each shape bumps the depth offset for the next, so with a bias the
+	// shapes have to be tesselated in sequence. verbose logs would interleave.
+	MOAIVectorTesselator& drawing = this->mDrawing;
+	if (( this->mWorkerCount == 0 ) || ( drawing.mDepthBias != 0.0f ) || drawing.mVerbose ) return;
+
+	// finishing the drawing on the worker can only merge shapes, so this is an upper bound
+	u32 totalShapes = ( u32 )drawing.mShapeStack.GetTop ();
+	u32 totalChunks = ( this->mWorkerCount + 1 ) * CHUNKS_PER_THREAD;
+	totalChunks = totalShapes < totalChunks ? totalShapes : totalChunks;
+	
+	if ( totalChunks < 2 ) return;
+	
+	// tesselators are lua objects, so they have to be made (and deleted) on this thread
+	this->mChunks.Init ( totalChunks );
+	for ( u32 i = 0; i < totalChunks; ++i ) {
+	
+		MOAIVectorTesselator* context = new MOAIVectorTesselator ();
+		context->ReserveVertexExtras (( u32 )drawing.mVtxExtras.Size (), drawing.mVtxExtraSize );
+		for ( u32 j = 0; j < drawing.mVtxExtras.Size (); ++j ) {
+			context->SetVertexExtra ( j, drawing.mVtxExtras [ j ], drawing.mVtxExtraSize );
+		}
+		this->mChunks [ i ].mContext = context;
+	}
+}
+
+//----------------------------------------------------------------//
+MOAIVectorTesselateTask::MOAIVectorTesselateTask () :
+	mSource ( 0 ),
+	mVtxBuffer ( 0 ),
+	mIdxBuffer ( 0 ),
+	mFormat ( 0 ),
+	mIdxSizeInBytes ( 4 ),
+	mRegion ( 0 ),
+	mFlags ( MOAIVectorTesselator::TESSELATE_ALL ),
+	mTotal ( 0 ),
+	mWorkerCount ( 0 ) {
+}
+
+//----------------------------------------------------------------//
+MOAIVectorTesselateTask::~MOAIVectorTesselateTask () {
+
+	for ( u32 i = 0; i < this->mChunks.Size (); ++i ) {
+		delete this->mChunks [ i ].mContext;
+	}
+
+	if ( this->mSource ) {
+		this->mSource->LuaRelease ();
+	}
+	
+	if ( this->mVtxBuffer ) {
+		this->mVtxBuffer->LuaRelease ();
+	}
+	
+	if ( this->mIdxBuffer ) {
+		this->mIdxBuffer->LuaRelease ();
+	}
+	
+	if ( this->mFormat ) {
+		this->mFormat->LuaRelease ();
+	}
+	
+	if ( this->mRegion ) {
+		this->mRegion->LuaRelease ();
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIVectorTesselateTask::Publish () {
+
+	this->ReturnShapes ();
+
+	u32 base = 0;
+	int totalElements = this->mTotal;
+
+	if ( this->mRegion ) {
+		if ( totalElements >= 0 ) {
+			this->mRegion->Copy ( this->mResult );
+		}
+	}
+	else {
+	
+		base = ( u32 )( this->mIdxBuffer->GetCursor () / this->mIdxSizeInBytes ); // TODO: cast
+		
+		if ( totalElements > 0 ) {
+			totalElements = MOAIGeometryWriter::GetMesh ( *this->mFormat, this->mVtxStream, this->mVtxStream.GetLength (), this->mIdxStream, this->mIdxStream.GetLength (), *this->mVtxBuffer, *this->mIdxBuffer, this->mIdxSizeInBytes );
+		}
+	}
+
+	if ( this->mOnFinish ) {
+		MOAIScopedLuaState state = MOAILuaRuntime::Get ().State ();
+		if ( this->mOnFinish.PushRef ( state )) {
+			state.Push ( totalElements );
+			state.Push ( base );
+			state.Push ( base + totalElements );
+			state.DebugCall ( 3, 0 );
+		}
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIVectorTesselateTask::RegisterLuaClass ( MOAILuaState& state ) {
+	MOAITask::RegisterLuaClass ( state );
+}
+
+//----------------------------------------------------------------//
+void MOAIVectorTesselateTask::RegisterLuaFuncs ( MOAILuaState& state ) {
+	MOAITask::RegisterLuaFuncs ( state );
+}
+
+//----------------------------------------------------------------//
+void MOAIVectorTesselateTask::ReturnShapes () {
+
+	// if the tesselator was given a new drawing while the job ran, keep that;
+	// the old shapes are deleted along with mDrawing
+	MOAIVectorTesselator& source = *this->mSource;
+	if ( source.mShapeStack.GetTop () || source.mVertexStack.GetTop ()) return;
+
+	MOAIVectorTesselator& drawing = this->mDrawing;
+	for ( u32 i = 0; i < drawing.mShapeStack.GetTop (); ++i ) {
+		source.mShapeStack.Push ( drawing.mShapeStack [ i ]);
+	}
+	drawing.mShapeStack.Reset ();
+}
+
+//----------------------------------------------------------------//
+void MOAIVectorTesselateTask::SetCallback ( lua_State* L, int idx ) {
+
+	MOAILuaState state ( L );
+	this->mOnFinish.SetRef ( state, idx );
+}
+
+//----------------------------------------------------------------//
+void MOAIVectorTesselateTask::TakeShapes ( MOAIVectorTesselator& source ) {
+
+	this->mSource = &source;
+	this->mSource->LuaRetain ();
+	
+	this->mWorkerCount = source.mWorkerCount;
+
+	MOAIVectorTesselator& drawing = this->mDrawing;
+
+	// the drawing isn't finished here; the job does that, exactly as tesselate would
+	for ( u32 i = 0; i < source.mShapeStack.GetTop (); ++i ) {
+		drawing.mShapeStack.Push ( source.mShapeStack [ i ]);
+	}
+	source.mShapeStack.Reset ();
+	
+	for ( u32 i = 0; i < source.mVertexStack.GetTop (); ++i ) {
+		drawing.mVertexStack.Push ( source.mVertexStack [ i ]);
+	}
+	source.mVertexStack.Reset ();
+	
+	drawing.mPolyClosed		= source.mPolyClosed;
+	drawing.mDepthBias		= source.mDepthBias;
+	drawing.mStyle			= source.mStyle;
+	drawing.mVerbose		= source.mVerbose;
+	
+	drawing.ReserveVertexExtras (( u32 )source.mVtxExtras.Size (), source.mVtxExtraSize );
+	for ( u32 i = 0; i < source.mVtxExtras.Size (); ++i ) {
+		drawing.SetVertexExtra ( i, source.mVtxExtras [ i ], source.mVtxExtraSize );
+	}
+}
+
+//----------------------------------------------------------------//
+int MOAIVectorTesselateTask::TesselateChunks () {
+
+	MOAIVectorTesselator& drawing = this->mDrawing;
+
+	int error = drawing.Finish ();
+	if ( error ) return -1;
+
+	u32 totalShapes = ( u32 )drawing.mShapeStack.GetTop ();
+	u32 totalChunks = ( u32 )this->mChunks.Size ();
+	totalChunks = totalShapes < totalChunks ? totalShapes : totalChunks;
+	
+	if ( !totalChunks ) return 0;
+	
+	for ( u32 i = 0; i < totalChunks; ++i ) {
+	
+		MOAIVectorTesselateTaskChunk& chunk = this->mChunks [ i ];
+		
+		chunk.mBase		= ( u32 )((( u64 )i * totalShapes ) / totalChunks );
+		chunk.mTop		= ( u32 )((( u64 )( i + 1 ) * totalShapes ) / totalChunks );
+		chunk.mError	= 0;
+	}
+	
+	this->mWorkers.SetWorkerCount ( this->mWorkerCount );
+	this->mWorkers.Run ( _tesselateChunk, this, totalChunks );
+	this->mWorkers.Stop ();
+	
+	// join in shape order. each chunk's indices count from its own first vertex.
+	size_t vertexSize = this->mFormat->GetVertexSize ();
+	u32 vtxBase = 0;
+	
+	for ( u32 i = 0; i < totalChunks; ++i ) {
+	
+		MOAIVectorTesselateTaskChunk& chunk = this->mChunks [ i ];
+		if ( chunk.mError ) return -1;
+		
+		size_t vtxSize = chunk.mVtxStream.GetLength ();
+		chunk.mVtxStream.Seek ( 0, SEEK_SET );
+		this->mVtxStream.WriteStream ( chunk.mVtxStream, vtxSize );
+		
+		size_t totalIndices = chunk.mIdxStream.GetLength () >> 2;
+		chunk.mIdxStream.Seek ( 0, SEEK_SET );
+		for ( size_t j = 0; j < totalIndices; ++j ) {
+			this->mIdxStream.Write < u32 >( vtxBase + chunk.mIdxStream.Read < u32 >( 0 ));
+		}
+		
+		vtxBase += ( u32 )( vtxSize / vertexSize ); // TODO: cast
+		
+		chunk.mVtxStream.Clear ();
+		chunk.mIdxStream.Clear ();
+	}
+	
+	// idx stream is 32-bits, so divide by 4 to get total indices
+	return ( int )( this->mIdxStream.GetCursor () >> 2 ); // TODO: cast
+}
@@ -0,0 +1,87 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef MOAIVECTORTESSELATETASK_H
+#define MOAIVECTORTESSELATETASK_H
+
+#include <moai-sim/MOAIRegion.h>
+#include <moai-sim/MOAIVectorTesselator.h>
+#include <moai-util/MOAIWorkerPool.h>
+
+class MOAIIndexBuffer;
+class MOAIVertexBuffer;
+class MOAIVertexFormat;
+
+//================================================================//
+// MOAIVectorTesselateTaskChunk
+//================================================================//
+// a run of shapes [ mBase, mTop ) tesselated by one worker job. each chunk
+// writes through its own tesselator so no depth state is shared.
+class MOAIVectorTesselateTaskChunk {
+private:
+
+	friend class MOAIVectorTesselateTask;
+
+	MOAIVectorTesselator*	mContext;
+	u32						mBase;
+	u32						mTop;
+	int						mError;
+	ZLMemStream				mVtxStream;
+	ZLMemStream				mIdxStream;
+};
+
+//================================================================//
+// MOAIVectorTesselateTask
+//================================================================//
+class MOAIVectorTesselateTask :
+	public MOAITask {
+private:
+
+	static const u32 CHUNKS_PER_THREAD = 4;
+
+	MOAIVectorTesselator	mDrawing;		// owns the shapes while the job runs
+	MOAIVectorTesselator*	mSource;
+	
+	MOAIVertexBuffer*		mVtxBuffer;
+	MOAIIndexBuffer*		mIdxBuffer;
+	MOAIVertexFormat*		mFormat;
+	u32						mIdxSizeInBytes;
+	ZLMemStream				mVtxStream;
+	ZLMemStream				mIdxStream;
+	
+	MOAIRegion*				mRegion;
+	MOAIRegion				mResult;
+	
+	u32						mFlags;
+	int						mTotal;
+	
+	MOAIWorkerPool									mWorkers;
+	u32												mWorkerCount;
+	ZLLeanArray < MOAIVectorTesselateTaskChunk >	mChunks;
+	
+	MOAILuaStrongRef		mOnFinish;
+
+	//----------------------------------------------------------------//
+	static void		_tesselateChunk			( void* param, u32 idx );
+
+	//----------------------------------------------------------------//
+	void			Execute					();
+	void			InitChunks				();
+	void			Publish					();
+	void			ReturnShapes			();
+	void			TakeShapes				( MOAIVectorTesselator& source );
+	int				TesselateChunks			();
+
+public:
+
+	//----------------------------------------------------------------//
+	void			Init					( MOAIVectorTesselator& source, MOAIVertexBuffer& vtxBuffer, MOAIIndexBuffer& idxBuffer, MOAIVertexFormat& format, u32 idxSizeInBytes, u32 flags );
+	void			Init					( MOAIVectorTesselator& source, MOAIRegion& region, u32 flags );
+					MOAIVectorTesselateTask		();
+					~MOAIVectorTesselateTask	();
+	void			RegisterLuaClass		( MOAILuaState& state );
+	void			RegisterLuaFuncs		( MOAILuaState& state );
+	void			SetCallback				( lua_State* L, int idx );
+};
+
+#endif
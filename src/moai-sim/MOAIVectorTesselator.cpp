@@ -15,6 +15,7 @@
 #include <moai-sim/MOAIVectorPoly.h>
 #include <moai-sim/MOAIVectorPoly.h>
 #include <moai-sim/MOAIVectorRect.h>
+#include <moai-sim/MOAIVectorTesselateTask.h>
 #include <moai-sim/MOAIVectorUtil.h>
 #include <moai-sim/MOAIVertexFormat.h>
 #include <moai-sim/MOAIVertexFormatMgr.h>
@@ -178,6 +179,41 @@ public:
 // local
 //================================================================//
 
+//----------------------------------------------------------------//
+// flattens everything about a format that changes the bytes written for a vertex
+static void _getFormatLayout ( const MOAIVertexFormat& format, ZLLeanArray < u32 >& layout ) {
+
+	u32 totalAttributes = format.GetTotalAttributes ();
+	layout.Init (( totalAttributes * 6 ) + 1 );
+	
+	u32* cursor = layout.Data ();
+	*( cursor++ ) = format.GetVertexSize ();
+	
+	for ( u32 i = 0; i < totalAttributes; ++i ) {
+		const MOAIVertexAttribute& attr = format.GetAttribute ( i );
+		*( cursor++ ) = attr.mIndex;
+		*( cursor++ ) = attr.mSize;
+		*( cursor++ ) = attr.mType;
+		*( cursor++ ) = attr.mUse;
+		*( cursor++ ) = attr.mNormalized ? 1 : 0;
+		*( cursor++ ) = attr.mOffset;
+	}
+}
+
+//----------------------------------------------------------------//
+/**	@lua	clearCache
+	@text	Drops all cached shape tesselations.
+
+	@in		MOAIVectorTesselator self
+	@out	nil
+*/
+int MOAIVectorTesselator::_clearCache ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIVectorTesselator, "U" )
+	
+	self->ClearCache ();
+	return 0;
+}
+
 //----------------------------------------------------------------//
 int MOAIVectorTesselator::_clearShapes ( lua_State* L ) {
 	MOAI_LUA_SETUP ( MOAIVectorTesselator, "U" )
@@ -247,6 +283,24 @@ int MOAIVectorTesselator::_finish ( lua_State* L ) {
 	return 2;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	getCacheStats
+	@text	Reports how the last tesselate call used the shape cache.
+
+	@in		MOAIVectorTesselator self
+	@out	number hits			Shapes copied from the cache.
+	@out	number misses		Shapes that had to be tesselated.
+	@out	number entries		Shapes held in the cache.
+*/
+int MOAIVectorTesselator::_getCacheStats ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIVectorTesselator, "U" )
+	
+	state.Push ( self->mCacheHits );
+	state.Push ( self->mCacheMisses );
+	state.Push (( u32 )self->mCache.size ());
+	return 3;
+}
+
 //----------------------------------------------------------------//
 int MOAIVectorTesselator::_getExtrude ( lua_State* L ) {
 	MOAI_LUA_SETUP ( MOAIVectorTesselator, "U" )
@@ -476,6 +530,26 @@ int MOAIVectorTesselator::_reserveVertexExtras ( lua_State* L ) {
 	return 0;	
 }
 
+//----------------------------------------------------------------//
+/**	@lua	setCacheEnabled
+	@text	Caches each shape's triangles when tesselating to vertex and
+			index buffers or streams. Shapes whose geometry and style
+			haven't changed since the last call are copied instead of
+			tesselated again. The cache only holds the shapes from the
+			last call, and is flushed when the vertex format or the
+			vertex extras change. Disabling the cache clears it.
+
+	@in		MOAIVectorTesselator self
+	@opt	boolean enable		Default value is true.
+	@out	nil
+*/
+int MOAIVectorTesselator::_setCacheEnabled ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIVectorTesselator, "U" )
+
+	self->SetCacheEnabled ( state.GetValue < bool >( 2, true ));
+	return 0;
+}
+
 //----------------------------------------------------------------//
 int MOAIVectorTesselator::_setCapStyle ( lua_State* L ) {
 	MOAI_LUA_SETUP ( MOAIVectorTesselator, "U" )
@@ -702,6 +776,23 @@ int MOAIVectorTesselator::_setWindingRule ( lua_State* L ) {
 	return 0;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	setWorkerCount
+	@text	Sets the number of worker threads each tesselateAsync job
+			uses for vertex and index output. The queue's thread always
+			takes part, so zero tesselates the job's shapes serially.
+
+	@in		MOAIVectorTesselator self
+	@opt	number count		Default value is 0.
+	@out	nil
+*/
+int MOAIVectorTesselator::_setWorkerCount ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIVectorTesselator, "U" )
+
+	self->mWorkerCount = state.GetValue < u32 >( 2, 0 );
+	return 0;
+}
+
 //----------------------------------------------------------------//
 int MOAIVectorTesselator::_tesselate ( lua_State* L ) {
 	MOAI_LUA_SETUP ( MOAIVectorTesselator, "U" )
@@ -747,6 +838,80 @@ int MOAIVectorTesselator::_tesselate ( lua_State* L ) {
 	return 3;
 }
 
+//----------------------------------------------------------------//
+/**	@lua	tesselateAsync
+	@text	Tesselates on a task queue. The tesselator's shapes move to
+			the job and come back when it publishes, unless new shapes
+			were pushed in the meantime. Vertex and index output is
+			split across the tesselator's worker threads (see
+			setWorkerCount) and joined in shape order, so the buffers
+			match what tesselate would have written. A depth bias or
+			verbose logging keeps the job on one thread. Regions are
+			always tesselated on one thread, as all shapes go through
+			the same libtess pass.
+			
+			The callback receives the values tesselate would have
+			returned.
+
+	@overload
+
+		@in		MOAIVectorTesselator self
+		@in		MOAITaskQueue queue
+		@in		function callback
+		@in		MOAIVertexBuffer vtxBuffer
+		@in		MOAIIndexBuffer idxBuffer
+		@in		number idxSizeInBytes
+		@in		MOAIVertexFormat format
+		@opt	number flags		Default value is TESSELATE_ALL.
+		@out	nil
+
+	@overload
+
+		@in		MOAIVectorTesselator self
+		@in		MOAITaskQueue queue
+		@in		function callback
+		@in		MOAIRegion region
+		@opt	number flags		Default value is TESSELATE_ALL.
+		@out	nil
+*/
+int MOAIVectorTesselator::_tesselateAsync ( lua_State* L ) {
+	MOAI_LUA_SETUP ( MOAIVectorTesselator, "UU" )
+	
+	MOAITaskQueue* queue = state.GetLuaObject < MOAITaskQueue >( 2, true );
+	if ( !queue ) return 0;
+	
+	MOAIVectorTesselateTask* task = 0;
+	
+	MOAIVertexBuffer* vtxBuffer		= state.GetLuaObject < MOAIVertexBuffer >( 4, false );
+	MOAIIndexBuffer* idxBuffer		= state.GetLuaObject < MOAIIndexBuffer >( 5, false );
+	MOAIRegion* region				= state.GetLuaObject < MOAIRegion >( 4, false );
+	
+	if ( vtxBuffer && idxBuffer ) {
+	
+		u32 idxSizeInBytes			= state.GetValue < u32 >( 6, 4 );
+		MOAIVertexFormat* format	= state.GetLuaObject < MOAIVertexFormat >( 7, true );
+		u32 flags					= state.GetValue < u32 >( 8, MOAIVectorTesselator::TESSELATE_ALL );
+		
+		if ( format ) {
+			task = new MOAIVectorTesselateTask ();
+			task->Init ( *self, *vtxBuffer, *idxBuffer, *format, idxSizeInBytes, flags );
+		}
+	}
+	else if ( region ) {
+	
+		u32 flags = state.GetValue < u32 >( 5, MOAIVectorTesselator::TESSELATE_ALL );
+		
+		task = new MOAIVectorTesselateTask ();
+		task->Init ( *self, *region, flags );
+	}
+	
+	if ( task ) {
+		task->SetCallback ( L, 3 );
+		task->Start ( *queue, MOAIMainThreadTaskSubscriber::Get ());
+	}
+	return 0;
+}
+
 //----------------------------------------------------------------//
 int MOAIVectorTesselator::_worldToDrawing ( lua_State* L ) {
 	MOAI_LUA_SETUP ( MOAIVectorTesselator, "UNN" )
@@ -800,6 +965,7 @@ int MOAIVectorTesselator::_writeShapes ( lua_State* L ) {
 void MOAIVectorTesselator::Clear () {
 
 	this->ClearShapes ();
+	this->ClearCache ();
 	
 	for ( u32 i = 0; i < this->mVtxExtras.Size (); ++i ) {
 		free ( this->mVtxExtras [ i ]);
@@ -807,6 +973,18 @@ void MOAIVectorTesselator::Clear () {
 	this->mVtxExtraSize = 0;
 }
 
+//----------------------------------------------------------------//
+void MOAIVectorTesselator::ClearCache () {
+
+	CacheIt cacheIt = this->mCache.begin ();
+	for ( ; cacheIt != this->mCache.end (); ++cacheIt ) {
+		delete cacheIt->second;
+	}
+	this->mCache.clear ();
+	this->mCacheFormat = 0;
+	this->mCacheLayout.Clear ();
+}
+
 //----------------------------------------------------------------//
 void MOAIVectorTesselator::ClearShapes () {
 
@@ -883,7 +1061,13 @@ MOAIVectorTesselator::MOAIVectorTesselator () :
 	mDepthBias ( 0.0f ),
 	mDepthOffset ( 0.0f ),
 	mVerbose ( false ),
-	mVtxExtraSize ( 0 ) {
+	mVtxExtraSize ( 0 ),
+	mCacheEnabled ( false ),
+	mCacheFormat ( 0 ),
+	mCacheGeneration ( 0 ),
+	mCacheHits ( 0 ),
+	mCacheMisses ( 0 ),
+	mWorkerCount ( 0 ) {
 	
 	this->mStyle.Default ();
 	
@@ -1108,12 +1292,14 @@ void MOAIVectorTesselator::RegisterLuaClass ( MOAILuaState& state ) {
 void MOAIVectorTesselator::RegisterLuaFuncs ( MOAILuaState& state ) {
 
 	luaL_Reg regTable [] = {
+		{ "clearCache",				_clearCache },
 		{ "clearShapes",			_clearShapes },
 		{ "clearStyles",			_clearStyles },
 		{ "clearTransforms",		_clearTransforms },
 		{ "drawingToWorld",			_drawingToWorld },
 		{ "drawingToWorldVec",		_drawingToWorldVec },
 		{ "finish",					_finish },
+		{ "getCacheStats",			_getCacheStats },
 		{ "getExtrude",				_getExtrude },
 		{ "getTransform",			_getTransform },
 		{ "openWriter",				_openWriter },
@@ -1131,6 +1317,7 @@ void MOAIVectorTesselator::RegisterLuaFuncs ( MOAILuaState& state ) {
 		{ "pushVertex",				_pushVertex },
 		{ "readShapes",				_readShapes },
 		{ "reserveVertexExtras",	_reserveVertexExtras },
+		{ "setCacheEnabled",		_setCacheEnabled },
 		{ "setCapStyle",			_setCapStyle },
 		{ "setCircleResolution",	_setCircleResolution },
 		{ "setDepthBias",			_setDepthBias },
@@ -1158,7 +1345,9 @@ void MOAIVectorTesselator::RegisterLuaFuncs ( MOAILuaState& state ) {
 		{ "setVerbose",				_setVerbose },
 		{ "setVertexExtra",			_setVertexExtra },
 		{ "setWindingRule",			_setWindingRule },
+		{ "setWorkerCount",			_setWorkerCount },
 		{ "tesselate",				_tesselate },
+		{ "tesselateAsync",			_tesselateAsync },
 		{ "worldToDrawing",			_worldToDrawing },
 		{ "worldToDrawingVec",		_worldToDrawingVec },
 		{ "writeShapes",			_writeShapes },
@@ -1171,6 +1360,8 @@ void MOAIVectorTesselator::RegisterLuaFuncs ( MOAILuaState& state ) {
 //----------------------------------------------------------------//
 void MOAIVectorTesselator::ReserveVertexExtras ( u32 total, size_t size ) {
 
+	this->ClearCache ();
+
 	this->mVtxExtraSize = size;
 	this->mVtxExtras.Init ( total );
 	
@@ -1185,6 +1376,30 @@ void MOAIVectorTesselator::SetVertexExtra ( u32 idx, void* extra, size_t size )
 	size = size <= this->mVtxExtraSize ? size : this->mVtxExtraSize;
 	if ( idx < this->mVtxExtras.Size ()) {
 		memcpy ( this->mVtxExtras [ idx ], extra, size );
+		this->ClearCache ();
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIVectorTesselator::SetCacheEnabled ( bool enable ) {
+
+	this->mCacheEnabled = enable;
+	if ( !enable ) {
+		this->ClearCache ();
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIVectorTesselator::SweepCache () {
+
+	// anything the last call didn't use belongs to a shape that changed or went away
+	CacheIt cacheIt = this->mCache.begin ();
+	while ( cacheIt != this->mCache.end ()) {
+		CacheIt cursor = cacheIt++;
+		if ( cursor->second->mGeneration != this->mCacheGeneration ) {
+			delete cursor->second;
+			this->mCache.erase ( cursor );
+		}
 	}
 }
 
@@ -1242,13 +1457,48 @@ int MOAIVectorTesselator::Tesselate ( ZLStream& vtxStream, ZLStream& idxStream,
 
 	this->mDepthOffset = 0.0f;
 
+	// cached output has to be read back, so both streams must allow it
+	u32 readSeek = ZLStream::CAN_READ | ZLStream::CAN_SEEK;
+	bool useCache = this->mCacheEnabled && ( !this->mVerbose ) && (( vtxStream.GetCaps () & readSeek ) == readSeek ) && (( idxStream.GetCaps () & readSeek ) == readSeek );
+	
+	if ( useCache ) {
+	
+		// a format can be redeclared in place, or a new one can land at a freed address,
+		// so the pointer alone can't vouch for the cached vertices
+		ZLLeanArray < u32 > layout;
+		_getFormatLayout ( format, layout );
+		
+		bool sameLayout = ( layout.Size () == this->mCacheLayout.Size ()) && ( memcmp ( layout.Data (), this->mCacheLayout.Data (), layout.Size () * sizeof ( u32 )) == 0 );
+		
+		if (( this->mCacheFormat != &format ) || ( !sameLayout )) {
+			this->ClearCache ();
+			this->mCacheFormat = &format;
+			this->mCacheLayout.Take ( layout );
+		}
+		this->mCacheGeneration++;
+		this->mCacheHits = 0;
+		this->mCacheMisses = 0;
+	}
+
+	MOAIVectorTesselatorWriter writer;
+	ZLMemStream keyStream;
+
 	for ( u32 i = 0; i < this->mShapeStack.GetTop (); ++i ) {
 		MOAIVectorShape* shape = this->mShapeStack [ i ];
-		error = shape->Tesselate ( *this, vtxStream, idxStream, format, flags );
+		if ( useCache ) {
+			error = this->TesselateCached ( *shape, writer, keyStream, vtxStream, idxStream, format, flags );
+		}
+		else {
+			error = shape->Tesselate ( *this, vtxStream, idxStream, format, flags );
+		}
 		assert ( error == 0 );
 		if ( error ) return -1;
 	}
 	
+	if ( useCache ) {
+		this->SweepCache ();
+	}
+	
 	// idx stream is 32-bits, so divide by 4 to get total indices
 	return ( int )(( idxStream.GetCursor () - base ) >> 2 ); // TODO: cast
 }
@@ -1269,6 +1519,82 @@ int MOAIVectorTesselator::Tesselate ( MOAIVertexBuffer& vtxBuffer, MOAIIndexBuff
 	return totalIndices;
 }
 
+//----------------------------------------------------------------//
+int MOAIVectorTesselator::TesselateCached ( MOAIVectorShape& shape, MOAIVectorTesselatorWriter& writer, ZLMemStream& keyStream, ZLStream& vtxStream, ZLStream& idxStream, MOAIVertexFormat& format, u32 flags ) {
+
+	// the key is everything that decides what the shape writes: its geometry and
+	// full style, the flags and the depth offset it starts from
+	keyStream.Clear ();
+	writer.mFlushStyle = true;
+	writer.WriteShape ( keyStream, shape );
+	keyStream.Write < u32 >( flags );
+	keyStream.Write < float >( this->mDepthOffset );
+	keyStream.Write < float >( this->mDepthBias );
+
+	size_t keySize = keyStream.GetLength ();
+	
+	ZLLeanArray < u8 > key;
+	key.Init ( keySize );
+	keyStream.SetCursor ( 0 );
+	keyStream.ReadBytes ( key.Data (), keySize );
+	
+	u32 hash = ZLHashedString::Hash (( cc8* )key.Data (), keySize );
+	u32 base = this->CountVertices ( format, vtxStream );
+	
+	MOAIVectorTesselatorCacheEntry* entry = this->mCache.value_for_key ( hash, 0 );
+	
+	if ( entry && ( entry->mKey.Size () == keySize ) && ( memcmp ( entry->mKey.Data (), key.Data (), keySize ) == 0 )) {
+	
+		vtxStream.WriteBytes ( entry->mVertices.Data (), entry->mVertices.Size ());
+		
+		size_t nIndices = entry->mIndices.Size ();
+		for ( size_t i = 0; i < nIndices; ++i ) {
+			idxStream.Write < u32 >( base + entry->mIndices [ i ]);
+		}
+		
+		this->mDepthOffset = entry->mDepthOffset;
+		entry->mGeneration = this->mCacheGeneration;
+		this->mCacheHits++;
+		return 0;
+	}
+	
+	size_t vtxStart = vtxStream.GetCursor ();
+	size_t idxStart = idxStream.GetCursor ();
+	
+	int error = shape.Tesselate ( *this, vtxStream, idxStream, format, flags );
+	if ( error ) return error;
+	
+	this->mCacheMisses++;
+	
+	// on a hash collision within the same call, the first shape keeps the slot
+	if ( entry && ( entry->mGeneration == this->mCacheGeneration )) return 0;
+	
+	size_t vtxEnd = vtxStream.GetCursor ();
+	size_t idxEnd = idxStream.GetCursor ();
+	
+	entry = entry ? entry : new MOAIVectorTesselatorCacheEntry ();
+	entry->mKey.Take ( key );
+	
+	entry->mVertices.Init ( vtxEnd - vtxStart );
+	vtxStream.SetCursor ( vtxStart );
+	vtxStream.ReadBytes ( entry->mVertices.Data (), vtxEnd - vtxStart );
+	vtxStream.SetCursor ( vtxEnd );
+	
+	size_t nIndices = ( idxEnd - idxStart ) >> 2;
+	entry->mIndices.Init ( nIndices );
+	idxStream.SetCursor ( idxStart );
+	for ( size_t i = 0; i < nIndices; ++i ) {
+		entry->mIndices [ i ] = idxStream.Read < u32 >( 0 ) - base;
+	}
+	idxStream.SetCursor ( idxEnd );
+	
+	entry->mDepthOffset = this->mDepthOffset;
+	entry->mGeneration = this->mCacheGeneration;
+	
+	this->mCache [ hash ] = entry;
+	return 0;
+}
+
 //----------------------------------------------------------------//
 void MOAIVectorTesselator::WriteShapes ( ZLStream& stream, MOAIVectorTesselatorWriter* writer ) {
 
@@ -68,6 +68,22 @@ public:
 	void					WriteShape							( ZLStream& stream, const MOAIVectorShape& shape );
 };
 
+//================================================================//
+// MOAIVectorTesselatorCacheEntry
+//================================================================//
+// one shape's output from the last tesselate call that produced it
+class MOAIVectorTesselatorCacheEntry {
+private:
+
+	friend class MOAIVectorTesselator;
+
+	ZLLeanArray < u8 >		mKey;			// the shape and its style as written by MOAIVectorTesselatorWriter, plus tesselator state
+	ZLLeanArray < u8 >		mVertices;		// in the cache's vertex format
+	ZLLeanArray < u32 >		mIndices;		// relative to the shape's first vertex
+	float					mDepthOffset;	// the tesselator's depth offset after the shape
+	u32						mGeneration;	// last tesselate call to use the entry
+};
+
 //================================================================//
 // MOAIVectorTesselator
 //================================================================//
@@ -78,6 +94,8 @@ class MOAIVectorTesselator :
 	public MOAILuaObject {
 private:
 
+	friend class MOAIVectorTesselateTask;
+
 	enum {
 		VERTEX_SIZE = 16,
 	};
@@ -99,13 +117,27 @@ private:
 	size_t					mVtxExtraSize;
 	ZLLeanArray < void* >	mVtxExtras;
 
+	typedef STLMap < u32, MOAIVectorTesselatorCacheEntry* >::iterator CacheIt;
+	STLMap < u32, MOAIVectorTesselatorCacheEntry* > mCache;
+
+	bool					mCacheEnabled;
+	const MOAIVertexFormat*	mCacheFormat;
+	ZLLeanArray < u32 >		mCacheLayout;		// the format's attributes when the cache was filled
+	u32						mCacheGeneration;
+	u32						mCacheHits;
+	u32						mCacheMisses;
+
+	u32						mWorkerCount;		// worker threads for each async job
+
 	//----------------------------------------------------------------//
+	static int		_clearCache				( lua_State* L );
 	static int		_clearShapes			( lua_State* L );
 	static int		_clearStyles			( lua_State* L );
 	static int		_clearTransforms		( lua_State* L );
 	static int		_drawingToWorld			( lua_State* L );
 	static int		_drawingToWorldVec		( lua_State* L );
 	static int		_finish					( lua_State* L );
+	static int		_getCacheStats			( lua_State* L );
 	static int		_getExtrude				( lua_State* L );
 	static int		_getTransform			( lua_State* L );
 	static int		_openWriter				( lua_State* L );
@@ -123,6 +155,7 @@ private:
 	static int		_pushVertex				( lua_State* L );
 	static int		_readShapes				( lua_State* L );
 	static int		_reserveVertexExtras	( lua_State* L );
+	static int		_setCacheEnabled		( lua_State* L );
 	static int		_setCapStyle			( lua_State* L );
 	static int		_setCircleResolution	( lua_State* L );
 	static int		_setDepthBias			( lua_State* L );
@@ -150,13 +183,17 @@ private:
 	static int		_setVerbose				( lua_State* L );
 	static int		_setVertexExtra			( lua_State* L );
 	static int		_setWindingRule			( lua_State* L );
+	static int		_setWorkerCount			( lua_State* L );
 	static int		_tesselate				( lua_State* L );
+	static int		_tesselateAsync			( lua_State* L );
 	static int		_worldToDrawing			( lua_State* L );
 	static int		_worldToDrawingVec		( lua_State* L );
 	static int		_writeShapes			( lua_State* L );
 
 	//----------------------------------------------------------------//
 	void			PushShape				( MOAIVectorShape* shape );
+	void			SweepCache				();
+	int				TesselateCached			( MOAIVectorShape& shape, MOAIVectorTesselatorWriter& writer, ZLMemStream& keyStream, ZLStream& vtxStream, ZLStream& idxStream, MOAIVertexFormat& format, u32 flags );
 		
 public:
 
@@ -171,8 +208,12 @@ public:
 	GET_SET ( bool, PolyClosed, mPolyClosed )
 	GET_SET ( float, DepthBias, mDepthBias )
 	
+	GET_CONST ( u32, CacheHits, mCacheHits )
+	GET_CONST ( u32, CacheMisses, mCacheMisses )
+	
 	//----------------------------------------------------------------//
 	void				Clear						();
+	void				ClearCache					();
 	void				ClearShapes					();
 	void				ClearTransforms				();
 	u32					CountVertices				( const MOAIVertexFormat& format, ZLStream& vtxStream );
@@ -197,6 +238,7 @@ public:
 	void				RegisterLuaClass			( MOAILuaState& state );
 	void				RegisterLuaFuncs			( MOAILuaState& state );
 	void				ReserveVertexExtras			( u32 total, size_t size );
+	void				SetCacheEnabled				( bool enable );
 	void				SetVertexExtra				( u32 idx, void* extra, size_t size );
 	int					Tesselate					( SafeTesselator& tess, u32 flags = TESSELATE_ALL );
 	int					Tesselate					( MOAIRegion& region, u32 flags = TESSELATE_ALL );
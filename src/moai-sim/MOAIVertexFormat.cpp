@@ -198,7 +198,7 @@ MOAIVertexFormat* MOAIVertexFormat::AffirmVertexFormat ( MOAILuaState& state, in
 		format = MOAIVertexFormatMgr::Get ().GetFormat ( state.GetValue < u32 >( idx, MOAIVertexFormatMgr::UNKNOWN_FORMAT ));
 	}
 	else {
-		format = state.GetLuaObject < MOAIVertexFormat >( 2, true );
+		format = state.GetLuaObject < MOAIVertexFormat >( idx, true );
 	}
 	return format;
 }
@@ -409,7 +409,7 @@ void MOAIVertexFormat::DeclareAttribute ( u32 index, u32 type, u32 size, u32 use
 }
 
 //----------------------------------------------------------------//
-const MOAIVertexAttribute& MOAIVertexFormat::GetAttribute ( u32 attrIdx ) {
+const MOAIVertexAttribute& MOAIVertexFormat::GetAttribute ( u32 attrIdx ) const {
 
 	assert ( attrIdx < this->mAttributes.Size ());
 	return this->mAttributes [ attrIdx ];
@@ -119,6 +119,7 @@ public:
 	
 	DECL_LUA_FACTORY ( MOAIVertexFormat )
 	
+	GET_CONST ( u32, TotalAttributes, mTotalAttributes )
 	GET_CONST ( u32, VertexSize, mVertexSize )
 	
 	//----------------------------------------------------------------//
@@ -137,7 +138,7 @@ public:
 
 	void							DeclareAttribute				( u32 index, u32 type, u32 size, u32 use, bool normalized );
 	
-	const MOAIVertexAttribute&		GetAttribute					( u32 attrIdx );
+	const MOAIVertexAttribute&		GetAttribute					( u32 attrIdx ) const;
 	const MOAIVertexAttribute*		GetAttributeByUse				( u32 useID, u32 attrIndex ) const;
 	
 									MOAIVertexFormat				();
@@ -28,6 +28,7 @@
 #include <moai-sim/MOAICollisionPrim.h>
 #include <moai-sim/MOAICollisionProp.h>
 #include <moai-sim/MOAICollisionShape.h>
+#include <moai-sim/MOAICollisionSweep.h>
 #include <moai-sim/MOAICollisionWorld.h>
 #include <moai-sim/MOAIColor.h>
 #include <moai-sim/MOAICompassSensor.h>
@@ -61,6 +62,7 @@
 #include <moai-sim/MOAIGraphicsGridProp.h>
 #include <moai-sim/MOAIGrid.h>
 #include <moai-sim/MOAIGridPathGraph.h>
+#include <moai-sim/MOAIGridPathHierarchy.h>
 #include <moai-sim/MOAIGridSpace.h>
 #include <moai-sim/MOAIImage.h>
 #include <moai-sim/MOAIImageFormat.h>
@@ -87,6 +89,7 @@
 #include <moai-sim/MOAIMaterialMgr.h>
 #include <moai-sim/MOAIMatrix.h>
 #include <moai-sim/MOAIMesh.h>
+#include <moai-sim/MOAIMeshBVH.h>
 #include <moai-sim/MOAIMeshPartition.h>
 #include <moai-sim/MOAIMeshSparseQuadTree.h>
 #include <moai-sim/MOAIMeshTernaryTree.h>
@@ -102,6 +105,7 @@
 #include <moai-sim/MOAIParticleDistanceEmitter.h>
 #include <moai-sim/MOAIParticleEmitter.h>
 #include <moai-sim/MOAIParticleForce.h>
+#include <moai-sim/MOAIParticleMgr.h>
 #include <moai-sim/MOAIParticlePexPlugin.h>
 #include <moai-sim/MOAIParticlePlugin.h>
 #include <moai-sim/MOAIParticleScript.h>
@@ -118,6 +122,7 @@
 #include <moai-sim/MOAIPartitionResultMgr.h>
 #include <moai-sim/MOAIPath.h>
 #include <moai-sim/MOAIPathFinder.h>
+#include <moai-sim/MOAIPathService.h>
 #include <moai-sim/MOAIPathStepper.h>
 #include <moai-sim/MOAIPathTerrainDeck.h>
 #include <moai-sim/MOAIPinTransform.h>
@@ -143,6 +148,8 @@
 #include <moai-sim/MOAIShaderUniformHandle.h>
 #include <moai-sim/MOAIShaderUniformSchema.h>
 #include <moai-sim/MOAISim.h>
+#include <moai-sim/MOAISkeleton.h>
+#include <moai-sim/MOAISnapshot.h>
 #include <moai-sim/MOAITextureBase.h>
 #include <moai-sim/MOAISpanList.h>
 #include <moai-sim/MOAISpriteDeck2D.h>
@@ -166,6 +173,7 @@
 #include <moai-sim/MOAIVectorSensor.h>
 #include <moai-sim/MOAIVectorShape.h>
 #include <moai-sim/MOAIVectorStyle.h>
+#include <moai-sim/MOAIVectorTesselateTask.h>
 #include <moai-sim/MOAIVectorTesselator.h>
 #include <moai-sim/MOAIVectorUtil.h>
 #include <moai-sim/MOAIVertexArray.h>
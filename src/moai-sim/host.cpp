@@ -398,6 +398,7 @@ void AKUSimContextInitialize () {
 	MOAIDraw::Affirm ();
 	MOAIDebugLinesMgr::Affirm ();
 	MOAIPartitionResultMgr::Affirm ();
+	MOAIParticleMgr::Affirm ();
 	MOAINodeMgr::Affirm ();
 	MOAIInputMgr::Affirm ();
 	MOAISim::Affirm ();
@@ -461,6 +462,7 @@ void AKUSimContextInitialize () {
 	REGISTER_LUA_CLASS ( MOAIParticleCallbackPlugin )
 	REGISTER_LUA_CLASS ( MOAIParticleDistanceEmitter )
 	REGISTER_LUA_CLASS ( MOAIParticleForce )
+	REGISTER_LUA_CLASS ( MOAIParticleMgr )
 	REGISTER_LUA_CLASS ( MOAIParticleScript )
 	REGISTER_LUA_CLASS ( MOAIParticleState )
 	REGISTER_LUA_CLASS ( MOAIParticleSystem )
@@ -469,6 +471,7 @@ void AKUSimContextInitialize () {
 	REGISTER_LUA_CLASS ( MOAIPartitionViewLayer )
 	REGISTER_LUA_CLASS ( MOAIPath )
 	REGISTER_LUA_CLASS ( MOAIPathFinder )
+	REGISTER_LUA_CLASS ( MOAIPathService )
 	REGISTER_LUA_CLASS ( MOAIPathStepper )
 	REGISTER_LUA_CLASS ( MOAIPathTerrainDeck )
 	REGISTER_LUA_CLASS ( MOAIPinTransform )
@@ -483,6 +486,8 @@ void AKUSimContextInitialize () {
 	REGISTER_LUA_CLASS ( MOAIShaderMgr )
 	REGISTER_LUA_CLASS ( MOAIShaderProgram )
 	REGISTER_LUA_CLASS ( MOAISim )
+	REGISTER_LUA_CLASS ( MOAISkeleton )
+	REGISTER_LUA_CLASS ( MOAISnapshot )
 	REGISTER_LUA_CLASS ( MOAISpriteDeck2D )
 	REGISTER_LUA_CLASS ( MOAIStretchPatch2D )
 	//REGISTER_LUA_CLASS ( MOAISurfaceDeck2D )
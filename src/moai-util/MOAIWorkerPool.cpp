@@ -0,0 +1,154 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#include "pch.h"
+#include <moai-util/MOAIWorkerPool.h>
+
+//================================================================//
+// MOAIWorkerPool main
+//================================================================//
+
+//----------------------------------------------------------------//
+void MOAIWorkerPool::_main ( void* param, MOAIThreadState& threadState ) {
+	UNUSED ( threadState );
+
+	(( MOAIWorkerPool* )param )->Main ();
+}
+
+//================================================================//
+// MOAIWorkerPool
+//================================================================//
+
+//----------------------------------------------------------------//
+u32 MOAIWorkerPool::GetWorkerCount () const {
+
+	return ( u32 )this->mThreads.Size ();
+}
+
+//----------------------------------------------------------------//
+void MOAIWorkerPool::Main () {
+
+	this->mCondition.Lock ();
+	
+	while ( this->mIsRunning ) {
+		
+		if ( this->mNext < this->mTotal ) {
+		
+			u32 idx = this->mNext++;
+			
+			this->mCondition.Unlock ();
+			this->mFunc ( this->mParam, idx );
+			this->mCondition.Lock ();
+			
+			if ( ++this->mFinished == this->mTotal ) {
+				this->mCondition.Broadcast ();
+			}
+		}
+		else {
+			this->mCondition.Wait ();
+		}
+	}
+	
+	this->mCondition.Unlock ();
+}
+
+//----------------------------------------------------------------//
+MOAIWorkerPool::MOAIWorkerPool () :
+	mIsRunning ( false ),
+	mFunc ( 0 ),
+	mParam ( 0 ),
+	mTotal ( 0 ),
+	mNext ( 0 ),
+	mFinished ( 0 ) {
+}
+
+//----------------------------------------------------------------//
+MOAIWorkerPool::~MOAIWorkerPool () {
+
+	this->Stop ();
+}
+
+//----------------------------------------------------------------//
+void MOAIWorkerPool::Run ( Func func, void* param, u32 total ) {
+
+	if ( !( func && total )) return;
+
+	if (( total == 1 ) || ( !this->mThreads.Size ())) {
+		for ( u32 i = 0; i < total; ++i ) {
+			func ( param, i );
+		}
+		return;
+	}
+
+	this->mCondition.Lock ();
+	
+	this->mFunc			= func;
+	this->mParam		= param;
+	this->mTotal		= total;
+	this->mNext			= 0;
+	this->mFinished		= 0;
+	
+	this->mCondition.Broadcast ();
+	
+	// the calling thread works too, then waits for the stragglers
+	while ( this->mFinished < this->mTotal ) {
+	
+		if ( this->mNext < this->mTotal ) {
+		
+			u32 idx = this->mNext++;
+			
+			this->mCondition.Unlock ();
+			func ( param, idx );
+			this->mCondition.Lock ();
+			
+			this->mFinished++;
+		}
+		else {
+			this->mCondition.Wait ();
+		}
+	}
+	
+	this->mFunc			= 0;
+	this->mParam		= 0;
+	this->mTotal		= 0;
+	this->mNext			= 0;
+	this->mFinished		= 0;
+	
+	this->mCondition.Unlock ();
+}
+
+//----------------------------------------------------------------//
+void MOAIWorkerPool::SetWorkerCount ( u32 count ) {
+
+	if ( count == this->mThreads.Size ()) return;
+
+	this->Stop ();
+	if ( !count ) return;
+	
+	this->mIsRunning = true;
+	this->mThreads.Init ( count );
+	
+	for ( u32 i = 0; i < count; ++i ) {
+		MOAIThread* thread = new MOAIThread ();
+		thread->Start ( _main, this, 0 );
+		this->mThreads [ i ] = thread;
+	}
+}
+
+//----------------------------------------------------------------//
+void MOAIWorkerPool::Stop () {
+
+	if ( !this->mThreads.Size ()) return;
+
+	this->mCondition.Lock ();
+	this->mIsRunning = false;
+	this->mCondition.Broadcast ();
+	this->mCondition.Unlock ();
+
+	for ( u32 i = 0; i < this->mThreads.Size (); ++i ) {
+		MOAIThread* thread = this->mThreads [ i ];
+		thread->Join ();
+		delete thread;
+	}
+	this->mThreads.Clear ();
+}
@@ -0,0 +1,58 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef MOAIWORKERPOOL_H
+#define MOAIWORKERPOOL_H
+
+#include <moai-util/MOAIConditionVariable.h>
+#include <moai-util/MOAIThread.h>
+
+//================================================================//
+// MOAIWorkerPool
+//================================================================//
+// Fork and join over a fixed set of worker threads. Run () hands out job
+// indices to the workers and to the calling thread and returns once every
+// job is done. Unlike MOAITaskQueue, nothing is published afterward; the
+// caller owns the results as soon as Run () returns.
+class MOAIWorkerPool {
+public:
+
+	typedef void ( *Func )( void* param, u32 idx );
+
+private:
+
+	ZLLeanArray < MOAIThread* >		mThreads;
+
+	MOAIConditionVariable			mCondition;
+	bool							mIsRunning;
+
+	Func							mFunc;
+	void*							mParam;
+	u32								mTotal;
+	u32								mNext;
+	u32								mFinished;
+
+	//----------------------------------------------------------------//
+	static void		_main					( void* param, MOAIThreadState& threadState );
+
+	//----------------------------------------------------------------//
+	void			Main					();
+					MOAIWorkerPool			( const MOAIWorkerPool& ) {}
+
+	//----------------------------------------------------------------//
+	MOAIWorkerPool& operator = ( const MOAIWorkerPool& ) {
+		return *this;
+	}
+
+public:
+
+	//----------------------------------------------------------------//
+	u32				GetWorkerCount			() const;
+					MOAIWorkerPool			();
+					~MOAIWorkerPool			();
+	void			Run						( Func func, void* param, u32 total );
+	void			SetWorkerCount			( u32 count );
+	void			Stop					();
+};
+
+#endif
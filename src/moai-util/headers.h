@@ -32,6 +32,7 @@
 #include <moai-util/MOAIThread.h>
 #include <moai-util/MOAIThread_posix.h>
 #include <moai-util/MOAIThread_win32.h>
+#include <moai-util/MOAIWorkerPool.h>
 
 #if MOAI_WITH_TINYXML
   #include <moai-util/MOAIXmlParser.h>
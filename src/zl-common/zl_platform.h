@@ -110,6 +110,18 @@
 	#define MOAI_ARM7
 #endif
 
+// define MOAI_NO_SIMD to force the scalar math paths
+#ifndef MOAI_NO_SIMD
+	#if defined ( __SSE__ ) || defined ( _M_X64 ) || ( defined ( _M_IX86_FP ) && ( _M_IX86_FP >= 1 ))
+		#define MOAI_SSE
+	#elif defined ( __ARM_NEON ) || defined ( __ARM_NEON__ )
+		#define MOAI_NEON
+	#endif
+	#if defined ( MOAI_SSE ) || defined ( MOAI_NEON )
+		#define MOAI_SIMD
+	#endif
+#endif
+
 #ifdef MOAI_COMPILER_MSVC
 	#define SUPPRESS_EMPTY_FILE_WARNING namespace { char gDummy##__LINE__; }
 #else
@@ -8,6 +8,7 @@
 #include <zl-util/ZLMathConsts.h>
 #include <zl-util/ZLMatrix.h>
 #include <zl-util/ZLRect.h>
+#include <zl-util/ZLSimd.h>
 #include <zl-util/ZLTrig.h>
 #include <zl-util/ZLVec2D.h>
 #include <zl-util/ZLVec3D.h>
@@ -328,6 +329,8 @@ public:
 	//----------------------------------------------------------------//
 	void Multiply ( const ZLMetaAffine3D < TYPE >& mtx2, const ZLMetaAffine3D < TYPE >& mtx1 ) {
 
+		if ( ZLSimd::MultiplyAffine3D ( this->m, mtx2.m, mtx1.m )) return;
+
 		this->m [ C0_R0 ]	=	( mtx1.m [ C0_R0 ] * mtx2.m [ C0_R0 ])	+
 								( mtx1.m [ C1_R0 ] * mtx2.m [ C0_R1 ])	+
 								( mtx1.m [ C2_R0 ] * mtx2.m [ C0_R2 ]);
@@ -842,6 +845,39 @@ public:
 		rect.Bless ();
 	}
 
+	//----------------------------------------------------------------//
+	template < typename PARAM_TYPE >
+	void TransformPoints ( ZLMetaVec2D < PARAM_TYPE >* points, size_t total ) const {
+
+		if ( ZLSimd::TransformPoints ( &this->m [ C0_R0 ], &this->m [ C1_R0 ], &this->m [ C3_R0 ], points, total )) return;
+
+		for ( size_t i = 0; i < total; ++i ) {
+			this->Transform ( points [ i ]);
+		}
+	}
+
+	//----------------------------------------------------------------//
+	template < typename PARAM_TYPE >
+	void TransformPoints ( ZLMetaVec3D < PARAM_TYPE >* points, size_t total ) const {
+
+		if ( ZLSimd::TransformPoints ( &this->m [ C0_R0 ], &this->m [ C1_R0 ], &this->m [ C2_R0 ], &this->m [ C3_R0 ], points, total )) return;
+
+		for ( size_t i = 0; i < total; ++i ) {
+			this->Transform ( points [ i ]);
+		}
+	}
+
+	//----------------------------------------------------------------//
+	template < typename PARAM_TYPE >
+	void TransformPoints ( ZLMetaVec4D < PARAM_TYPE >* points, size_t total ) const {
+
+		if ( ZLSimd::TransformPoints ( &this->m [ C0_R0 ], &this->m [ C1_R0 ], &this->m [ C2_R0 ], &this->m [ C3_R0 ], points, total, true )) return;
+
+		for ( size_t i = 0; i < total; ++i ) {
+			this->Transform ( points [ i ]);
+		}
+	}
+
 	//----------------------------------------------------------------//
 	template < typename PARAM_TYPE>
 	void TransformQuad ( ZLMetaVec2D < PARAM_TYPE >* quad ) const {
@@ -905,14 +941,18 @@ public:
 			
 		#else
 		
-			this->Transform ( quad [ 0 ]);
-			this->Transform ( quad [ 1 ]);
-			this->Transform ( quad [ 2 ]);
-			this->Transform ( quad [ 3 ]);
+			this->TransformPoints ( quad, 4 );
 		
 		#endif
 	}
 
+	//----------------------------------------------------------------//
+	template < typename PARAM_TYPE >
+	void TransformQuads ( ZLMetaVec2D < PARAM_TYPE >* quads, size_t totalQuads ) const {
+
+		this->TransformPoints ( quads, totalQuads * 4 );
+	}
+
 	//----------------------------------------------------------------//
 	// Transforms w/o translation
 	template < typename PARAM_TYPE >
@@ -11,13 +11,84 @@
 
 #define MIN_FILL_RATIO 0.95f
 
+// matches ZLDist::VecToPlane, which snaps smaller distances to zero
+#define PLANE_SNAP 0.000001f
+
 //================================================================//
 // local
 //================================================================//
 
-static double	_frustArea		( const ZLFrustum& frust );
-static double	_quadArea		( const ZLVec3D& v0, const ZLVec3D& v1, const ZLVec3D& v2, const ZLVec3D& v3 );
-static bool		_vecToXYPlane	( const ZLVec3D& v0, const ZLVec3D& v1, ZLVec2D& result );
+static void		_classifyPlanes		( const ZLFrustum& frust, const ZLBox& box, u32& outside, u32& inside );
+static double	_frustArea			( const ZLFrustum& frust );
+static double	_quadArea			( const ZLVec3D& v0, const ZLVec3D& v1, const ZLVec3D& v2, const ZLVec3D& v3 );
+static bool		_vecToXYPlane		( const ZLVec3D& v0, const ZLVec3D& v1, ZLVec2D& result );
+
+//----------------------------------------------------------------//
+// sets a bit in outside for each plane the box is entirely in front of and a bit in inside for
+// each plane it is entirely behind; same results as ZLSect::BoxToPlane, six planes at a time
+void _classifyPlanes ( const ZLFrustum& frust, const ZLBox& box, u32& outside, u32& inside ) {
+
+	ZLVec3D spans = box.mMax;
+	spans.Sub ( box.mMin );
+	spans.Scale ( 0.5f );
+
+	ZLVec3D center = box.mMin;
+	center.Add ( spans );
+
+	#ifdef MOAI_SIMD
+
+		ZLSimdVec4 cX = ZLSimdVec4::Splat ( center.mX );
+		ZLSimdVec4 cY = ZLSimdVec4::Splat ( center.mY );
+		ZLSimdVec4 cZ = ZLSimdVec4::Splat ( center.mZ );
+
+		ZLSimdVec4 sX = ZLSimdVec4::Splat ( spans.mX );
+		ZLSimdVec4 sY = ZLSimdVec4::Splat ( spans.mY );
+		ZLSimdVec4 sZ = ZLSimdVec4::Splat ( spans.mZ );
+
+		ZLSimdVec4 zero = ZLSimdVec4::Splat ( 0.0f );
+		ZLSimdVec4 snap = ZLSimdVec4::Splat ( PLANE_SNAP );
+
+		outside = 0;
+		inside = 0;
+
+		for ( u32 i = 0; i < 8; i += 4 ) {
+
+			ZLSimdVec4 nX = ZLSimdVec4::Load ( &frust.mPlaneRows [ 0 ][ i ]);
+			ZLSimdVec4 nY = ZLSimdVec4::Load ( &frust.mPlaneRows [ 1 ][ i ]);
+			ZLSimdVec4 nZ = ZLSimdVec4::Load ( &frust.mPlaneRows [ 2 ][ i ]);
+			ZLSimdVec4 dist = ZLSimdVec4::Load ( &frust.mPlaneRows [ 3 ][ i ]);
+
+			ZLSimdVec4 d = ((( cX * nX ) + ( cY * nY )) + ( cZ * nZ )) + dist;
+			ZLSimdVec4 r = (( sX * nX ).Abs () + ( sY * nY ).Abs ()) + ( sZ * nZ ).Abs ();
+
+			u32 snapped = d.Abs ().CompareLess ( snap );
+
+			outside |= ( d.CompareGreater ( r ) & ~snapped ) << i;
+			inside |= ( d.CompareLess ( zero - r ) & ~snapped ) << i;
+		}
+
+		outside &= ZLFrustum::CULL_PLANES;
+		inside &= ZLFrustum::CULL_PLANES;
+
+	#else
+
+		outside = 0;
+		inside = 0;
+
+		for ( u32 i = 0; i < ZLFrustum::TOTAL_PLANES; ++i ) {
+
+			s32 side = ZLSect::BoxToPlane ( box, frust.mPlanes [ i ]);
+
+			if ( side > 0 ) {
+				outside |= 1 << i;
+			}
+			else if ( side < 0 ) {
+				inside |= 1 << i;
+			}
+		}
+
+	#endif
+}
 
 //----------------------------------------------------------------//
 double _frustArea ( const ZLFrustum& frust ) {
@@ -132,6 +203,60 @@ bool _vecToXYPlane ( const ZLVec3D& v0, const ZLVec3D& v1, ZLVec2D& result ) {
 // ZLFrustum
 //================================================================//
 
+//----------------------------------------------------------------//
+// cullMask holds the tests still to run against the box; a box inside a parent
+// volume can skip the tests the parent passed outright. on return it holds the
+// tests the box straddles, and is zero when the box is entirely inside. lastPlane
+// is the test that last culled a box (TOTAL_PLANES for the AABB); it is tried
+// first, since a box that is culled tends to be culled by the same plane again.
+u32 ZLFrustum::Classify ( const ZLBox& box, u32& cullMask, u32& lastPlane ) const {
+
+	if ( !this->mUsePlanesForCull ) {
+		cullMask &= CULL_AABB;
+	}
+
+	if ( cullMask & ( 1 << lastPlane )) {
+		if ( lastPlane == TOTAL_PLANES ) {
+			if ( !box.Overlap ( this->mAABB )) return BOX_OUTSIDE;
+		}
+		else if ( ZLSect::BoxToPlane ( box, this->mPlanes [ lastPlane ]) > 0 ) {
+			return BOX_OUTSIDE;
+		}
+	}
+
+	u32 inside = 0;
+
+	if ( cullMask & CULL_AABB ) {
+	
+		if ( !box.Overlap ( this->mAABB )) {
+			lastPlane = TOTAL_PLANES;
+			return BOX_OUTSIDE;
+		}
+		
+		if ( this->mAABB.Contains ( box.mMin ) && this->mAABB.Contains ( box.mMax )) {
+			inside |= CULL_AABB;
+		}
+	}
+
+	if ( cullMask & CULL_PLANES ) {
+	
+		u32 planesOutside;
+		u32 planesInside;
+		_classifyPlanes ( *this, box, planesOutside, planesInside );
+		
+		planesOutside &= cullMask;
+		
+		if ( planesOutside ) {
+			for ( lastPlane = 0; !( planesOutside & ( 1 << lastPlane )); ++lastPlane );
+			return BOX_OUTSIDE;
+		}
+		inside |= planesInside;
+	}
+
+	cullMask &= ~inside;
+	return cullMask ? BOX_INTERSECTS : BOX_INSIDE;
+}
+
 //----------------------------------------------------------------//
 bool ZLFrustum::Cull ( const ZLVec3D& vec ) const {
 
@@ -151,17 +276,9 @@ bool ZLFrustum::Cull ( const ZLVec3D& vec ) const {
 //----------------------------------------------------------------//
 bool ZLFrustum::Cull ( const ZLBox& box ) const {
 
-	if ( !box.Overlap ( mAABB )) return true;
-
-	if ( this->mUsePlanesForCull ) {
-		if ( ZLSect::BoxToPlane ( box, mPlanes [ NEAR_PLANE ]) > 0 ) return true;
-		if ( ZLSect::BoxToPlane ( box, mPlanes [ FAR_PLANE ]) > 0 ) return true;
-		if ( ZLSect::BoxToPlane ( box, mPlanes [ LEFT_PLANE ]) > 0 ) return true;
-		if ( ZLSect::BoxToPlane ( box, mPlanes [ RIGHT_PLANE ]) > 0 ) return true;
-		if ( ZLSect::BoxToPlane ( box, mPlanes [ TOP_PLANE ]) > 0 ) return true;
-		if ( ZLSect::BoxToPlane ( box, mPlanes [ BOTTOM_PLANE ]) > 0 ) return true;
-	}
-	return false;
+	u32 cullMask = CULL_ALL;
+	u32 lastPlane = TOTAL_PLANES;
+	return this->Classify ( box, cullMask, lastPlane ) == BOX_OUTSIDE;
 }
 
 //----------------------------------------------------------------//
@@ -297,6 +414,22 @@ void ZLFrustum::Init ( const ZLMatrix4x4& invViewProjMtx ) {
 	this->mPlanes [ NEAR_PLANE ].Init ( nrt, nlt, nlb );
 	this->mPlanes [ FAR_PLANE ].Init ( flt, frt, frb );
 	
+	for ( u32 i = 0; i < 8; ++i ) {
+		
+		if ( i < TOTAL_PLANES ) {
+			this->mPlaneRows [ 0 ][ i ] = this->mPlanes [ i ].mNorm.mX;
+			this->mPlaneRows [ 1 ][ i ] = this->mPlanes [ i ].mNorm.mY;
+			this->mPlaneRows [ 2 ][ i ] = this->mPlanes [ i ].mNorm.mZ;
+			this->mPlaneRows [ 3 ][ i ] = this->mPlanes [ i ].mDist;
+		}
+		else {
+			this->mPlaneRows [ 0 ][ i ] = 0.0f;
+			this->mPlaneRows [ 1 ][ i ] = 0.0f;
+			this->mPlaneRows [ 2 ][ i ] = 0.0f;
+			this->mPlaneRows [ 3 ][ i ] = -1.0f;
+		}
+	}
+	
 	double frustArea = _frustArea ( *this );
 	double boxArea = this->mAABB.Area ();
 	
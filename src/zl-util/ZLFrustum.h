@@ -41,15 +41,31 @@ public:
 		TOTAL_POINTS,
 	};
 
+	enum {
+		BOX_OUTSIDE,
+		BOX_INTERSECTS,
+		BOX_INSIDE,
+	};
+
+	// cull masks for Classify: one bit per plane, plus one for the AABB test
+	static const u32	CULL_PLANES		= ( 1 << TOTAL_PLANES ) - 1;
+	static const u32	CULL_AABB		= 1 << TOTAL_PLANES;
+	static const u32	CULL_ALL		= CULL_PLANES | CULL_AABB;
+
 	ZLBox		mAABB;
 	ZLVec3D		mPoints [ TOTAL_POINTS ];
 	ZLPlane3D	mPlanes [ TOTAL_PLANES ];
 	bool		mUsePlanesForCull;
 
+	// the planes' x, y, z and dist in separate rows, padded to eight lanes with
+	// a plane every box is behind; set by Init for the vectorized box test
+	float		mPlaneRows [ 4 ][ 8 ];
+
 	//----------------------------------------------------------------//
 //	void		BeginFit		( ZLFrustumFitter& fitter, const ZLVec3D& loc );
 //	void		EndFit			( ZLFrustumFitter& fitter );
 //	void		FitPoint		( ZLFrustumFitter& fitter, const ZLVec3D& loc, float radius );
+	u32			Classify		( const ZLBox& box, u32& cullMask, u32& lastPlane ) const;
 	bool		Cull			( const ZLVec3D& vec ) const;
 	bool		Cull			( const ZLBox& box ) const;
 	bool		Cull			( const ZLPrism& prism ) const;
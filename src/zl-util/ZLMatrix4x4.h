@@ -7,6 +7,7 @@
 #include <zl-util/ZLLog.h>
 #include <zl-util/ZLMatrix.h>
 #include <zl-util/ZLRect.h>
+#include <zl-util/ZLSimd.h>
 #include <zl-util/ZLTrig.h>
 #include <zl-util/ZLVec3D.h>
 #include <zl-util/ZLVec4D.h>
@@ -316,6 +317,8 @@ public:
 	//----------------------------------------------------------------//
 	bool Inverse ( const ZLMetaMatrix4x4 < TYPE >& mtx ) {
 
+		if ( ZLSimd::InverseMatrix4x4 ( this->m, mtx.m )) return true;
+
 		// 2x2 determinants
 		TYPE fA0 = mtx.m[C0_R0]*mtx.m[C1_R1] - mtx.m[C1_R0]*mtx.m[C0_R1];
 		TYPE fA1 = mtx.m[C0_R0]*mtx.m[C2_R1] - mtx.m[C2_R0]*mtx.m[C0_R1];
@@ -384,6 +387,8 @@ public:
 	//----------------------------------------------------------------//
 	void Multiply (	const ZLMetaMatrix4x4 < TYPE >& mtx2, const ZLMetaMatrix4x4 < TYPE >& mtx1 ) {
 
+		if ( ZLSimd::MultiplyMatrix4x4 ( this->m, mtx2.m, mtx1.m )) return;
+
 		m[C0_R0]	=	( mtx1.m[C0_R0] * mtx2.m[C0_R0] )	+
 						( mtx1.m[C1_R0] * mtx2.m[C0_R1] )	+
 						( mtx1.m[C2_R0] * mtx2.m[C0_R2] )	+
@@ -937,6 +942,39 @@ public:
 		rect.Bless ();
 	}
 
+	//----------------------------------------------------------------//
+	template < typename PARAM_TYPE >
+	void TransformPoints ( ZLMetaVec2D < PARAM_TYPE >* points, size_t total ) const {
+
+		if ( ZLSimd::TransformPoints ( &this->m [ C0_R0 ], &this->m [ C1_R0 ], &this->m [ C3_R0 ], points, total )) return;
+
+		for ( size_t i = 0; i < total; ++i ) {
+			this->Transform ( points [ i ]);
+		}
+	}
+
+	//----------------------------------------------------------------//
+	template < typename PARAM_TYPE >
+	void TransformPoints ( ZLMetaVec3D < PARAM_TYPE >* points, size_t total ) const {
+
+		if ( ZLSimd::TransformPoints ( &this->m [ C0_R0 ], &this->m [ C1_R0 ], &this->m [ C2_R0 ], &this->m [ C3_R0 ], points, total )) return;
+
+		for ( size_t i = 0; i < total; ++i ) {
+			this->Transform ( points [ i ]);
+		}
+	}
+
+	//----------------------------------------------------------------//
+	template < typename PARAM_TYPE >
+	void TransformPoints ( ZLMetaVec4D < PARAM_TYPE >* points, size_t total ) const {
+
+		if ( ZLSimd::TransformPoints ( &this->m [ C0_R0 ], &this->m [ C1_R0 ], &this->m [ C2_R0 ], &this->m [ C3_R0 ], points, total, false )) return;
+
+		for ( size_t i = 0; i < total; ++i ) {
+			this->Transform ( points [ i ]);
+		}
+	}
+
 	//----------------------------------------------------------------//
 	template < typename PARAM_TYPE>
 	void TransformQuad ( ZLMetaVec2D < PARAM_TYPE >* quad ) const {
@@ -999,11 +1037,8 @@ public:
 			quad[3].mX = outpt_mat[12]; quad[3].mY = outpt_mat[13];
 			
 		#else
-	
-			this->Transform ( quad [ 0 ]);
-			this->Transform ( quad [ 1 ]);
-			this->Transform ( quad [ 2 ]);
-			this->Transform ( quad [ 3 ]);
+		
+			this->TransformPoints ( quad, 4 );
 		
 		#endif
 	}
@@ -1012,10 +1047,21 @@ public:
 	template < typename PARAM_TYPE>
 	void TransformQuad ( ZLMetaVec4D < PARAM_TYPE >* quad ) const {
 	
-		this->Transform ( quad [ 0 ]);
-		this->Transform ( quad [ 1 ]);
-		this->Transform ( quad [ 2 ]);
-		this->Transform ( quad [ 3 ]);
+		this->TransformPoints ( quad, 4 );
+	}
+
+	//----------------------------------------------------------------//
+	template < typename PARAM_TYPE >
+	void TransformQuads ( ZLMetaVec2D < PARAM_TYPE >* quads, size_t totalQuads ) const {
+
+		this->TransformPoints ( quads, totalQuads * 4 );
+	}
+
+	//----------------------------------------------------------------//
+	template < typename PARAM_TYPE >
+	void TransformQuads ( ZLMetaVec4D < PARAM_TYPE >* quads, size_t totalQuads ) const {
+
+		this->TransformPoints ( quads, totalQuads * 4 );
 	}
 
 	//----------------------------------------------------------------//
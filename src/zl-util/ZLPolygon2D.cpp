@@ -293,8 +293,8 @@ bool ZLPolygon2D::GetDistance ( const ZLVec2D& point, float& d, ZLVec2D& p ) con
 		
 		ZLVec2D candidateP;
 		
-		// if point lies inside edge
-		if (( edgeDist0 <= edgeDist ) && ( edgeDist <= edgeDist1 )) {
+		// if point lies inside edge (zero length edges have no inside; they'd snap every point to itself)
+		if (( edgeDist0 < edgeDist1 ) && ( edgeDist0 <= edgeDist ) && ( edgeDist <= edgeDist1 )) {
 			// snap the point onto the edge
 			
 			// edge normal
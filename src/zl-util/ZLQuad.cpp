@@ -339,34 +339,7 @@ void ZLQuad::Transform ( const ZLAffine2D& transform ) {
 //----------------------------------------------------------------//
 void ZLQuad::Transform ( const ZLAffine3D& transform ) {
 	
-	float x;
-	float y;
-	
-	const float* m = transform.m;
-	
-	x =	( m[ ZLAffine3D::C0_R0 ] * this->mV [ 0 ].mX ) + ( m[ ZLAffine3D::C1_R0 ] * this->mV [ 0 ].mY ) + ( m[ ZLAffine3D::C3_R0 ]);
-	y =	( m[ ZLAffine3D::C0_R1 ] * this->mV [ 0 ].mX ) + ( m[ ZLAffine3D::C1_R1 ] * this->mV [ 0 ].mY ) + ( m[ ZLAffine3D::C3_R1 ]);
-	
-	this->mV [ 0 ].mX = x;
-	this->mV [ 0 ].mY = y;
-	
-	x =	( m[ ZLAffine3D::C0_R0 ] * this->mV [ 1 ].mX ) + ( m[ ZLAffine3D::C1_R0 ] * this->mV [ 1 ].mY ) + ( m[ ZLAffine3D::C3_R0 ]);
-	y =	( m[ ZLAffine3D::C0_R1 ] * this->mV [ 1 ].mX ) + ( m[ ZLAffine3D::C1_R1 ] * this->mV [ 1 ].mY ) + ( m[ ZLAffine3D::C3_R1 ]);
-	
-	this->mV [ 1 ].mX = x;
-	this->mV [ 1 ].mY = y;
-	
-	x =	( m[ ZLAffine3D::C0_R0 ] * this->mV [ 2 ].mX ) + ( m[ ZLAffine3D::C1_R0 ] * this->mV [ 2 ].mY ) + ( m[ ZLAffine3D::C3_R0 ]);
-	y =	( m[ ZLAffine3D::C0_R1 ] * this->mV [ 2 ].mX ) + ( m[ ZLAffine3D::C1_R1 ] * this->mV [ 2 ].mY ) + ( m[ ZLAffine3D::C3_R1 ]);
-	
-	this->mV [ 2 ].mX = x;
-	this->mV [ 2 ].mY = y;
-	
-	x =	( m[ ZLAffine3D::C0_R0 ] * this->mV [ 3 ].mX ) + ( m[ ZLAffine3D::C1_R0 ] * this->mV [ 3 ].mY ) + ( m[ ZLAffine3D::C3_R0 ]);
-	y =	( m[ ZLAffine3D::C0_R1 ] * this->mV [ 3 ].mX ) + ( m[ ZLAffine3D::C1_R1 ] * this->mV [ 3 ].mY ) + ( m[ ZLAffine3D::C3_R1 ]);
-	
-	this->mV [ 3 ].mX = x;
-	this->mV [ 3 ].mY = y;
+	transform.TransformPoints ( this->mV, 4 );
 }
 
 //----------------------------------------------------------------//
@@ -0,0 +1,548 @@
+// Copyright (c) 2010-2017 Zipline Games, Inc. All Rights Reserved.
+// http://getmoai.com
+
+#ifndef ZLSIMD_H
+#define ZLSIMD_H
+
+#include <zl-util/ZLVec2D.h>
+#include <zl-util/ZLVec3D.h>
+#include <zl-util/ZLVec4D.h>
+
+#if defined ( MOAI_SSE )
+	#include <xmmintrin.h>
+#elif defined ( MOAI_NEON )
+	#include <arm_neon.h>
+#endif
+
+#ifdef MOAI_SIMD
+
+//================================================================//
+// ZLSimdVec4
+//================================================================//
+// four float lanes; only the operations the kernels below use
+class ZLSimdVec4 {
+public:
+
+	#if defined ( MOAI_SSE )
+		__m128			mV;
+	#else
+		float32x4_t		mV;
+	#endif
+
+	//----------------------------------------------------------------//
+	inline ZLSimdVec4 Abs () const {
+
+		ZLSimdVec4 result;
+		#if defined ( MOAI_SSE )
+			result.mV = _mm_andnot_ps ( _mm_set1_ps ( -0.0f ), this->mV );
+		#else
+			result.mV = vabsq_f32 ( this->mV );
+		#endif
+		return result;
+	}
+
+	//----------------------------------------------------------------//
+	// one bit per lane, lane 0 in bit 0
+	inline u32 CompareGreater ( const ZLSimdVec4& rhs ) const {
+
+		#if defined ( MOAI_SSE )
+			return ( u32 )_mm_movemask_ps ( _mm_cmpgt_ps ( this->mV, rhs.mV ));
+		#else
+			return MoveMask ( vcgtq_f32 ( this->mV, rhs.mV ));
+		#endif
+	}
+
+	//----------------------------------------------------------------//
+	// one bit per lane, lane 0 in bit 0
+	inline u32 CompareLess ( const ZLSimdVec4& rhs ) const {
+
+		#if defined ( MOAI_SSE )
+			return ( u32 )_mm_movemask_ps ( _mm_cmplt_ps ( this->mV, rhs.mV ));
+		#else
+			return MoveMask ( vcltq_f32 ( this->mV, rhs.mV ));
+		#endif
+	}
+
+	//----------------------------------------------------------------//
+	inline ZLSimdVec4 DupEven () const {
+
+		ZLSimdVec4 result;
+		#if defined ( MOAI_SSE )
+			result.mV = _mm_shuffle_ps ( this->mV, this->mV, _MM_SHUFFLE ( 2, 2, 0, 0 ));
+		#else
+			result.mV = vtrnq_f32 ( this->mV, this->mV ).val [ 0 ];
+		#endif
+		return result;
+	}
+
+	//----------------------------------------------------------------//
+	inline ZLSimdVec4 DupOdd () const {
+
+		ZLSimdVec4 result;
+		#if defined ( MOAI_SSE )
+			result.mV = _mm_shuffle_ps ( this->mV, this->mV, _MM_SHUFFLE ( 3, 3, 1, 1 ));
+		#else
+			result.mV = vtrnq_f32 ( this->mV, this->mV ).val [ 1 ];
+		#endif
+		return result;
+	}
+
+	//----------------------------------------------------------------//
+	inline static ZLSimdVec4 Load ( const float* src ) {
+
+		ZLSimdVec4 result;
+		#if defined ( MOAI_SSE )
+			result.mV = _mm_loadu_ps ( src );
+		#else
+			result.mV = vld1q_f32 ( src );
+		#endif
+		return result;
+	}
+
+	#if defined ( MOAI_NEON )
+
+		//----------------------------------------------------------------//
+		inline static u32 MoveMask ( uint32x4_t cmp ) {
+
+			static const uint32_t bits [ 4 ] = { 1, 2, 4, 8 };
+
+			uint32x4_t lanes = vandq_u32 ( cmp, vld1q_u32 ( bits ));
+			uint32x2_t sum = vpadd_u32 ( vget_low_u32 ( lanes ), vget_high_u32 ( lanes ));
+			sum = vpadd_u32 ( sum, sum );
+			return ( u32 )vget_lane_u32 ( sum, 0 );
+		}
+
+	#endif
+
+	//----------------------------------------------------------------//
+	inline ZLSimdVec4 operator + ( const ZLSimdVec4& rhs ) const {
+
+		ZLSimdVec4 result;
+		#if defined ( MOAI_SSE )
+			result.mV = _mm_add_ps ( this->mV, rhs.mV );
+		#else
+			result.mV = vaddq_f32 ( this->mV, rhs.mV );
+		#endif
+		return result;
+	}
+
+	//----------------------------------------------------------------//
+	inline ZLSimdVec4 operator - ( const ZLSimdVec4& rhs ) const {
+
+		ZLSimdVec4 result;
+		#if defined ( MOAI_SSE )
+			result.mV = _mm_sub_ps ( this->mV, rhs.mV );
+		#else
+			result.mV = vsubq_f32 ( this->mV, rhs.mV );
+		#endif
+		return result;
+	}
+
+	//----------------------------------------------------------------//
+	inline ZLSimdVec4 operator * ( const ZLSimdVec4& rhs ) const {
+
+		ZLSimdVec4 result;
+		#if defined ( MOAI_SSE )
+			result.mV = _mm_mul_ps ( this->mV, rhs.mV );
+		#else
+			result.mV = vmulq_f32 ( this->mV, rhs.mV );
+		#endif
+		return result;
+	}
+
+	//----------------------------------------------------------------//
+	inline static ZLSimdVec4 Set ( float x, float y, float z, float w ) {
+
+		ZLSimdVec4 result;
+		#if defined ( MOAI_SSE )
+			result.mV = _mm_setr_ps ( x, y, z, w );
+		#else
+			float lanes [ 4 ] = { x, y, z, w };
+			result.mV = vld1q_f32 ( lanes );
+		#endif
+		return result;
+	}
+
+	//----------------------------------------------------------------//
+	inline static ZLSimdVec4 Splat ( float s ) {
+
+		ZLSimdVec4 result;
+		#if defined ( MOAI_SSE )
+			result.mV = _mm_set1_ps ( s );
+		#else
+			result.mV = vdupq_n_f32 ( s );
+		#endif
+		return result;
+	}
+
+	//----------------------------------------------------------------//
+	template < int LANE >
+	inline ZLSimdVec4 SplatLane () const {
+
+		ZLSimdVec4 result;
+		#if defined ( MOAI_SSE )
+			result.mV = _mm_shuffle_ps ( this->mV, this->mV, _MM_SHUFFLE ( LANE, LANE, LANE, LANE ));
+		#else
+			result.mV = vdupq_lane_f32 ( LANE < 2 ? vget_low_f32 ( this->mV ) : vget_high_f32 ( this->mV ), LANE & 1 );
+		#endif
+		return result;
+	}
+
+	//----------------------------------------------------------------//
+	inline void Store ( float* dest ) const {
+
+		#if defined ( MOAI_SSE )
+			_mm_storeu_ps ( dest, this->mV );
+		#else
+			vst1q_f32 ( dest, this->mV );
+		#endif
+	}
+
+	//----------------------------------------------------------------//
+	// ( z, w, x, y )
+	inline ZLSimdVec4 SwapHalves () const {
+
+		ZLSimdVec4 result;
+		#if defined ( MOAI_SSE )
+			result.mV = _mm_shuffle_ps ( this->mV, this->mV, _MM_SHUFFLE ( 1, 0, 3, 2 ));
+		#else
+			result.mV = vcombine_f32 ( vget_high_f32 ( this->mV ), vget_low_f32 ( this->mV ));
+		#endif
+		return result;
+	}
+
+	//----------------------------------------------------------------//
+	// ( y, x, w, z )
+	inline ZLSimdVec4 SwapPairs () const {
+
+		ZLSimdVec4 result;
+		#if defined ( MOAI_SSE )
+			result.mV = _mm_shuffle_ps ( this->mV, this->mV, _MM_SHUFFLE ( 2, 3, 0, 1 ));
+		#else
+			result.mV = vrev64q_f32 ( this->mV );
+		#endif
+		return result;
+	}
+
+	//----------------------------------------------------------------//
+	inline static void Transpose ( ZLSimdVec4& r0, ZLSimdVec4& r1, ZLSimdVec4& r2, ZLSimdVec4& r3 ) {
+
+		#if defined ( MOAI_SSE )
+			_MM_TRANSPOSE4_PS ( r0.mV, r1.mV, r2.mV, r3.mV );
+		#else
+			float32x4x2_t t01 = vtrnq_f32 ( r0.mV, r1.mV );
+			float32x4x2_t t23 = vtrnq_f32 ( r2.mV, r3.mV );
+			r0.mV = vcombine_f32 ( vget_low_f32 ( t01.val [ 0 ]), vget_low_f32 ( t23.val [ 0 ]));
+			r1.mV = vcombine_f32 ( vget_low_f32 ( t01.val [ 1 ]), vget_low_f32 ( t23.val [ 1 ]));
+			r2.mV = vcombine_f32 ( vget_high_f32 ( t01.val [ 0 ]), vget_high_f32 ( t23.val [ 0 ]));
+			r3.mV = vcombine_f32 ( vget_high_f32 ( t01.val [ 1 ]), vget_high_f32 ( t23.val [ 1 ]));
+		#endif
+	}
+};
+
+#endif
+
+//================================================================//
+// ZLSimd
+//================================================================//
+// Float kernels behind the matrix templates. Each template calls the kernel
+// first and falls back on its own scalar code when it returns false: the
+// catch-all templates below always do, and the float overloads only exist
+// when MOAI_SIMD is defined. The kernels add and multiply in the same order
+// as the scalar code, so products and transforms match it exactly unless the
+// compiler contracts the scalar code into fused multiply-adds. The inverse
+// uses a different (cofactor) expansion and only agrees to within rounding.
+class ZLSimd {
+private:
+
+	#ifdef MOAI_SIMD
+
+		//----------------------------------------------------------------//
+		inline static ZLSimdVec4 LoadColumn3 ( const float* column, float w ) {
+
+			return ZLSimdVec4::Set ( column [ 0 ], column [ 1 ], column [ 2 ], w );
+		}
+
+	#endif
+
+public:
+
+	//----------------------------------------------------------------//
+	template < typename TYPE >
+	inline static bool InverseMatrix4x4 ( TYPE* result, const TYPE* mtx ) {
+		UNUSED ( result );
+		UNUSED ( mtx );
+		return false;
+	}
+
+	//----------------------------------------------------------------//
+	template < typename TYPE >
+	inline static bool MultiplyAffine3D ( TYPE* result, const TYPE* mtx2, const TYPE* mtx1 ) {
+		UNUSED ( result );
+		UNUSED ( mtx2 );
+		UNUSED ( mtx1 );
+		return false;
+	}
+
+	//----------------------------------------------------------------//
+	template < typename TYPE >
+	inline static bool MultiplyMatrix4x4 ( TYPE* result, const TYPE* mtx2, const TYPE* mtx1 ) {
+		UNUSED ( result );
+		UNUSED ( mtx2 );
+		UNUSED ( mtx1 );
+		return false;
+	}
+
+	//----------------------------------------------------------------//
+	template < typename TYPE, typename PARAM_TYPE >
+	inline static bool TransformPoints ( const TYPE* c0, const TYPE* c1, const TYPE* c3, ZLMetaVec2D < PARAM_TYPE >* points, size_t total ) {
+		UNUSED ( c0 );
+		UNUSED ( c1 );
+		UNUSED ( c3 );
+		UNUSED ( points );
+		UNUSED ( total );
+		return false;
+	}
+
+	//----------------------------------------------------------------//
+	template < typename TYPE, typename PARAM_TYPE >
+	inline static bool TransformPoints ( const TYPE* c0, const TYPE* c1, const TYPE* c2, const TYPE* c3, ZLMetaVec3D < PARAM_TYPE >* points, size_t total ) {
+		UNUSED ( c0 );
+		UNUSED ( c1 );
+		UNUSED ( c2 );
+		UNUSED ( c3 );
+		UNUSED ( points );
+		UNUSED ( total );
+		return false;
+	}
+
+	//----------------------------------------------------------------//
+	template < typename TYPE, typename PARAM_TYPE >
+	inline static bool TransformPoints ( const TYPE* c0, const TYPE* c1, const TYPE* c2, const TYPE* c3, ZLMetaVec4D < PARAM_TYPE >* points, size_t total, bool affine ) {
+		UNUSED ( c0 );
+		UNUSED ( c1 );
+		UNUSED ( c2 );
+		UNUSED ( c3 );
+		UNUSED ( points );
+		UNUSED ( total );
+		UNUSED ( affine );
+		return false;
+	}
+
+	#ifdef MOAI_SIMD
+
+		//----------------------------------------------------------------//
+		// column major, as ZLMetaMatrix4x4. follows Intel's "Streaming SIMD Extensions -
+		// Inverse of 4x4 Matrix" (AP-928), which treats the columns as rows; the
+		// inverse of the transpose is the transpose of the inverse, so it comes
+		// out in the same layout.
+		inline static bool InverseMatrix4x4 ( float* result, const float* mtx ) {
+
+			ZLSimdVec4 row0 = ZLSimdVec4::Load ( mtx );
+			ZLSimdVec4 row1 = ZLSimdVec4::Load ( mtx + 4 );
+			ZLSimdVec4 row2 = ZLSimdVec4::Load ( mtx + 8 );
+			ZLSimdVec4 row3 = ZLSimdVec4::Load ( mtx + 12 );
+
+			ZLSimdVec4::Transpose ( row0, row1, row2, row3 );
+			row1 = row1.SwapHalves ();
+			row3 = row3.SwapHalves ();
+
+			ZLSimdVec4 minor0;
+			ZLSimdVec4 minor1;
+			ZLSimdVec4 minor2;
+			ZLSimdVec4 minor3;
+			ZLSimdVec4 tmp;
+
+			tmp = ( row2 * row3 ).SwapPairs ();
+			minor0 = row1 * tmp;
+			minor1 = row0 * tmp;
+			tmp = tmp.SwapHalves ();
+			minor0 = ( row1 * tmp ) - minor0;
+			minor1 = (( row0 * tmp ) - minor1 ).SwapHalves ();
+
+			tmp = ( row1 * row2 ).SwapPairs ();
+			minor0 = ( row3 * tmp ) + minor0;
+			minor3 = row0 * tmp;
+			tmp = tmp.SwapHalves ();
+			minor0 = minor0 - ( row3 * tmp );
+			minor3 = (( row0 * tmp ) - minor3 ).SwapHalves ();
+
+			tmp = ( row1.SwapHalves () * row3 ).SwapPairs ();
+			row2 = row2.SwapHalves ();
+			minor0 = ( row2 * tmp ) + minor0;
+			minor2 = row0 * tmp;
+			tmp = tmp.SwapHalves ();
+			minor0 = minor0 - ( row2 * tmp );
+			minor2 = (( row0 * tmp ) - minor2 ).SwapHalves ();
+
+			tmp = ( row0 * row1 ).SwapPairs ();
+			minor2 = ( row3 * tmp ) + minor2;
+			minor3 = ( row2 * tmp ) - minor3;
+			tmp = tmp.SwapHalves ();
+			minor2 = ( row3 * tmp ) - minor2;
+			minor3 = minor3 - ( row2 * tmp );
+
+			tmp = ( row0 * row3 ).SwapPairs ();
+			minor1 = minor1 - ( row2 * tmp );
+			minor2 = ( row1 * tmp ) + minor2;
+			tmp = tmp.SwapHalves ();
+			minor1 = ( row2 * tmp ) + minor1;
+			minor2 = minor2 - ( row1 * tmp );
+
+			tmp = ( row0 * row2 ).SwapPairs ();
+			minor1 = ( row3 * tmp ) + minor1;
+			minor3 = minor3 - ( row1 * tmp );
+			tmp = tmp.SwapHalves ();
+			minor1 = minor1 - ( row3 * tmp );
+			minor3 = ( row1 * tmp ) + minor3;
+
+			float lanes [ 4 ];
+			( row0 * minor0 ).Store ( lanes );
+			float det = ( lanes [ 0 ] + lanes [ 1 ]) + ( lanes [ 2 ] + lanes [ 3 ]);
+
+			if ( det == 0.0f ) return false;
+
+			ZLSimdVec4 invDet = ZLSimdVec4::Splat ( 1.0f / det );
+
+			( minor0 * invDet ).Store ( result );
+			( minor1 * invDet ).Store ( result + 4 );
+			( minor2 * invDet ).Store ( result + 8 );
+			( minor3 * invDet ).Store ( result + 12 );
+
+			return true;
+		}
+
+		//----------------------------------------------------------------//
+		// column major, three rows, as ZLMetaAffine3D
+		inline static bool MultiplyAffine3D ( float* result, const float* mtx2, const float* mtx1 ) {
+
+			ZLSimdVec4 c0 = LoadColumn3 ( mtx1, 0.0f );
+			ZLSimdVec4 c1 = LoadColumn3 ( mtx1 + 3, 0.0f );
+			ZLSimdVec4 c2 = LoadColumn3 ( mtx1 + 6, 0.0f );
+			ZLSimdVec4 c3 = LoadColumn3 ( mtx1 + 9, 0.0f );
+
+			float columns [ 16 ];
+
+			for ( u32 i = 0; i < 4; ++i ) {
+
+				const float* b = mtx2 + ( i * 3 );
+
+				ZLSimdVec4 column = (( c0 * ZLSimdVec4::Splat ( b [ 0 ])) + ( c1 * ZLSimdVec4::Splat ( b [ 1 ]))) + ( c2 * ZLSimdVec4::Splat ( b [ 2 ]));
+				if ( i == 3 ) {
+					column = column + c3;
+				}
+				column.Store ( columns + ( i * 4 ));
+			}
+
+			for ( u32 i = 0; i < 4; ++i ) {
+				result [ i * 3 ]			= columns [ i * 4 ];
+				result [( i * 3 ) + 1 ]		= columns [( i * 4 ) + 1 ];
+				result [( i * 3 ) + 2 ]		= columns [( i * 4 ) + 2 ];
+			}
+			return true;
+		}
+
+		//----------------------------------------------------------------//
+		// column major, as ZLMetaMatrix4x4
+		inline static bool MultiplyMatrix4x4 ( float* result, const float* mtx2, const float* mtx1 ) {
+
+			ZLSimdVec4 c0 = ZLSimdVec4::Load ( mtx1 );
+			ZLSimdVec4 c1 = ZLSimdVec4::Load ( mtx1 + 4 );
+			ZLSimdVec4 c2 = ZLSimdVec4::Load ( mtx1 + 8 );
+			ZLSimdVec4 c3 = ZLSimdVec4::Load ( mtx1 + 12 );
+
+			ZLSimdVec4 columns [ 4 ];
+
+			for ( u32 i = 0; i < 4; ++i ) {
+
+				const float* b = mtx2 + ( i * 4 );
+
+				columns [ i ] =	((( c0 * ZLSimdVec4::Splat ( b [ 0 ])) +
+								( c1 * ZLSimdVec4::Splat ( b [ 1 ]))) +
+								( c2 * ZLSimdVec4::Splat ( b [ 2 ]))) +
+								( c3 * ZLSimdVec4::Splat ( b [ 3 ]));
+			}
+
+			// everything is read before anything is written, so result may alias either input
+			for ( u32 i = 0; i < 4; ++i ) {
+				columns [ i ].Store ( result + ( i * 4 ));
+			}
+			return true;
+		}
+
+		//----------------------------------------------------------------//
+		// two points per vector: ( x0, y0, x1, y1 )
+		inline static bool TransformPoints ( const float* c0, const float* c1, const float* c3, ZLMetaVec2D < float >* points, size_t total ) {
+
+			ZLSimdVec4 m0 = ZLSimdVec4::Set ( c0 [ 0 ], c0 [ 1 ], c0 [ 0 ], c0 [ 1 ]);
+			ZLSimdVec4 m1 = ZLSimdVec4::Set ( c1 [ 0 ], c1 [ 1 ], c1 [ 0 ], c1 [ 1 ]);
+			ZLSimdVec4 m3 = ZLSimdVec4::Set ( c3 [ 0 ], c3 [ 1 ], c3 [ 0 ], c3 [ 1 ]);
+
+			float* cursor = &points [ 0 ].mX;
+			size_t pairs = total >> 1;
+
+			for ( size_t i = 0; i < pairs; ++i, cursor += 4 ) {
+
+				ZLSimdVec4 v = ZLSimdVec4::Load ( cursor );
+				(( m0 * v.DupEven ()) + ( m1 * v.DupOdd ()) + m3 ).Store ( cursor );
+			}
+
+			if ( total & 1 ) {
+
+				float lanes [ 4 ];
+				ZLSimdVec4 v = ZLSimdVec4::Set ( cursor [ 0 ], cursor [ 1 ], cursor [ 0 ], cursor [ 1 ]);
+				(( m0 * v.DupEven ()) + ( m1 * v.DupOdd ()) + m3 ).Store ( lanes );
+
+				cursor [ 0 ] = lanes [ 0 ];
+				cursor [ 1 ] = lanes [ 1 ];
+			}
+			return true;
+		}
+
+		//----------------------------------------------------------------//
+		inline static bool TransformPoints ( const float* c0, const float* c1, const float* c2, const float* c3, ZLMetaVec3D < float >* points, size_t total ) {
+
+			ZLSimdVec4 m0 = LoadColumn3 ( c0, 0.0f );
+			ZLSimdVec4 m1 = LoadColumn3 ( c1, 0.0f );
+			ZLSimdVec4 m2 = LoadColumn3 ( c2, 0.0f );
+			ZLSimdVec4 m3 = LoadColumn3 ( c3, 0.0f );
+
+			float lanes [ 4 ];
+
+			for ( size_t i = 0; i < total; ++i ) {
+
+				ZLMetaVec3D < float >& point = points [ i ];
+
+				((( m0 * ZLSimdVec4::Splat ( point.mX )) + ( m1 * ZLSimdVec4::Splat ( point.mY ))) + ( m2 * ZLSimdVec4::Splat ( point.mZ )) + m3 ).Store ( lanes );
+
+				point.mX = lanes [ 0 ];
+				point.mY = lanes [ 1 ];
+				point.mZ = lanes [ 2 ];
+			}
+			return true;
+		}
+
+		//----------------------------------------------------------------//
+		// affine columns have three rows, and w passes through unchanged: the fourth
+		// lane of the loaded columns is 0 for x, y and z and 1 for w
+		inline static bool TransformPoints ( const float* c0, const float* c1, const float* c2, const float* c3, ZLMetaVec4D < float >* points, size_t total, bool affine ) {
+
+			ZLSimdVec4 m0 = affine ? LoadColumn3 ( c0, 0.0f ) : ZLSimdVec4::Load ( c0 );
+			ZLSimdVec4 m1 = affine ? LoadColumn3 ( c1, 0.0f ) : ZLSimdVec4::Load ( c1 );
+			ZLSimdVec4 m2 = affine ? LoadColumn3 ( c2, 0.0f ) : ZLSimdVec4::Load ( c2 );
+			ZLSimdVec4 m3 = affine ? LoadColumn3 ( c3, 1.0f ) : ZLSimdVec4::Load ( c3 );
+
+			float* cursor = &points [ 0 ].mX;
+
+			for ( size_t i = 0; i < total; ++i, cursor += 4 ) {
+
+				ZLSimdVec4 v = ZLSimdVec4::Load ( cursor );
+				((( m0 * v.SplatLane < 0 >()) + ( m1 * v.SplatLane < 1 >())) + ( m2 * v.SplatLane < 2 >()) + ( m3 * v.SplatLane < 3 >())).Store ( cursor );
+			}
+			return true;
+		}
+
+	#endif
+};
+
+#endif